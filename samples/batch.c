@@ -0,0 +1,148 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include "sdlang.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*
+    Parses a list of files one after another, like samples/parser.c would
+    in a loop, then all at once with sdlang_parser_parse_jobs(), and prints
+    the files per second of both.
+
+    batch [-j threads] [-d] [-r rounds] file...
+*/
+
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void count_token(const struct sdlang_token_t* token, void* user)
+{
+    ++*(size_t*)user;
+}
+
+static void count_parser_token(struct sdlang_parser_t* parser, const struct sdlang_token_t* token, void* user)
+{
+    ++*(size_t*)user;
+}
+
+static void report_error(enum sdlang_error_t error, int line)
+{
+    fprintf(stderr, "error [%d] at line %d\n", error, line);
+}
+
+int main(int argc, char* argv[])
+{
+    int threads = 0, rounds = 3, arg = 1;
+    bool documents = false;
+
+    for (; arg < argc && argv[arg][0] == '-'; arg++)
+    {
+        if (strcmp(argv[arg], "-j") == 0 && arg + 1 < argc)
+        {
+            threads = atoi(argv[++arg]);
+        }
+        else if (strcmp(argv[arg], "-r") == 0 && arg + 1 < argc)
+        {
+            rounds = atoi(argv[++arg]);
+        }
+        else if (strcmp(argv[arg], "-d") == 0)
+        {
+            documents = true;
+        }
+    }
+
+    const size_t count = (size_t)(argc - arg);
+
+    if (count == 0 || rounds < 1)
+    {
+        fprintf(stderr, "usage: %s [-j threads] [-d] [-r rounds] file...\n", argv[0]);
+        return 1;
+    }
+
+    struct sdlang_job_t* jobs = calloc(count, sizeof(struct sdlang_job_t));
+    struct sdlang_document_t* docs = calloc(count, sizeof(struct sdlang_document_t));
+    size_t* tokens = calloc(count, sizeof(size_t));
+
+    if (jobs == NULL || docs == NULL || tokens == NULL)
+    {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    struct sdlang_parser_t parser;
+    sdlang_parser_init(&parser);
+    sdlang_parser_set_report_error(&parser, report_error);
+    sdlang_set_report_error(report_error);
+
+    if (!documents)
+    {
+        sdlang_parser_set_emit_token(&parser, count_parser_token);
+        sdlang_set_emit_token(count_token);
+    }
+
+    sdlang_parser_set_threads(&parser, threads);
+
+    double sequential = 1e30, pooled = 1e30;
+    int result = 0;
+
+    for (int round = 0; round < rounds; round++)
+    {
+        double start = now();
+
+        for (size_t i = 0; i < count; i++)
+        {
+            if (documents)
+            {
+                result |= sdlang_document_parse_file(&docs[i], argv[arg + (int)i], NULL);
+            }
+            else
+            {
+                result |= sdlang_parse_file(argv[arg + (int)i], &tokens[i]);
+            }
+        }
+
+        double elapsed = now() - start;
+        sequential = elapsed < sequential ? elapsed : sequential;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            if (documents)
+            {
+                sdlang_document_free(&docs[i]);
+            }
+
+            jobs[i] = (struct sdlang_job_t) {
+                .path = argv[arg + (int)i],
+                .user = &tokens[i],
+                .document = documents ? &docs[i] : NULL
+            };
+        }
+
+        start = now();
+        result |= sdlang_parser_parse_jobs(&parser, jobs, count);
+        elapsed = now() - start;
+        pooled = elapsed < pooled ? elapsed : pooled;
+
+        for (size_t i = 0; documents && i < count; i++)
+        {
+            sdlang_document_free(&docs[i]);
+        }
+    }
+
+    fprintf(stdout, "%zu files, %d threads\n", count, parser.threads);
+    fprintf(stdout, "sequential: %.1f ms, %.0f files/s\n", sequential * 1e3, (double)count / sequential);
+    fprintf(stdout, "jobs:       %.1f ms, %.0f files/s\n", pooled * 1e3, (double)count / pooled);
+
+    free(tokens);
+    free(docs);
+    free(jobs);
+
+    return result != 0;
+}
@@ -0,0 +1,1687 @@
+#define _POSIX_C_SOURCE 199309L
+#define _DEFAULT_SOURCE
+
+#include "sdlang.h"
+
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef __linux__
+# include <linux/perf_event.h>
+# include <sys/ioctl.h>
+# include <sys/syscall.h>
+# include <unistd.h>
+#endif
+
+#if !defined(SDLANG_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+# define SCANNERS "simd"
+#else
+# define SCANNERS "scalar"
+#endif
+
+/*
+    Generates a document of a given shape, or reads one, and runs one of
+    these tests on it:
+
+    - parse: parses it from memory in three modes
+        - tokens: a token callback which only counts tokens
+        - table: a function table with a handler for every value type
+        - null: a function table without handlers, so only the dispatch runs
+    - io: parses it from memory, from a memory-mapped file and from a
+      stdio stream, without handlers - the file is the input file, the
+      output file, or a temporary bench-io.sdl
+    - feed: passes it to sdlang_parser_feed() in pieces of 1460 (a TCP
+      segment), 4096 and 65536 bytes, and checks that the bytes copied to
+      the parser buffer are bounded by the tokens split between pieces
+    - threads: parses it from memory with 1, 2, 4, 8 and 16 threads, with
+      a token callback which only counts tokens, and prints the speedup
+      over one thread - the input needs to span many SDLANG_PARSE_CHUNKSIZE
+      blocks for all threads to get work
+    - ints: converts the integer tokens of each type with the library and
+      with strtol() and friends
+    - floats: converts the float tokens with the library and with strtof()
+      and strtod()
+    - memory: builds a sdlang_document_t, and a pointer tree with one
+      malloc() per node, value, attribute name and string from the same
+      tokens, and prints the size, bytes per node, allocations and build
+      time of both - tree sizes don't include the per-block overhead of
+      malloc(), typically 8 to 16 bytes
+
+    The first line names the skip scanners the library was built with, the
+    same way sdlang.c picks them - bench-nosimd is built from sdlang.c with
+    SDLANG_NO_SIMD, to compare against the scalar loops.
+
+    For each mode, prints the best of all rounds in MB/s and tokens/s, and in
+    CPU cycles per byte where perf_event_open() is available. Conversions
+    print MB/s of token text, ns per token, and whether both sides agree.
+
+    bench [-t test] [-s shape] [-d depth] [-m megabytes] [-r rounds] [-o output.sdl] [file]
+
+    tests: parse (default), io, feed, threads, ints, floats, memory
+    shapes: mixed (default), strings, numbers, base64, comments, tiny,
+            integers (default for ints), floats (default for floats) - the
+            last two aren't part of mixed
+*/
+
+enum test_t
+{
+    TEST_PARSE,
+    TEST_IO,
+    TEST_FEED,
+    TEST_THREADS,
+    TEST_INTS,
+    TEST_FLOATS,
+    TEST_MEMORY,
+    NUM_TESTS
+};
+
+static const char* const test_names[NUM_TESTS] = {
+    "parse", "io", "feed", "threads", "ints", "floats", "memory"
+};
+
+enum shape_t
+{
+    SHAPE_MIXED,
+    SHAPE_STRINGS,
+    SHAPE_NUMBERS,
+    SHAPE_BASE64,
+    SHAPE_COMMENTS,
+    SHAPE_TINY,
+    SHAPE_INTEGERS,
+    SHAPE_FLOATS,
+    NUM_SHAPES
+};
+
+static const char* const shape_names[NUM_SHAPES] = {
+    "mixed", "strings", "numbers", "base64", "comments", "tiny", "integers", "floats"
+};
+
+static const char* const words[] = {
+    "alpha", "beta", "gamma", "delta", "render", "target", "shader", "mesh",
+    "light", "camera", "texture", "sound", "level", "player", "config", "value"
+};
+
+#define NUM_WORDS (sizeof(words) / sizeof(words[0]))
+
+struct generator_t
+{
+    char* text;
+    size_t len, capacity;
+    uint64_t state;
+    enum shape_t shape;
+    int depth;
+};
+
+enum source_t
+{
+    SOURCE_BUFFER,
+    SOURCE_FILE,
+    SOURCE_STREAM,
+    SOURCE_FEED
+};
+
+struct input_t
+{
+    enum source_t source;
+    const char* text;
+    size_t len;
+    const char* path;
+
+    /* bytes per sdlang_parser_feed() call */
+    size_t piece;
+};
+
+struct extents_t
+{
+    /* offsets of the token strings in the text */
+    const char* text;
+    size_t* offsets;
+    size_t count, capacity;
+};
+
+struct result_t
+{
+    double seconds;
+    uint64_t cycles;
+};
+
+struct tree_value_t
+{
+    struct tree_value_t* next;
+
+    /* attribute name, or NULL */
+    char* attr;
+
+    enum sdlang_token_type_t type;
+    union
+    {
+        int64_t i;
+        uint64_t u;
+        double f;
+
+        /* token text of strings, binaries and 128 bit integers */
+        char* text;
+    } data;
+};
+
+struct tree_node_t
+{
+    struct tree_node_t* parent;
+    struct tree_node_t* first_child;
+    struct tree_node_t* last_child;
+    struct tree_node_t* next_sibling;
+    struct tree_value_t* first_value;
+    struct tree_value_t* last_value;
+    char* name;
+    int line;
+};
+
+struct tree_t
+{
+    /* the node of the innermost block, and the node being built */
+    struct tree_node_t root;
+    struct tree_node_t* block;
+    struct tree_node_t* node;
+    char* attr;
+
+    size_t bytes, allocations, nodes;
+    bool failed;
+};
+
+struct token_set_t
+{
+    /* null-terminated copies of the token strings, one after the other */
+    enum sdlang_token_type_t type;
+    const char* name;
+    const char* libc;
+    char* text;
+    size_t len, capacity, count;
+};
+
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static uint32_t next_random(struct generator_t* gen)
+{
+    gen->state ^= gen->state << 13;
+    gen->state ^= gen->state >> 7;
+    gen->state ^= gen->state << 17;
+    return (uint32_t)(gen->state >> 32);
+}
+
+static const char* random_word(struct generator_t* gen)
+{
+    return words[next_random(gen) % NUM_WORDS];
+}
+
+static bool append(struct generator_t* gen, const char* format, ...)
+{
+    va_list args;
+    int n;
+
+    for (;;)
+    {
+        va_start(args, format);
+        n = vsnprintf(gen->text + gen->len, gen->capacity - gen->len, format, args);
+        va_end(args);
+
+        if (n < 0)
+        {
+            return false;
+        }
+
+        if ((size_t)n < gen->capacity - gen->len)
+        {
+            gen->len += (size_t)n;
+            return true;
+        }
+
+        char* text = realloc(gen->text, gen->capacity * 2);
+
+        if (text == NULL)
+        {
+            return false;
+        }
+
+        gen->text = text;
+        gen->capacity *= 2;
+    }
+}
+
+static bool indent(struct generator_t* gen, int level)
+{
+    return append(gen, "%*s", level * 4, "");
+}
+
+static bool strings_node(struct generator_t* gen, int level)
+{
+    bool ok = indent(gen, level) && append(gen, "%s name=\"%s %s\"", random_word(gen), random_word(gen), random_word(gen));
+
+    for (uint32_t i = 0, n = 1 + next_random(gen) % 4; ok && i < n; i++)
+    {
+        switch (next_random(gen) % 4)
+        {
+        case 0:
+            ok = append(gen, " \"%s %s %s %s\"", random_word(gen), random_word(gen), random_word(gen), random_word(gen));
+            break;
+        case 1:
+            ok = append(gen, " \"%s \\\"%s\\\"\\t%s\\n\"", random_word(gen), random_word(gen), random_word(gen));
+            break;
+        case 2:
+            ok = append(gen, " `%s\\%s {%s}`", random_word(gen), random_word(gen), random_word(gen));
+            break;
+        default:
+            ok = append(gen, " \"%s/%s/%s.%s\"", random_word(gen), random_word(gen), random_word(gen), random_word(gen));
+            break;
+        }
+    }
+
+    return ok && append(gen, "\n");
+}
+
+static bool numbers_node(struct generator_t* gen, int level)
+{
+    bool ok = indent(gen, level) && append(gen, "%s id=%u", random_word(gen), next_random(gen) % 100000);
+
+    for (uint32_t i = 0, n = 2 + next_random(gen) % 6; ok && i < n; i++)
+    {
+        const uint32_t r = next_random(gen);
+
+        switch (r % 6)
+        {
+        case 0:
+            ok = append(gen, " %d", (int)(r >> 8) - (1 << 23));
+            break;
+        case 1:
+            ok = append(gen, " %uL", r);
+            break;
+        case 2:
+            ok = append(gen, " %.6f", ((double)(r >> 8) - (1 << 23)) * 1e-3);
+            break;
+        case 3:
+            ok = append(gen, " %.3ff", (double)(r >> 12) * 1e-2);
+            break;
+        case 4:
+            ok = append(gen, " %.5e", (double)r * 1e-7);
+            break;
+        default:
+            ok = append(gen, " 0x%x", r);
+            break;
+        }
+    }
+
+    return ok && append(gen, "\n");
+}
+
+static bool integers_node(struct generator_t* gen, int level)
+{
+    /* every integer token type, in all lengths */
+    bool ok = indent(gen, level) && append(gen, "%s", random_word(gen));
+
+    for (uint32_t i = 0, n = 4 + next_random(gen) % 8; ok && i < n; i++)
+    {
+        const uint32_t r = next_random(gen);
+        const uint32_t bits = next_random(gen) >> (r >> 2) % 32;
+        const int sign = r & 128 ? -1 : 1;
+
+        switch (r % 4)
+        {
+        case 0:
+            ok = append(gen, " %" PRId32, sign * (int32_t)(bits >> 1));
+            break;
+        case 1:
+            ok = append(gen, " %" PRId64 "L", sign * (int64_t)(((uint64_t)bits << 32 | next_random(gen)) >> 1));
+            break;
+        case 2:
+            ok = append(gen, " 0x%" PRIx32, bits);
+            break;
+        default:
+            ok = append(gen, " 0x%" PRIx64, (uint64_t)(bits | 1) << 32 | next_random(gen));
+            break;
+        }
+    }
+
+    return ok && append(gen, "\n");
+}
+
+static double random_float(struct generator_t* gen, int min_exp, int max_exp)
+{
+    /* 64 random bits in [0, 1), scaled by a random power of 10 */
+    double value = ((double)next_random(gen) * 4294967296.0 + next_random(gen)) / 18446744073709551616.0;
+
+    for (int e = min_exp + (int)(next_random(gen) % (uint32_t)(max_exp - min_exp + 1)); e != 0; e += e < 0 ? 1 : -1)
+    {
+        value = e < 0 ? value / 10 : value * 10;
+    }
+
+    return next_random(gen) & 1 ? -value : value;
+}
+
+static bool floats_node(struct generator_t* gen, int level)
+{
+    /* float32 and float64 tokens, in fixed and e-notation, with up to 17 significant digits */
+    bool ok = indent(gen, level) && append(gen, "%s", random_word(gen));
+
+    for (uint32_t i = 0, n = 4 + next_random(gen) % 8; ok && i < n; i++)
+    {
+        const uint32_t r = next_random(gen);
+
+        switch (r % 4)
+        {
+        case 0:
+            ok = append(gen, " %.*f", 1 + (int)((r >> 8) % 9), random_float(gen, -3, 6));
+            break;
+        case 1:
+            ok = append(gen, " %.*e", (int)((r >> 8) % 17), random_float(gen, -30, 30));
+            break;
+        case 2:
+            ok = append(gen, " %.*ff", 1 + (int)((r >> 8) % 7), random_float(gen, -3, 6));
+            break;
+        default:
+            ok = append(gen, " %.*ef", (int)((r >> 8) % 9), random_float(gen, -30, 30));
+            break;
+        }
+    }
+
+    return ok && append(gen, "\n");
+}
+
+static bool base64_node(struct generator_t* gen, int level)
+{
+    static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    const uint32_t groups = 16 + next_random(gen) % 64;
+    bool ok = indent(gen, level) && append(gen, "%s [", random_word(gen));
+
+    for (uint32_t i = 0; ok && i < groups; i++)
+    {
+        const uint32_t r = next_random(gen);
+        ok = append(gen, "%c%c%c%c", alphabet[r & 63], alphabet[(r >> 6) & 63],
+                    alphabet[(r >> 12) & 63], alphabet[(r >> 18) & 63]);
+    }
+
+    return ok && append(gen, "]\n");
+}
+
+static bool comments_node(struct generator_t* gen, int level)
+{
+    bool ok = true;
+
+    for (uint32_t i = 0, n = 1 + next_random(gen) % 3; ok && i < n; i++)
+    {
+        ok = indent(gen, level);
+
+        switch (next_random(gen) % 4)
+        {
+        case 0:
+            ok = ok && append(gen, "// %s %s %s, \"not\" {a string}\n", random_word(gen), random_word(gen), random_word(gen));
+            break;
+        case 1:
+            ok = ok && append(gen, "# %s %s %s\n", random_word(gen), random_word(gen), random_word(gen));
+            break;
+        case 2:
+            ok = ok && append(gen, "-- %s %s %s\n", random_word(gen), random_word(gen), random_word(gen));
+            break;
+        default:
+            ok = ok && append(gen, "/* %s\n%*s   %s %s */\n", random_word(gen), level * 4, "", random_word(gen), random_word(gen));
+            break;
+        }
+    }
+
+    return ok && indent(gen, level) && append(gen, "%s %u // %s\n", random_word(gen), next_random(gen) % 1000, random_word(gen));
+}
+
+static bool tiny_node(struct generator_t* gen, int level)
+{
+    static const char* const names[] = { "a", "b", "c", "x", "y", "z", "w", "id" };
+    const uint32_t r = next_random(gen);
+
+    switch (r % 4)
+    {
+    case 0:
+        return indent(gen, level) && append(gen, "%s\n", names[(r >> 8) & 7]);
+    case 1:
+        return indent(gen, level) && append(gen, "%s %u\n", names[(r >> 8) & 7], (r >> 16) & 255);
+    case 2:
+        return indent(gen, level) && append(gen, "%s true; %s\n", names[(r >> 8) & 7], names[(r >> 12) & 7]);
+    default:
+        return indent(gen, level) && append(gen, "%s \"%c\"\n", names[(r >> 8) & 7], 'a' + (r >> 16) % 26);
+    }
+}
+
+static bool leaf_node(struct generator_t* gen, int level)
+{
+    const enum shape_t shape = gen->shape == SHAPE_MIXED
+        ? (enum shape_t)(1 + next_random(gen) % SHAPE_TINY) : gen->shape;
+
+    switch (shape)
+    {
+    case SHAPE_STRINGS:
+        return strings_node(gen, level);
+    case SHAPE_NUMBERS:
+        return numbers_node(gen, level);
+    case SHAPE_BASE64:
+        return base64_node(gen, level);
+    case SHAPE_COMMENTS:
+        return comments_node(gen, level);
+    case SHAPE_INTEGERS:
+        return integers_node(gen, level);
+    case SHAPE_FLOATS:
+        return floats_node(gen, level);
+    default:
+        return tiny_node(gen, level);
+    }
+}
+
+static bool block_node(struct generator_t* gen, int level)
+{
+    /* a few leaves on each level, and one nested block down to the depth */
+    bool ok = indent(gen, level) && append(gen, "%s index=%d {\n", random_word(gen), level);
+
+    for (uint32_t i = 0, n = 2 + next_random(gen) % 4; ok && i < n; i++)
+    {
+        ok = leaf_node(gen, level + 1);
+    }
+
+    if (ok && level + 1 < gen->depth)
+    {
+        ok = block_node(gen, level + 1);
+    }
+
+    return ok && indent(gen, level) && append(gen, "}\n");
+}
+
+static char* generate(enum shape_t shape, int depth, size_t size, size_t* len)
+{
+    struct generator_t gen = { NULL, 0, 65536, 88172645463325252ull, shape, depth };
+    bool ok = (gen.text = malloc(gen.capacity)) != NULL;
+
+    while (ok && gen.len < size)
+    {
+        ok = depth > 0 ? block_node(&gen, 0) : leaf_node(&gen, 0);
+    }
+
+    if (!ok)
+    {
+        free(gen.text);
+        return NULL;
+    }
+
+    *len = gen.len;
+    return gen.text;
+}
+
+static char* read_file(const char* path, size_t* len)
+{
+    FILE* file = fopen(path, "rb");
+    char* text = NULL;
+    long size;
+
+    if (file == NULL)
+    {
+        return NULL;
+    }
+
+    if (fseek(file, 0, SEEK_END) == 0 && (size = ftell(file)) >= 0 && fseek(file, 0, SEEK_SET) == 0
+        && (text = malloc((size_t)size + 1)) != NULL)
+    {
+        *len = fread(text, 1, (size_t)size, file);
+    }
+
+    fclose(file);
+    return text;
+}
+
+static int open_cycles(void)
+{
+    /* user space CPU cycles of this thread, or -1 */
+#ifdef __linux__
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_CPU_CYCLES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#else
+    return -1;
+#endif
+}
+
+static void start_cycles(int fd)
+{
+#ifdef __linux__
+    if (fd >= 0)
+    {
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+}
+
+static uint64_t stop_cycles(int fd)
+{
+    uint64_t cycles = 0;
+
+#ifdef __linux__
+    if (fd >= 0)
+    {
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+
+        if (read(fd, &cycles, sizeof(cycles)) != sizeof(cycles))
+        {
+            cycles = 0;
+        }
+    }
+#endif
+
+    return cycles;
+}
+
+static void count_token(struct sdlang_parser_t* parser, const struct sdlang_token_t* token, void* user)
+{
+    ++*(size_t*)user;
+}
+
+/* function table handlers, which keep their values from being optimized away */
+static void block_begin(const char* node, void* user)
+{
+    *(double*)user += 1;
+}
+
+static void block_end(void* user)
+{
+    *(double*)user += 1;
+}
+
+static void value_i32(const char* node, const char* attr, int32_t value, void* user)
+{
+    *(double*)user += value;
+}
+
+static void value_i64(const char* node, const char* attr, int64_t value, void* user)
+{
+    *(double*)user += (double)value;
+}
+
+static void value_i128(const char* node, const char* attr, int64_t hi, uint64_t lo, void* user)
+{
+    *(double*)user += (double)lo;
+}
+
+static void value_f32(const char* node, const char* attr, float value, void* user)
+{
+    *(double*)user += value;
+}
+
+static void value_f64(const char* node, const char* attr, double value, void* user)
+{
+    *(double*)user += value;
+}
+
+static void value_string(const char* node, const char* attr, const char* ptr, int len, void* user)
+{
+    *(double*)user += len;
+}
+
+static void value_binary(const char* node, const char* attr, const unsigned char* ptr, int len, void* user)
+{
+    *(double*)user += len;
+}
+
+static void value_u32(const char* node, const char* attr, uint32_t value, void* user)
+{
+    *(double*)user += value;
+}
+
+static void value_u64(const char* node, const char* attr, uint64_t value, void* user)
+{
+    *(double*)user += (double)value;
+}
+
+static void value_bool(const char* node, const char* attr, bool value, void* user)
+{
+    *(double*)user += value;
+}
+
+static void value_null(const char* node, const char* attr, void* user)
+{
+    *(double*)user += 1;
+}
+
+static void report_error(enum sdlang_error_t error, int line)
+{
+    fprintf(stderr, "error [%d] at line %d\n", error, line);
+}
+
+static size_t read_stream(void* ptr, size_t size, void* user)
+{
+    return fread(ptr, 1, size, (FILE*)user);
+}
+
+static int parse_stream(struct sdlang_parser_t* parser, const char* path)
+{
+    /* the stream shares the user pointer with the callbacks, so the parser can't have any */
+    FILE* file = fopen(path, "rb");
+    int err;
+
+    if (file == NULL)
+    {
+        return SDLANG_PARSE_ERROR_IO;
+    }
+
+    err = sdlang_parser_parse(parser, read_stream, file);
+
+    fclose(file);
+
+    return err;
+}
+
+static int feed_pieces(struct sdlang_parser_t* parser, const struct input_t* input, void* user)
+{
+    int err = SDLANG_PARSE_OK;
+
+    sdlang_parser_begin(parser, user);
+
+    for (size_t offset = 0; offset < input->len && err == SDLANG_PARSE_OK; offset += input->piece)
+    {
+        const size_t len = input->len - offset < input->piece ? input->len - offset : input->piece;
+        err = sdlang_parser_feed(parser, input->text + offset, len);
+    }
+
+    return err != SDLANG_PARSE_OK ? err : sdlang_parser_finish(parser);
+}
+
+static int run(struct sdlang_parser_t* parser, const struct input_t* input, void* user,
+               int rounds, int fd, struct result_t* best)
+{
+    int err = SDLANG_PARSE_OK;
+
+    best->seconds = 1e30;
+    best->cycles = 0;
+
+    for (int round = 0; round < rounds; round++)
+    {
+        start_cycles(fd);
+        const double start = now();
+
+        switch (input->source)
+        {
+        case SOURCE_BUFFER:
+            err |= sdlang_parser_parse_buffer(parser, input->text, input->len, user);
+            break;
+        case SOURCE_FILE:
+            err |= sdlang_parser_parse_file(parser, input->path, user);
+            break;
+        case SOURCE_FEED:
+            err |= feed_pieces(parser, input, user);
+            break;
+        default:
+            err |= parse_stream(parser, input->path);
+            break;
+        }
+
+        const double elapsed = now() - start;
+        const uint64_t cycles = stop_cycles(fd);
+
+        best->seconds = elapsed < best->seconds ? elapsed : best->seconds;
+        best->cycles = best->cycles == 0 || (cycles != 0 && cycles < best->cycles) ? cycles : best->cycles;
+    }
+
+    return err;
+}
+
+static void print_result(const char* mode, const struct result_t* result, size_t len, size_t tokens)
+{
+    fprintf(stdout, "%-8s %9.1f %11.2f", mode, (double)len / result->seconds * 1e-6,
+            (double)tokens / result->seconds * 1e-6);
+
+    if (result->cycles != 0)
+    {
+        fprintf(stdout, " %12.2f\n", (double)result->cycles / (double)len);
+    }
+    else
+    {
+        fprintf(stdout, " %12s\n", "n/a");
+    }
+}
+
+static void collect_token(struct sdlang_parser_t* parser, const struct sdlang_token_t* token, void* user)
+{
+    /* token strings don't outlive the callback, so they are copied */
+    struct token_set_t* set = user;
+    const size_t len = (size_t)(token->string.to - token->string.from);
+
+    for (; set->libc != NULL && set->type != token->type; set++)
+    {
+    }
+
+    if (set->libc == NULL)
+    {
+        return;
+    }
+
+    if (set->len + len + 1 > set->capacity)
+    {
+        const size_t capacity = set->capacity * 2 > set->len + len + 1 ? set->capacity * 2 : set->len + len + 1;
+        char* text = realloc(set->text, capacity);
+
+        if (text == NULL)
+        {
+            return;
+        }
+
+        set->text = text;
+        set->capacity = capacity;
+    }
+
+    memcpy(set->text + set->len, token->string.from, len);
+    set->text[set->len + len] = '\0';
+    set->len += len + 1;
+    set->count++;
+}
+
+static struct sdlang_token_t* make_tokens(const struct token_set_t* set)
+{
+    struct sdlang_token_t* tokens = calloc(set->count + 1, sizeof(struct sdlang_token_t));
+    const char* text = set->text;
+
+    for (size_t i = 0; tokens != NULL && i < set->count; i++)
+    {
+        const size_t len = strlen(text);
+
+        tokens[i].type = set->type;
+        tokens[i].string.from = text;
+        tokens[i].string.to = text + len;
+        text += len + 1;
+    }
+
+    return tokens;
+}
+
+static uint64_t float_bits(float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static uint64_t double_bits(double value)
+{
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static uint64_t decode_sdlang(const struct sdlang_token_t* token, const struct sdlang_token_t* end)
+{
+    /* sums up the values, as bits for floats, so that the conversions can't be optimized away */
+    uint64_t sum = 0;
+
+    switch (token->type)
+    {
+    case SDLANG_TOKEN_INT32:
+        for (; token < end; token++)
+        {
+            sum += (uint64_t)(int64_t)sdlang_token_i32(token);
+        }
+        break;
+    case SDLANG_TOKEN_INT64:
+        for (; token < end; token++)
+        {
+            sum += (uint64_t)sdlang_token_i64(token);
+        }
+        break;
+    case SDLANG_TOKEN_FLOAT32:
+        for (; token < end; token++)
+        {
+            sum += float_bits(sdlang_token_f32(token));
+        }
+        break;
+    case SDLANG_TOKEN_FLOAT64:
+        for (; token < end; token++)
+        {
+            sum += double_bits(sdlang_token_f64(token));
+        }
+        break;
+    default:
+        for (; token < end; token++)
+        {
+            sum += sdlang_token_u64(token);
+        }
+        break;
+    }
+
+    return sum;
+}
+
+static uint64_t decode_libc(const struct sdlang_token_t* token, const struct sdlang_token_t* end)
+{
+    /* the strings are null-terminated, and the conversions stop at a 'L' or 'f' suffix */
+    uint64_t sum = 0;
+
+    switch (token->type)
+    {
+    case SDLANG_TOKEN_INT32:
+        for (; token < end; token++)
+        {
+            sum += (uint64_t)(int64_t)(int32_t)strtol(token->string.from, NULL, 10);
+        }
+        break;
+    case SDLANG_TOKEN_INT64:
+        for (; token < end; token++)
+        {
+            sum += (uint64_t)(int64_t)strtoll(token->string.from, NULL, 10);
+        }
+        break;
+    case SDLANG_TOKEN_UINT32:
+        for (; token < end; token++)
+        {
+            sum += (uint32_t)strtoul(token->string.from, NULL, 16);
+        }
+        break;
+    case SDLANG_TOKEN_FLOAT32:
+        for (; token < end; token++)
+        {
+            sum += float_bits(strtof(token->string.from, NULL));
+        }
+        break;
+    case SDLANG_TOKEN_FLOAT64:
+        for (; token < end; token++)
+        {
+            sum += double_bits(strtod(token->string.from, NULL));
+        }
+        break;
+    default:
+        for (; token < end; token++)
+        {
+            sum += (uint64_t)strtoull(token->string.from, NULL, 16);
+        }
+        break;
+    }
+
+    return sum;
+}
+
+static uint64_t run_decode(uint64_t (*decode)(const struct sdlang_token_t*, const struct sdlang_token_t*),
+                           const struct sdlang_token_t* tokens, size_t count, int rounds, double* best)
+{
+    uint64_t sum = 0;
+
+    *best = 1e30;
+
+    for (int round = 0; round < rounds; round++)
+    {
+        const double start = now();
+        sum = (*decode)(tokens, tokens + count);
+        const double elapsed = now() - start;
+
+        *best = elapsed < *best ? elapsed : *best;
+    }
+
+    return sum;
+}
+
+static int bench_decode(const struct input_t* input, struct token_set_t* sets, int rounds)
+{
+    struct sdlang_parser_t collect;
+    int err;
+
+    sdlang_parser_init(&collect);
+    sdlang_parser_set_emit_token(&collect, collect_token);
+    sdlang_parser_set_report_error(&collect, report_error);
+    err = sdlang_parser_parse_buffer(&collect, input->text, input->len, sets);
+    sdlang_parser_release(&collect);
+
+    if (err == SDLANG_PARSE_OK)
+    {
+        fprintf(stdout, "%-8s %9s %9s %8s %-9s %9s %8s\n", "type", "tokens", "MB/s", "ns/token", "libc", "MB/s", "ns/token");
+    }
+
+    for (struct token_set_t* set = sets; err == SDLANG_PARSE_OK && set->libc != NULL; set++)
+    {
+        struct sdlang_token_t* tokens = make_tokens(set);
+        double seconds, libc_seconds;
+
+        if (tokens == NULL)
+        {
+            err = SDLANG_PARSE_ERROR;
+            break;
+        }
+
+        if (set->count > 0)
+        {
+            const uint64_t sum = run_decode(decode_sdlang, tokens, set->count, rounds, &seconds);
+            const uint64_t libc_sum = run_decode(decode_libc, tokens, set->count, rounds, &libc_seconds);
+            /* the strings without their null terminators */
+            const double bytes = (double)(set->len - set->count);
+
+            fprintf(stdout, "%-8s %9zu %9.1f %8.1f %-9s %9.1f %8.1f%s\n", set->name, set->count,
+                    bytes / seconds * 1e-6, seconds / (double)set->count * 1e9, set->libc,
+                    bytes / libc_seconds * 1e-6, libc_seconds / (double)set->count * 1e9,
+                    sum == libc_sum ? "" : "  results differ");
+        }
+
+        free(tokens);
+    }
+
+    for (struct token_set_t* set = sets; set->libc != NULL; set++)
+    {
+        free(set->text);
+    }
+
+    return err;
+}
+
+static void* tree_alloc(struct tree_t* tree, size_t size)
+{
+    void* ptr = calloc(1, size);
+
+    tree->failed = tree->failed || ptr == NULL;
+    tree->bytes += size;
+    tree->allocations++;
+
+    return ptr;
+}
+
+static char* tree_text(struct tree_t* tree, const struct sdlang_token_t* token)
+{
+    const size_t len = (size_t)(token->string.to - token->string.from);
+    char* text = tree_alloc(tree, len + 1);
+
+    if (text != NULL)
+    {
+        memcpy(text, token->string.from, len);
+    }
+
+    return text;
+}
+
+static void tree_node(struct tree_t* tree, const struct sdlang_token_t* token)
+{
+    /* nodes without a name get an empty one, like in the document */
+    static const struct sdlang_token_t anonymous = { .type = SDLANG_TOKEN_NODE, .string = { "", "" } };
+    struct tree_node_t* node = tree_alloc(tree, sizeof(struct tree_node_t));
+
+    if (node == NULL)
+    {
+        return;
+    }
+
+    node->parent = tree->block;
+    node->name = tree_text(tree, token != NULL ? token : &anonymous);
+    node->line = token != NULL ? token->line : 0;
+
+    if (tree->block->last_child != NULL)
+    {
+        tree->block->last_child->next_sibling = node;
+    }
+    else
+    {
+        tree->block->first_child = node;
+    }
+
+    tree->block->last_child = node;
+    tree->node = node;
+    tree->nodes++;
+}
+
+static void tree_token(struct sdlang_parser_t* parser, const struct sdlang_token_t* token, void* user)
+{
+    struct tree_t* tree = user;
+    struct tree_value_t* value;
+
+    switch (token->type)
+    {
+    case SDLANG_TOKEN_NODE:
+        tree_node(tree, token);
+        return;
+    case SDLANG_TOKEN_NODE_END:
+        tree->node = NULL;
+        return;
+    case SDLANG_TOKEN_BLOCK:
+        if (tree->node == NULL)
+        {
+            tree_node(tree, NULL);
+        }
+
+        tree->block = tree->node != NULL ? tree->node : tree->block;
+        tree->node = NULL;
+        return;
+    case SDLANG_TOKEN_BLOCK_END:
+        tree->block = tree->block->parent != NULL ? tree->block->parent : tree->block;
+        tree->node = NULL;
+        return;
+    case SDLANG_TOKEN_ATTRIBUTE:
+        /* without the '=' */
+        tree->attr = tree_text(tree, token);
+
+        if (tree->attr != NULL)
+        {
+            tree->attr[token->string.to - token->string.from - 1] = '\0';
+        }
+        return;
+    default:
+        break;
+    }
+
+    if (tree->node == NULL)
+    {
+        tree_node(tree, NULL);
+    }
+
+    if (tree->node == NULL || (value = tree_alloc(tree, sizeof(struct tree_value_t))) == NULL)
+    {
+        return;
+    }
+
+    value->attr = tree->attr;
+    value->type = token->type;
+    tree->attr = NULL;
+
+    switch (token->type)
+    {
+    case SDLANG_TOKEN_INT32:
+        value->data.i = sdlang_token_i32(token);
+        break;
+    case SDLANG_TOKEN_INT64:
+        value->data.i = sdlang_token_i64(token);
+        break;
+    case SDLANG_TOKEN_UINT32:
+    case SDLANG_TOKEN_UINT64:
+        value->data.u = sdlang_token_u64(token);
+        break;
+    case SDLANG_TOKEN_FLOAT32:
+        value->data.f = sdlang_token_f32(token);
+        break;
+    case SDLANG_TOKEN_FLOAT64:
+        value->data.f = sdlang_token_f64(token);
+        break;
+    case SDLANG_TOKEN_STRING:
+    case SDLANG_TOKEN_BASE64:
+    case SDLANG_TOKEN_INT128:
+        value->data.text = tree_text(tree, token);
+        break;
+    default:
+        break;
+    }
+
+    if (tree->node->last_value != NULL)
+    {
+        tree->node->last_value->next = value;
+    }
+    else
+    {
+        tree->node->first_value = value;
+    }
+
+    tree->node->last_value = value;
+}
+
+static void tree_free(struct tree_node_t* node)
+{
+    for (struct tree_node_t* child = node->first_child, *next; child != NULL; child = next)
+    {
+        next = child->next_sibling;
+        tree_free(child);
+        free(child);
+    }
+
+    for (struct tree_value_t* value = node->first_value, *next; value != NULL; value = next)
+    {
+        next = value->next;
+
+        if (value->type == SDLANG_TOKEN_STRING || value->type == SDLANG_TOKEN_BASE64
+            || value->type == SDLANG_TOKEN_INT128)
+        {
+            free(value->data.text);
+        }
+
+        free(value->attr);
+        free(value);
+    }
+
+    free(node->name);
+}
+
+static void* counting_alloc(void* ptr, size_t size, void* user)
+{
+    /* counts allocations and reallocations, the document reports its own size */
+    if (size == 0)
+    {
+        free(ptr);
+        return NULL;
+    }
+
+    ++*(size_t*)user;
+    return realloc(ptr, size);
+}
+
+static void print_memory(const char* model, size_t bytes, size_t nodes, size_t allocations, double seconds)
+{
+    fprintf(stdout, "%-8s %9.1f %10.1f %11zu %9.1f\n", model, (double)bytes * 1e-6,
+            (double)bytes / (double)(nodes > 0 ? nodes : 1), allocations, seconds * 1e3);
+}
+
+static int bench_memory(const struct input_t* input, int rounds)
+{
+    struct sdlang_document_t doc;
+    struct sdlang_allocator_t allocator = { counting_alloc, NULL };
+    struct sdlang_parser_t parser;
+    struct tree_t tree;
+    size_t doc_allocations = 0, doc_bytes = 0, doc_nodes = 0;
+    double doc_seconds = 1e30, tree_seconds = 1e30;
+    int err = SDLANG_PARSE_OK;
+
+    sdlang_parser_init(&parser);
+    sdlang_parser_set_emit_token(&parser, tree_token);
+    sdlang_parser_set_report_error(&parser, report_error);
+
+    for (int round = 0; err == SDLANG_PARSE_OK && round < rounds; round++)
+    {
+        size_t allocations = 0;
+
+        allocator.user = &allocations;
+
+        double start = now();
+        err |= sdlang_document_parse_buffer(&doc, input->text, input->len, &allocator);
+        double elapsed = now() - start;
+
+        if (err != SDLANG_PARSE_OK)
+        {
+            break;
+        }
+
+        /* the root is no node of the document */
+        doc_seconds = elapsed < doc_seconds ? elapsed : doc_seconds;
+        doc_allocations = allocations;
+        doc_bytes = doc.arena_size;
+        doc_nodes = doc.num_nodes - 1;
+        sdlang_document_free(&doc);
+
+        memset(&tree, 0, sizeof(tree));
+        tree.block = &tree.root;
+
+        start = now();
+        err |= sdlang_parser_parse_buffer(&parser, input->text, input->len, &tree);
+        elapsed = now() - start;
+
+        tree_seconds = elapsed < tree_seconds ? elapsed : tree_seconds;
+        err |= tree.failed ? SDLANG_PARSE_ERROR_BUFFER_TOO_SMALL : SDLANG_PARSE_OK;
+        free(tree.attr);
+        tree_free(&tree.root);
+    }
+
+    sdlang_parser_release(&parser);
+
+    if (err == SDLANG_PARSE_OK)
+    {
+        fprintf(stdout, "%zu nodes, %zu in the tree\n", doc_nodes, tree.nodes);
+        fprintf(stdout, "%-8s %9s %10s %11s %9s\n", "model", "MB", "bytes/node", "allocations", "ms");
+        print_memory("document", doc_bytes, doc_nodes, doc_allocations, doc_seconds);
+        print_memory("tree", tree.bytes, tree.nodes, tree.allocations, tree_seconds);
+    }
+
+    return err;
+}
+
+static int bench_parse(const struct input_t* input, size_t num_tokens, int rounds, int fd)
+{
+    struct sdlang_functions_t functions = {
+        .block_begin = block_begin,
+        .block_end = block_end,
+        .value_i32 = value_i32,
+        .value_i64 = value_i64,
+        .value_i128 = value_i128,
+        .value_f32 = value_f32,
+        .value_f64 = value_f64,
+        .value_string = value_string,
+        .value_binary = value_binary,
+        .value_u32 = value_u32,
+        .value_u64 = value_u64,
+        .value_bool = value_bool,
+        .value_null = value_null
+    };
+    struct sdlang_parser_t tokens, table, null;
+    struct result_t token_result, table_result, null_result;
+    size_t counted = 0;
+    double sum = 0;
+    int err = SDLANG_PARSE_OK;
+
+    sdlang_parser_init(&tokens);
+    sdlang_parser_set_emit_token(&tokens, count_token);
+    sdlang_parser_set_report_error(&tokens, report_error);
+    sdlang_parser_init(&table);
+    sdlang_parser_set_emit_functions(&table, &functions);
+    sdlang_parser_set_report_error(&table, report_error);
+    sdlang_parser_init(&null);
+    sdlang_parser_set_report_error(&null, report_error);
+
+    err |= run(&tokens, input, &counted, rounds, fd, &token_result);
+    err |= run(&table, input, &sum, rounds, fd, &table_result);
+    err |= run(&null, input, NULL, rounds, fd, &null_result);
+
+    if (err == SDLANG_PARSE_OK)
+    {
+        fprintf(stdout, "%-8s %9s %11s %12s\n", "mode", "MB/s", "Mtokens/s", "cycles/byte");
+        print_result("tokens", &token_result, input->len, num_tokens);
+        print_result("table", &table_result, input->len, num_tokens);
+        print_result("null", &null_result, input->len, num_tokens);
+    }
+
+    sdlang_parser_release(&null);
+    sdlang_parser_release(&table);
+    sdlang_parser_release(&tokens);
+
+    return err;
+}
+
+static int bench_io(const struct input_t* input, size_t num_tokens, int rounds, int fd)
+{
+    /* the same parse from each source, so the difference is the cost of getting the bytes in */
+    struct input_t file = *input, stream = *input;
+    struct sdlang_parser_t null;
+    struct result_t buffer_result, file_result, stream_result;
+    int err = SDLANG_PARSE_OK;
+
+    file.source = SOURCE_FILE;
+    stream.source = SOURCE_STREAM;
+
+    sdlang_parser_init(&null);
+    sdlang_parser_set_report_error(&null, report_error);
+
+    err |= run(&null, input, NULL, rounds, fd, &buffer_result);
+    err |= run(&null, &file, NULL, rounds, fd, &file_result);
+    err |= run(&null, &stream, NULL, rounds, fd, &stream_result);
+
+    if (err == SDLANG_PARSE_OK)
+    {
+        fprintf(stdout, "%-8s %9s %11s %12s\n", "source", "MB/s", "Mtokens/s", "cycles/byte");
+        print_result("buffer", &buffer_result, input->len, num_tokens);
+        print_result("mmap", &file_result, input->len, num_tokens);
+        print_result("stream", &stream_result, input->len, num_tokens);
+    }
+
+    sdlang_parser_release(&null);
+
+    return err;
+}
+
+static void collect_extent(struct sdlang_parser_t* parser, const struct sdlang_token_t* token, void* user)
+{
+    struct extents_t* extents = user;
+
+    if (token->string.from == NULL)
+    {
+        return;
+    }
+
+    if (extents->count + 2 > extents->capacity)
+    {
+        const size_t capacity = extents->capacity > 0 ? extents->capacity * 2 : 4096;
+        size_t* offsets = realloc(extents->offsets, capacity * sizeof(size_t));
+
+        if (offsets == NULL)
+        {
+            return;
+        }
+
+        extents->offsets = offsets;
+        extents->capacity = capacity;
+    }
+
+    extents->offsets[extents->count++] = (size_t)(token->string.from - extents->text);
+    extents->offsets[extents->count++] = (size_t)(token->string.to - extents->text);
+}
+
+static size_t split_bound(const struct input_t* input, const struct extents_t* extents)
+{
+    /*
+        what the parser may copy for the tokens split between pieces: the
+        part before the split, which is kept until the next piece, and
+        twice the part after it, which is copied in doubling steps - one
+        token of lookahead is included. Comments, line breaks and blanks
+        aren't passed to the callback, and are bounded by their line.
+    */
+    size_t bound = 0, i = 0;
+
+    for (size_t split = input->piece; split < input->len; split += input->piece)
+    {
+        size_t from = split, to = split;
+
+        for (; i < extents->count && extents->offsets[i + 1] < split; i += 2)
+        {
+        }
+
+        if (i < extents->count && extents->offsets[i] < split)
+        {
+            from = extents->offsets[i];
+            to = extents->offsets[i + 1];
+        }
+        else
+        {
+            for (; from > 0 && input->text[from - 1] != '\n'; from--)
+            {
+            }
+
+            for (; to < input->len && input->text[to] != '\n'; to++)
+            {
+            }
+        }
+
+        bound += 2 * (split - from) + 2 * (to + 1 - split) + 16;
+    }
+
+    return bound;
+}
+
+static void* heap_alloc(void* ptr, size_t size, void* user)
+{
+    if (size == 0)
+    {
+        free(ptr);
+        return NULL;
+    }
+
+    return realloc(ptr, size);
+}
+
+static int bench_feed(const struct input_t* input, size_t num_tokens, int rounds, int fd)
+{
+    static const size_t pieces[] = { 1460, 4096, 65536 };
+    struct sdlang_allocator_t allocator = { heap_alloc, NULL };
+    struct extents_t extents = { input->text, NULL, 0, 0 };
+    struct sdlang_parser_t tokens;
+    struct result_t results[3];
+    size_t copied[3], bounds[3], counted = 0;
+    int err = SDLANG_PARSE_OK;
+
+    sdlang_parser_init(&tokens);
+    sdlang_parser_set_report_error(&tokens, report_error);
+    sdlang_parser_set_allocator(&tokens, &allocator);
+
+    sdlang_parser_set_emit_token(&tokens, collect_extent);
+    err |= sdlang_parser_parse_buffer(&tokens, input->text, input->len, &extents);
+    sdlang_parser_set_emit_token(&tokens, count_token);
+
+    for (int i = 0; i < 3 && err == SDLANG_PARSE_OK; i++)
+    {
+        struct input_t feed = *input;
+
+        feed.source = SOURCE_FEED;
+        feed.piece = pieces[i];
+
+        err |= run(&tokens, &feed, &counted, rounds, fd, &results[i]);
+        copied[i] = tokens.stats.bytes_copied;
+        bounds[i] = split_bound(&feed, &extents);
+    }
+
+    if (err == SDLANG_PARSE_OK)
+    {
+        char names[3][16];
+
+        fprintf(stdout, "%-8s %9s %11s %12s\n", "piece", "MB/s", "Mtokens/s", "cycles/byte");
+
+        for (int i = 0; i < 3; i++)
+        {
+            snprintf(names[i], sizeof(names[i]), "%zu", pieces[i]);
+            print_result(names[i], &results[i], input->len, num_tokens);
+        }
+
+        fprintf(stdout, "%-8s %9s %11s\n", "piece", "copied", "bound");
+
+        for (int i = 0; i < 3; i++)
+        {
+            fprintf(stdout, "%-8s %8.3f%% %10.3f%%\n", names[i], (double)copied[i] * 100 / (double)input->len,
+                    (double)bounds[i] * 100 / (double)input->len);
+
+            if (copied[i] > bounds[i])
+            {
+                fprintf(stderr, "copied %zu bytes in pieces of %zu, more than the split tokens allow\n",
+                        copied[i], pieces[i]);
+                err = SDLANG_PARSE_ERROR;
+            }
+        }
+    }
+
+    sdlang_parser_release(&tokens);
+    free(extents.offsets);
+
+    return err;
+}
+
+static int bench_threads(const struct input_t* input, size_t num_tokens, int rounds, int fd)
+{
+    /* cycles are only counted on the calling thread, so they aren't printed */
+    static const int threads[] = { 1, 2, 4, 8, 16 };
+    struct sdlang_parser_t tokens;
+    struct result_t results[5];
+    int err = SDLANG_PARSE_OK;
+
+    sdlang_parser_init(&tokens);
+    sdlang_parser_set_emit_token(&tokens, count_token);
+    sdlang_parser_set_report_error(&tokens, report_error);
+
+    for (int i = 0; i < 5 && err == SDLANG_PARSE_OK; i++)
+    {
+        size_t counted = 0;
+
+        sdlang_parser_set_threads(&tokens, threads[i]);
+        err |= run(&tokens, input, &counted, rounds, fd, &results[i]);
+
+        if (err == SDLANG_PARSE_OK && counted != num_tokens * (size_t)rounds)
+        {
+            fprintf(stderr, "%zu tokens with %d threads, %zu with one\n",
+                    counted / (size_t)rounds, threads[i], num_tokens);
+            err = SDLANG_PARSE_ERROR;
+        }
+    }
+
+    if (err == SDLANG_PARSE_OK)
+    {
+        fprintf(stdout, "%-8s %9s %11s %12s\n", "threads", "MB/s", "Mtokens/s", "speedup");
+
+        for (int i = 0; i < 5; i++)
+        {
+            fprintf(stdout, "%-8d %9.1f %11.2f %12.2f\n", threads[i], (double)input->len / results[i].seconds * 1e-6,
+                    (double)num_tokens / results[i].seconds * 1e-6, results[0].seconds / results[i].seconds);
+        }
+    }
+
+    sdlang_parser_release(&tokens);
+
+    return err;
+}
+
+static bool write_file(const char* path, const char* text, size_t len)
+{
+    FILE* file = fopen(path, "wb");
+    bool ok = file != NULL && fwrite(text, 1, len, file) == len;
+
+    if (file != NULL)
+    {
+        ok = fclose(file) == 0 && ok;
+    }
+
+    return ok;
+}
+
+int main(int argc, char* argv[])
+{
+    enum test_t test = TEST_PARSE;
+    enum shape_t shape = SHAPE_MIXED;
+    int depth = 3, rounds = 5, arg = 1;
+    double megabytes = 16;
+    const char* output = NULL;
+    bool shaped = false;
+
+    for (; arg + 1 < argc && argv[arg][0] == '-'; arg += 2)
+    {
+        if (strcmp(argv[arg], "-t") == 0)
+        {
+            for (test = TEST_PARSE; test < NUM_TESTS && strcmp(test_names[test], argv[arg + 1]) != 0; test++)
+            {
+            }
+        }
+        else if (strcmp(argv[arg], "-s") == 0)
+        {
+            for (shape = SHAPE_MIXED; shape < NUM_SHAPES && strcmp(shape_names[shape], argv[arg + 1]) != 0; shape++)
+            {
+            }
+
+            shaped = true;
+        }
+        else if (strcmp(argv[arg], "-d") == 0)
+        {
+            depth = atoi(argv[arg + 1]);
+        }
+        else if (strcmp(argv[arg], "-m") == 0)
+        {
+            megabytes = atof(argv[arg + 1]);
+        }
+        else if (strcmp(argv[arg], "-r") == 0)
+        {
+            rounds = atoi(argv[arg + 1]);
+        }
+        else if (strcmp(argv[arg], "-o") == 0)
+        {
+            output = argv[arg + 1];
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    if (arg + 1 < argc || test == NUM_TESTS || shape == NUM_SHAPES || depth < 0 || depth > SDLANG_PARSE_STACKSIZE - 2
+        || megabytes <= 0 || rounds < 1)
+    {
+        fprintf(stderr, "usage: %s [-t test] [-s shape] [-d depth] [-m megabytes] [-r rounds] [-o output.sdl] [file]\n", argv[0]);
+        fprintf(stderr, "tests: parse, io, feed, threads, ints, floats, memory\n");
+        fprintf(stderr, "shapes: mixed, strings, numbers, base64, comments, tiny, integers, floats\n");
+        return 1;
+    }
+
+    if (!shaped && (test == TEST_INTS || test == TEST_FLOATS))
+    {
+        shape = test == TEST_INTS ? SHAPE_INTEGERS : SHAPE_FLOATS;
+    }
+
+    size_t len = 0;
+    char* text = arg < argc ? read_file(argv[arg], &len) : generate(shape, depth, (size_t)(megabytes * 1e6), &len);
+
+    if (text == NULL)
+    {
+        fprintf(stderr, arg < argc ? "failed to read %s\n" : "out of memory\n", argv[arg]);
+        return 1;
+    }
+
+    /* the io test needs the text in a file */
+    const char* path = arg < argc ? argv[arg] : output != NULL ? output : test == TEST_IO ? "bench-io.sdl" : NULL;
+    const bool temporary = arg >= argc && output == NULL && path != NULL;
+
+    if (arg >= argc && path != NULL && !write_file(path, text, len))
+    {
+        fprintf(stderr, "failed to write %s\n", path);
+        path = NULL;
+    }
+
+    struct input_t input = { SOURCE_BUFFER, text, len, path, 0 };
+    struct sdlang_parser_t tokens;
+    size_t num_tokens = 0;
+    int err = SDLANG_PARSE_OK;
+    const int fd = open_cycles();
+
+    /* counted once, to be independent of the rounds */
+    sdlang_parser_init(&tokens);
+    sdlang_parser_set_emit_token(&tokens, count_token);
+    sdlang_parser_set_report_error(&tokens, report_error);
+    err |= sdlang_parser_parse_buffer(&tokens, text, len, &num_tokens);
+    sdlang_parser_release(&tokens);
+
+    if (arg < argc)
+    {
+        fprintf(stdout, "%s, %.1f MB, %zu tokens, %s scanners\n", argv[arg], (double)len * 1e-6, num_tokens, SCANNERS);
+    }
+    else
+    {
+        fprintf(stdout, "shape %s, depth %d, %.1f MB, %zu tokens, %s scanners\n", shape_names[shape], depth,
+                (double)len * 1e-6, num_tokens, SCANNERS);
+    }
+
+    if (err == SDLANG_PARSE_OK)
+    {
+        switch (test)
+        {
+        case TEST_IO:
+            err = path != NULL ? bench_io(&input, num_tokens, rounds, fd) : SDLANG_PARSE_ERROR_IO;
+            break;
+        case TEST_FEED:
+            err = bench_feed(&input, num_tokens, rounds, fd);
+            break;
+        case TEST_THREADS:
+            err = bench_threads(&input, num_tokens, rounds, fd);
+            break;
+        case TEST_INTS:
+            {
+                struct token_set_t sets[] = {
+                    { .type = SDLANG_TOKEN_INT32, .name = "int32", .libc = "strtol" },
+                    { .type = SDLANG_TOKEN_INT64, .name = "int64", .libc = "strtoll" },
+                    { .type = SDLANG_TOKEN_UINT32, .name = "uint32", .libc = "strtoul" },
+                    { .type = SDLANG_TOKEN_UINT64, .name = "uint64", .libc = "strtoull" },
+                    { .libc = NULL }
+                };
+                err = bench_decode(&input, sets, rounds);
+            }
+            break;
+        case TEST_FLOATS:
+            {
+                struct token_set_t sets[] = {
+                    { .type = SDLANG_TOKEN_FLOAT32, .name = "float32", .libc = "strtof" },
+                    { .type = SDLANG_TOKEN_FLOAT64, .name = "float64", .libc = "strtod" },
+                    { .libc = NULL }
+                };
+                err = bench_decode(&input, sets, rounds);
+            }
+            break;
+        case TEST_MEMORY:
+            err = bench_memory(&input, rounds);
+            break;
+        default:
+            err = bench_parse(&input, num_tokens, rounds, fd);
+            break;
+        }
+    }
+
+    if (err != SDLANG_PARSE_OK)
+    {
+        fprintf(stderr, "failed to parse [%d]\n", err);
+    }
+
+#ifdef __linux__
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+#endif
+
+    if (temporary)
+    {
+        remove(path);
+    }
+
+    free(text);
+
+    return err != SDLANG_PARSE_OK;
+}
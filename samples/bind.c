@@ -0,0 +1,290 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include "sdlang.h"
+#include "scene_schema.h"
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*
+    Loads a generated scene into a struct three times, with a schema, with
+    the loader which tools/schemac.c generated from samples/scene_schema.sdl,
+    and with a hand-written function table which compares names, checks
+    that all give the same struct, and prints the time of each next to the
+    time of parsing alone.
+
+    bind [-n entities] [-r rounds]
+*/
+
+/* as in samples/scene_schema.sdl, which declares struct scene_t */
+#define MAX_ENTITIES 65536
+
+static const struct sdlang_field_t scene_fields[] = {
+    { "renderer@title", SDLANG_FIELD_STRING, offsetof(struct scene_t, title), 32 },
+    { "renderer/size", SDLANG_FIELD_I32, offsetof(struct scene_t, size), 2 },
+    { "renderer/vsync", SDLANG_FIELD_BOOL, offsetof(struct scene_t, vsync), 1 },
+    { "renderer/gamma", SDLANG_FIELD_F64, offsetof(struct scene_t, gamma), 1 },
+    { "entity@id", SDLANG_FIELD_I64, offsetof(struct scene_t, ids), MAX_ENTITIES },
+    { "entity/position", SDLANG_FIELD_F32, offsetof(struct scene_t, positions), MAX_ENTITIES * 3 },
+    { "entity/mass", SDLANG_FIELD_F32, offsetof(struct scene_t, masses), MAX_ENTITIES },
+    { "entity/flags", SDLANG_FIELD_U32, offsetof(struct scene_t, flags), MAX_ENTITIES }
+};
+
+#define NUM_FIELDS (sizeof(scene_fields) / sizeof(scene_fields[0]))
+
+/* state of the hand-written loader */
+struct loader_t
+{
+    struct scene_t* scene;
+    char block[SDLANG_NODE_MAXNAMELEN];
+    int depth;
+    uint32_t counts[NUM_FIELDS];
+};
+
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void count_token(struct sdlang_parser_t* parser, const struct sdlang_token_t* token, void* user)
+{
+    ++*(size_t*)user;
+}
+
+static bool in_block(const struct loader_t* loader, const char* name)
+{
+    return loader->depth == 1 && strcmp(loader->block, name) == 0;
+}
+
+static void block_begin(const char* node, void* user)
+{
+    struct loader_t* loader = (struct loader_t*)user;
+
+    if (loader->depth++ == 0)
+    {
+        strcpy(loader->block, node);
+    }
+}
+
+static void block_end(void* user)
+{
+    --((struct loader_t*)user)->depth;
+}
+
+static void value_i32(const char* node, const char* attr, int32_t value, void* user)
+{
+    struct loader_t* loader = (struct loader_t*)user;
+
+    if (in_block(loader, "renderer") && strcmp(node, "size") == 0 && !*attr && loader->counts[1] < 2)
+    {
+        loader->scene->size[loader->counts[1]++] = value;
+    }
+    else if (loader->depth == 0 && strcmp(node, "entity") == 0 && strcmp(attr, "id") == 0
+             && loader->counts[4] < MAX_ENTITIES)
+    {
+        loader->scene->ids[loader->counts[4]++] = value;
+    }
+}
+
+static void value_u32(const char* node, const char* attr, uint32_t value, void* user)
+{
+    struct loader_t* loader = (struct loader_t*)user;
+
+    if (in_block(loader, "entity") && strcmp(node, "flags") == 0 && !*attr && loader->counts[7] < MAX_ENTITIES)
+    {
+        loader->scene->flags[loader->counts[7]++] = value;
+    }
+}
+
+static void value_f64(const char* node, const char* attr, double value, void* user)
+{
+    struct loader_t* loader = (struct loader_t*)user;
+
+    if (in_block(loader, "renderer") && strcmp(node, "gamma") == 0 && !*attr && loader->counts[3] < 1)
+    {
+        loader->scene->gamma = value;
+        loader->counts[3]++;
+    }
+    else if (in_block(loader, "entity") && strcmp(node, "position") == 0 && !*attr
+             && loader->counts[5] < MAX_ENTITIES * 3)
+    {
+        loader->scene->positions[loader->counts[5]++] = (float)value;
+    }
+    else if (in_block(loader, "entity") && strcmp(node, "mass") == 0 && !*attr
+             && loader->counts[6] < MAX_ENTITIES)
+    {
+        loader->scene->masses[loader->counts[6]++] = (float)value;
+    }
+}
+
+static void value_bool(const char* node, const char* attr, bool value, void* user)
+{
+    struct loader_t* loader = (struct loader_t*)user;
+
+    if (in_block(loader, "renderer") && strcmp(node, "vsync") == 0 && !*attr && loader->counts[2] < 1)
+    {
+        loader->scene->vsync = value;
+        loader->counts[2]++;
+    }
+}
+
+static void value_text(const char* node, const char* attr, const char* ptr, int len, void* user)
+{
+    struct loader_t* loader = (struct loader_t*)user;
+
+    if (loader->depth == 0 && strcmp(node, "renderer") == 0 && strcmp(attr, "title") == 0
+        && loader->counts[0] < 1 && len < 32)
+    {
+        memcpy(loader->scene->title, ptr, len);
+        loader->scene->title[len] = '\0';
+        loader->counts[0]++;
+    }
+}
+
+static char* generate(int entities, size_t* size)
+{
+    const size_t capacity = 256 + (size_t)entities * 160;
+    char* text = malloc(capacity);
+    size_t len;
+
+    if (text == NULL)
+    {
+        return NULL;
+    }
+
+    len = (size_t)snprintf(text, capacity,
+                           "renderer title=\"demo\" {\n    size 1920 1080\n    vsync true\n    gamma 2.2\n}\n");
+
+    for (int i = 0; i < entities; i++)
+    {
+        len += (size_t)snprintf(text + len, capacity - len,
+                                "entity id=%d {\n    position %.3f %.3f %.3f\n    mass %.2f\n"
+                                "    flags 0x%x\n    // not bound\n    script `update()`\n}\n",
+                                i, i * 0.5, i * -0.25, i * 2.0, 1.0 + i % 10, (unsigned)i * 2654435761u);
+    }
+
+    *size = len;
+    return text;
+}
+
+int main(int argc, char* argv[])
+{
+    int entities = 10000, rounds = 5;
+
+    for (int arg = 1; arg + 1 < argc; arg += 2)
+    {
+        if (strcmp(argv[arg], "-n") == 0)
+        {
+            entities = atoi(argv[arg + 1]);
+        }
+        else if (strcmp(argv[arg], "-r") == 0)
+        {
+            rounds = atoi(argv[arg + 1]);
+        }
+    }
+
+    if (entities < 0 || entities > MAX_ENTITIES || rounds < 1)
+    {
+        fprintf(stderr, "usage: %s [-n entities] [-r rounds]\n", argv[0]);
+        return 1;
+    }
+
+    struct scene_t* bound = calloc(1, sizeof(struct scene_t));
+    struct scene_t* loaded = calloc(1, sizeof(struct scene_t));
+    struct scene_t* generated = calloc(1, sizeof(struct scene_t));
+    struct sdlang_schema_t* schema = malloc(sizeof(struct sdlang_schema_t));
+    size_t size;
+    char* text = generate(entities, &size);
+
+    if (bound == NULL || loaded == NULL || generated == NULL || schema == NULL || text == NULL)
+    {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    if (sdlang_schema_init(schema, scene_fields, NUM_FIELDS) != SDLANG_PARSE_OK)
+    {
+        fprintf(stderr, "invalid schema\n");
+        return 1;
+    }
+
+    struct sdlang_functions_t functions = {
+        .block_begin = block_begin,
+        .block_end = block_end,
+        .value_i32 = value_i32,
+        .value_u32 = value_u32,
+        .value_f64 = value_f64,
+        .value_bool = value_bool,
+        .value_text = value_text
+    };
+    struct sdlang_parser_t parser, tokens, loader_parser;
+    struct loader_t loader;
+    uint32_t counts[NUM_FIELDS], generated_counts[SCENE_NUM_FIELDS];
+    double schema_time = 1e30, generated_time = 1e30, table_time = 1e30, token_time = 1e30;
+    size_t num_tokens = 0;
+    int err = SDLANG_PARSE_OK;
+
+    sdlang_parser_init(&parser);
+    sdlang_parser_set_emit_functions(&parser, &functions);
+    sdlang_parser_init(&tokens);
+    sdlang_parser_set_emit_token(&tokens, count_token);
+    sdlang_parser_init(&loader_parser);
+
+    for (int round = 0; round < rounds; round++)
+    {
+        double start = now();
+        err |= sdlang_schema_parse_buffer(schema, bound, counts, text, size);
+        double elapsed = now() - start;
+        schema_time = elapsed < schema_time ? elapsed : schema_time;
+
+        start = now();
+        err |= scene_parse_buffer(&loader_parser, generated, generated_counts, text, size);
+        elapsed = now() - start;
+        generated_time = elapsed < generated_time ? elapsed : generated_time;
+
+        memset(&loader, 0, sizeof(loader));
+        loader.scene = loaded;
+
+        start = now();
+        err |= sdlang_parser_parse_buffer(&parser, text, size, &loader);
+        elapsed = now() - start;
+        table_time = elapsed < table_time ? elapsed : table_time;
+
+        num_tokens = 0;
+        start = now();
+        err |= sdlang_parser_parse_buffer(&tokens, text, size, &num_tokens);
+        elapsed = now() - start;
+        token_time = elapsed < token_time ? elapsed : token_time;
+    }
+
+    const bool same = err == SDLANG_PARSE_OK && memcmp(counts, loader.counts, sizeof(counts)) == 0
+        && memcmp(counts, generated_counts, sizeof(counts)) == 0
+        && memcmp(bound, loaded, sizeof(struct scene_t)) == 0
+        && memcmp(bound, generated, sizeof(struct scene_t)) == 0;
+
+    fprintf(stdout, "%d entities, %zu bytes, %zu tokens, title \"%s\", size %dx%d\n",
+            entities, size, num_tokens, bound->title, bound->size[0], bound->size[1]);
+    fprintf(stdout, "tokens only:    %.2f ms\n", token_time * 1e3);
+    fprintf(stdout, "function table: %.2f ms, %.2f ms over tokens\n", table_time * 1e3, (table_time - token_time) * 1e3);
+    fprintf(stdout, "schema:         %.2f ms, %.2f ms over tokens (%.1fx)\n", schema_time * 1e3,
+            (schema_time - token_time) * 1e3, (table_time - token_time) / (schema_time - token_time));
+    fprintf(stdout, "generated:      %.2f ms, %.2f ms over tokens (%.1fx)\n", generated_time * 1e3,
+            (generated_time - token_time) * 1e3, (table_time - token_time) / (generated_time - token_time));
+    fprintf(stdout, "same struct: %s\n", same ? "yes" : "no");
+
+    sdlang_parser_release(&loader_parser);
+    sdlang_parser_release(&tokens);
+    sdlang_parser_release(&parser);
+    free(text);
+    free(schema);
+    free(generated);
+    free(loaded);
+    free(bound);
+
+    return same ? 0 : 1;
+}
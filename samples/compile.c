@@ -0,0 +1,124 @@
+#include "sdlang.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/*
+    Compiles a text document to a binary image, loads the image back, and
+    checks that both documents hold the same nodes, values and attributes.
+
+    compile input.sdl output.sdlb
+*/
+
+static bool same_value(const struct sdlang_document_t* a, const struct sdlang_value_t* va,
+                       const struct sdlang_document_t* b, const struct sdlang_value_t* vb)
+{
+    if (va->type != vb->type || va->length != vb->length)
+    {
+        return false;
+    }
+
+    switch (va->type)
+    {
+    case SDLANG_VALUE_BOOL:
+        return va->data.b == vb->data.b;
+    case SDLANG_VALUE_I32:
+    case SDLANG_VALUE_U32:
+    case SDLANG_VALUE_F32:
+        return va->data.u32 == vb->data.u32;
+    case SDLANG_VALUE_I64:
+    case SDLANG_VALUE_U64:
+    case SDLANG_VALUE_F64:
+        return va->data.u64 == vb->data.u64;
+    case SDLANG_VALUE_STRING:
+    case SDLANG_VALUE_BINARY:
+    case SDLANG_VALUE_I128:
+        return memcmp(sdlang_document_data(a, va), sdlang_document_data(b, vb), va->length) == 0;
+    default:
+        return true;
+    }
+}
+
+static bool same_node(const struct sdlang_document_t* a, uint32_t na,
+                      const struct sdlang_document_t* b, uint32_t nb)
+{
+    const struct sdlang_node_t* x = &a->nodes[na];
+    const struct sdlang_node_t* y = &b->nodes[nb];
+
+    if (strcmp(sdlang_document_name(a, na), sdlang_document_name(b, nb)) != 0
+        || x->num_children != y->num_children || x->num_values != y->num_values
+        || x->num_attributes != y->num_attributes || x->line != y->line)
+    {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < x->num_values; i++)
+    {
+        if (!same_value(a, sdlang_document_value(a, na, i), b, sdlang_document_value(b, nb, i)))
+        {
+            return false;
+        }
+    }
+
+    for (uint32_t i = 0; i < x->num_attributes; i++)
+    {
+        const struct sdlang_attribute_t* attr = &a->attributes[x->attributes + i];
+        const struct sdlang_attribute_t* other = &b->attributes[y->attributes + i];
+
+        if (strcmp(a->strings + attr->name, b->strings + other->name) != 0
+            || !same_value(a, &attr->value, b, &other->value))
+        {
+            return false;
+        }
+    }
+
+    /* the children of loaded images are contiguous */
+    uint32_t ca = sdlang_document_child(a, na, NULL);
+
+    for (uint32_t i = 0; i < y->num_children; i++, ca = sdlang_document_next(a, ca, NULL))
+    {
+        if (ca == 0 || !same_node(a, ca, b, y->first_child + i))
+        {
+            return false;
+        }
+    }
+
+    return ca == 0;
+}
+
+int main(int argc, char* argv[])
+{
+    struct sdlang_document_t text, image;
+    int err;
+
+    if (argc != 3)
+    {
+        fprintf(stderr, "usage: %s input.sdl output.sdlb\n", argv[0]);
+        return 1;
+    }
+
+    if ((err = sdlang_document_parse_file(&text, argv[1], NULL)) != SDLANG_PARSE_OK)
+    {
+        fprintf(stderr, "failed to parse %s [%d]\n", argv[1], err);
+        return 1;
+    }
+
+    if ((err = sdlang_document_save(&text, argv[2])) != SDLANG_PARSE_OK
+        || (err = sdlang_document_load_file(&image, argv[2])) != SDLANG_PARSE_OK)
+    {
+        fprintf(stderr, "failed to write or load %s [%d]\n", argv[2], err);
+        sdlang_document_free(&text);
+        return 1;
+    }
+
+    const bool same = text.num_nodes == image.num_nodes && same_node(&text, 0, &image, 0);
+
+    fprintf(stdout, "%u nodes, %u values, %u attributes, %u bytes of strings (%u in text)\n",
+            image.num_nodes, image.num_values, image.num_attributes, image.strings_size, text.strings_size);
+    fprintf(stdout, "round trip: %s\n", same ? "ok" : "mismatch");
+
+    sdlang_document_free(&image);
+    sdlang_document_free(&text);
+
+    return same ? 0 : 1;
+}
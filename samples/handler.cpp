@@ -0,0 +1,208 @@
+#include "sdlang.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+/*
+    Parses a document with a sdlang.hpp handler, and with a C function
+    table which has a handler for the same value types, and prints the
+    best of all rounds in MB/s for both. Both sides sum up what they get,
+    so that nothing can be optimized away, and have to agree.
+
+    Without a file, parses a generated document of nodes with numbers,
+    strings, base64 and attributes in blocks - bench -o writes
+    documents of other shapes.
+
+    handler [-r rounds] [file]
+*/
+
+namespace
+{
+
+struct handler
+{
+    double sum = 0;
+
+    void on_block_begin() { sum += 1; }
+    void on_block_end() { sum += 1; }
+    void on_i32(int32_t value) { sum += value; }
+    void on_i64(int64_t value) { sum += static_cast<double>(value); }
+    void on_i128(int64_t, uint64_t lo) { sum += static_cast<double>(lo); }
+    void on_u32(uint32_t value) { sum += value; }
+    void on_u64(uint64_t value) { sum += static_cast<double>(value); }
+    void on_f32(float value) { sum += value; }
+    void on_f64(double value) { sum += value; }
+    void on_bool(bool value) { sum += value; }
+    void on_null() { sum += 1; }
+    void on_text(std::string_view text) { sum += static_cast<double>(text.size()); }
+    void on_binary(const unsigned char*, size_t len) { sum += static_cast<double>(len); }
+};
+
+std::string generate(size_t size)
+{
+    static const char* const words[] = { "alpha", "beta", "gamma", "delta", "mesh", "light", "camera", "level" };
+    std::string text;
+    uint32_t state = 2463534242u;
+    char line[256];
+
+    while (text.size() < size)
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+
+        std::snprintf(line, sizeof(line), "%s index=%u {\n    %s %d %uL %.4f 1.5f 0x%x\n    %s \"%s\\t%s\" `%s` [aGVsbG8gd29ybGQ=] visible=true\n}\n",
+                      words[state & 7], state % 1000, words[(state >> 3) & 7], static_cast<int>(state >> 8) - (1 << 23),
+                      state, static_cast<double>(state >> 12) * 1e-3, state, words[(state >> 6) & 7],
+                      words[(state >> 9) & 7], words[(state >> 12) & 7], words[(state >> 15) & 7]);
+        text += line;
+    }
+
+    return text;
+}
+
+bool read_file(const char* path, std::string& text)
+{
+    std::FILE* file = std::fopen(path, "rb");
+    char buffer[65536];
+    size_t len;
+
+    if (file == nullptr)
+    {
+        return false;
+    }
+
+    while ((len = std::fread(buffer, 1, sizeof(buffer), file)) > 0)
+    {
+        text.append(buffer, len);
+    }
+
+    std::fclose(file);
+    return true;
+}
+
+template<class Parse>
+double best_of(int rounds, double& sum, Parse parse)
+{
+    double best = 1e30;
+
+    for (int round = 0; round < rounds; round++)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        sum = parse();
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        best = elapsed.count() < best ? elapsed.count() : best;
+    }
+
+    return best;
+}
+
+}
+
+extern "C"
+{
+
+static void block_begin(const char*, void* user) { *static_cast<double*>(user) += 1; }
+static void block_end(void* user) { *static_cast<double*>(user) += 1; }
+static void value_i32(const char*, const char*, int32_t value, void* user) { *static_cast<double*>(user) += value; }
+static void value_i64(const char*, const char*, int64_t value, void* user) { *static_cast<double*>(user) += static_cast<double>(value); }
+static void value_i128(const char*, const char*, int64_t, uint64_t lo, void* user) { *static_cast<double*>(user) += static_cast<double>(lo); }
+static void value_u32(const char*, const char*, uint32_t value, void* user) { *static_cast<double*>(user) += value; }
+static void value_u64(const char*, const char*, uint64_t value, void* user) { *static_cast<double*>(user) += static_cast<double>(value); }
+static void value_f32(const char*, const char*, float value, void* user) { *static_cast<double*>(user) += value; }
+static void value_f64(const char*, const char*, double value, void* user) { *static_cast<double*>(user) += value; }
+static void value_bool(const char*, const char*, bool value, void* user) { *static_cast<double*>(user) += value; }
+static void value_null(const char*, const char*, void* user) { *static_cast<double*>(user) += 1; }
+static void value_text(const char*, const char*, const char*, int len, void* user) { *static_cast<double*>(user) += len; }
+static void value_binary(const char*, const char*, const unsigned char*, int len, void* user) { *static_cast<double*>(user) += len; }
+
+}
+
+int main(int argc, char* argv[])
+{
+    int rounds = 5, arg = 1;
+    std::string text;
+
+    if (arg + 1 < argc && std::strcmp(argv[arg], "-r") == 0)
+    {
+        rounds = std::atoi(argv[arg + 1]);
+        arg += 2;
+    }
+
+    if (arg + 1 < argc || rounds < 1)
+    {
+        std::fprintf(stderr, "usage: %s [-r rounds] [file]\n", argv[0]);
+        return 1;
+    }
+
+    if (arg == argc)
+    {
+        text = generate(16000000);
+    }
+    else if (!read_file(argv[arg], text))
+    {
+        std::fprintf(stderr, "failed to read %s\n", argv[arg]);
+        return 1;
+    }
+
+    sdlang_functions_t functions = {};
+    functions.block_begin = block_begin;
+    functions.block_end = block_end;
+    functions.value_i32 = value_i32;
+    functions.value_i64 = value_i64;
+    functions.value_i128 = value_i128;
+    functions.value_u32 = value_u32;
+    functions.value_u64 = value_u64;
+    functions.value_f32 = value_f32;
+    functions.value_f64 = value_f64;
+    functions.value_bool = value_bool;
+    functions.value_null = value_null;
+    functions.value_text = value_text;
+    functions.value_binary = value_binary;
+
+    int err = SDLANG_PARSE_OK;
+    double table_sum = 0, handler_sum = 0;
+
+    const double table_seconds = best_of(rounds, table_sum, [&]() {
+        sdlang_parser_t parser;
+        double sum = 0;
+
+        sdlang_parser_init(&parser);
+        sdlang_parser_set_emit_functions(&parser, &functions);
+        err |= sdlang_parser_parse_buffer(&parser, text.data(), text.size(), &sum);
+        sdlang_parser_release(&parser);
+
+        return sum;
+    });
+
+    const double handler_seconds = best_of(rounds, handler_sum, [&]() {
+        handler h;
+
+        err |= sdlang::parse(h, text.data(), text.size());
+
+        return h.sum;
+    });
+
+    if (err != SDLANG_PARSE_OK)
+    {
+        std::fprintf(stderr, "failed to parse [%d]\n", err);
+        return 1;
+    }
+
+    std::fprintf(stdout, "%.1f MB\n", static_cast<double>(text.size()) * 1e-6);
+    std::fprintf(stdout, "%-8s %9s\n", "mode", "MB/s");
+    std::fprintf(stdout, "%-8s %9.1f\n", "table", static_cast<double>(text.size()) / table_seconds * 1e-6);
+    std::fprintf(stdout, "%-8s %9.1f\n", "handler", static_cast<double>(text.size()) / handler_seconds * 1e-6);
+
+    if (table_sum != handler_sum)
+    {
+        std::fprintf(stderr, "results differ: %f, %f\n", table_sum, handler_sum);
+        return 1;
+    }
+
+    return 0;
+}
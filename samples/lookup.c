@@ -0,0 +1,134 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include "sdlang.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*
+    Looks up the first value of a top-level node with a control function,
+    which skips all blocks and stops at the value, then compares the time of
+    the lookup with a full parse.
+
+    lookup [-r rounds] file name
+*/
+
+struct lookup_t
+{
+    const char* name;
+    size_t len;
+    bool in_name;
+    struct sdlang_token_t value;
+    char text[64];
+    size_t tokens;
+};
+
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void count_token(const struct sdlang_token_t* token, void* user)
+{
+    ++((struct lookup_t*)user)->tokens;
+}
+
+static enum sdlang_control_t find_value(const struct sdlang_token_t* token, void* user)
+{
+    struct lookup_t* lookup = (struct lookup_t*)user;
+    const size_t len = (size_t)(token->string.to - token->string.from);
+
+    switch (token->type)
+    {
+    case SDLANG_TOKEN_NODE:
+        lookup->in_name = len == lookup->len && memcmp(token->string.from, lookup->name, len) == 0;
+        return SDLANG_CONTINUE;
+
+    case SDLANG_TOKEN_NODE_END:
+    case SDLANG_TOKEN_ATTRIBUTE:
+        lookup->in_name = false;
+        return SDLANG_CONTINUE;
+
+    case SDLANG_TOKEN_BLOCK:
+        /* only top-level nodes are looked at */
+        return SDLANG_SKIP;
+
+    case SDLANG_TOKEN_BLOCK_END:
+        return SDLANG_CONTINUE;
+
+    default:
+        if (!lookup->in_name)
+        {
+            return SDLANG_CONTINUE;
+        }
+
+        /* the token string doesn't outlive the call */
+        lookup->value = *token;
+        snprintf(lookup->text, sizeof(lookup->text), "%.*s", (int)(len < 63 ? len : 63), token->string.from);
+        return SDLANG_STOP;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    struct lookup_t lookup = { 0 };
+    int rounds = 5, arg = 1;
+    double full = 1e30, found = 1e30;
+    int err;
+
+    if (arg + 1 < argc && strcmp(argv[arg], "-r") == 0)
+    {
+        rounds = atoi(argv[arg + 1]);
+        arg += 2;
+    }
+
+    if (argc - arg != 2 || rounds < 1)
+    {
+        fprintf(stderr, "usage: %s [-r rounds] file name\n", argv[0]);
+        return 1;
+    }
+
+    lookup.name = argv[arg + 1];
+    lookup.len = strlen(lookup.name);
+
+    /* the control function passes the tokens it lets through on */
+    sdlang_set_emit_token(count_token);
+    sdlang_set_emit_control(find_value);
+
+    if ((err = sdlang_parse_file(argv[arg], &lookup)) != SDLANG_PARSE_STOPPED)
+    {
+        fprintf(stderr, "%s not found in %s [%d]\n", lookup.name, argv[arg], err);
+        return 1;
+    }
+
+    fprintf(stdout, "%s: %s at line %d\n", lookup.name, lookup.text, lookup.value.line);
+
+    for (int round = 0; round < rounds; round++)
+    {
+        double start = now();
+        sdlang_set_emit_control(NULL);
+        err = sdlang_parse_file(argv[arg], &lookup);
+        double elapsed = now() - start;
+        full = elapsed < full ? elapsed : full;
+
+        start = now();
+        sdlang_set_emit_control(find_value);
+        err |= sdlang_parse_file(argv[arg], &lookup) != SDLANG_PARSE_STOPPED;
+        elapsed = now() - start;
+        found = elapsed < found ? elapsed : found;
+
+        if (err != SDLANG_PARSE_OK)
+        {
+            return 1;
+        }
+    }
+
+    fprintf(stdout, "full parse: %.3f ms\n", full * 1e3);
+    fprintf(stdout, "lookup:     %.3f ms (%.0fx)\n", found * 1e3, full / found);
+
+    return 0;
+}
@@ -150,14 +150,14 @@ static void emit_value_f64(const char* node, const char* attr, double value, voi
     fprintf(stdout, "node '%s', attr '%s', f64=%f\n", node, attr, value);
 }
 
-static void emit_value_string(const char* node, const char* attr, const char* value, int len, void* user)
+static void emit_value_text(const char* node, const char* attr, const char* value, int len, void* user)
 {
-    fprintf(stdout, "node '%s', attr '%s', string '%.*s'\n", node, attr, len, value);
+    fprintf(stdout, "node '%s', attr '%s', text '%.*s'\n", node, attr, len, value);
 }
 
-static void emit_value_base64(const char* node, const char* attr, const char* value, int len, void* user)
+static void emit_value_binary(const char* node, const char* attr, const unsigned char* value, int len, void* user)
 {
-    fprintf(stdout, "node '%s', attr '%s', base64 [%.*s]\n", node, attr, len, value);
+    fprintf(stdout, "node '%s', attr '%s', binary (%d bytes)\n", node, attr, len);
 }
 
 static void emit_value_u32(const char* node, const char* attr, uint32_t value, void* user)
@@ -193,6 +193,18 @@ static void report_error(enum sdlang_error_t error, int line)
     case SDLANG_PARSE_ERROR_BUFFER_TOO_SMALL:
         fprintf(stderr, "out of buffer memory at line %d\n", line);
         break;
+    case SDLANG_PARSE_ERROR_IO:
+        fprintf(stderr, "failed to read input\n");
+        break;
+    case SDLANG_PARSE_ERROR_BASE64:
+        fprintf(stderr, "invalid base64 value at line %d\n", line);
+        break;
+    case SDLANG_PARSE_ERROR_IMAGE:
+        fprintf(stderr, "invalid binary image\n");
+        break;
+    case SDLANG_PARSE_ERROR_VALUE:
+        fprintf(stderr, "value can't be written\n");
+        break;
     default:
         fprintf(stderr, "unknown error [%d] at line %d\n", error, line);
         break;
@@ -203,15 +215,20 @@ int main(int argc, char* argv[])
 {
     FILE* file = stdout;
     int mode = 0;
+    bool map = false;
 
     if (argc > 1)
     {
-        if (argc > 2)
+        for (int arg = 1; arg < argc - 1; arg++)
         {
-            if (strcmp(argv[1], "-t") == 0)
+            if (strcmp(argv[arg], "-t") == 0)
             {
                 mode = 1;
             }
+            else if (strcmp(argv[arg], "-m") == 0)
+            {
+                map = true;
+            }
         }
 
         file = fopen(argv[argc - 1], "rb");
@@ -223,23 +240,26 @@ int main(int argc, char* argv[])
         }
     }
 
+    /* the parser keeps names in the table, so it has to outlive the parse */
+    struct sdlang_functions_t functions = {
+        .block_begin = begin_block,
+        .block_end = end_block,
+        .value_i32 = emit_value_i32,
+        .value_i64 = emit_value_i64,
+        .value_i128 = emit_value_i128,
+        .value_f32 = emit_value_f32,
+        .value_f64 = emit_value_f64,
+        .value_text = emit_value_text,
+        .value_binary = emit_value_binary,
+        .value_u32 = emit_value_u32,
+        .value_u64 = emit_value_u64,
+        .value_bool = emit_value_bool,
+        .value_null = emit_value_null
+    };
+
     if (mode == 0)
     {
-        sdlang_set_emit_functions(&(struct sdlang_functions_t) {
-            .block_begin = begin_block,
-            .block_end = end_block,
-            .value_i32 = emit_value_i32,
-            .value_i64 = emit_value_i64,
-            .value_i128 = emit_value_i128,
-            .value_f32 = emit_value_f32,
-            .value_f64 = emit_value_f64,
-            .value_string = emit_value_string,
-            .value_base64 = emit_value_base64,
-            .value_u32 = emit_value_u32,
-            .value_u64 = emit_value_u64,
-            .value_bool = emit_value_bool,
-            .value_null = emit_value_null
-        });
+        sdlang_set_emit_functions(&functions);
     }
     else
     {
@@ -248,7 +268,8 @@ int main(int argc, char* argv[])
 
     sdlang_set_report_error(report_error);
 
-    const int result = sdlang_parse(read, file);
+    const int result = map ? sdlang_parse_file(argv[argc - 1], NULL)
+                           : sdlang_parse(read, file);
 
     if (file != NULL)
     {
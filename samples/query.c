@@ -0,0 +1,121 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include "sdlang.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*
+    Prints the values selected by a query, then compares the time of the
+    query with a full parse which converts every value.
+
+    query [-r rounds] file path...
+*/
+
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static double convert(const struct sdlang_token_t* token)
+{
+    switch (token->type)
+    {
+    case SDLANG_TOKEN_INT32:
+        return sdlang_token_i32(token);
+    case SDLANG_TOKEN_INT64:
+        return (double)sdlang_token_i64(token);
+    case SDLANG_TOKEN_UINT32:
+    case SDLANG_TOKEN_UINT64:
+        return (double)sdlang_token_u64(token);
+    case SDLANG_TOKEN_FLOAT32:
+        return sdlang_token_f32(token);
+    case SDLANG_TOKEN_FLOAT64:
+        return sdlang_token_f64(token);
+    default:
+        return (double)(token->string.to - token->string.from);
+    }
+}
+
+static void full_token(const struct sdlang_token_t* token, void* user)
+{
+    *(double*)user += convert(token);
+}
+
+static void print_match(int path, const struct sdlang_token_t* token, void* user)
+{
+    if (++*(size_t*)user <= 20)
+    {
+        fprintf(stdout, "[%d] line %d: %.*s\n", path, token->line,
+                (int)(token->string.to - token->string.from), token->string.from);
+    }
+}
+
+static void count_match(int path, const struct sdlang_token_t* token, void* user)
+{
+    *(double*)user += convert(token);
+}
+
+int main(int argc, char* argv[])
+{
+    struct sdlang_query_t query;
+    int rounds = 5, arg = 1;
+    size_t matches = 0;
+    double sum = 0, full = 1e30, queried = 1e30;
+    int err;
+
+    if (arg + 1 < argc && strcmp(argv[arg], "-r") == 0)
+    {
+        rounds = atoi(argv[arg + 1]);
+        arg += 2;
+    }
+
+    if (argc - arg < 2 || rounds < 1)
+    {
+        fprintf(stderr, "usage: %s [-r rounds] file path...\n", argv[0]);
+        return 1;
+    }
+
+    sdlang_query_init(&query, print_match);
+
+    for (int i = arg + 1; i < argc; i++)
+    {
+        if (sdlang_query_add(&query, argv[i]) < 0)
+        {
+            fprintf(stderr, "invalid path %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    if ((err = sdlang_query_parse_file(&query, argv[arg], &matches)) != SDLANG_PARSE_OK)
+    {
+        return 1;
+    }
+
+    fprintf(stdout, "%zu values\n", matches);
+
+    sdlang_set_emit_token(full_token);
+    query.match = count_match;
+
+    for (int round = 0; round < rounds; round++)
+    {
+        double start = now();
+        err |= sdlang_parse_file(argv[arg], &sum);
+        double elapsed = now() - start;
+        full = elapsed < full ? elapsed : full;
+
+        start = now();
+        err |= sdlang_query_parse_file(&query, argv[arg], &sum);
+        elapsed = now() - start;
+        queried = elapsed < queried ? elapsed : queried;
+    }
+
+    fprintf(stdout, "full parse: %.1f ms\n", full * 1e3);
+    fprintf(stdout, "query:      %.1f ms (%.1fx)\n", queried * 1e3, full / queried);
+
+    return err != SDLANG_PARSE_OK;
+}
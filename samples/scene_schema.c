@@ -0,0 +1,437 @@
+/* generated by schemac from samples/scene_schema.sdl, don't edit */
+
+#include "scene_schema.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+struct scene_state_t
+{
+    struct scene_t* target;
+    uint32_t counts[8];
+    int err;
+
+    /* key of each open block, 0 for the top level */
+    uint32_t blocks[SDLANG_PARSE_STACKSIZE + 1];
+    int depth;
+
+    /* the current node and its key, and the field + 1 selected by an attribute name */
+    bool node, attribute;
+    uint32_t key, selected;
+
+    size_t (*stream)(void* ptr, size_t size, void* user);
+    void* stream_user;
+};
+
+/* field + 1 of the values of each node key */
+static const uint32_t scene_values[9] = { 0, 0, 2, 3, 4, 0, 6, 7, 8 };
+
+/* whether a path looks into the block of each node key */
+static const bool scene_children[9] = { false, true, false, false, false, true, false, false, false };
+
+static uint32_t scene_node(uint32_t block, const char* s, size_t len)
+{
+    /* returns the key of a node in the block of key `block`, or 0 */
+    switch (block)
+    {
+    case 0:
+        switch (len)
+        {
+        case 6:
+            return memcmp(s, "entity", 6) == 0 ? 5 : 0;
+        case 8:
+            return memcmp(s, "renderer", 8) == 0 ? 1 : 0;
+        }
+        break;
+    case 1:
+        switch (len)
+        {
+        case 4:
+            return memcmp(s, "size", 4) == 0 ? 2 : 0;
+        case 5:
+            switch (s[0])
+            {
+            case 'g':
+                return memcmp(s, "gamma", 5) == 0 ? 4 : 0;
+            case 'v':
+                return memcmp(s, "vsync", 5) == 0 ? 3 : 0;
+            }
+            break;
+        }
+        break;
+    case 5:
+        switch (len)
+        {
+        case 4:
+            return memcmp(s, "mass", 4) == 0 ? 7 : 0;
+        case 5:
+            return memcmp(s, "flags", 5) == 0 ? 8 : 0;
+        case 8:
+            return memcmp(s, "position", 8) == 0 ? 6 : 0;
+        }
+        break;
+    }
+
+    return 0;
+}
+
+static uint32_t scene_attribute(uint32_t key, const char* s, size_t len)
+{
+    /* returns the field + 1 of an attribute of a node of key `key`, or 0 */
+    switch (key)
+    {
+    case 1:
+        switch (len)
+        {
+        case 5:
+            return memcmp(s, "title", 5) == 0 ? 1 : 0;
+        }
+        break;
+    case 5:
+        switch (len)
+        {
+        case 2:
+            return memcmp(s, "id", 2) == 0 ? 5 : 0;
+        }
+        break;
+    }
+
+    return 0;
+}
+
+static bool scene_store_i32(const struct sdlang_token_t* token, int32_t* dst, uint32_t size, uint32_t* count)
+{
+    if (*count == size || token->type != SDLANG_TOKEN_INT32)
+    {
+        return false;
+    }
+
+    dst[(*count)++] = sdlang_token_i32(token);
+    return true;
+}
+
+static bool scene_store_i64(const struct sdlang_token_t* token, int64_t* dst, uint32_t size, uint32_t* count)
+{
+    if (*count == size || (token->type != SDLANG_TOKEN_INT32 && token->type != SDLANG_TOKEN_INT64))
+    {
+        return false;
+    }
+
+    dst[(*count)++] = token->type == SDLANG_TOKEN_INT32 ? sdlang_token_i32(token) : sdlang_token_i64(token);
+    return true;
+}
+
+static bool scene_store_u32(const struct sdlang_token_t* token, uint32_t* dst, uint32_t size, uint32_t* count)
+{
+    int32_t i;
+
+    if (*count == size)
+    {
+        return false;
+    }
+
+    if (token->type == SDLANG_TOKEN_UINT32)
+    {
+        dst[(*count)++] = (uint32_t)sdlang_token_u64(token);
+        return true;
+    }
+
+    if (token->type != SDLANG_TOKEN_INT32 || (i = sdlang_token_i32(token)) < 0)
+    {
+        return false;
+    }
+
+    dst[(*count)++] = (uint32_t)i;
+    return true;
+}
+
+static bool scene_store_f32(const struct sdlang_token_t* token, float* dst, uint32_t size, uint32_t* count)
+{
+    if (*count == size)
+    {
+        return false;
+    }
+
+    switch (token->type)
+    {
+    case SDLANG_TOKEN_FLOAT32:
+    case SDLANG_TOKEN_FLOAT64:
+        dst[(*count)++] = sdlang_token_f32(token);
+        return true;
+    case SDLANG_TOKEN_INT32:
+        dst[(*count)++] = (float)sdlang_token_i32(token);
+        return true;
+    case SDLANG_TOKEN_INT64:
+        dst[(*count)++] = (float)sdlang_token_i64(token);
+        return true;
+    default:
+        return false;
+    }
+}
+
+static bool scene_store_f64(const struct sdlang_token_t* token, double* dst, uint32_t size, uint32_t* count)
+{
+    if (*count == size)
+    {
+        return false;
+    }
+
+    switch (token->type)
+    {
+    case SDLANG_TOKEN_FLOAT32:
+        dst[(*count)++] = sdlang_token_f32(token);
+        return true;
+    case SDLANG_TOKEN_FLOAT64:
+        dst[(*count)++] = sdlang_token_f64(token);
+        return true;
+    case SDLANG_TOKEN_INT32:
+        dst[(*count)++] = (double)sdlang_token_i32(token);
+        return true;
+    case SDLANG_TOKEN_INT64:
+        dst[(*count)++] = (double)sdlang_token_i64(token);
+        return true;
+    default:
+        return false;
+    }
+}
+
+static bool scene_store_bool(const struct sdlang_token_t* token, bool* dst, uint32_t size, uint32_t* count)
+{
+    if (*count == size || (token->type != SDLANG_TOKEN_TRUE && token->type != SDLANG_TOKEN_FALSE))
+    {
+        return false;
+    }
+
+    dst[(*count)++] = token->type == SDLANG_TOKEN_TRUE;
+    return true;
+}
+
+static bool scene_store_string(const struct sdlang_token_t* token, char* dst, uint32_t size, uint32_t* count)
+{
+    /* a single string, `size` is the size of the array; backquoted strings are taken literally */
+    const char *s = token->string.from, *e = token->string.to;
+    const size_t len = (size_t)(e - s);
+    char* text;
+    int n;
+
+    if (*count != 0 || token->type != SDLANG_TOKEN_STRING)
+    {
+        return false;
+    }
+
+    if (token->raw || memchr(s, '\\', len) == NULL)
+    {
+        if (len >= size)
+        {
+            return false;
+        }
+
+        memcpy(dst, s, len);
+        dst[len] = '\0';
+        *count = 1;
+        return true;
+    }
+
+    /* escapes only shorten the text, which may then fit */
+    if ((text = len < size ? dst : (char*)malloc(len)) == NULL)
+    {
+        return false;
+    }
+
+    n = sdlang_decode_string(s, (int)len, text);
+
+    if (text != dst)
+    {
+        if ((size_t)n < size)
+        {
+            memcpy(dst, text, (size_t)n);
+        }
+
+        free(text);
+    }
+
+    if ((size_t)n >= size)
+    {
+        return false;
+    }
+
+    dst[n] = '\0';
+    *count = 1;
+    return true;
+}
+
+static bool scene_store(struct scene_state_t* state, uint32_t field, const struct sdlang_token_t* token)
+{
+    struct scene_t* target = state->target;
+    uint32_t* count = &state->counts[field];
+
+    switch (field)
+    {
+    case 0:
+        return scene_store_string(token, target->title, 32, count);
+    case 1:
+        return scene_store_i32(token, target->size, 2, count);
+    case 2:
+        return scene_store_bool(token, &target->vsync, 1, count);
+    case 3:
+        return scene_store_f64(token, &target->gamma, 1, count);
+    case 4:
+        return scene_store_i64(token, target->ids, 65536, count);
+    case 5:
+        return scene_store_f32(token, target->positions, 196608, count);
+    case 6:
+        return scene_store_f32(token, target->masses, 65536, count);
+    case 7:
+        return scene_store_u32(token, target->flags, 65536, count);
+    default:
+        return false;
+    }
+}
+
+static enum sdlang_control_t scene_control(struct sdlang_parser_t* parser, const struct sdlang_token_t* token,
+    void* user)
+{
+    struct scene_state_t* state = (struct scene_state_t*)user;
+    const char *s = token->string.from, *e = token->string.to;
+    uint32_t field;
+
+    switch (token->type)
+    {
+    case SDLANG_TOKEN_NODE:
+        state->node = true;
+        state->key = scene_node(state->blocks[state->depth], s, (size_t)(e - s));
+        state->attribute = false;
+        break;
+
+    case SDLANG_TOKEN_NODE_END:
+        state->node = false;
+        state->attribute = false;
+        break;
+
+    case SDLANG_TOKEN_BLOCK:
+        if (!state->node || !scene_children[state->key] || state->depth == SDLANG_PARSE_STACKSIZE)
+        {
+            /* nothing to bind inside */
+            state->node = false;
+            state->attribute = false;
+            return SDLANG_SKIP;
+        }
+
+        state->blocks[++state->depth] = state->key;
+        state->node = false;
+        state->attribute = false;
+        break;
+
+    case SDLANG_TOKEN_BLOCK_END:
+        if (state->depth > 0)
+        {
+            --state->depth;
+        }
+
+        state->node = false;
+        state->attribute = false;
+        break;
+
+    case SDLANG_TOKEN_ATTRIBUTE:
+        if (!state->node)
+        {
+            /* attributes without a name */
+            state->node = true;
+            state->key = 0;
+        }
+
+        state->attribute = true;
+        state->selected = state->key != 0 ? scene_attribute(state->key, s, (size_t)(e - s)) : 0;
+        break;
+
+    default:
+        if (!state->node)
+        {
+            /* values without a name */
+            state->node = true;
+            state->key = 0;
+        }
+
+        field = state->attribute ? state->selected : scene_values[state->key];
+        state->attribute = false;
+
+        if (field != 0 && token->type != SDLANG_TOKEN_NULL && !scene_store(state, field - 1, token))
+        {
+            state->err = SDLANG_PARSE_ERROR_VALUE;
+            (*parser->report_error)(SDLANG_PARSE_ERROR_VALUE, token->line);
+        }
+        break;
+    }
+
+    return SDLANG_CONTINUE;
+}
+
+static void scene_emit_token(struct sdlang_parser_t* parser, const struct sdlang_token_t* token, void* user)
+{
+    /* everything is done by the control function */
+    (void)parser;
+    (void)token;
+    (void)user;
+}
+
+static void scene_begin(struct scene_state_t* state, struct sdlang_parser_t* parser, struct scene_t* target)
+{
+    state->target = target;
+    memset(state->counts, 0, sizeof(state->counts));
+    state->err = SDLANG_PARSE_OK;
+    state->blocks[0] = 0;
+    state->depth = 0;
+    state->node = state->attribute = false;
+    state->stream = NULL;
+
+    sdlang_parser_set_emit_token(parser, scene_emit_token);
+    sdlang_parser_set_emit_control(parser, scene_control);
+}
+
+static int scene_end(struct scene_state_t* state, uint32_t* counts, int err)
+{
+    if (counts != NULL)
+    {
+        memcpy(counts, state->counts, sizeof(state->counts));
+    }
+
+    return err != SDLANG_PARSE_OK ? err : state->err;
+}
+
+static size_t scene_stream(void* ptr, size_t size, void* user)
+{
+    struct scene_state_t* state = (struct scene_state_t*)user;
+    return (*state->stream)(ptr, size, state->stream_user);
+}
+
+int scene_parse(struct sdlang_parser_t* parser, struct scene_t* target, uint32_t* counts,
+    size_t (*stream)(void* ptr, size_t size, void* user), void* user)
+{
+    struct scene_state_t state;
+
+    scene_begin(&state, parser, target);
+    state.stream = stream;
+    state.stream_user = user;
+
+    return scene_end(&state, counts, sdlang_parser_parse(parser, scene_stream, &state));
+}
+
+int scene_parse_buffer(struct sdlang_parser_t* parser, struct scene_t* target, uint32_t* counts,
+    const char* buffer, size_t size)
+{
+    struct scene_state_t state;
+
+    scene_begin(&state, parser, target);
+
+    return scene_end(&state, counts, sdlang_parser_parse_buffer(parser, buffer, size, &state));
+}
+
+int scene_parse_file(struct sdlang_parser_t* parser, struct scene_t* target, uint32_t* counts,
+    const char* path)
+{
+    struct scene_state_t state;
+
+    scene_begin(&state, parser, target);
+
+    return scene_end(&state, counts, sdlang_parser_parse_file(parser, path, &state));
+}
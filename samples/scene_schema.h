@@ -0,0 +1,46 @@
+/* generated by schemac from samples/scene_schema.sdl, don't edit */
+
+#pragma once
+
+#include "sdlang.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct scene_t
+{
+    char title[32];
+    int32_t size[2];
+    bool vsync;
+    double gamma;
+    int64_t ids[65536];
+    float positions[196608];
+    float masses[65536];
+    uint32_t flags[65536];
+};
+
+/* indices of `counts` */
+enum scene_field_t
+{
+    SCENE_TITLE,
+    SCENE_SIZE,
+    SCENE_VSYNC,
+    SCENE_GAMMA,
+    SCENE_IDS,
+    SCENE_POSITIONS,
+    SCENE_MASSES,
+    SCENE_FLAGS,
+    SCENE_NUM_FIELDS
+};
+
+extern int scene_parse(struct sdlang_parser_t* parser, struct scene_t* target, uint32_t* counts,
+    size_t (*stream)(void* ptr, size_t size, void* user), void* user);
+extern int scene_parse_buffer(struct sdlang_parser_t* parser, struct scene_t* target, uint32_t* counts,
+    const char* buffer, size_t size);
+extern int scene_parse_file(struct sdlang_parser_t* parser, struct scene_t* target, uint32_t* counts,
+    const char* path);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,133 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include "sdlang.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*
+    Copies a document token by token through a writer, then times writing
+    random values with the writer and with fprintf().
+
+    write input.sdl output.sdl [count]
+*/
+
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static size_t write_file(const void* ptr, size_t size, void* user)
+{
+    return fwrite(ptr, 1, size, (FILE*)user);
+}
+
+static size_t discard(const void* ptr, size_t size, void* user)
+{
+    *(size_t*)user += size;
+    return size;
+}
+
+static void copy_token(const struct sdlang_token_t* token, void* user)
+{
+    sdlang_writer_token((struct sdlang_writer_t*)user, token);
+}
+
+static uint64_t next_random(uint64_t* state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+static double random_double(uint64_t* state)
+{
+    /* random bits, in a range of exponents which occurs in practice */
+    const uint64_t bits = (next_random(state) & 0x800fffffffffffffull) | ((uint64_t)(1023 - 30 + next_random(state) % 60) << 52);
+    double value;
+
+    memcpy(&value, &bits, sizeof(value));
+
+    return value;
+}
+
+int main(int argc, char* argv[])
+{
+    static struct sdlang_writer_t writer;
+
+    if (argc < 3)
+    {
+        fprintf(stderr, "usage: %s input.sdl output.sdl [count]\n", argv[0]);
+        return 1;
+    }
+
+    FILE* file = fopen(argv[2], "wb");
+
+    if (file == NULL)
+    {
+        fprintf(stderr, "failed to open %s\n", argv[2]);
+        return 1;
+    }
+
+    sdlang_set_emit_token(copy_token);
+    sdlang_writer_init(&writer, write_file, file);
+
+    int err = sdlang_parse_file(argv[1], &writer);
+    const int write_err = sdlang_writer_finish(&writer);
+
+    fclose(file);
+
+    if (err != SDLANG_PARSE_OK || write_err != SDLANG_PARSE_OK)
+    {
+        fprintf(stderr, "failed to copy %s to %s [%d, %d]\n", argv[1], argv[2], err, write_err);
+        return 1;
+    }
+
+    const long count = argc > 3 ? atol(argv[3]) : 1000000;
+    uint64_t state = 88172645463325252ull;
+    size_t bytes = 0;
+
+    double start = now();
+    sdlang_writer_init(&writer, discard, &bytes);
+    sdlang_writer_node(&writer, "values", 6);
+
+    for (long i = 0; i < count; i++)
+    {
+        sdlang_writer_f64(&writer, random_double(&state));
+    }
+
+    err = sdlang_writer_finish(&writer);
+    const double writer_time = now() - start;
+
+    /* same values, formatted with enough digits to read back exactly */
+    FILE* null = fopen("/dev/null", "wb");
+
+    if (null == NULL)
+    {
+        return err != SDLANG_PARSE_OK;
+    }
+
+    state = 88172645463325252ull;
+    start = now();
+    fputs("values", null);
+
+    for (long i = 0; i < count; i++)
+    {
+        fprintf(null, " %.17g", random_double(&state));
+    }
+
+    fputc('\n', null);
+    fclose(null);
+    const double fprintf_time = now() - start;
+
+    fprintf(stdout, "%ld doubles, %zu bytes\n", count, bytes);
+    fprintf(stdout, "writer:  %.1f ms, %.1f M values/s\n", writer_time * 1e3, (double)count / writer_time * 1e-6);
+    fprintf(stdout, "fprintf: %.1f ms, %.1f M values/s\n", fprintf_time * 1e3, (double)count / fprintf_time * 1e-6);
+
+    return err != SDLANG_PARSE_OK;
+}
@@ -1,274 +1,6769 @@
 #include "sdlang.h"
 
+#include <errno.h>
+#include <float.h>
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+# include <intrin.h>
+#endif
+
+#if !defined(SDLANG_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+# define SDLANG_HAVE_SSE2 1
+# include <emmintrin.h>
+# if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#  define SDLANG_HAVE_SSSE3 1
+#  define SDLANG_HAVE_AVX2 1
+#  include <immintrin.h>
+# endif
+#endif
+
+#if !defined(SDLANG_NO_MMAP) && (defined(__unix__) || defined(__APPLE__))
+# define SDLANG_HAVE_MMAP 1
+# include <sys/mman.h>
+# include <sys/stat.h>
+#endif
+
+#if !defined(SDLANG_NO_THREADS) && (defined(__unix__) || defined(__APPLE__))
+# define SDLANG_HAVE_THREADS 1
+# include <pthread.h>
+#endif
+
+#ifdef _WIN32
+# include <fcntl.h>
+# include <io.h>
+# define sdlang_open_fd(path) _open(path, _O_RDONLY | _O_BINARY)
+# define sdlang_read_fd(fd, ptr, size) _read(fd, ptr, (unsigned int)(size))
+# define sdlang_close_fd(fd) _close(fd)
+#else
+# include <fcntl.h>
+# include <unistd.h>
+# define sdlang_open_fd(path) open(path, O_RDONLY)
+# define sdlang_read_fd(fd, ptr, size) read(fd, ptr, size)
+# define sdlang_close_fd(fd) close(fd)
+#endif
+
+/*
+    Number conversion.
+
+    The FSM has already validated the lexeme of each numeric token, so the
+    decoders below only need to accumulate digits, without any locale
+    handling, and never read past the end of the token.
+*/
+
+static uint64_t sdlang_load64(const char* s)
+{
+    /* endian-neutral unaligned load, first char in the low byte */
+    const unsigned char* u = (const unsigned char*)s;
+
+    return (uint64_t)u[0] | ((uint64_t)u[1] << 8) | ((uint64_t)u[2] << 16) | ((uint64_t)u[3] << 24)
+        | ((uint64_t)u[4] << 32) | ((uint64_t)u[5] << 40) | ((uint64_t)u[6] << 48) | ((uint64_t)u[7] << 56);
+}
+
+static uint32_t sdlang_decode_8digits(const char* s)
+{
+    /* SWAR: converts 8 decimal digits at once */
+    uint64_t v = sdlang_load64(s) - 0x3030303030303030ull;
+
+    v = (v * 10) + (v >> 8);
+    v = (((v & 0x000000ff000000ffull) * (100 + (1000000ull << 32)))
+        + (((v >> 16) & 0x000000ff000000ffull) * (1 + (10000ull << 32)))) >> 32;
+
+    return (uint32_t)v;
+}
+
+static uint32_t sdlang_decode_8xdigits(const char* s)
+{
+    /* SWAR: converts 8 hexadecimal digits at once */
+    uint64_t v = sdlang_load64(s);
+
+    v = (v & 0x0f0f0f0f0f0f0f0full) + ((v >> 6) & 0x0101010101010101ull) * 9;
+    v = ((v & 0x0f000f000f000f00ull) >> 8) | ((v & 0x000f000f000f000full) << 4);
+    v = ((v & 0x000000ff000000ffull) << 8) | ((v >> 16) & 0x000000ff000000ffull);
+
+    return (uint32_t)(((v & 0xffff) << 16) | ((v >> 32) & 0xffff));
+}
+
+static bool sdlang_decode_u64(const char* s, const char* e, uint64_t* value)
+{
+    /* returns false if the value doesn't fit into 64 bits */
+    const char* last;
+    uint64_t v = 0;
+
+    while (*s == '0' && e - s > 1)
+    {
+        ++s;
+    }
+
+    if (e - s > 20)
+    {
+        return false;
+    }
+
+    /* up to 19 digits can't overflow */
+    last = e - s == 20 ? e - 1 : e;
+
+    for (; last - s >= 8; s += 8)
+    {
+        v = v * 100000000 + sdlang_decode_8digits(s);
+    }
+
+    for (; s != last; ++s)
+    {
+        v = v * 10 + (uint64_t)(*s - '0');
+    }
+
+    if (last != e)
+    {
+        const uint64_t digit = (uint64_t)(*last - '0');
+
+        if (v > (UINT64_MAX - digit) / 10)
+        {
+            return false;
+        }
+
+        v = v * 10 + digit;
+    }
+
+    *value = v;
+    return true;
+}
+
+static int64_t sdlang_decode_i64(const char* s, const char* e)
+{
+    /* clamps to INT64_MIN/INT64_MAX on overflow */
+    const bool neg = *s == '-';
+    uint64_t v;
+
+    if (!sdlang_decode_u64(s + neg, e, &v) || v > (uint64_t)INT64_MAX + neg)
+    {
+        return neg ? INT64_MIN : INT64_MAX;
+    }
+
+    return neg ? (int64_t)(0 - v) : (int64_t)v;
+}
+
+static int32_t sdlang_decode_i32(const char* s, const char* e)
+{
+    /* clamps to INT32_MIN/INT32_MAX on overflow */
+    const int64_t v = sdlang_decode_i64(s, e);
+
+    return v < INT32_MIN ? INT32_MIN : v > INT32_MAX ? INT32_MAX : (int32_t)v;
+}
+
+static uint64_t sdlang_decode_hex(const char* s, const char* e)
+{
+    /* skips the "0x" prefix, then reads up to 16 digits */
+    uint64_t v = 0;
+
+    for (s += 2; (e - s) & 7; ++s)
+    {
+        v = (v << 4) | (uint64_t)((*s & 0xf) + (*s >> 6) * 9);
+    }
+
+    for (; s != e; s += 8)
+    {
+        v = (v << 32) | sdlang_decode_8xdigits(s);
+    }
+
+    return v;
+}
+
+#ifdef SDLANG_HAVE_INT128
+__extension__ typedef unsigned __int128 sdlang_uint128_t;
+#endif
+
+static uint64_t sdlang_mul64(uint64_t a, uint64_t b, uint64_t* hi)
+{
+    /* full 64x64 -> 128 bit multiplication, returns the low half */
+#ifdef SDLANG_HAVE_INT128
+    const sdlang_uint128_t r = (sdlang_uint128_t)a * b;
+    *hi = (uint64_t)(r >> 64);
+    return (uint64_t)r;
+#elif defined(_MSC_VER) && defined(_M_X64)
+    return _umul128(a, b, hi);
+#else
+    const uint64_t a0 = (uint32_t)a, a1 = a >> 32, b0 = (uint32_t)b, b1 = b >> 32;
+    const uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+    const uint64_t mid = (p00 >> 32) + (uint32_t)p01 + (uint32_t)p10;
+    *hi = p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+    return (mid << 32) | (uint32_t)p00;
+#endif
+}
+
+static void sdlang_decode_i128(const char* s, const char* e, int64_t* hi, uint64_t* lo)
+{
+    /*
+        Accumulates 8 digits at a time into a 128 bit two's complement
+        value, split into the upper (signed) and lower 64 bits. Clamps to
+        the signed 128 bit range on overflow.
+    */
+    static const uint64_t pow10[] = {
+        1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000
+    };
+
+    const bool neg = *s == '-';
+    uint64_t h = 0, l = 0;
+    bool overflow = false;
+
+    for (s += neg; s != e && !overflow;)
+    {
+        const int n = e - s >= 8 ? 8 : (int)(e - s);
+        uint64_t digits = 0, carry, hh, hl;
+
+        if (n == 8)
+        {
+            digits = sdlang_decode_8digits(s);
+        }
+        else
+        {
+            for (int i = 0; i < n; ++i)
+            {
+                digits = digits * 10 + (uint64_t)(s[i] - '0');
+            }
+        }
+
+        s += n;
+
+        /* (h, l) = (h, l) * 10^n + digits */
+        l = sdlang_mul64(l, pow10[n], &carry);
+        hl = sdlang_mul64(h, pow10[n], &hh);
+        h = hl + carry;
+        overflow = hh != 0 || h < hl;
+
+        l += digits;
+        h += l < digits;
+        overflow |= h == 0 && l < digits;
+    }
+
+    if (overflow || h > (uint64_t)INT64_MAX + (neg && l == 0))
+    {
+        *hi = neg ? INT64_MIN : INT64_MAX;
+        *lo = neg ? 0 : UINT64_MAX;
+        return;
+    }
+
+    if (neg)
+    {
+        l = 0 - l;
+        h = 0 - h - (l != 0);
+    }
+
+    *hi = (int64_t)h;
+    *lo = l;
+}
+
+static int sdlang_clz64(uint64_t v)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_clzll(v);
+#else
+    int n = 0;
+
+    while (!(v & 0x8000000000000000ull))
+    {
+        v <<= 1;
+        ++n;
+    }
+
+    return n;
+#endif
+}
+
+/*
+    Truncated 128 bit approximations of 5^q, for q in [-342, 308], with the
+    most significant bit set. Used by the Eisel-Lemire algorithm.
+*/
+
+#define SDLANG_POW5_MIN -342
+#define SDLANG_POW5_MAX 308
+
+static const uint64_t sdlang_pow5_128[] = {
+    0xeef453d6923bd65aull, 0x113faa2906a13b3full, 0x9558b4661b6565f8ull, 0x4ac7ca59a424c507ull,
+    0xbaaee17fa23ebf76ull, 0x5d79bcf00d2df649ull, 0xe95a99df8ace6f53ull, 0xf4d82c2c107973dcull,
+    0x91d8a02bb6c10594ull, 0x79071b9b8a4be869ull, 0xb64ec836a47146f9ull, 0x9748e2826cdee284ull,
+    0xe3e27a444d8d98b7ull, 0xfd1b1b2308169b25ull, 0x8e6d8c6ab0787f72ull, 0xfe30f0f5e50e20f7ull,
+    0xb208ef855c969f4full, 0xbdbd2d335e51a935ull, 0xde8b2b66b3bc4723ull, 0xad2c788035e61382ull,
+    0x8b16fb203055ac76ull, 0x4c3bcb5021afcc31ull, 0xaddcb9e83c6b1793ull, 0xdf4abe242a1bbf3dull,
+    0xd953e8624b85dd78ull, 0xd71d6dad34a2af0dull, 0x87d4713d6f33aa6bull, 0x8672648c40e5ad68ull,
+    0xa9c98d8ccb009506ull, 0x680efdaf511f18c2ull, 0xd43bf0effdc0ba48ull, 0x0212bd1b2566def2ull,
+    0x84a57695fe98746dull, 0x014bb630f7604b57ull, 0xa5ced43b7e3e9188ull, 0x419ea3bd35385e2dull,
+    0xcf42894a5dce35eaull, 0x52064cac828675b9ull, 0x818995ce7aa0e1b2ull, 0x7343efebd1940993ull,
+    0xa1ebfb4219491a1full, 0x1014ebe6c5f90bf8ull, 0xca66fa129f9b60a6ull, 0xd41a26e077774ef6ull,
+    0xfd00b897478238d0ull, 0x8920b098955522b4ull, 0x9e20735e8cb16382ull, 0x55b46e5f5d5535b0ull,
+    0xc5a890362fddbc62ull, 0xeb2189f734aa831dull, 0xf712b443bbd52b7bull, 0xa5e9ec7501d523e4ull,
+    0x9a6bb0aa55653b2dull, 0x47b233c92125366eull, 0xc1069cd4eabe89f8ull, 0x999ec0bb696e840aull,
+    0xf148440a256e2c76ull, 0xc00670ea43ca250dull, 0x96cd2a865764dbcaull, 0x380406926a5e5728ull,
+    0xbc807527ed3e12bcull, 0xc605083704f5ecf2ull, 0xeba09271e88d976bull, 0xf7864a44c633682eull,
+    0x93445b8731587ea3ull, 0x7ab3ee6afbe0211dull, 0xb8157268fdae9e4cull, 0x5960ea05bad82964ull,
+    0xe61acf033d1a45dfull, 0x6fb92487298e33bdull, 0x8fd0c16206306babull, 0xa5d3b6d479f8e056ull,
+    0xb3c4f1ba87bc8696ull, 0x8f48a4899877186cull, 0xe0b62e2929aba83cull, 0x331acdabfe94de87ull,
+    0x8c71dcd9ba0b4925ull, 0x9ff0c08b7f1d0b14ull, 0xaf8e5410288e1b6full, 0x07ecf0ae5ee44dd9ull,
+    0xdb71e91432b1a24aull, 0xc9e82cd9f69d6150ull, 0x892731ac9faf056eull, 0xbe311c083a225cd2ull,
+    0xab70fe17c79ac6caull, 0x6dbd630a48aaf406ull, 0xd64d3d9db981787dull, 0x092cbbccdad5b108ull,
+    0x85f0468293f0eb4eull, 0x25bbf56008c58ea5ull, 0xa76c582338ed2621ull, 0xaf2af2b80af6f24eull,
+    0xd1476e2c07286faaull, 0x1af5af660db4aee1ull, 0x82cca4db847945caull, 0x50d98d9fc890ed4dull,
+    0xa37fce126597973cull, 0xe50ff107bab528a0ull, 0xcc5fc196fefd7d0cull, 0x1e53ed49a96272c8ull,
+    0xff77b1fcbebcdc4full, 0x25e8e89c13bb0f7aull, 0x9faacf3df73609b1ull, 0x77b191618c54e9acull,
+    0xc795830d75038c1dull, 0xd59df5b9ef6a2417ull, 0xf97ae3d0d2446f25ull, 0x4b0573286b44ad1dull,
+    0x9becce62836ac577ull, 0x4ee367f9430aec32ull, 0xc2e801fb244576d5ull, 0x229c41f793cda73full,
+    0xf3a20279ed56d48aull, 0x6b43527578c1110full, 0x9845418c345644d6ull, 0x830a13896b78aaa9ull,
+    0xbe5691ef416bd60cull, 0x23cc986bc656d553ull, 0xedec366b11c6cb8full, 0x2cbfbe86b7ec8aa8ull,
+    0x94b3a202eb1c3f39ull, 0x7bf7d71432f3d6a9ull, 0xb9e08a83a5e34f07ull, 0xdaf5ccd93fb0cc53ull,
+    0xe858ad248f5c22c9ull, 0xd1b3400f8f9cff68ull, 0x91376c36d99995beull, 0x23100809b9c21fa1ull,
+    0xb58547448ffffb2dull, 0xabd40a0c2832a78aull, 0xe2e69915b3fff9f9ull, 0x16c90c8f323f516cull,
+    0x8dd01fad907ffc3bull, 0xae3da7d97f6792e3ull, 0xb1442798f49ffb4aull, 0x99cd11cfdf41779cull,
+    0xdd95317f31c7fa1dull, 0x40405643d711d583ull, 0x8a7d3eef7f1cfc52ull, 0x482835ea666b2572ull,
+    0xad1c8eab5ee43b66ull, 0xda3243650005eecfull, 0xd863b256369d4a40ull, 0x90bed43e40076a82ull,
+    0x873e4f75e2224e68ull, 0x5a7744a6e804a291ull, 0xa90de3535aaae202ull, 0x711515d0a205cb36ull,
+    0xd3515c2831559a83ull, 0x0d5a5b44ca873e03ull, 0x8412d9991ed58091ull, 0xe858790afe9486c2ull,
+    0xa5178fff668ae0b6ull, 0x626e974dbe39a872ull, 0xce5d73ff402d98e3ull, 0xfb0a3d212dc8128full,
+    0x80fa687f881c7f8eull, 0x7ce66634bc9d0b99ull, 0xa139029f6a239f72ull, 0x1c1fffc1ebc44e80ull,
+    0xc987434744ac874eull, 0xa327ffb266b56220ull, 0xfbe9141915d7a922ull, 0x4bf1ff9f0062baa8ull,
+    0x9d71ac8fada6c9b5ull, 0x6f773fc3603db4a9ull, 0xc4ce17b399107c22ull, 0xcb550fb4384d21d3ull,
+    0xf6019da07f549b2bull, 0x7e2a53a146606a48ull, 0x99c102844f94e0fbull, 0x2eda7444cbfc426dull,
+    0xc0314325637a1939ull, 0xfa911155fefb5308ull, 0xf03d93eebc589f88ull, 0x793555ab7eba27caull,
+    0x96267c7535b763b5ull, 0x4bc1558b2f3458deull, 0xbbb01b9283253ca2ull, 0x9eb1aaedfb016f16ull,
+    0xea9c227723ee8bcbull, 0x465e15a979c1cadcull, 0x92a1958a7675175full, 0x0bfacd89ec191ec9ull,
+    0xb749faed14125d36ull, 0xcef980ec671f667bull, 0xe51c79a85916f484ull, 0x82b7e12780e7401aull,
+    0x8f31cc0937ae58d2ull, 0xd1b2ecb8b0908810ull, 0xb2fe3f0b8599ef07ull, 0x861fa7e6dcb4aa15ull,
+    0xdfbdcece67006ac9ull, 0x67a791e093e1d49aull, 0x8bd6a141006042bdull, 0xe0c8bb2c5c6d24e0ull,
+    0xaecc49914078536dull, 0x58fae9f773886e18ull, 0xda7f5bf590966848ull, 0xaf39a475506a899eull,
+    0x888f99797a5e012dull, 0x6d8406c952429603ull, 0xaab37fd7d8f58178ull, 0xc8e5087ba6d33b83ull,
+    0xd5605fcdcf32e1d6ull, 0xfb1e4a9a90880a64ull, 0x855c3be0a17fcd26ull, 0x5cf2eea09a55067full,
+    0xa6b34ad8c9dfc06full, 0xf42faa48c0ea481eull, 0xd0601d8efc57b08bull, 0xf13b94daf124da26ull,
+    0x823c12795db6ce57ull, 0x76c53d08d6b70858ull, 0xa2cb1717b52481edull, 0x54768c4b0c64ca6eull,
+    0xcb7ddcdda26da268ull, 0xa9942f5dcf7dfd09ull, 0xfe5d54150b090b02ull, 0xd3f93b35435d7c4cull,
+    0x9efa548d26e5a6e1ull, 0xc47bc5014a1a6dafull, 0xc6b8e9b0709f109aull, 0x359ab6419ca1091bull,
+    0xf867241c8cc6d4c0ull, 0xc30163d203c94b62ull, 0x9b407691d7fc44f8ull, 0x79e0de63425dcf1dull,
+    0xc21094364dfb5636ull, 0x985915fc12f542e4ull, 0xf294b943e17a2bc4ull, 0x3e6f5b7b17b2939dull,
+    0x979cf3ca6cec5b5aull, 0xa705992ceecf9c42ull, 0xbd8430bd08277231ull, 0x50c6ff782a838353ull,
+    0xece53cec4a314ebdull, 0xa4f8bf5635246428ull, 0x940f4613ae5ed136ull, 0x871b7795e136be99ull,
+    0xb913179899f68584ull, 0x28e2557b59846e3full, 0xe757dd7ec07426e5ull, 0x331aeada2fe589cfull,
+    0x9096ea6f3848984full, 0x3ff0d2c85def7621ull, 0xb4bca50b065abe63ull, 0x0fed077a756b53a9ull,
+    0xe1ebce4dc7f16dfbull, 0xd3e8495912c62894ull, 0x8d3360f09cf6e4bdull, 0x64712dd7abbbd95cull,
+    0xb080392cc4349decull, 0xbd8d794d96aacfb3ull, 0xdca04777f541c567ull, 0xecf0d7a0fc5583a0ull,
+    0x89e42caaf9491b60ull, 0xf41686c49db57244ull, 0xac5d37d5b79b6239ull, 0x311c2875c522ced5ull,
+    0xd77485cb25823ac7ull, 0x7d633293366b828bull, 0x86a8d39ef77164bcull, 0xae5dff9c02033197ull,
+    0xa8530886b54dbdebull, 0xd9f57f830283fdfcull, 0xd267caa862a12d66ull, 0xd072df63c324fd7bull,
+    0x8380dea93da4bc60ull, 0x4247cb9e59f71e6dull, 0xa46116538d0deb78ull, 0x52d9be85f074e608ull,
+    0xcd795be870516656ull, 0x67902e276c921f8bull, 0x806bd9714632dff6ull, 0x00ba1cd8a3db53b6ull,
+    0xa086cfcd97bf97f3ull, 0x80e8a40eccd228a4ull, 0xc8a883c0fdaf7df0ull, 0x6122cd128006b2cdull,
+    0xfad2a4b13d1b5d6cull, 0x796b805720085f81ull, 0x9cc3a6eec6311a63ull, 0xcbe3303674053bb0ull,
+    0xc3f490aa77bd60fcull, 0xbedbfc4411068a9cull, 0xf4f1b4d515acb93bull, 0xee92fb5515482d44ull,
+    0x991711052d8bf3c5ull, 0x751bdd152d4d1c4aull, 0xbf5cd54678eef0b6ull, 0xd262d45a78a0635dull,
+    0xef340a98172aace4ull, 0x86fb897116c87c34ull, 0x9580869f0e7aac0eull, 0xd45d35e6ae3d4da0ull,
+    0xbae0a846d2195712ull, 0x8974836059cca109ull, 0xe998d258869facd7ull, 0x2bd1a438703fc94bull,
+    0x91ff83775423cc06ull, 0x7b6306a34627ddcfull, 0xb67f6455292cbf08ull, 0x1a3bc84c17b1d542ull,
+    0xe41f3d6a7377eecaull, 0x20caba5f1d9e4a93ull, 0x8e938662882af53eull, 0x547eb47b7282ee9cull,
+    0xb23867fb2a35b28dull, 0xe99e619a4f23aa43ull, 0xdec681f9f4c31f31ull, 0x6405fa00e2ec94d4ull,
+    0x8b3c113c38f9f37eull, 0xde83bc408dd3dd04ull, 0xae0b158b4738705eull, 0x9624ab50b148d445ull,
+    0xd98ddaee19068c76ull, 0x3badd624dd9b0957ull, 0x87f8a8d4cfa417c9ull, 0xe54ca5d70a80e5d6ull,
+    0xa9f6d30a038d1dbcull, 0x5e9fcf4ccd211f4cull, 0xd47487cc8470652bull, 0x7647c3200069671full,
+    0x84c8d4dfd2c63f3bull, 0x29ecd9f40041e073ull, 0xa5fb0a17c777cf09ull, 0xf468107100525890ull,
+    0xcf79cc9db955c2ccull, 0x7182148d4066eeb4ull, 0x81ac1fe293d599bfull, 0xc6f14cd848405530ull,
+    0xa21727db38cb002full, 0xb8ada00e5a506a7cull, 0xca9cf1d206fdc03bull, 0xa6d90811f0e4851cull,
+    0xfd442e4688bd304aull, 0x908f4a166d1da663ull, 0x9e4a9cec15763e2eull, 0x9a598e4e043287feull,
+    0xc5dd44271ad3cdbaull, 0x40eff1e1853f29fdull, 0xf7549530e188c128ull, 0xd12bee59e68ef47cull,
+    0x9a94dd3e8cf578b9ull, 0x82bb74f8301958ceull, 0xc13a148e3032d6e7ull, 0xe36a52363c1faf01ull,
+    0xf18899b1bc3f8ca1ull, 0xdc44e6c3cb279ac1ull, 0x96f5600f15a7b7e5ull, 0x29ab103a5ef8c0b9ull,
+    0xbcb2b812db11a5deull, 0x7415d448f6b6f0e7ull, 0xebdf661791d60f56ull, 0x111b495b3464ad21ull,
+    0x936b9fcebb25c995ull, 0xcab10dd900beec34ull, 0xb84687c269ef3bfbull, 0x3d5d514f40eea742ull,
+    0xe65829b3046b0afaull, 0x0cb4a5a3112a5112ull, 0x8ff71a0fe2c2e6dcull, 0x47f0e785eaba72abull,
+    0xb3f4e093db73a093ull, 0x59ed216765690f56ull, 0xe0f218b8d25088b8ull, 0x306869c13ec3532cull,
+    0x8c974f7383725573ull, 0x1e414218c73a13fbull, 0xafbd2350644eeacfull, 0xe5d1929ef90898faull,
+    0xdbac6c247d62a583ull, 0xdf45f746b74abf39ull, 0x894bc396ce5da772ull, 0x6b8bba8c328eb783ull,
+    0xab9eb47c81f5114full, 0x066ea92f3f326564ull, 0xd686619ba27255a2ull, 0xc80a537b0efefebdull,
+    0x8613fd0145877585ull, 0xbd06742ce95f5f36ull, 0xa798fc4196e952e7ull, 0x2c48113823b73704ull,
+    0xd17f3b51fca3a7a0ull, 0xf75a15862ca504c5ull, 0x82ef85133de648c4ull, 0x9a984d73dbe722fbull,
+    0xa3ab66580d5fdaf5ull, 0xc13e60d0d2e0ebbaull, 0xcc963fee10b7d1b3ull, 0x318df905079926a8ull,
+    0xffbbcfe994e5c61full, 0xfdf17746497f7052ull, 0x9fd561f1fd0f9bd3ull, 0xfeb6ea8bedefa633ull,
+    0xc7caba6e7c5382c8ull, 0xfe64a52ee96b8fc0ull, 0xf9bd690a1b68637bull, 0x3dfdce7aa3c673b0ull,
+    0x9c1661a651213e2dull, 0x06bea10ca65c084eull, 0xc31bfa0fe5698db8ull, 0x486e494fcff30a62ull,
+    0xf3e2f893dec3f126ull, 0x5a89dba3c3efccfaull, 0x986ddb5c6b3a76b7ull, 0xf89629465a75e01cull,
+    0xbe89523386091465ull, 0xf6bbb397f1135823ull, 0xee2ba6c0678b597full, 0x746aa07ded582e2cull,
+    0x94db483840b717efull, 0xa8c2a44eb4571cdcull, 0xba121a4650e4ddebull, 0x92f34d62616ce413ull,
+    0xe896a0d7e51e1566ull, 0x77b020baf9c81d17ull, 0x915e2486ef32cd60ull, 0x0ace1474dc1d122eull,
+    0xb5b5ada8aaff80b8ull, 0x0d819992132456baull, 0xe3231912d5bf60e6ull, 0x10e1fff697ed6c69ull,
+    0x8df5efabc5979c8full, 0xca8d3ffa1ef463c1ull, 0xb1736b96b6fd83b3ull, 0xbd308ff8a6b17cb2ull,
+    0xddd0467c64bce4a0ull, 0xac7cb3f6d05ddbdeull, 0x8aa22c0dbef60ee4ull, 0x6bcdf07a423aa96bull,
+    0xad4ab7112eb3929dull, 0x86c16c98d2c953c6ull, 0xd89d64d57a607744ull, 0xe871c7bf077ba8b7ull,
+    0x87625f056c7c4a8bull, 0x11471cd764ad4972ull, 0xa93af6c6c79b5d2dull, 0xd598e40d3dd89bcfull,
+    0xd389b47879823479ull, 0x4aff1d108d4ec2c3ull, 0x843610cb4bf160cbull, 0xcedf722a585139baull,
+    0xa54394fe1eedb8feull, 0xc2974eb4ee658828ull, 0xce947a3da6a9273eull, 0x733d226229feea32ull,
+    0x811ccc668829b887ull, 0x0806357d5a3f525full, 0xa163ff802a3426a8ull, 0xca07c2dcb0cf26f7ull,
+    0xc9bcff6034c13052ull, 0xfc89b393dd02f0b5ull, 0xfc2c3f3841f17c67ull, 0xbbac2078d443ace2ull,
+    0x9d9ba7832936edc0ull, 0xd54b944b84aa4c0dull, 0xc5029163f384a931ull, 0x0a9e795e65d4df11ull,
+    0xf64335bcf065d37dull, 0x4d4617b5ff4a16d5ull, 0x99ea0196163fa42eull, 0x504bced1bf8e4e45ull,
+    0xc06481fb9bcf8d39ull, 0xe45ec2862f71e1d6ull, 0xf07da27a82c37088ull, 0x5d767327bb4e5a4cull,
+    0x964e858c91ba2655ull, 0x3a6a07f8d510f86full, 0xbbe226efb628afeaull, 0x890489f70a55368bull,
+    0xeadab0aba3b2dbe5ull, 0x2b45ac74ccea842eull, 0x92c8ae6b464fc96full, 0x3b0b8bc90012929dull,
+    0xb77ada0617e3bbcbull, 0x09ce6ebb40173744ull, 0xe55990879ddcaabdull, 0xcc420a6a101d0515ull,
+    0x8f57fa54c2a9eab6ull, 0x9fa946824a12232dull, 0xb32df8e9f3546564ull, 0x47939822dc96abf9ull,
+    0xdff9772470297ebdull, 0x59787e2b93bc56f7ull, 0x8bfbea76c619ef36ull, 0x57eb4edb3c55b65aull,
+    0xaefae51477a06b03ull, 0xede622920b6b23f1ull, 0xdab99e59958885c4ull, 0xe95fab368e45ecedull,
+    0x88b402f7fd75539bull, 0x11dbcb0218ebb414ull, 0xaae103b5fcd2a881ull, 0xd652bdc29f26a119ull,
+    0xd59944a37c0752a2ull, 0x4be76d3346f0495full, 0x857fcae62d8493a5ull, 0x6f70a4400c562ddbull,
+    0xa6dfbd9fb8e5b88eull, 0xcb4ccd500f6bb952ull, 0xd097ad07a71f26b2ull, 0x7e2000a41346a7a7ull,
+    0x825ecc24c873782full, 0x8ed400668c0c28c8ull, 0xa2f67f2dfa90563bull, 0x728900802f0f32faull,
+    0xcbb41ef979346bcaull, 0x4f2b40a03ad2ffb9ull, 0xfea126b7d78186bcull, 0xe2f610c84987bfa8ull,
+    0x9f24b832e6b0f436ull, 0x0dd9ca7d2df4d7c9ull, 0xc6ede63fa05d3143ull, 0x91503d1c79720dbbull,
+    0xf8a95fcf88747d94ull, 0x75a44c6397ce912aull, 0x9b69dbe1b548ce7cull, 0xc986afbe3ee11abaull,
+    0xc24452da229b021bull, 0xfbe85badce996168ull, 0xf2d56790ab41c2a2ull, 0xfae27299423fb9c3ull,
+    0x97c560ba6b0919a5ull, 0xdccd879fc967d41aull, 0xbdb6b8e905cb600full, 0x5400e987bbc1c920ull,
+    0xed246723473e3813ull, 0x290123e9aab23b68ull, 0x9436c0760c86e30bull, 0xf9a0b6720aaf6521ull,
+    0xb94470938fa89bceull, 0xf808e40e8d5b3e69ull, 0xe7958cb87392c2c2ull, 0xb60b1d1230b20e04ull,
+    0x90bd77f3483bb9b9ull, 0xb1c6f22b5e6f48c2ull, 0xb4ecd5f01a4aa828ull, 0x1e38aeb6360b1af3ull,
+    0xe2280b6c20dd5232ull, 0x25c6da63c38de1b0ull, 0x8d590723948a535full, 0x579c487e5a38ad0eull,
+    0xb0af48ec79ace837ull, 0x2d835a9df0c6d851ull, 0xdcdb1b2798182244ull, 0xf8e431456cf88e65ull,
+    0x8a08f0f8bf0f156bull, 0x1b8e9ecb641b58ffull, 0xac8b2d36eed2dac5ull, 0xe272467e3d222f3full,
+    0xd7adf884aa879177ull, 0x5b0ed81dcc6abb0full, 0x86ccbb52ea94baeaull, 0x98e947129fc2b4e9ull,
+    0xa87fea27a539e9a5ull, 0x3f2398d747b36224ull, 0xd29fe4b18e88640eull, 0x8eec7f0d19a03aadull,
+    0x83a3eeeef9153e89ull, 0x1953cf68300424acull, 0xa48ceaaab75a8e2bull, 0x5fa8c3423c052dd7ull,
+    0xcdb02555653131b6ull, 0x3792f412cb06794dull, 0x808e17555f3ebf11ull, 0xe2bbd88bbee40bd0ull,
+    0xa0b19d2ab70e6ed6ull, 0x5b6aceaeae9d0ec4ull, 0xc8de047564d20a8bull, 0xf245825a5a445275ull,
+    0xfb158592be068d2eull, 0xeed6e2f0f0d56712ull, 0x9ced737bb6c4183dull, 0x55464dd69685606bull,
+    0xc428d05aa4751e4cull, 0xaa97e14c3c26b886ull, 0xf53304714d9265dfull, 0xd53dd99f4b3066a8ull,
+    0x993fe2c6d07b7fabull, 0xe546a8038efe4029ull, 0xbf8fdb78849a5f96ull, 0xde98520472bdd033ull,
+    0xef73d256a5c0f77cull, 0x963e66858f6d4440ull, 0x95a8637627989aadull, 0xdde7001379a44aa8ull,
+    0xbb127c53b17ec159ull, 0x5560c018580d5d52ull, 0xe9d71b689dde71afull, 0xaab8f01e6e10b4a6ull,
+    0x9226712162ab070dull, 0xcab3961304ca70e8ull, 0xb6b00d69bb55c8d1ull, 0x3d607b97c5fd0d22ull,
+    0xe45c10c42a2b3b05ull, 0x8cb89a7db77c506aull, 0x8eb98a7a9a5b04e3ull, 0x77f3608e92adb242ull,
+    0xb267ed1940f1c61cull, 0x55f038b237591ed3ull, 0xdf01e85f912e37a3ull, 0x6b6c46dec52f6688ull,
+    0x8b61313bbabce2c6ull, 0x2323ac4b3b3da015ull, 0xae397d8aa96c1b77ull, 0xabec975e0a0d081aull,
+    0xd9c7dced53c72255ull, 0x96e7bd358c904a21ull, 0x881cea14545c7575ull, 0x7e50d64177da2e54ull,
+    0xaa242499697392d2ull, 0xdde50bd1d5d0b9e9ull, 0xd4ad2dbfc3d07787ull, 0x955e4ec64b44e864ull,
+    0x84ec3c97da624ab4ull, 0xbd5af13bef0b113eull, 0xa6274bbdd0fadd61ull, 0xecb1ad8aeacdd58eull,
+    0xcfb11ead453994baull, 0x67de18eda5814af2ull, 0x81ceb32c4b43fcf4ull, 0x80eacf948770ced7ull,
+    0xa2425ff75e14fc31ull, 0xa1258379a94d028dull, 0xcad2f7f5359a3b3eull, 0x096ee45813a04330ull,
+    0xfd87b5f28300ca0dull, 0x8bca9d6e188853fcull, 0x9e74d1b791e07e48ull, 0x775ea264cf55347eull,
+    0xc612062576589ddaull, 0x95364afe032a819eull, 0xf79687aed3eec551ull, 0x3a83ddbd83f52205ull,
+    0x9abe14cd44753b52ull, 0xc4926a9672793543ull, 0xc16d9a0095928a27ull, 0x75b7053c0f178294ull,
+    0xf1c90080baf72cb1ull, 0x5324c68b12dd6339ull, 0x971da05074da7beeull, 0xd3f6fc16ebca5e04ull,
+    0xbce5086492111aeaull, 0x88f4bb1ca6bcf585ull, 0xec1e4a7db69561a5ull, 0x2b31e9e3d06c32e6ull,
+    0x9392ee8e921d5d07ull, 0x3aff322e62439fd0ull, 0xb877aa3236a4b449ull, 0x09befeb9fad487c3ull,
+    0xe69594bec44de15bull, 0x4c2ebe687989a9b4ull, 0x901d7cf73ab0acd9ull, 0x0f9d37014bf60a11ull,
+    0xb424dc35095cd80full, 0x538484c19ef38c95ull, 0xe12e13424bb40e13ull, 0x2865a5f206b06fbaull,
+    0x8cbccc096f5088cbull, 0xf93f87b7442e45d4ull, 0xafebff0bcb24aafeull, 0xf78f69a51539d749ull,
+    0xdbe6fecebdedd5beull, 0xb573440e5a884d1cull, 0x89705f4136b4a597ull, 0x31680a88f8953031ull,
+    0xabcc77118461cefcull, 0xfdc20d2b36ba7c3eull, 0xd6bf94d5e57a42bcull, 0x3d32907604691b4dull,
+    0x8637bd05af6c69b5ull, 0xa63f9a49c2c1b110ull, 0xa7c5ac471b478423ull, 0x0fcf80dc33721d54ull,
+    0xd1b71758e219652bull, 0xd3c36113404ea4a9ull, 0x83126e978d4fdf3bull, 0x645a1cac083126eaull,
+    0xa3d70a3d70a3d70aull, 0x3d70a3d70a3d70a4ull, 0xccccccccccccccccull, 0xcccccccccccccccdull,
+    0x8000000000000000ull, 0x0000000000000000ull, 0xa000000000000000ull, 0x0000000000000000ull,
+    0xc800000000000000ull, 0x0000000000000000ull, 0xfa00000000000000ull, 0x0000000000000000ull,
+    0x9c40000000000000ull, 0x0000000000000000ull, 0xc350000000000000ull, 0x0000000000000000ull,
+    0xf424000000000000ull, 0x0000000000000000ull, 0x9896800000000000ull, 0x0000000000000000ull,
+    0xbebc200000000000ull, 0x0000000000000000ull, 0xee6b280000000000ull, 0x0000000000000000ull,
+    0x9502f90000000000ull, 0x0000000000000000ull, 0xba43b74000000000ull, 0x0000000000000000ull,
+    0xe8d4a51000000000ull, 0x0000000000000000ull, 0x9184e72a00000000ull, 0x0000000000000000ull,
+    0xb5e620f480000000ull, 0x0000000000000000ull, 0xe35fa931a0000000ull, 0x0000000000000000ull,
+    0x8e1bc9bf04000000ull, 0x0000000000000000ull, 0xb1a2bc2ec5000000ull, 0x0000000000000000ull,
+    0xde0b6b3a76400000ull, 0x0000000000000000ull, 0x8ac7230489e80000ull, 0x0000000000000000ull,
+    0xad78ebc5ac620000ull, 0x0000000000000000ull, 0xd8d726b7177a8000ull, 0x0000000000000000ull,
+    0x878678326eac9000ull, 0x0000000000000000ull, 0xa968163f0a57b400ull, 0x0000000000000000ull,
+    0xd3c21bcecceda100ull, 0x0000000000000000ull, 0x84595161401484a0ull, 0x0000000000000000ull,
+    0xa56fa5b99019a5c8ull, 0x0000000000000000ull, 0xcecb8f27f4200f3aull, 0x0000000000000000ull,
+    0x813f3978f8940984ull, 0x4000000000000000ull, 0xa18f07d736b90be5ull, 0x5000000000000000ull,
+    0xc9f2c9cd04674edeull, 0xa400000000000000ull, 0xfc6f7c4045812296ull, 0x4d00000000000000ull,
+    0x9dc5ada82b70b59dull, 0xf020000000000000ull, 0xc5371912364ce305ull, 0x6c28000000000000ull,
+    0xf684df56c3e01bc6ull, 0xc732000000000000ull, 0x9a130b963a6c115cull, 0x3c7f400000000000ull,
+    0xc097ce7bc90715b3ull, 0x4b9f100000000000ull, 0xf0bdc21abb48db20ull, 0x1e86d40000000000ull,
+    0x96769950b50d88f4ull, 0x1314448000000000ull, 0xbc143fa4e250eb31ull, 0x17d955a000000000ull,
+    0xeb194f8e1ae525fdull, 0x5dcfab0800000000ull, 0x92efd1b8d0cf37beull, 0x5aa1cae500000000ull,
+    0xb7abc627050305adull, 0xf14a3d9e40000000ull, 0xe596b7b0c643c719ull, 0x6d9ccd05d0000000ull,
+    0x8f7e32ce7bea5c6full, 0xe4820023a2000000ull, 0xb35dbf821ae4f38bull, 0xdda2802c8a800000ull,
+    0xe0352f62a19e306eull, 0xd50b2037ad200000ull, 0x8c213d9da502de45ull, 0x4526f422cc340000ull,
+    0xaf298d050e4395d6ull, 0x9670b12b7f410000ull, 0xdaf3f04651d47b4cull, 0x3c0cdd765f114000ull,
+    0x88d8762bf324cd0full, 0xa5880a69fb6ac800ull, 0xab0e93b6efee0053ull, 0x8eea0d047a457a00ull,
+    0xd5d238a4abe98068ull, 0x72a4904598d6d880ull, 0x85a36366eb71f041ull, 0x47a6da2b7f864750ull,
+    0xa70c3c40a64e6c51ull, 0x999090b65f67d924ull, 0xd0cf4b50cfe20765ull, 0xfff4b4e3f741cf6dull,
+    0x82818f1281ed449full, 0xbff8f10e7a8921a4ull, 0xa321f2d7226895c7ull, 0xaff72d52192b6a0dull,
+    0xcbea6f8ceb02bb39ull, 0x9bf4f8a69f764490ull, 0xfee50b7025c36a08ull, 0x02f236d04753d5b4ull,
+    0x9f4f2726179a2245ull, 0x01d762422c946590ull, 0xc722f0ef9d80aad6ull, 0x424d3ad2b7b97ef5ull,
+    0xf8ebad2b84e0d58bull, 0xd2e0898765a7deb2ull, 0x9b934c3b330c8577ull, 0x63cc55f49f88eb2full,
+    0xc2781f49ffcfa6d5ull, 0x3cbf6b71c76b25fbull, 0xf316271c7fc3908aull, 0x8bef464e3945ef7aull,
+    0x97edd871cfda3a56ull, 0x97758bf0e3cbb5acull, 0xbde94e8e43d0c8ecull, 0x3d52eeed1cbea317ull,
+    0xed63a231d4c4fb27ull, 0x4ca7aaa863ee4bddull, 0x945e455f24fb1cf8ull, 0x8fe8caa93e74ef6aull,
+    0xb975d6b6ee39e436ull, 0xb3e2fd538e122b44ull, 0xe7d34c64a9c85d44ull, 0x60dbbca87196b616ull,
+    0x90e40fbeea1d3a4aull, 0xbc8955e946fe31cdull, 0xb51d13aea4a488ddull, 0x6babab6398bdbe41ull,
+    0xe264589a4dcdab14ull, 0xc696963c7eed2dd1ull, 0x8d7eb76070a08aecull, 0xfc1e1de5cf543ca2ull,
+    0xb0de65388cc8ada8ull, 0x3b25a55f43294bcbull, 0xdd15fe86affad912ull, 0x49ef0eb713f39ebeull,
+    0x8a2dbf142dfcc7abull, 0x6e3569326c784337ull, 0xacb92ed9397bf996ull, 0x49c2c37f07965404ull,
+    0xd7e77a8f87daf7fbull, 0xdc33745ec97be906ull, 0x86f0ac99b4e8dafdull, 0x69a028bb3ded71a3ull,
+    0xa8acd7c0222311bcull, 0xc40832ea0d68ce0cull, 0xd2d80db02aabd62bull, 0xf50a3fa490c30190ull,
+    0x83c7088e1aab65dbull, 0x792667c6da79e0faull, 0xa4b8cab1a1563f52ull, 0x577001b891185938ull,
+    0xcde6fd5e09abcf26ull, 0xed4c0226b55e6f86ull, 0x80b05e5ac60b6178ull, 0x544f8158315b05b4ull,
+    0xa0dc75f1778e39d6ull, 0x696361ae3db1c721ull, 0xc913936dd571c84cull, 0x03bc3a19cd1e38e9ull,
+    0xfb5878494ace3a5full, 0x04ab48a04065c723ull, 0x9d174b2dcec0e47bull, 0x62eb0d64283f9c76ull,
+    0xc45d1df942711d9aull, 0x3ba5d0bd324f8394ull, 0xf5746577930d6500ull, 0xca8f44ec7ee36479ull,
+    0x9968bf6abbe85f20ull, 0x7e998b13cf4e1ecbull, 0xbfc2ef456ae276e8ull, 0x9e3fedd8c321a67eull,
+    0xefb3ab16c59b14a2ull, 0xc5cfe94ef3ea101eull, 0x95d04aee3b80ece5ull, 0xbba1f1d158724a12ull,
+    0xbb445da9ca61281full, 0x2a8a6e45ae8edc97ull, 0xea1575143cf97226ull, 0xf52d09d71a3293bdull,
+    0x924d692ca61be758ull, 0x593c2626705f9c56ull, 0xb6e0c377cfa2e12eull, 0x6f8b2fb00c77836cull,
+    0xe498f455c38b997aull, 0x0b6dfb9c0f956447ull, 0x8edf98b59a373fecull, 0x4724bd4189bd5eacull,
+    0xb2977ee300c50fe7ull, 0x58edec91ec2cb657ull, 0xdf3d5e9bc0f653e1ull, 0x2f2967b66737e3edull,
+    0x8b865b215899f46cull, 0xbd79e0d20082ee74ull, 0xae67f1e9aec07187ull, 0xecd8590680a3aa11ull,
+    0xda01ee641a708de9ull, 0xe80e6f4820cc9495ull, 0x884134fe908658b2ull, 0x3109058d147fdcddull,
+    0xaa51823e34a7eedeull, 0xbd4b46f0599fd415ull, 0xd4e5e2cdc1d1ea96ull, 0x6c9e18ac7007c91aull,
+    0x850fadc09923329eull, 0x03e2cf6bc604ddb0ull, 0xa6539930bf6bff45ull, 0x84db8346b786151cull,
+    0xcfe87f7cef46ff16ull, 0xe612641865679a63ull, 0x81f14fae158c5f6eull, 0x4fcb7e8f3f60c07eull,
+    0xa26da3999aef7749ull, 0xe3be5e330f38f09dull, 0xcb090c8001ab551cull, 0x5cadf5bfd3072cc5ull,
+    0xfdcb4fa002162a63ull, 0x73d9732fc7c8f7f6ull, 0x9e9f11c4014dda7eull, 0x2867e7fddcdd9afaull,
+    0xc646d63501a1511dull, 0xb281e1fd541501b8ull, 0xf7d88bc24209a565ull, 0x1f225a7ca91a4226ull,
+    0x9ae757596946075full, 0x3375788de9b06958ull, 0xc1a12d2fc3978937ull, 0x0052d6b1641c83aeull,
+    0xf209787bb47d6b84ull, 0xc0678c5dbd23a49aull, 0x9745eb4d50ce6332ull, 0xf840b7ba963646e0ull,
+    0xbd176620a501fbffull, 0xb650e5a93bc3d898ull, 0xec5d3fa8ce427affull, 0xa3e51f138ab4cebeull,
+    0x93ba47c980e98cdfull, 0xc66f336c36b10137ull, 0xb8a8d9bbe123f017ull, 0xb80b0047445d4184ull,
+    0xe6d3102ad96cec1dull, 0xa60dc059157491e5ull, 0x9043ea1ac7e41392ull, 0x87c89837ad68db2full,
+    0xb454e4a179dd1877ull, 0x29babe4598c311fbull, 0xe16a1dc9d8545e94ull, 0xf4296dd6fef3d67aull,
+    0x8ce2529e2734bb1dull, 0x1899e4a65f58660cull, 0xb01ae745b101e9e4ull, 0x5ec05dcff72e7f8full,
+    0xdc21a1171d42645dull, 0x76707543f4fa1f73ull, 0x899504ae72497ebaull, 0x6a06494a791c53a8ull,
+    0xabfa45da0edbde69ull, 0x0487db9d17636892ull, 0xd6f8d7509292d603ull, 0x45a9d2845d3c42b6ull,
+    0x865b86925b9bc5c2ull, 0x0b8a2392ba45a9b2ull, 0xa7f26836f282b732ull, 0x8e6cac7768d7141eull,
+    0xd1ef0244af2364ffull, 0x3207d795430cd926ull, 0x8335616aed761f1full, 0x7f44e6bd49e807b8ull,
+    0xa402b9c5a8d3a6e7ull, 0x5f16206c9c6209a6ull, 0xcd036837130890a1ull, 0x36dba887c37a8c0full,
+    0x802221226be55a64ull, 0xc2494954da2c9789ull, 0xa02aa96b06deb0fdull, 0xf2db9baa10b7bd6cull,
+    0xc83553c5c8965d3dull, 0x6f92829494e5acc7ull, 0xfa42a8b73abbf48cull, 0xcb772339ba1f17f9ull,
+    0x9c69a97284b578d7ull, 0xff2a760414536efbull, 0xc38413cf25e2d70dull, 0xfef5138519684abaull,
+    0xf46518c2ef5b8cd1ull, 0x7eb258665fc25d69ull, 0x98bf2f79d5993802ull, 0xef2f773ffbd97a61ull,
+    0xbeeefb584aff8603ull, 0xaafb550ffacfd8faull, 0xeeaaba2e5dbf6784ull, 0x95ba2a53f983cf38ull,
+    0x952ab45cfa97a0b2ull, 0xdd945a747bf26183ull, 0xba756174393d88dfull, 0x94f971119aeef9e4ull,
+    0xe912b9d1478ceb17ull, 0x7a37cd5601aab85dull, 0x91abb422ccb812eeull, 0xac62e055c10ab33aull,
+    0xb616a12b7fe617aaull, 0x577b986b314d6009ull, 0xe39c49765fdf9d94ull, 0xed5a7e85fda0b80bull,
+    0x8e41ade9fbebc27dull, 0x14588f13be847307ull, 0xb1d219647ae6b31cull, 0x596eb2d8ae258fc8ull,
+    0xde469fbd99a05fe3ull, 0x6fca5f8ed9aef3bbull, 0x8aec23d680043beeull, 0x25de7bb9480d5854ull,
+    0xada72ccc20054ae9ull, 0xaf561aa79a10ae6aull, 0xd910f7ff28069da4ull, 0x1b2ba1518094da04ull,
+    0x87aa9aff79042286ull, 0x90fb44d2f05d0842ull, 0xa99541bf57452b28ull, 0x353a1607ac744a53ull,
+    0xd3fa922f2d1675f2ull, 0x42889b8997915ce8ull, 0x847c9b5d7c2e09b7ull, 0x69956135febada11ull,
+    0xa59bc234db398c25ull, 0x43fab9837e699095ull, 0xcf02b2c21207ef2eull, 0x94f967e45e03f4bbull,
+    0x8161afb94b44f57dull, 0x1d1be0eebac278f5ull, 0xa1ba1ba79e1632dcull, 0x6462d92a69731732ull,
+    0xca28a291859bbf93ull, 0x7d7b8f7503cfdcfeull, 0xfcb2cb35e702af78ull, 0x5cda735244c3d43eull,
+    0x9defbf01b061adabull, 0x3a0888136afa64a7ull, 0xc56baec21c7a1916ull, 0x088aaa1845b8fdd0ull,
+    0xf6c69a72a3989f5bull, 0x8aad549e57273d45ull, 0x9a3c2087a63f6399ull, 0x36ac54e2f678864bull,
+    0xc0cb28a98fcf3c7full, 0x84576a1bb416a7ddull, 0xf0fdf2d3f3c30b9full, 0x656d44a2a11c51d5ull,
+    0x969eb7c47859e743ull, 0x9f644ae5a4b1b325ull, 0xbc4665b596706114ull, 0x873d5d9f0dde1feeull,
+    0xeb57ff22fc0c7959ull, 0xa90cb506d155a7eaull, 0x9316ff75dd87cbd8ull, 0x09a7f12442d588f2ull,
+    0xb7dcbf5354e9beceull, 0x0c11ed6d538aeb2full, 0xe5d3ef282a242e81ull, 0x8f1668c8a86da5faull,
+    0x8fa475791a569d10ull, 0xf96e017d694487bcull, 0xb38d92d760ec4455ull, 0x37c981dcc395a9acull,
+    0xe070f78d3927556aull, 0x85bbe253f47b1417ull, 0x8c469ab843b89562ull, 0x93956d7478ccec8eull,
+    0xaf58416654a6babbull, 0x387ac8d1970027b2ull, 0xdb2e51bfe9d0696aull, 0x06997b05fcc0319eull,
+    0x88fcf317f22241e2ull, 0x441fece3bdf81f03ull, 0xab3c2fddeeaad25aull, 0xd527e81cad7626c3ull,
+    0xd60b3bd56a5586f1ull, 0x8a71e223d8d3b074ull, 0x85c7056562757456ull, 0xf6872d5667844e49ull,
+    0xa738c6bebb12d16cull, 0xb428f8ac016561dbull, 0xd106f86e69d785c7ull, 0xe13336d701beba52ull,
+    0x82a45b450226b39cull, 0xecc0024661173473ull, 0xa34d721642b06084ull, 0x27f002d7f95d0190ull,
+    0xcc20ce9bd35c78a5ull, 0x31ec038df7b441f4ull, 0xff290242c83396ceull, 0x7e67047175a15271ull,
+    0x9f79a169bd203e41ull, 0x0f0062c6e984d386ull, 0xc75809c42c684dd1ull, 0x52c07b78a3e60868ull,
+    0xf92e0c3537826145ull, 0xa7709a56ccdf8a82ull, 0x9bbcc7a142b17ccbull, 0x88a66076400bb691ull,
+    0xc2abf989935ddbfeull, 0x6acff893d00ea435ull, 0xf356f7ebf83552feull, 0x0583f6b8c4124d43ull,
+    0x98165af37b2153deull, 0xc3727a337a8b704aull, 0xbe1bf1b059e9a8d6ull, 0x744f18c0592e4c5cull,
+    0xeda2ee1c7064130cull, 0x1162def06f79df73ull, 0x9485d4d1c63e8be7ull, 0x8addcb5645ac2ba8ull,
+    0xb9a74a0637ce2ee1ull, 0x6d953e2bd7173692ull, 0xe8111c87c5c1ba99ull, 0xc8fa8db6ccdd0437ull,
+    0x910ab1d4db9914a0ull, 0x1d9c9892400a22a2ull, 0xb54d5e4a127f59c8ull, 0x2503beb6d00cab4bull,
+    0xe2a0b5dc971f303aull, 0x2e44ae64840fd61dull, 0x8da471a9de737e24ull, 0x5ceaecfed289e5d2ull,
+    0xb10d8e1456105dadull, 0x7425a83e872c5f47ull, 0xdd50f1996b947518ull, 0xd12f124e28f77719ull,
+    0x8a5296ffe33cc92full, 0x82bd6b70d99aaa6full, 0xace73cbfdc0bfb7bull, 0x636cc64d1001550bull,
+    0xd8210befd30efa5aull, 0x3c47f7e05401aa4eull, 0x8714a775e3e95c78ull, 0x65acfaec34810a71ull,
+    0xa8d9d1535ce3b396ull, 0x7f1839a741a14d0dull, 0xd31045a8341ca07cull, 0x1ede48111209a050ull,
+    0x83ea2b892091e44dull, 0x934aed0aab460432ull, 0xa4e4b66b68b65d60ull, 0xf81da84d5617853full,
+    0xce1de40642e3f4b9ull, 0x36251260ab9d668eull, 0x80d2ae83e9ce78f3ull, 0xc1d72b7c6b426019ull,
+    0xa1075a24e4421730ull, 0xb24cf65b8612f81full, 0xc94930ae1d529cfcull, 0xdee033f26797b627ull,
+    0xfb9b7cd9a4a7443cull, 0x169840ef017da3b1ull, 0x9d412e0806e88aa5ull, 0x8e1f289560ee864eull,
+    0xc491798a08a2ad4eull, 0xf1a6f2bab92a27e2ull, 0xf5b5d7ec8acb58a2ull, 0xae10af696774b1dbull,
+    0x9991a6f3d6bf1765ull, 0xacca6da1e0a8ef29ull, 0xbff610b0cc6edd3full, 0x17fd090a58d32af3ull,
+    0xeff394dcff8a948eull, 0xddfc4b4cef07f5b0ull, 0x95f83d0a1fb69cd9ull, 0x4abdaf101564f98eull,
+    0xbb764c4ca7a4440full, 0x9d6d1ad41abe37f1ull, 0xea53df5fd18d5513ull, 0x84c86189216dc5edull,
+    0x92746b9be2f8552cull, 0x32fd3cf5b4e49bb4ull, 0xb7118682dbb66a77ull, 0x3fbc8c33221dc2a1ull,
+    0xe4d5e82392a40515ull, 0x0fabaf3feaa5334aull, 0x8f05b1163ba6832dull, 0x29cb4d87f2a7400eull,
+    0xb2c71d5bca9023f8ull, 0x743e20e9ef511012ull, 0xdf78e4b2bd342cf6ull, 0x914da9246b255416ull,
+    0x8bab8eefb6409c1aull, 0x1ad089b6c2f7548eull, 0xae9672aba3d0c320ull, 0xa184ac2473b529b1ull,
+    0xda3c0f568cc4f3e8ull, 0xc9e5d72d90a2741eull, 0x8865899617fb1871ull, 0x7e2fa67c7a658892ull,
+    0xaa7eebfb9df9de8dull, 0xddbb901b98feeab7ull, 0xd51ea6fa85785631ull, 0x552a74227f3ea565ull,
+    0x8533285c936b35deull, 0xd53a88958f87275full, 0xa67ff273b8460356ull, 0x8a892abaf368f137ull,
+    0xd01fef10a657842cull, 0x2d2b7569b0432d85ull, 0x8213f56a67f6b29bull, 0x9c3b29620e29fc73ull,
+    0xa298f2c501f45f42ull, 0x8349f3ba91b47b8full, 0xcb3f2f7642717713ull, 0x241c70a936219a73ull,
+    0xfe0efb53d30dd4d7ull, 0xed238cd383aa0110ull, 0x9ec95d1463e8a506ull, 0xf4363804324a40aaull,
+    0xc67bb4597ce2ce48ull, 0xb143c6053edcd0d5ull, 0xf81aa16fdc1b81daull, 0xdd94b7868e94050aull,
+    0x9b10a4e5e9913128ull, 0xca7cf2b4191c8326ull, 0xc1d4ce1f63f57d72ull, 0xfd1c2f611f63a3f0ull,
+    0xf24a01a73cf2dccfull, 0xbc633b39673c8cecull, 0x976e41088617ca01ull, 0xd5be0503e085d813ull,
+    0xbd49d14aa79dbc82ull, 0x4b2d8644d8a74e18ull, 0xec9c459d51852ba2ull, 0xddf8e7d60ed1219eull,
+    0x93e1ab8252f33b45ull, 0xcabb90e5c942b503ull, 0xb8da1662e7b00a17ull, 0x3d6a751f3b936243ull,
+    0xe7109bfba19c0c9dull, 0x0cc512670a783ad4ull, 0x906a617d450187e2ull, 0x27fb2b80668b24c5ull,
+    0xb484f9dc9641e9daull, 0xb1f9f660802dedf6ull, 0xe1a63853bbd26451ull, 0x5e7873f8a0396973ull,
+    0x8d07e33455637eb2ull, 0xdb0b487b6423e1e8ull, 0xb049dc016abc5e5full, 0x91ce1a9a3d2cda62ull,
+    0xdc5c5301c56b75f7ull, 0x7641a140cc7810fbull, 0x89b9b3e11b6329baull, 0xa9e904c87fcb0a9dull,
+    0xac2820d9623bf429ull, 0x546345fa9fbdcd44ull, 0xd732290fbacaf133ull, 0xa97c177947ad4095ull,
+    0x867f59a9d4bed6c0ull, 0x49ed8eabcccc485dull, 0xa81f301449ee8c70ull, 0x5c68f256bfff5a74ull,
+    0xd226fc195c6a2f8cull, 0x73832eec6fff3111ull, 0x83585d8fd9c25db7ull, 0xc831fd53c5ff7eabull,
+    0xa42e74f3d032f525ull, 0xba3e7ca8b77f5e55ull, 0xcd3a1230c43fb26full, 0x28ce1bd2e55f35ebull,
+    0x80444b5e7aa7cf85ull, 0x7980d163cf5b81b3ull, 0xa0555e361951c366ull, 0xd7e105bcc332621full,
+    0xc86ab5c39fa63440ull, 0x8dd9472bf3fefaa7ull, 0xfa856334878fc150ull, 0xb14f98f6f0feb951ull,
+    0x9c935e00d4b9d8d2ull, 0x6ed1bf9a569f33d3ull, 0xc3b8358109e84f07ull, 0x0a862f80ec4700c8ull,
+    0xf4a642e14c6262c8ull, 0xcd27bb612758c0faull, 0x98e7e9cccfbd7dbdull, 0x8038d51cb897789cull,
+    0xbf21e44003acdd2cull, 0xe0470a63e6bd56c3ull, 0xeeea5d5004981478ull, 0x1858ccfce06cac74ull,
+    0x95527a5202df0ccbull, 0x0f37801e0c43ebc8ull, 0xbaa718e68396cffdull, 0xd30560258f54e6baull,
+    0xe950df20247c83fdull, 0x47c6b82ef32a2069ull, 0x91d28b7416cdd27eull, 0x4cdc331d57fa5441ull,
+    0xb6472e511c81471dull, 0xe0133fe4adf8e952ull, 0xe3d8f9e563a198e5ull, 0x58180fddd97723a6ull,
+    0x8e679c2f5e44ff8full, 0x570f09eaa7ea7648ull
+};
+
+struct sdlang_float_format_t
+{
+    int mantissa_bits;
+    int min_exponent;
+    int infinite_power;
+    int min_pow10, max_pow10;
+    int min_round_to_even, max_round_to_even;
+    int max_fast_pow10;
+    uint64_t max_fast_mantissa;
+};
+
+static const struct sdlang_float_format_t sdlang_float64_format = {
+    52, -1023, 0x7ff, -342, 308, -4, 23, 22, 1ull << 53
+};
+
+static const struct sdlang_float_format_t sdlang_float32_format = {
+    23, -127, 0xff, -65, 38, -17, 10, 10, 1ull << 24
+};
+
+static void sdlang_eisel_lemire(const struct sdlang_float_format_t* fmt,
+                                int64_t q, uint64_t w, uint64_t* mantissa, int* power2)
+{
+    /*
+        Computes the binary significand and biased exponent of w * 10^q,
+        rounded to nearest-even.
+    */
+    const int index = 2 * (int)(q - SDLANG_POW5_MIN);
+    const uint64_t precision_mask = 0xffffffffffffffffull >> (fmt->mantissa_bits + 3);
+    uint64_t lo, hi, m;
+    int lz, upperbit, shift, p2;
+
+    if (w == 0 || q < fmt->min_pow10)
+    {
+        *mantissa = 0;
+        *power2 = 0;
+        return;
+    }
+
+    if (q > fmt->max_pow10)
+    {
+        *mantissa = 0;
+        *power2 = fmt->infinite_power;
+        return;
+    }
+
+    lz = sdlang_clz64(w);
+    w <<= lz;
+
+    lo = sdlang_mul64(w, sdlang_pow5_128[index], &hi);
+
+    if ((hi & precision_mask) == precision_mask)
+    {
+        uint64_t hi2;
+        sdlang_mul64(w, sdlang_pow5_128[index + 1], &hi2);
+        lo += hi2;
+
+        if (hi2 > lo)
+        {
+            ++hi;
+        }
+    }
+
+    upperbit = (int)(hi >> 63);
+    shift = upperbit + 64 - fmt->mantissa_bits - 3;
+    m = hi >> shift;
+
+    /* 217706 / 2^16 ~ log2(10) */
+    p2 = (int)(((217706 * q) >> 16) + 63) + upperbit - lz - fmt->min_exponent;
+
+    if (p2 <= 0)
+    {
+        /* subnormal */
+        if (-p2 + 1 >= 64)
+        {
+            *mantissa = 0;
+            *power2 = 0;
+            return;
+        }
+
+        m >>= -p2 + 1;
+        m += m & 1;
+        m >>= 1;
+
+        *mantissa = m;
+        *power2 = m < (1ull << fmt->mantissa_bits) ? 0 : 1;
+        return;
+    }
+
+    if (lo <= 1 && q >= fmt->min_round_to_even && q <= fmt->max_round_to_even
+        && (m & 3) == 1 && (m << shift) == hi)
+    {
+        /* exactly halfway, round to even */
+        m &= ~1ull;
+    }
+
+    m += m & 1;
+    m >>= 1;
+
+    if (m >= (2ull << fmt->mantissa_bits))
+    {
+        m = 1ull << fmt->mantissa_bits;
+        ++p2;
+    }
+
+    m &= ~(1ull << fmt->mantissa_bits);
+
+    if (p2 >= fmt->infinite_power)
+    {
+        m = 0;
+        p2 = fmt->infinite_power;
+    }
+
+    *mantissa = m;
+    *power2 = p2;
+}
+
+struct sdlang_decimal_t
+{
+    uint64_t w;
+    int64_t q;
+    bool negative;
+    bool truncated;
+};
+
+static void sdlang_parse_decimal(const char* s, const char* e, struct sdlang_decimal_t* dec)
+{
+    /*
+        Splits a float lexeme into w * 10^q. If there are more than 19
+        significant digits, w holds the first 19 and `truncated` is set.
+    */
+    const char *start, *int_end, *frac_begin = NULL, *mantissa_end;
+    int64_t exponent = 0, exp_number = 0, count;
+    uint64_t w = 0;
+
+    dec->negative = *s == '-';
+    start = s + dec->negative;
+
+    for (s = start; s != e && *s >= '0' && *s <= '9'; ++s)
+    {
+        w = w * 10 + (uint64_t)(*s - '0');
+    }
+
+    int_end = s;
+    count = int_end - start;
+
+    if (s != e && *s == '.')
+    {
+        frac_begin = ++s;
+
+        for (; s != e && *s >= '0' && *s <= '9'; ++s)
+        {
+            w = w * 10 + (uint64_t)(*s - '0');
+        }
+
+        exponent = frac_begin - s;
+        count -= exponent;
+    }
+
+    mantissa_end = s;
+
+    if (s != e)
+    {
+        /* 'e' or 'E' */
+        const bool neg = *++s == '-';
+
+        for (s += (*s == '+' || *s == '-'); s != e; ++s)
+        {
+            if (exp_number < 0x10000000)
+            {
+                exp_number = exp_number * 10 + (*s - '0');
+            }
+        }
+
+        exp_number = neg ? -exp_number : exp_number;
+        exponent += exp_number;
+    }
+
+    dec->truncated = false;
+
+    if (count > 19)
+    {
+        /* don't count leading zeros */
+        for (s = start; s != mantissa_end && (*s == '0' || *s == '.'); ++s)
+        {
+            count -= *s == '0';
+        }
+
+        if (count > 19)
+        {
+            const uint64_t min_19_digits = 1000000000000000000ull;
+
+            dec->truncated = true;
+            w = 0;
+
+            for (s = start; w < min_19_digits && s != int_end; ++s)
+            {
+                w = w * 10 + (uint64_t)(*s - '0');
+            }
+
+            if (w >= min_19_digits)
+            {
+                exponent = (int_end - s) + exp_number;
+            }
+            else
+            {
+                for (s = frac_begin; w < min_19_digits && s != mantissa_end; ++s)
+                {
+                    w = w * 10 + (uint64_t)(*s - '0');
+                }
+
+                exponent = (frac_begin - s) + exp_number;
+            }
+        }
+    }
+
+    dec->w = w;
+    dec->q = exponent;
+}
+
+static bool sdlang_decode_float_bits(const struct sdlang_float_format_t* fmt,
+                                     const struct sdlang_decimal_t* dec, uint64_t* bits)
+{
+    /*
+        With truncated digits, the exact value lies between w and w + 1. If
+        both round to the same float, that's the result.
+    */
+    uint64_t m, m1;
+    int p2, p21;
+
+    sdlang_eisel_lemire(fmt, dec->q, dec->w, &m, &p2);
+
+    if (dec->truncated)
+    {
+        sdlang_eisel_lemire(fmt, dec->q, dec->w + 1, &m1, &p21);
+
+        if (m != m1 || p2 != p21)
+        {
+            return false;
+        }
+    }
+
+    *bits = m | ((uint64_t)p2 << fmt->mantissa_bits);
+    return true;
+}
+
+#define SDLANG_FLOAT_MAXDIGITS 768
+
+static double sdlang_decode_float_slow(const char* s, const char* e, bool single)
+{
+    /*
+        Fallback if the fast path can't decide the rounding. The lexeme is
+        rewritten to "ddd...e-n" form, which doesn't contain a locale-
+        dependent decimal point, and passed to strtod()/strtof(). Digits
+        beyond the longest possible halfway representation are replaced by
+        a single sticky digit.
+    */
+    char buf[SDLANG_FLOAT_MAXDIGITS + 32], rev[24];
+    char* d = buf;
+    int64_t exponent = 0, n = 0;
+    int digits = 0, k = 0;
+    bool fraction = false, sticky = false;
+
+    if (*s == '-')
+    {
+        *d++ = *s++;
+    }
+
+    for (; s != e && *s != 'e' && *s != 'E'; ++s)
+    {
+        if (*s == '.')
+        {
+            fraction = true;
+        }
+        else if (digits == 0 && *s == '0')
+        {
+            exponent -= fraction;
+        }
+        else if (digits < SDLANG_FLOAT_MAXDIGITS)
+        {
+            *d++ = *s;
+            ++digits;
+            exponent -= fraction;
+        }
+        else
+        {
+            exponent += !fraction;
+            sticky |= *s != '0';
+        }
+    }
+
+    if (sticky)
+    {
+        *d++ = '1';
+        --exponent;
+    }
+
+    if (digits == 0)
+    {
+        *d++ = '0';
+    }
+
+    if (s != e)
+    {
+        const bool neg = *++s == '-';
+
+        for (s += (*s == '+' || *s == '-'); s != e; ++s)
+        {
+            if (n < 0x10000000)
+            {
+                n = n * 10 + (*s - '0');
+            }
+        }
+
+        exponent += neg ? -n : n;
+    }
+
+    *d++ = 'e';
+
+    if (exponent < 0)
+    {
+        *d++ = '-';
+        exponent = -exponent;
+    }
+
+    do
+    {
+        rev[k++] = (char)('0' + exponent % 10);
+        exponent /= 10;
+    }
+    while (exponent > 0);
+
+    while (k > 0)
+    {
+        *d++ = rev[--k];
+    }
+
+    *d = '\0';
+
+    return single ? strtof(buf, NULL) : strtod(buf, NULL);
+}
+
+static double sdlang_decode_f64(const char* s, const char* e)
+{
+    static const double pow10[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    struct sdlang_decimal_t dec;
+    union { uint64_t u; double d; } bits;
+
+    sdlang_parse_decimal(s, e, &dec);
+
+#if FLT_EVAL_METHOD == 0
+    /* Clinger's fast path: both w and 10^q are exact doubles */
+    if (!dec.truncated && dec.q >= -22 && dec.q <= 22 && dec.w <= (1ull << 53))
+    {
+        double d = (double)dec.w;
+        d = dec.q < 0 ? d / pow10[-dec.q] : d * pow10[dec.q];
+        return dec.negative ? -d : d;
+    }
+#endif
+
+    if (!sdlang_decode_float_bits(&sdlang_float64_format, &dec, &bits.u))
+    {
+        return sdlang_decode_float_slow(s, e, false);
+    }
+
+    bits.u |= (uint64_t)dec.negative << 63;
+    return bits.d;
+}
+
+static float sdlang_decode_f32(const char* s, const char* e)
+{
+    static const float pow10[] = {
+        1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f
+    };
+
+    struct sdlang_decimal_t dec;
+    union { uint32_t u; float f; } bits;
+    uint64_t u;
+
+    sdlang_parse_decimal(s, e, &dec);
+
+#if FLT_EVAL_METHOD == 0
+    if (!dec.truncated && dec.q >= -10 && dec.q <= 10 && dec.w <= (1ull << 24))
+    {
+        float f = (float)dec.w;
+        f = dec.q < 0 ? f / pow10[-dec.q] : f * pow10[dec.q];
+        return dec.negative ? -f : f;
+    }
+#endif
+
+    if (!sdlang_decode_float_bits(&sdlang_float32_format, &dec, &u))
+    {
+        return (float)sdlang_decode_float_slow(s, e, true);
+    }
+
+    bits.u = (uint32_t)u | ((uint32_t)dec.negative << 31);
+    return bits.f;
+}
+
+/*
+    Fast-skip scanners.
+
+    Called by the FSM from inside string bodies, comments and runs of blanks
+    to jump over characters which cannot change its state. Each returns a
+    pointer to the first character in [p, pe) which is one of `a`, `b`, `c`
+    or `d` (or, for blanks, is not), or `pe`. Line breaks are always stop
+    characters, so the FSM still counts them.
+*/
+
+static int sdlang_ctz32(uint32_t v)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(v);
+#else
+    int n = 0;
+
+    while (!(v & 1))
+    {
+        v >>= 1;
+        ++n;
+    }
+
+    return n;
+#endif
+}
+
+#ifdef SDLANG_HAVE_AVX2
+
+/* the CPU features are checked once at load time, not on every call */
+static bool sdlang_cpu_avx2, sdlang_cpu_ssse3;
+
+__attribute__((constructor))
+static void sdlang_check_cpu(void)
+{
+    __builtin_cpu_init();
+    sdlang_cpu_avx2 = __builtin_cpu_supports("avx2") != 0;
+    sdlang_cpu_ssse3 = __builtin_cpu_supports("ssse3") != 0;
+}
+
+__attribute__((target("avx2")))
+static const char* sdlang_skip_avx2(const char* p, const char* pe,
+                                    char a, char b, char c, char d, uint32_t invert)
+{
+    const __m256i va = _mm256_set1_epi8(a), vb = _mm256_set1_epi8(b);
+    const __m256i vc = _mm256_set1_epi8(c), vd = _mm256_set1_epi8(d);
+
+    for (; pe - p >= 32; p += 32)
+    {
+        const __m256i v = _mm256_loadu_si256((const __m256i*)p);
+        const __m256i m = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, va), _mm256_cmpeq_epi8(v, vb)),
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, vc), _mm256_cmpeq_epi8(v, vd)));
+        const uint32_t bits = (uint32_t)_mm256_movemask_epi8(m) ^ invert;
+
+        if (bits != 0)
+        {
+            return p + sdlang_ctz32(bits);
+        }
+    }
+
+    return p;
+}
+
+#endif
+
+#ifdef SDLANG_HAVE_SSE2
+
+static uint32_t sdlang_match_sse2(const char* p, __m128i va, __m128i vb, __m128i vc, __m128i vd)
+{
+    const __m128i v = _mm_loadu_si128((const __m128i*)p);
+    const __m128i m = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(v, va), _mm_cmpeq_epi8(v, vb)),
+        _mm_or_si128(_mm_cmpeq_epi8(v, vc), _mm_cmpeq_epi8(v, vd)));
+
+    return (uint32_t)_mm_movemask_epi8(m);
+}
+
+static const char* sdlang_skip_sse2(const char* p, const char* pe,
+                                    char a, char b, char c, char d, uint32_t invert)
+{
+    /* the last 16 bytes before `pe` must be readable, even if p > pe - 16 */
+    const __m128i va = _mm_set1_epi8(a), vb = _mm_set1_epi8(b);
+    const __m128i vc = _mm_set1_epi8(c), vd = _mm_set1_epi8(d);
+    uint32_t bits;
+
+    for (; pe - p >= 16; p += 16)
+    {
+        bits = (sdlang_match_sse2(p, va, vb, vc, vd) ^ invert) & 0xffff;
+
+        if (bits != 0)
+        {
+            return p + sdlang_ctz32(bits);
+        }
+    }
+
+    if (p == pe)
+    {
+        return pe;
+    }
+
+    /* the tail overlaps with the last block */
+    bits = ((sdlang_match_sse2(pe - 16, va, vb, vc, vd) ^ invert) & 0xffff) >> (p - (pe - 16));
+
+    return bits != 0 ? p + sdlang_ctz32(bits) : pe;
+}
+
+#endif
+
+static const char* sdlang_skip(const char* p, const char* pe,
+                               char a, char b, char c, char d, bool invert)
+{
+    /* most runs are short, test the first character before vectorizing */
+    if (p == pe || (*p == a || *p == b || *p == c || *p == d) != invert)
+    {
+        return p;
+    }
+
+#ifdef SDLANG_HAVE_SSE2
+    if (pe - p >= 16)
+    {
+#ifdef SDLANG_HAVE_AVX2
+        if (pe - p >= 32 && sdlang_cpu_avx2)
+        {
+            p = sdlang_skip_avx2(p, pe, a, b, c, d, invert ? 0xffffffffu : 0);
+
+            if (pe - p >= 32)
+            {
+                return p;
+            }
+        }
+#endif
+
+        /* finishes the remaining bytes, possibly overlapping */
+        return sdlang_skip_sse2(p, pe, a, b, c, d, invert ? 0xffffffffu : 0);
+    }
+#else
+    if (!invert)
+    {
+        /* SWAR: tests 8 bytes at once, a match sets the high bit of its byte */
+        const uint64_t ones = 0x0101010101010101ull, highs = 0x8080808080808080ull;
+        const uint64_t ka = ones * (unsigned char)a, kb = ones * (unsigned char)b;
+        const uint64_t kc = ones * (unsigned char)c, kd = ones * (unsigned char)d;
+
+        for (; pe - p >= 8; p += 8)
+        {
+            const uint64_t w = sdlang_load64(p);
+            const uint64_t xa = w ^ ka, xb = w ^ kb, xc = w ^ kc, xd = w ^ kd;
+
+            if ((((xa - ones) & ~xa) | ((xb - ones) & ~xb) | ((xc - ones) & ~xc) | ((xd - ones) & ~xd)) & highs)
+            {
+                break;
+            }
+        }
+    }
+#endif
+
+    for (; p != pe; ++p)
+    {
+        if ((*p == a || *p == b || *p == c || *p == d) != invert)
+        {
+            break;
+        }
+    }
+
+    return p;
+}
+
+static const char* sdlang_skip_dquote(const char* p, const char* pe)
+{
+    return sdlang_skip(p, pe, '"', '\\', '\n', '\n', false);
+}
+
+static const char* sdlang_skip_squote(const char* p, const char* pe)
+{
+    return sdlang_skip(p, pe, '\'', '`', '\\', '\n', false);
+}
+
+static const char* sdlang_skip_line(const char* p, const char* pe)
+{
+    return sdlang_skip(p, pe, '\n', '\n', '\n', '\n', false);
+}
+
+static const char* sdlang_skip_comment(const char* p, const char* pe)
+{
+    return sdlang_skip(p, pe, '*', '\n', '\n', '\n', false);
+}
+
+static const char* sdlang_skip_blank(const char* p, const char* pe)
+{
+    return sdlang_skip(p, pe, ' ', '\t', ' ', '\t', true);
+}
+
+static const char* sdlang_skip_comment_body(const char* p, const char* pe, int* curline)
+{
+    /* stops in front of the closing '*' and leaves it to the scanner */
+    while ((p = sdlang_skip_comment(p, pe)) != pe)
+    {
+        if (*p == '\n')
+        {
+            *curline += 1;
+        }
+        else if (p + 1 == pe || p[1] == '/')
+        {
+            break;
+        }
+
+        ++p;
+    }
+
+    return p;
+}
+
+static const unsigned char sdlang_structural[256] = {
+    ['\n'] = 1, [';'] = 1, ['{'] = 1, ['}'] = 1, ['"'] = 1, ['\''] = 1,
+    ['`'] = 1, ['['] = 1, ['#'] = 1, ['/'] = 1, ['-'] = 1, ['\\'] = 1
+};
+
+static bool sdlang_name_char(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')
+        || c == '.' || c == ':' || c == '-' || c == '_' || c == '$';
+}
+
+/*
+    Skipping blocks.
+
+    Blocks which a query doesn't look into are jumped over instead of being
+    tokenized, counting braces and line breaks, and stepping over strings,
+    binary literals and comments as a whole. A block can span several
+    buffers when parsing a stream, so the scan keeps its state in the
+    parser between calls.
+*/
+
+enum sdlang_skip_state_t
+{
+    SDLANG_SKIP_PLAIN,
+    SDLANG_SKIP_DQUOTE,
+    SDLANG_SKIP_SQUOTE,
+    SDLANG_SKIP_DQUOTE_ESCAPE,
+    SDLANG_SKIP_SQUOTE_ESCAPE,
+    SDLANG_SKIP_BASE64,
+    SDLANG_SKIP_LINE_COMMENT,
+    SDLANG_SKIP_C_COMMENT,
+    SDLANG_SKIP_C_COMMENT_STAR,
+    SDLANG_SKIP_SLASH,
+    SDLANG_SKIP_DASH
+};
+
+#ifdef SDLANG_HAVE_SSE2
+static int sdlang_popcount32(uint32_t v)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcount(v);
+#else
+    int n = 0;
+
+    for (; v != 0; v &= v - 1)
+    {
+        ++n;
+    }
+
+    return n;
+#endif
+}
+#endif
+
+static const char* sdlang_skip_nested(const char* p, const char* pe, int* line)
+{
+    /*
+        finds the next character which opens or closes a block, a string,
+        a binary literal or a comment, counting the line breaks before it
+    */
+#ifdef SDLANG_HAVE_SSE2
+    const __m128i v0 = _mm_set1_epi8('{'), v1 = _mm_set1_epi8('}');
+    const __m128i v2 = _mm_set1_epi8('"'), v3 = _mm_set1_epi8('\'');
+    const __m128i v4 = _mm_set1_epi8('`'), v5 = _mm_set1_epi8('[');
+    const __m128i v6 = _mm_set1_epi8('#'), v7 = _mm_set1_epi8('/');
+    const __m128i v8 = _mm_set1_epi8('-'), newline = _mm_set1_epi8('\n');
+
+    for (; pe - p >= 16; p += 16)
+    {
+        const uint32_t bits = sdlang_match_sse2(p, v0, v1, v2, v3)
+                            | sdlang_match_sse2(p, v4, v5, v6, v7)
+                            | sdlang_match_sse2(p, v8, v8, v8, v8);
+        const uint32_t newlines = sdlang_match_sse2(p, newline, newline, newline, newline);
+
+        if (bits != 0)
+        {
+            *line += sdlang_popcount32(newlines & ((bits & (0 - bits)) - 1));
+            return p + sdlang_ctz32(bits);
+        }
+
+        *line += sdlang_popcount32(newlines);
+    }
+#endif
+
+    for (; p != pe; ++p)
+    {
+        if (*p == '\n')
+        {
+            ++*line;
+        }
+        else if (sdlang_structural[(unsigned char)*p] && *p != ';' && *p != '\\')
+        {
+            break;
+        }
+    }
+
+    return p;
+}
+
+static const char* sdlang_skip_block(struct sdlang_parser_t* parser,
+                                     const char* p, const char* pe, int* curline)
+{
+    /*
+        returns the position after the brace which closes the skipped
+        block, or `pe` if the block goes on
+    */
+    const char* const begin = p;
+    int depth = parser->skip.depth, state = parser->skip.state, line = *curline;
+
+    while (p != pe && depth > 0)
+    {
+        char c;
+
+        switch (state)
+        {
+        case SDLANG_SKIP_PLAIN:
+            if ((p = sdlang_skip_nested(p, pe, &line)) == pe)
+            {
+                break;
+            }
+
+            switch (c = *p++)
+            {
+            case '{':
+                ++depth;
+                break;
+
+            case '}':
+                --depth;
+                break;
+
+            case '"':
+                state = SDLANG_SKIP_DQUOTE;
+                break;
+
+            case '\'':
+            case '`':
+                state = SDLANG_SKIP_SQUOTE;
+                break;
+
+            case '[':
+                state = SDLANG_SKIP_BASE64;
+                break;
+
+            case '#':
+                state = SDLANG_SKIP_LINE_COMMENT;
+                break;
+
+            case '/':
+                state = SDLANG_SKIP_SLASH;
+                break;
+
+            case '-':
+                /* dashes can also be part of names */
+                if (!sdlang_name_char(p - 1 != begin ? p[-2] : parser->skip.last))
+                {
+                    state = SDLANG_SKIP_DASH;
+                }
+                break;
+
+            default:
+                break;
+            }
+            break;
+
+        case SDLANG_SKIP_DQUOTE:
+        case SDLANG_SKIP_SQUOTE:
+            p = state == SDLANG_SKIP_DQUOTE ? sdlang_skip_dquote(p, pe) : sdlang_skip_squote(p, pe);
+
+            if (p == pe)
+            {
+                break;
+            }
+
+            if ((c = *p++) == '\\')
+            {
+                state = state == SDLANG_SKIP_DQUOTE ? SDLANG_SKIP_DQUOTE_ESCAPE : SDLANG_SKIP_SQUOTE_ESCAPE;
+            }
+            else if (c == '\n')
+            {
+                ++line;
+            }
+            else
+            {
+                state = SDLANG_SKIP_PLAIN;
+            }
+            break;
+
+        case SDLANG_SKIP_DQUOTE_ESCAPE:
+        case SDLANG_SKIP_SQUOTE_ESCAPE:
+            line += *p++ == '\n';
+            state = state == SDLANG_SKIP_DQUOTE_ESCAPE ? SDLANG_SKIP_DQUOTE : SDLANG_SKIP_SQUOTE;
+            break;
+
+        case SDLANG_SKIP_BASE64:
+            if ((p = sdlang_skip(p, pe, ']', '\n', ']', '\n', false)) != pe)
+            {
+                line += *p == '\n';
+                state = *p++ == ']' ? SDLANG_SKIP_PLAIN : state;
+            }
+            break;
+
+        case SDLANG_SKIP_LINE_COMMENT:
+            if ((p = sdlang_skip_line(p, pe)) != pe)
+            {
+                ++line;
+                ++p;
+                state = SDLANG_SKIP_PLAIN;
+            }
+            break;
+
+        case SDLANG_SKIP_C_COMMENT:
+            if ((p = sdlang_skip_comment(p, pe)) != pe)
+            {
+                line += *p == '\n';
+                state = *p++ == '*' ? SDLANG_SKIP_C_COMMENT_STAR : state;
+            }
+            break;
+
+        case SDLANG_SKIP_C_COMMENT_STAR:
+            c = *p++;
+            line += c == '\n';
+            state = c == '/' ? SDLANG_SKIP_PLAIN : c == '*' ? state : SDLANG_SKIP_C_COMMENT;
+            break;
+
+        case SDLANG_SKIP_SLASH:
+            /* the character after a slash isn't consumed, unless it starts a comment */
+            state = *p == '/' ? SDLANG_SKIP_LINE_COMMENT : *p == '*' ? SDLANG_SKIP_C_COMMENT : SDLANG_SKIP_PLAIN;
+            p += state != SDLANG_SKIP_PLAIN;
+            break;
+
+        case SDLANG_SKIP_DASH:
+            state = *p == '-' ? SDLANG_SKIP_LINE_COMMENT : SDLANG_SKIP_PLAIN;
+            p += state != SDLANG_SKIP_PLAIN;
+            break;
+        }
+    }
+
+    parser->skip.depth = depth;
+    parser->skip.state = state;
+    parser->skip.last = p != begin ? p[-1] : parser->skip.last;
+    *curline = line;
+
+    return p;
+}
+
+static void sdlang_begin_skip(struct sdlang_parser_t* parser)
+{
+    /* called for a block token, the action of the '{' takes it from there */
+    parser->skip.depth = 1;
+    parser->skip.state = SDLANG_SKIP_PLAIN;
+    parser->skip.last = '{';
+}
+
+/*
+    Base64 decoding.
+
+    Blocks of 32 or 16 characters are translated and packed with AVX2 or
+    SSSE3 (checked at runtime), using the nibble lookups by Wojciech Mula.
+    Blocks with any other character than [A-Za-z0-9+/], including padding,
+    are left to the scalar loop, which also validates the input.
+*/
+
+static const unsigned char sdlang_base64_value[256] = {
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3e, 0xff, 0xff, 0xff, 0x3f,
+    0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e,
+    0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+    0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f, 0x30, 0x31, 0x32, 0x33, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
+};
+
+#ifdef SDLANG_HAVE_AVX2
+
+__attribute__((target("avx2")))
+static size_t sdlang_decode_base64_avx2(const unsigned char* s, size_t len, unsigned char* d)
+{
+    /* needs 8 bytes of slack after the 24 decoded bytes of each block */
+    const __m256i lut_lo = _mm256_setr_epi8(
+        0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a,
+        0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a);
+    const __m256i lut_hi = _mm256_setr_epi8(
+        0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+        0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m256i lut_roll = _mm256_setr_epi8(
+        0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i pack = _mm256_setr_epi8(
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    const __m256i nibble = _mm256_set1_epi8(0x0f);
+    const __m256i slash = _mm256_set1_epi8('/');
+    size_t done = 0;
+
+    for (; len - done >= 64; done += 32, d += 24)
+    {
+        const __m256i v = _mm256_loadu_si256((const __m256i*)(s + done));
+        const __m256i hi_nibbles = _mm256_and_si256(_mm256_srli_epi32(v, 4), nibble);
+        const __m256i lo = _mm256_shuffle_epi8(lut_lo, _mm256_and_si256(v, nibble));
+        const __m256i hi = _mm256_shuffle_epi8(lut_hi, hi_nibbles);
+        __m256i out;
+
+        if (!_mm256_testz_si256(lo, hi))
+        {
+            break;
+        }
+
+        out = _mm256_add_epi8(v, _mm256_shuffle_epi8(lut_roll,
+            _mm256_add_epi8(_mm256_cmpeq_epi8(v, slash), hi_nibbles)));
+        out = _mm256_maddubs_epi16(out, _mm256_set1_epi32(0x01400140));
+        out = _mm256_madd_epi16(out, _mm256_set1_epi32(0x00011000));
+        out = _mm256_shuffle_epi8(out, pack);
+        out = _mm256_permutevar8x32_epi32(out, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7));
+
+        _mm256_storeu_si256((__m256i*)d, out);
+    }
+
+    return done;
+}
+
+#endif
+
+#ifdef SDLANG_HAVE_SSSE3
+
+__attribute__((target("ssse3")))
+static size_t sdlang_decode_base64_ssse3(const unsigned char* s, size_t len, unsigned char* d)
+{
+    /* needs 4 bytes of slack after the 12 decoded bytes of each block */
+    const __m128i lut_lo = _mm_setr_epi8(
+        0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a);
+    const __m128i lut_hi = _mm_setr_epi8(
+        0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m128i lut_roll = _mm_setr_epi8(
+        0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i pack = _mm_setr_epi8(
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    const __m128i nibble = _mm_set1_epi8(0x0f);
+    const __m128i slash = _mm_set1_epi8('/');
+    size_t done = 0;
+
+    for (; len - done >= 24; done += 16, d += 12)
+    {
+        const __m128i v = _mm_loadu_si128((const __m128i*)(s + done));
+        const __m128i hi_nibbles = _mm_and_si128(_mm_srli_epi32(v, 4), nibble);
+        const __m128i lo = _mm_shuffle_epi8(lut_lo, _mm_and_si128(v, nibble));
+        const __m128i hi = _mm_shuffle_epi8(lut_hi, hi_nibbles);
+        __m128i out;
+
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128())) != 0xffff)
+        {
+            break;
+        }
+
+        out = _mm_add_epi8(v, _mm_shuffle_epi8(lut_roll,
+            _mm_add_epi8(_mm_cmpeq_epi8(v, slash), hi_nibbles)));
+        out = _mm_maddubs_epi16(out, _mm_set1_epi32(0x01400140));
+        out = _mm_madd_epi16(out, _mm_set1_epi32(0x00011000));
+        out = _mm_shuffle_epi8(out, pack);
+
+        _mm_storeu_si128((__m128i*)d, out);
+    }
+
+    return done;
+}
+
+#endif
+
+int sdlang_decode_base64(const char* src, int len, unsigned char* dst)
+{
+    const unsigned char* s = (const unsigned char*)src;
+    unsigned char* d = dst;
+    size_t n, i = 0;
+    int pad = 0;
+
+    /* padding is optional, but if present must complete the last quad */
+    if (len > 0 && s[len - 1] == '=')
+    {
+        pad = len > 1 && s[len - 2] == '=' ? 2 : 1;
+
+        if (len % 4 != 0)
+        {
+            return -1;
+        }
+    }
+
+    n = (size_t)(len - pad);
+
+    if (n % 4 == 1)
+    {
+        return -1;
+    }
+
+#ifdef SDLANG_HAVE_AVX2
+    if (n >= 64 && sdlang_cpu_avx2)
+    {
+        i = sdlang_decode_base64_avx2(s, n, d);
+        d += i / 4 * 3;
+    }
+#endif
+
+#ifdef SDLANG_HAVE_SSSE3
+    if (n - i >= 24 && sdlang_cpu_ssse3)
+    {
+        const size_t done = sdlang_decode_base64_ssse3(s + i, n - i, d);
+        i += done;
+        d += done / 4 * 3;
+    }
+#endif
+
+    for (; n - i >= 4; i += 4, d += 3)
+    {
+        const uint32_t a = sdlang_base64_value[s[i]], b = sdlang_base64_value[s[i + 1]];
+        const uint32_t c = sdlang_base64_value[s[i + 2]], e = sdlang_base64_value[s[i + 3]];
+        const uint32_t v = (a << 18) | (b << 12) | (c << 6) | e;
+
+        if ((a | b | c | e) & 0x80)
+        {
+            return -1;
+        }
+
+        d[0] = (unsigned char)(v >> 16);
+        d[1] = (unsigned char)(v >> 8);
+        d[2] = (unsigned char)v;
+    }
+
+    if (n - i >= 2)
+    {
+        const uint32_t a = sdlang_base64_value[s[i]], b = sdlang_base64_value[s[i + 1]];
+        const uint32_t c = n - i == 3 ? sdlang_base64_value[s[i + 2]] : 0;
+        const uint32_t v = (a << 18) | (b << 12) | (c << 6);
+
+        if ((a | b | c) & 0x80)
+        {
+            return -1;
+        }
+
+        *d++ = (unsigned char)(v >> 16);
+
+        if (n - i == 3)
+        {
+            *d++ = (unsigned char)(v >> 8);
+        }
+    }
+
+    return (int)(d - dst);
+}
+
+static void sdlang_report_error(enum sdlang_error_t error, int line)
+{
+    (void)error;
+    (void)line;
+}
+
+static void (*sdlang_user_report_error)(enum sdlang_error_t error, int line) = sdlang_report_error;
+
+void sdlang_set_report_error(void (*report_error)(enum sdlang_error_t error, int line))
+{
+    sdlang_user_report_error = report_error != NULL ? report_error : sdlang_report_error;
+}
+
+/*
+    String unescaping.
+*/
+
+static const char* sdlang_skip_newline(const char* s, const char* e)
+{
+    /* line continuation, skips the line break and leading blanks */
+    if (*s == '\r' && s + 1 != e && s[1] == '\n')
+    {
+        ++s;
+    }
+
+    for (++s; s != e && (*s == ' ' || *s == '\t'); ++s)
+    {
+    }
+
+    return s;
+}
+
+int sdlang_decode_string(const char* src, int len, char* dst)
+{
+    const char *s = src, *e = src + len;
+    char* d = dst;
+
+    while (s != e)
+    {
+        /* copies the run up to the next backslash in one go */
+        const char* esc = sdlang_skip(s, e, '\\', '\\', '\\', '\\', false);
+
+        SDLANG_MEMMOVE(d, s, esc - s);
+        d += esc - s;
+
+        if (esc == e)
+        {
+            break;
+        }
+
+        if (esc + 1 == e)
+        {
+            /* a trailing backslash is kept */
+            *d++ = '\\';
+            break;
+        }
+
+        s = esc + 1;
+
+        switch (*s)
+        {
+        case 'n':
+            *d++ = '\n';
+            ++s;
+            break;
+
+        case 'r':
+            *d++ = '\r';
+            ++s;
+            break;
+
+        case 't':
+            *d++ = '\t';
+            ++s;
+            break;
+
+        case '\r':
+        case '\n':
+            s = sdlang_skip_newline(s, e);
+            break;
+
+        default:
+            *d++ = *s++;
+            break;
+        }
+    }
+
+    return (int)(d - dst);
+}
+
+int32_t sdlang_token_i32(const struct sdlang_token_t* token)
+{
+    return sdlang_decode_i32(token->string.from, token->string.to);
+}
+
+int64_t sdlang_token_i64(const struct sdlang_token_t* token)
+{
+    /* strip 'L' suffix */
+    return sdlang_decode_i64(token->string.from, token->string.to - 1);
+}
+
+void sdlang_token_i128(const struct sdlang_token_t* token, int64_t* hi, uint64_t* lo)
+{
+    sdlang_decode_i128(token->string.from, token->string.to, hi, lo);
+}
+
+uint64_t sdlang_token_u64(const struct sdlang_token_t* token)
+{
+    return sdlang_decode_hex(token->string.from, token->string.to);
+}
+
+float sdlang_token_f32(const struct sdlang_token_t* token)
+{
+    /* strip 'f' suffix, float64 tokens are rounded to float once */
+    return sdlang_decode_f32(token->string.from, token->string.to - (token->type == SDLANG_TOKEN_FLOAT32));
+}
+
+double sdlang_token_f64(const struct sdlang_token_t* token)
+{
+    return sdlang_decode_f64(token->string.from, token->string.to);
+}
+
+/*
+    Symbol table.
+
+    Names are kept in a chain of pool chunks which never move, so that
+    callbacks can hold on to them. Slots hold ids, with linear probing at a
+    load factor of at most 1/2.
+*/
+
+static void* sdlang_default_alloc(void* ptr, size_t size, void* user)
+{
+    (void)user;
+
+    if (size == 0)
+    {
+        free(ptr);
+        return NULL;
+    }
+
+    return realloc(ptr, size);
+}
+
+static uint32_t sdlang_hash(const char* s, size_t len)
+{
+    uint64_t h = 0x9e3779b97f4a7c15ull ^ len, w;
+
+    for (; len >= 8; s += 8, len -= 8)
+    {
+        SDLANG_MEMMOVE(&w, s, 8);
+        h = (h ^ w) * 0xff51afd7ed558ccdull;
+        h ^= h >> 32;
+    }
+
+    if (len > 0)
+    {
+        w = 0;
+        SDLANG_MEMMOVE(&w, s, len);
+        h = (h ^ w) * 0xff51afd7ed558ccdull;
+    }
+
+    h ^= h >> 29;
+    h *= 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 32;
+
+    return (uint32_t)h;
+}
+
+void sdlang_symbols_init(struct sdlang_symbols_t* symbols, const struct sdlang_allocator_t* allocator)
+{
+    *symbols = (struct sdlang_symbols_t) { 0 };
+    symbols->allocator = allocator != NULL
+        ? *allocator : (struct sdlang_allocator_t) { sdlang_default_alloc, NULL };
+}
+
+void sdlang_symbols_release(struct sdlang_symbols_t* symbols)
+{
+    const struct sdlang_allocator_t allocator = symbols->allocator;
+    char* chunk = symbols->chunk;
+
+    while (chunk != NULL)
+    {
+        char* prev;
+        SDLANG_MEMMOVE(&prev, chunk, sizeof(prev));
+        (*allocator.alloc)(chunk, 0, allocator.user);
+        chunk = prev;
+    }
+
+    if (symbols->slots != NULL)
+    {
+        (*allocator.alloc)(symbols->slots, 0, allocator.user);
+    }
+
+    if (symbols->entries != NULL)
+    {
+        (*allocator.alloc)(symbols->entries, 0, allocator.user);
+    }
+
+    sdlang_symbols_init(symbols, &allocator);
+}
+
+static bool sdlang_symbols_grow(struct sdlang_symbols_t* symbols)
+{
+    /* doubles both the slots and the entries, then rehashes */
+    const uint32_t capacity = symbols->capacity > 0 ? symbols->capacity * 2 : 64;
+    uint32_t* slots;
+    void* entries;
+
+    slots = (*symbols->allocator.alloc)(NULL, capacity * sizeof(uint32_t), symbols->allocator.user);
+
+    if (slots == NULL)
+    {
+        return false;
+    }
+
+    entries = (*symbols->allocator.alloc)(symbols->entries,
+        (capacity / 2 + 1) * sizeof(symbols->entries[0]), symbols->allocator.user);
+
+    if (entries == NULL)
+    {
+        (*symbols->allocator.alloc)(slots, 0, symbols->allocator.user);
+        return false;
+    }
+
+    symbols->entries = entries;
+
+    for (uint32_t i = 0; i < capacity; ++i)
+    {
+        slots[i] = 0;
+    }
+
+    for (uint32_t id = 1; id <= symbols->count; ++id)
+    {
+        uint32_t i = symbols->entries[id].hash & (capacity - 1);
+
+        while (slots[i] != 0)
+        {
+            i = (i + 1) & (capacity - 1);
+        }
+
+        slots[i] = id;
+    }
+
+    if (symbols->slots != NULL)
+    {
+        (*symbols->allocator.alloc)(symbols->slots, 0, symbols->allocator.user);
+    }
+
+    symbols->slots = slots;
+    symbols->capacity = capacity;
+
+    return true;
+}
+
+static const char* sdlang_symbols_store(struct sdlang_symbols_t* symbols,
+                                        const char* name, size_t len)
+{
+    const size_t size = len + 1;
+    char* dst;
+
+    if (symbols->chunk == NULL || symbols->chunk_used + size > symbols->chunk_size)
+    {
+        const size_t head = sizeof(char*);
+        const size_t chunk_size = head + size > 4096 ? head + size : 4096;
+        char* chunk = (*symbols->allocator.alloc)(NULL, chunk_size, symbols->allocator.user);
+
+        if (chunk == NULL)
+        {
+            return NULL;
+        }
+
+        SDLANG_MEMMOVE(chunk, &symbols->chunk, sizeof(char*));
+        symbols->chunk = chunk;
+        symbols->chunk_used = head;
+        symbols->chunk_size = chunk_size;
+    }
+
+    dst = symbols->chunk + symbols->chunk_used;
+    symbols->chunk_used += size;
+
+    SDLANG_MEMMOVE(dst, name, len);
+    dst[len] = '\0';
+
+    return dst;
+}
+
+uint32_t sdlang_symbols_intern(struct sdlang_symbols_t* symbols, const char* name, size_t len)
+{
+    const uint32_t hash = sdlang_hash(name, len);
+    uint32_t i, id;
+
+    if (symbols->count >= symbols->capacity / 2 && !sdlang_symbols_grow(symbols))
+    {
+        return 0;
+    }
+
+    for (i = hash & (symbols->capacity - 1); (id = symbols->slots[i]) != 0;
+         i = (i + 1) & (symbols->capacity - 1))
+    {
+        if (symbols->entries[id].hash == hash && symbols->entries[id].length == len
+            && memcmp(symbols->entries[id].name, name, len) == 0)
+        {
+            return id;
+        }
+    }
+
+    id = symbols->count + 1;
+
+    if ((symbols->entries[id].name = sdlang_symbols_store(symbols, name, len)) == NULL)
+    {
+        return 0;
+    }
+
+    symbols->entries[id].hash = hash;
+    symbols->entries[id].length = (uint32_t)len;
+    symbols->slots[i] = id;
+    symbols->count = id;
+
+    return id;
+}
+
+const char* sdlang_symbols_name(const struct sdlang_symbols_t* symbols, uint32_t id)
+{
+    return id != 0 && id <= symbols->count ? symbols->entries[id].name : NULL;
+}
 
 static struct sdlang_functions_t* sdlang_user_emit_functions = NULL;
 
-void sdlang_set_emit_functions(struct sdlang_functions_t* emit_functions)
+void sdlang_set_emit_functions(struct sdlang_functions_t* emit_functions)
+{
+    if (emit_functions != NULL)
+    {
+        emit_functions->node = NULL;
+        emit_functions->attr = NULL;
+        emit_functions->node_symbol = 0;
+        emit_functions->attr_symbol = 0;
+        emit_functions->node_name[0] = '\0';
+        emit_functions->attr_name[0] = '\0';
+    }
+
+    sdlang_user_emit_functions = emit_functions;
+}
+
+static void* sdlang_parser_scratch(struct sdlang_parser_t* parser, size_t size)
+{
+    /* grows the buffer for decoded string and binary values */
+    size_t capacity = parser->scratch_capacity > 0 ? parser->scratch_capacity : SDLANG_PARSE_BUFFERSIZE;
+    void* scratch;
+
+    if (size <= parser->scratch_capacity)
+    {
+        return parser->scratch;
+    }
+
+    if (parser->allocator.alloc == NULL)
+    {
+        return NULL;
+    }
+
+    while (capacity < size)
+    {
+        capacity *= 2;
+    }
+
+    scratch = (*parser->allocator.alloc)(parser->scratch, capacity, parser->allocator.user);
+
+    if (scratch != NULL)
+    {
+        parser->scratch = scratch;
+        parser->scratch_capacity = capacity;
+    }
+
+    return scratch;
+}
+
+static const char* sdlang_node_name(const struct sdlang_functions_t* vtbl)
+{
+    /* interned name, or the local copy */
+    return vtbl->node != NULL ? vtbl->node : vtbl->node_name;
+}
+
+static const char* sdlang_attr_name(const struct sdlang_functions_t* vtbl)
+{
+    return vtbl->attr != NULL ? vtbl->attr : vtbl->attr_name;
+}
+
+static void sdlang_deliver_text(struct sdlang_parser_t* parser, struct sdlang_functions_t* vtbl,
+                                const char* ptr, int len, void* user)
+{
+    /* without a function table, the parser's version 2 table is used */
+    if (vtbl != NULL)
+    {
+        vtbl->value_text(sdlang_node_name(vtbl), sdlang_attr_name(vtbl), ptr, len, user);
+    }
+    else
+    {
+        parser->functions_v2.value_text(parser->node, parser->attr, ptr, len, user);
+    }
+}
+
+static void sdlang_emit_text(struct sdlang_parser_t* parser, struct sdlang_functions_t* vtbl,
+                             const struct sdlang_token_t* token, void* user)
+{
+    /*
+        strings without escapes are passed in place, which includes
+        backquoted strings, as these are taken literally
+    */
+    char local[SDLANG_PARSE_BUFFERSIZE];
+    char* text = local;
+    const char *s = token->string.from, *e = token->string.to;
+    const char* esc = token->raw ? e : sdlang_skip(s, e, '\\', '\\', '\\', '\\', false);
+    const int len = (int)(e - s);
+
+    if (esc == e)
+    {
+        sdlang_deliver_text(parser, vtbl, s, len, user);
+        return;
+    }
+
+    if ((size_t)len > sizeof(local))
+    {
+        text = parser != NULL ? sdlang_parser_scratch(parser, len) : NULL;
+    }
+
+    if (text == NULL)
+    {
+        (*(parser != NULL ? parser->report_error : sdlang_user_report_error))(
+            SDLANG_PARSE_ERROR_BUFFER_TOO_SMALL, token->line);
+        return;
+    }
+
+    /* the part before the first backslash is known to be plain */
+    SDLANG_MEMMOVE(text, s, esc - s);
+    sdlang_deliver_text(parser, vtbl, text,
+                        (int)(esc - s) + sdlang_decode_string(esc, (int)(e - esc), text + (esc - s)), user);
+}
+
+static void sdlang_emit_binary(struct sdlang_parser_t* parser, struct sdlang_functions_t* vtbl,
+                               const struct sdlang_token_t* token, void* user)
+{
+    /*
+        small payloads are decoded on the stack, anything larger needs
+        a parser context with an allocator
+    */
+    unsigned char local[SDLANG_PARSE_BINARYSIZE];
+    unsigned char* binary = local;
+    const int len = (int)(token->string.to - token->string.from);
+    const size_t size = (size_t)(len + 3) / 4 * 3;
+    int err = SDLANG_PARSE_OK, n;
+
+    if (size > sizeof(local))
+    {
+        binary = parser != NULL ? (unsigned char*)sdlang_parser_scratch(parser, size) : NULL;
+    }
+
+    if (binary == NULL)
+    {
+        err = SDLANG_PARSE_ERROR_BUFFER_TOO_SMALL;
+    }
+    else if ((n = sdlang_decode_base64(token->string.from, len, binary)) < 0)
+    {
+        err = SDLANG_PARSE_ERROR_BASE64;
+    }
+    else
+    {
+        if (vtbl != NULL)
+        {
+            vtbl->value_binary(sdlang_node_name(vtbl), sdlang_attr_name(vtbl), binary, n, user);
+        }
+        else
+        {
+            parser->functions_v2.value_binary(parser->node, parser->attr, binary, n, user);
+        }
+    }
+
+    if (err != SDLANG_PARSE_OK)
+    {
+        (*(parser != NULL ? parser->report_error : sdlang_user_report_error))(err, token->line);
+    }
+}
+
+static void sdlang_emit_functions(struct sdlang_parser_t* parser, struct sdlang_functions_t* vtbl,
+                                  const struct sdlang_token_t* token, void* user)
+{
+    const char* value = token->string.from;
+    const int len = (const int)(token->string.to - value);
+
+#define size_minus_one(dst) \
+    ((int)sizeof(vtbl->dst) - 1)
+
+#define safe_copy_value(dst) \
+    strncpy(vtbl->dst, value, len < size_minus_one(dst) ? len : size_minus_one(dst)); \
+    vtbl->dst[len < size_minus_one(dst) ? len : size_minus_one(dst)] = '\0'
+
+#define safe_set_name(name) \
+    vtbl->name = token->symbol != 0 && parser != NULL && parser->symbols != NULL \
+        ? sdlang_symbols_name(parser->symbols, token->symbol) : NULL; \
+    vtbl->name##_symbol = token->symbol; \
+    if (vtbl->name == NULL) { safe_copy_value(name##_name); }
+
+#define safe_call(fn, params) \
+    if (vtbl->fn != NULL) vtbl->fn params
+
+#define safe_clear_attr() \
+    vtbl->attr = NULL; \
+    vtbl->attr_symbol = 0; \
+    vtbl->attr_name[0] = '\0'
+
+#define safe_emit_value(fn, ...) \
+    if (vtbl->value_##fn != NULL) vtbl->value_##fn(sdlang_node_name(vtbl), sdlang_attr_name(vtbl), __VA_ARGS__); \
+    safe_clear_attr();
+
+    switch (token->type)
+    {
+    case SDLANG_TOKEN_NODE:
+        {
+            safe_set_name(node);
+        }
+        break;
+
+    case SDLANG_TOKEN_NODE_END:
+        {
+            vtbl->node = NULL;
+            vtbl->node_symbol = 0;
+            vtbl->node_name[0] = '\0';
+        }
+        break;
+
+    case SDLANG_TOKEN_BLOCK:
+        {
+            safe_call(block_begin, (sdlang_node_name(vtbl), user));
+        }
+        break;
+
+    case SDLANG_TOKEN_BLOCK_END:
+        {
+            safe_call(block_end, (user));
+        }
+        break;
+
+    case SDLANG_TOKEN_ATTRIBUTE:
+        {
+            /* store attribute name */
+            safe_set_name(attr);
+        }
+        break;
+
+    case SDLANG_TOKEN_INT32:
+        {
+            const int32_t l = sdlang_decode_i32(value, token->string.to);
+            safe_emit_value(i32, l, user);
+        }
+        break;
+
+    case SDLANG_TOKEN_INT64:
+        {
+            /* strip 'L' suffix */
+            const int64_t ll = sdlang_decode_i64(value, token->string.to - 1);
+            safe_emit_value(i64, ll, user);
+        }
+        break;
+
+    case SDLANG_TOKEN_INT128:
+        {
+            int64_t hi;
+            uint64_t lo;
+
+            sdlang_decode_i128(value, token->string.to, &hi, &lo);
+
+#ifdef SDLANG_HAVE_INT128
+            if (vtbl->value_i128_native != NULL)
+            {
+                const sdlang_int128_t i128 =
+                    (sdlang_int128_t)(((sdlang_uint128_t)(uint64_t)hi << 64) | lo);
+                vtbl->value_i128_native(sdlang_node_name(vtbl), sdlang_attr_name(vtbl), i128, user);
+            }
+#endif
+
+            safe_emit_value(i128, hi, lo, user);
+        }
+        break;
+
+    case SDLANG_TOKEN_FLOAT32:
+        {
+            /* strip 'f' suffix */
+            const float f = sdlang_decode_f32(value, token->string.to - 1);
+            safe_emit_value(f32, f, user);
+        }
+        break;
+
+    case SDLANG_TOKEN_FLOAT64:
+        {
+            const double d = sdlang_decode_f64(value, token->string.to);
+            safe_emit_value(f64, d, user);
+        }
+        break;
+
+    case SDLANG_TOKEN_STRING:
+        {
+            /* value_text takes the place of value_string */
+            if (vtbl->value_text != NULL)
+            {
+                sdlang_emit_text(parser, vtbl, token, user);
+                safe_clear_attr();
+            }
+            else
+            {
+                safe_emit_value(string, value, len, user);
+            }
+        }
+        break;
+
+    case SDLANG_TOKEN_BASE64:
+        {
+            /* value_binary takes the place of value_base64 */
+            if (vtbl->value_binary != NULL)
+            {
+                sdlang_emit_binary(parser, vtbl, token, user);
+                safe_clear_attr();
+            }
+            else
+            {
+                safe_emit_value(base64, value, len, user);
+            }
+        }
+        break;
+
+    case SDLANG_TOKEN_UINT32:
+        {
+            const uint32_t ul = (uint32_t)sdlang_decode_hex(value, token->string.to);
+            safe_emit_value(u32, ul, user);
+        }
+        break;
+
+    case SDLANG_TOKEN_UINT64:
+        {
+            const uint64_t ull = sdlang_decode_hex(value, token->string.to);
+            safe_emit_value(u64, ull, user);
+        }
+        break;
+
+    case SDLANG_TOKEN_TRUE:
+        {
+            safe_emit_value(bool, true, user);
+        }
+        break;
+
+    case SDLANG_TOKEN_FALSE:
+        {
+            safe_emit_value(bool, false, user);
+        }
+        break;
+
+    case SDLANG_TOKEN_NULL:
+        {
+            safe_emit_value(null, user);
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+void sdlang_emit_token(const struct sdlang_token_t* token, void* user)
+{
+    if (sdlang_user_emit_functions != NULL)
+    {
+        sdlang_emit_functions(NULL, sdlang_user_emit_functions, token, user);
+    }
+}
+
+static void (*sdlang_user_emit_token)(const struct sdlang_token_t*, void*) = sdlang_emit_token;
+
+void sdlang_set_emit_token(void (*emit_token)(const struct sdlang_token_t* token, void* user))
+{
+    sdlang_user_emit_token = emit_token != NULL ? emit_token : sdlang_emit_token;
+}
+
+static enum sdlang_control_t (*sdlang_user_emit_control)(const struct sdlang_token_t*, void*) = NULL;
+
+void sdlang_set_emit_control(enum sdlang_control_t (*emit_control)(const struct sdlang_token_t* token, void* user))
+{
+    sdlang_user_emit_control = emit_control;
+}
+
+void sdlang_parser_emit_token(struct sdlang_parser_t* parser,
+                              const struct sdlang_token_t* token, void* user)
+{
+    sdlang_emit_functions(parser, &parser->functions, token, user);
+}
+
+static struct sdlang_name_t sdlang_name(const struct sdlang_parser_t* parser,
+                                        const struct sdlang_token_t* token)
+{
+    /* interned name if there's a symbol table, or a view into the input */
+    const char* interned = token->symbol != 0 && parser->symbols != NULL
+        ? sdlang_symbols_name(parser->symbols, token->symbol) : NULL;
+
+    return (struct sdlang_name_t) {
+        .ptr = interned != NULL ? interned : token->string.from,
+        .len = (uint32_t)(token->string.to - token->string.from),
+        .symbol = interned != NULL ? token->symbol : 0
+    };
+}
+
+static void sdlang_emit_functions_v2(struct sdlang_parser_t* parser,
+                                     const struct sdlang_token_t* token, void* user)
+{
+    const struct sdlang_functions_v2_t* vtbl = &parser->functions_v2;
+    const struct sdlang_name_t none = { "", 0, 0 };
+    const char* value = token->string.from;
+    const int len = (const int)(token->string.to - value);
+
+#define safe_emit_value_v2(fn, ...) \
+    if (vtbl->value_##fn != NULL) vtbl->value_##fn(parser->node, parser->attr, __VA_ARGS__); \
+    parser->attr = none;
+
+    switch (token->type)
+    {
+    case SDLANG_TOKEN_NODE:
+        {
+            parser->node = sdlang_name(parser, token);
+        }
+        break;
+
+    case SDLANG_TOKEN_NODE_END:
+        {
+            parser->node = none;
+        }
+        break;
+
+    case SDLANG_TOKEN_BLOCK:
+        {
+            safe_call(block_begin, (parser->node, user));
+        }
+        break;
+
+    case SDLANG_TOKEN_BLOCK_END:
+        {
+            safe_call(block_end, (user));
+            parser->node = none;
+        }
+        break;
+
+    case SDLANG_TOKEN_ATTRIBUTE:
+        {
+            parser->attr = sdlang_name(parser, token);
+        }
+        break;
+
+    case SDLANG_TOKEN_INT32:
+        {
+            const int32_t l = sdlang_decode_i32(value, token->string.to);
+            safe_emit_value_v2(i32, l, user);
+        }
+        break;
+
+    case SDLANG_TOKEN_INT64:
+        {
+            /* strip 'L' suffix */
+            const int64_t ll = sdlang_decode_i64(value, token->string.to - 1);
+            safe_emit_value_v2(i64, ll, user);
+        }
+        break;
+
+    case SDLANG_TOKEN_INT128:
+        {
+            int64_t hi;
+            uint64_t lo;
+
+            sdlang_decode_i128(value, token->string.to, &hi, &lo);
+
+#ifdef SDLANG_HAVE_INT128
+            if (vtbl->value_i128_native != NULL)
+            {
+                const sdlang_int128_t i128 =
+                    (sdlang_int128_t)(((sdlang_uint128_t)(uint64_t)hi << 64) | lo);
+                vtbl->value_i128_native(parser->node, parser->attr, i128, user);
+            }
+#endif
+
+            safe_emit_value_v2(i128, hi, lo, user);
+        }
+        break;
+
+    case SDLANG_TOKEN_FLOAT32:
+        {
+            /* strip 'f' suffix */
+            const float f = sdlang_decode_f32(value, token->string.to - 1);
+            safe_emit_value_v2(f32, f, user);
+        }
+        break;
+
+    case SDLANG_TOKEN_FLOAT64:
+        {
+            const double d = sdlang_decode_f64(value, token->string.to);
+            safe_emit_value_v2(f64, d, user);
+        }
+        break;
+
+    case SDLANG_TOKEN_STRING:
+        {
+            if (vtbl->value_text != NULL)
+            {
+                sdlang_emit_text(parser, NULL, token, user);
+                parser->attr = none;
+            }
+            else
+            {
+                safe_emit_value_v2(string, value, len, user);
+            }
+        }
+        break;
+
+    case SDLANG_TOKEN_BASE64:
+        {
+            if (vtbl->value_binary != NULL)
+            {
+                sdlang_emit_binary(parser, NULL, token, user);
+                parser->attr = none;
+            }
+            else
+            {
+                safe_emit_value_v2(base64, value, len, user);
+            }
+        }
+        break;
+
+    case SDLANG_TOKEN_UINT32:
+        {
+            const uint32_t ul = (uint32_t)sdlang_decode_hex(value, token->string.to);
+            safe_emit_value_v2(u32, ul, user);
+        }
+        break;
+
+    case SDLANG_TOKEN_UINT64:
+        {
+            const uint64_t ull = sdlang_decode_hex(value, token->string.to);
+            safe_emit_value_v2(u64, ull, user);
+        }
+        break;
+
+    case SDLANG_TOKEN_TRUE:
+        {
+            safe_emit_value_v2(bool, true, user);
+        }
+        break;
+
+    case SDLANG_TOKEN_FALSE:
+        {
+            safe_emit_value_v2(bool, false, user);
+        }
+        break;
+
+    case SDLANG_TOKEN_NULL:
+        {
+            safe_emit_value_v2(null, user);
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+static void sdlang_batch_flush(struct sdlang_parser_t* parser)
+{
+    struct sdlang_batch_t* batch = parser->batch;
+
+    if (batch->count > 0)
+    {
+        (*batch->flush)(batch, parser->user);
+    }
+
+    batch->count = 0;
+    batch->base = NULL;
+}
+
+static void sdlang_batch_push(struct sdlang_parser_t* parser, enum sdlang_token_type_t type,
+                              const char* ts, const char* te, int line, bool raw)
+{
+    struct sdlang_batch_t* batch = parser->batch;
+    uint32_t i;
+
+    if (ts != NULL)
+    {
+        /* offsets are 32 bit */
+        if (batch->base != NULL && (size_t)(te - batch->base) > UINT32_MAX)
+        {
+            sdlang_batch_flush(parser);
+        }
+
+        if (batch->base == NULL)
+        {
+            batch->base = ts;
+        }
+    }
+
+    i = batch->count;
+    batch->types[i] = (uint8_t)type;
+    batch->offsets[i] = ts != NULL ? (uint32_t)(ts - batch->base) : 0;
+    batch->lengths[i] = ts != NULL ? (uint32_t)(te - ts) : 0;
+    batch->lines[i] = (uint32_t)line;
+
+    if (batch->raw != NULL)
+    {
+        batch->raw[i] = (uint8_t)raw;
+    }
+
+    if (++batch->count == batch->capacity)
+    {
+        sdlang_batch_flush(parser);
+    }
+}
+
+static bool sdlang_control(struct sdlang_parser_t* parser, const struct sdlang_token_t* token)
+{
+    /* returns true if the token is dropped */
+    switch ((*parser->emit_control)(parser, token, parser->user))
+    {
+    case SDLANG_SKIP:
+        if (token->type == SDLANG_TOKEN_BLOCK)
+        {
+            sdlang_begin_skip(parser);
+            return true;
+        }
+        return false;
+
+    case SDLANG_STOP:
+        parser->stopped = true;
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+static void sdlang_push_token(struct sdlang_parser_t* parser, enum sdlang_token_type_t type,
+                              const char* ts, const char* te, int line, bool raw)
+{
+    if (parser->stopped)
+    {
+        /* tokens completed at the end of the input after a stop */
+        return;
+    }
+
+    if (parser->batch != NULL)
+    {
+        sdlang_batch_push(parser, type, ts, te, line, raw);
+        return;
+    }
+
+    const struct sdlang_token_t token = {
+        .type = type,
+        .string = {
+            .from = ts,
+            .to = te
+        },
+        .line = line,
+        .raw = raw,
+        .symbol = (type == SDLANG_TOKEN_NODE || type == SDLANG_TOKEN_ATTRIBUTE) && parser->symbols != NULL
+            ? sdlang_symbols_intern(parser->symbols, ts, te - ts) : 0
+    };
+
+    if (parser->emit_control != NULL && sdlang_control(parser, &token))
+    {
+        return;
+    }
+
+    (*parser->emit_token)(parser, &token, parser->user);
+}
+
+static void emit(struct sdlang_parser_t* parser, enum sdlang_token_type_t type,
+                 const char* ts, const char* te, int line)
+{
+    bool raw = false;
+
+    switch (type)
+    {
+    case SDLANG_TOKEN_ATTRIBUTE:
+        /* strip trailing '=' */
+        --te;
+        break;
+
+    case SDLANG_TOKEN_INT32:
+    case SDLANG_TOKEN_INT64:
+    case SDLANG_TOKEN_FLOAT32:
+    case SDLANG_TOKEN_FLOAT64:
+        /* strip leading '+' */
+        if (*ts == '+')
+        {
+            ++ts;
+        }
+        break;
+
+    case SDLANG_TOKEN_INT128:
+        /* strip leading '+' and suffix */
+        if (*ts == '+')
+        {
+            ++ts;
+        }
+        te -= 2;
+        break;
+
+    case SDLANG_TOKEN_STRING:
+        /* strip delimiters, which tell how to read the string */
+        raw = *ts++ == '`';
+        --te;
+        break;
+
+    case SDLANG_TOKEN_BASE64:
+        /* strip delimiters */
+        ++ts;
+        --te;
+        break;
+
+    default:
+        break;
+    }
+
+    sdlang_push_token(parser, type, ts, te, line, raw);
+}
+
+void sdlang_parser_init(struct sdlang_parser_t* parser)
+{
+    parser->emit_token = sdlang_parser_emit_token;
+    parser->emit_control = NULL;
+    parser->report_error = sdlang_report_error;
+    parser->functions = (struct sdlang_functions_t) { 0 };
+    parser->functions_v2 = (struct sdlang_functions_v2_t) { 0 };
+    parser->user = NULL;
+    parser->node = parser->attr = (struct sdlang_name_t) { "", 0, 0 };
+    parser->buf = parser->buffer;
+    parser->capacity = SDLANG_PARSE_BUFFERSIZE;
+    parser->have = 0;
+    parser->error = SDLANG_PARSE_OK;
+    parser->scratch = NULL;
+    parser->scratch_capacity = 0;
+    parser->allocator = (struct sdlang_allocator_t) { 0 };
+    parser->symbols = NULL;
+    parser->batch = NULL;
+    parser->stats = (struct sdlang_stats_t) { 0 };
+    parser->threads = 1;
+}
+
+void sdlang_parser_set_emit_token(struct sdlang_parser_t* parser,
+    void (*emit_token)(struct sdlang_parser_t* parser,
+                       const struct sdlang_token_t* token, void* user))
+{
+    parser->emit_token = emit_token != NULL ? emit_token : sdlang_parser_emit_token;
+}
+
+void sdlang_parser_set_emit_control(struct sdlang_parser_t* parser,
+    enum sdlang_control_t (*emit_control)(struct sdlang_parser_t* parser,
+                                          const struct sdlang_token_t* token, void* user))
+{
+    parser->emit_control = emit_control;
+}
+
+void sdlang_parser_set_emit_functions(struct sdlang_parser_t* parser,
+                                      const struct sdlang_functions_t* emit_functions)
+{
+    parser->functions = emit_functions != NULL ? *emit_functions : (struct sdlang_functions_t) { 0 };
+    parser->functions.node = NULL;
+    parser->functions.attr = NULL;
+    parser->functions.node_symbol = 0;
+    parser->functions.attr_symbol = 0;
+    parser->functions.node_name[0] = '\0';
+    parser->functions.attr_name[0] = '\0';
+}
+
+void sdlang_parser_set_emit_functions_v2(struct sdlang_parser_t* parser,
+                                         const struct sdlang_functions_v2_t* emit_functions)
+{
+    parser->functions_v2 = emit_functions != NULL ? *emit_functions : (struct sdlang_functions_v2_t) { 0 };
+    parser->emit_token = emit_functions != NULL ? sdlang_emit_functions_v2 : sdlang_parser_emit_token;
+}
+
+void sdlang_parser_set_report_error(struct sdlang_parser_t* parser,
+    void (*report_error)(enum sdlang_error_t error, int line))
+{
+    parser->report_error = report_error != NULL ? report_error : sdlang_report_error;
+}
+
+void sdlang_parser_set_allocator(struct sdlang_parser_t* parser,
+                                 const struct sdlang_allocator_t* allocator)
+{
+    sdlang_parser_release(parser);
+    parser->allocator = allocator != NULL ? *allocator : (struct sdlang_allocator_t) { 0 };
+}
+
+void sdlang_parser_set_symbols(struct sdlang_parser_t* parser, struct sdlang_symbols_t* symbols)
+{
+    parser->symbols = symbols;
+}
+
+void sdlang_parser_set_batch(struct sdlang_parser_t* parser, struct sdlang_batch_t* batch)
+{
+    parser->batch = batch;
+
+    if (batch != NULL)
+    {
+        batch->count = 0;
+        batch->base = NULL;
+    }
+}
+
+void sdlang_parser_set_threads(struct sdlang_parser_t* parser, int threads)
+{
+#ifdef SDLANG_HAVE_THREADS
+    if (threads == 0)
+    {
+        const long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cpus > 0 ? (int)cpus : 1;
+    }
+
+    parser->threads = threads > 0 ? threads : 1;
+#else
+    (void)threads;
+    parser->threads = 1;
+#endif
+}
+
+void sdlang_parser_release(struct sdlang_parser_t* parser)
+{
+    if (parser->buf != parser->buffer)
+    {
+        (*parser->allocator.alloc)(parser->buf, 0, parser->allocator.user);
+    }
+
+    if (parser->scratch != NULL)
+    {
+        (*parser->allocator.alloc)(parser->scratch, 0, parser->allocator.user);
+    }
+
+    parser->buf = parser->buffer;
+    parser->capacity = SDLANG_PARSE_BUFFERSIZE;
+    parser->have = 0;
+    parser->scratch = NULL;
+    parser->scratch_capacity = 0;
+}
+
+static void check_stack_size(const char** p, const char* pe, int top, int line)
+{
+    if (top == SDLANG_PARSE_STACKSIZE - 1)
+    {
+        /*
+            trick the FSM into completing the current iteration,
+            then the main loop checks for the stack pointer
+        */
+        *p = pe - 1;
+    }
+}
+
+#ifdef SDLANG_HAVE_THREADS
+static int sdlang_parse_parallel(struct sdlang_parser_t* parser,
+                                 const char* buffer, size_t size, void* user);
+#endif
+
+/*
+    a control function may stop the parser from within a token action, in
+    which case the FSM is tricked into completing the current iteration like
+    above, and the main loop checks for the flag
+*/
+#define emit(parser, type, ts, te, line) \
+    (emit(parser, type, ts, te, line), p = (parser)->stopped ? pe - 1 : p)
+
+#include "sdlang.inl"
+
+#undef emit
+
+static void sdlang_global_emit_token(struct sdlang_parser_t* parser,
+                                     const struct sdlang_token_t* token, void* user)
+{
+    (void)parser;
+    (*sdlang_user_emit_token)(token, user);
+}
+
+static enum sdlang_control_t sdlang_global_emit_control(struct sdlang_parser_t* parser,
+                                                        const struct sdlang_token_t* token, void* user)
+{
+    (void)parser;
+    return (*sdlang_user_emit_control)(token, user);
+}
+
+static void sdlang_global_parser_init(struct sdlang_parser_t* parser)
+{
+    /* temporary parser context using the global callbacks */
+    sdlang_parser_init(parser);
+    parser->emit_token = sdlang_global_emit_token;
+    parser->emit_control = sdlang_user_emit_control != NULL ? sdlang_global_emit_control : NULL;
+    parser->report_error = sdlang_user_report_error;
+}
+
+int sdlang_parse(size_t (*stream)(void* ptr, size_t size, void* user), void* user)
+{
+    struct sdlang_parser_t parser;
+    sdlang_global_parser_init(&parser);
+    return sdlang_parser_parse(&parser, stream, user);
+}
+
+int sdlang_parse_buffer(const char* buffer, size_t size, void* user)
+{
+    struct sdlang_parser_t parser;
+    sdlang_global_parser_init(&parser);
+    return sdlang_parser_parse_buffer(&parser, buffer, size, user);
+}
+
+struct sdlang_fd_stream_t
+{
+    struct sdlang_parser_t* parser;
+    int fd;
+    bool failed;
+};
+
+static size_t read_fd(void* ptr, size_t size, void* user)
+{
+    /*
+        the parser treats a short read as end of input, so keep reading
+        until the buffer is full - pipes return partial chunks. A failed
+        read stops the parser, instead of ending the input where it failed.
+    */
+    struct sdlang_fd_stream_t* stream = user;
+    size_t total = 0;
+
+    while (total < size)
+    {
+        const int len = (int)sdlang_read_fd(stream->fd, (char*)ptr + total, size - total);
+
+        if (len < 0 && errno == EINTR)
+        {
+            continue;
+        }
+
+        if (len < 0)
+        {
+            stream->failed = true;
+            stream->parser->stopped = true;
+            break;
+        }
+
+        if (len == 0)
+        {
+            break;
+        }
+
+        total += len;
+    }
+
+    return total;
+}
+
+int sdlang_parser_parse_fd(struct sdlang_parser_t* parser, int fd, void* user)
+{
+#ifdef SDLANG_HAVE_MMAP
+    struct stat st;
+
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode))
+    {
+        const size_t size = (size_t)st.st_size;
+        void* map;
+        int err;
+
+        if (size == 0)
+        {
+            return sdlang_parser_parse_buffer(parser, "", 0, user);
+        }
+
+        map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if (map != MAP_FAILED)
+        {
+#ifdef MADV_SEQUENTIAL
+            madvise(map, size, MADV_SEQUENTIAL);
+#endif
+#ifdef MADV_WILLNEED
+            madvise(map, size, MADV_WILLNEED);
+#endif
+            err = sdlang_parser_parse_buffer(parser, (const char*)map, size, user);
+
+            munmap(map, size);
+
+            return err;
+        }
+    }
+#endif
+
+    /* pipes, sockets, or no mmap() support */
+    struct sdlang_fd_stream_t stream = { parser, fd, false };
+    const int err = sdlang_parse_stream(parser, read_fd, &stream, user);
+
+    if (stream.failed)
+    {
+        (*parser->report_error)(SDLANG_PARSE_ERROR_IO, parser->curline);
+        return SDLANG_PARSE_ERROR_IO;
+    }
+
+    return err;
+}
+
+int sdlang_parser_parse_file(struct sdlang_parser_t* parser, const char* path, void* user)
+{
+    const int fd = sdlang_open_fd(path);
+    int err;
+
+    if (fd < 0)
+    {
+        (*parser->report_error)(SDLANG_PARSE_ERROR_IO, 0);
+        return SDLANG_PARSE_ERROR_IO;
+    }
+
+    err = sdlang_parser_parse_fd(parser, fd, user);
+
+    sdlang_close_fd(fd);
+
+    return err;
+}
+
+int sdlang_parse_fd(int fd, void* user)
+{
+    struct sdlang_parser_t parser;
+    sdlang_global_parser_init(&parser);
+    return sdlang_parser_parse_fd(&parser, fd, user);
+}
+
+int sdlang_parse_file(const char* path, void* user)
+{
+    struct sdlang_parser_t parser;
+    sdlang_global_parser_init(&parser);
+    return sdlang_parser_parse_file(&parser, path, user);
+}
+
+/*
+    Parallel parsing.
+
+    The input is cut into chunks of roughly equal size. Each cut is looked
+    for near its target only, at the next line which starts with a name in
+    the first column, so finding them doesn't depend on the size of the
+    input. Workers run the state machine on each chunk with a parser of
+    their own, which starts at the top level, and record the tokens. The
+    calling thread passes the tokens on in order, adding the number of
+    lines before each chunk.
+
+    A chunk is only taken as parsed if the parser of the previous chunk
+    stopped between two top-level statements. Otherwise the cut was
+    wrong, say within a string or an unindented block, and that parser
+    goes on over the chunk, passing its tokens on directly - so the cuts
+    only have to be right in the common case.
+*/
+
+#ifdef SDLANG_HAVE_THREADS
+
+static const char* sdlang_find_split(const char* target, const char* pe)
+{
+    /*
+        returns the position after the first line break at or after
+        `target` which is followed by a name in the first column, or `pe` -
+        statements within blocks are usually indented, so this is most
+        likely where a top-level statement starts
+    */
+    const char* p = target;
+
+    while ((p = memchr(p, '\n', (size_t)(pe - p))) != NULL && ++p != pe)
+    {
+        if ((*p >= 'a' && *p <= 'z') || (*p >= 'A' && *p <= 'Z') || *p == '_')
+        {
+            return p;
+        }
+    }
+
+    return pe;
+}
+
+struct sdlang_record_t
+{
+    uint16_t type, raw;
+    uint32_t offset, length, line;
+};
+
+struct sdlang_records_t
+{
+    struct sdlang_record_t* data;
+    size_t count, capacity;
+};
+
+struct sdlang_chunk_t
+{
+    struct sdlang_parallel_t* parallel;
+    const char *from, *to;
+    struct sdlang_parser_t parser;
+
+    /* tokens, with offsets from `from` and lines counted from the chunk */
+    struct sdlang_records_t records;
+    bool failed;
+
+    /* tokens are passed on directly instead, with `base` added to lines */
+    bool direct;
+    int base;
+
+    bool done;
+};
+
+struct sdlang_parallel_t
+{
+    struct sdlang_parser_t* parser;
+    struct sdlang_allocator_t allocator;
+    const char *buffer, *eof;
+
+    /* chunks, the next one to claim, and the first one which can't be claimed yet */
+    struct sdlang_chunk_t* chunks;
+    size_t count, next, limit;
+    bool stop;
+
+    /* record buffers of chunks already passed on */
+    struct sdlang_records_t* spare;
+    size_t num_spare;
+
+    pthread_mutex_t mutex;
+    pthread_cond_t queued, done;
+};
+
+static void sdlang_chunk_emit(struct sdlang_parser_t* parser,
+                              const struct sdlang_token_t* token, void* user)
+{
+    struct sdlang_chunk_t* chunk = (struct sdlang_chunk_t*)user;
+    struct sdlang_records_t* records = &chunk->records;
+    const char* from = token->string.from;
+    struct sdlang_record_t* record;
+
+    (void)parser;
+
+    if (chunk->direct)
+    {
+        sdlang_push_token(chunk->parallel->parser, token->type, from, token->string.to,
+                          token->line + chunk->base, token->raw);
+        return;
+    }
+
+    if (chunk->failed)
+    {
+        return;
+    }
+
+    if (records->count == records->capacity)
+    {
+        const size_t capacity = records->capacity > 0 ? records->capacity * 2 : 4096;
+        const struct sdlang_allocator_t* allocator = &chunk->parallel->allocator;
+        void* data = (*allocator->alloc)(records->data, capacity * sizeof(struct sdlang_record_t),
+                                         allocator->user);
+
+        if (data == NULL)
+        {
+            chunk->failed = true;
+            return;
+        }
+
+        records->data = (struct sdlang_record_t*)data;
+        records->capacity = capacity;
+    }
+
+    /* offsets are 32 bit, with UINT32_MAX for tokens without a string */
+    if (from != NULL && (size_t)(token->string.to - chunk->from) >= UINT32_MAX)
+    {
+        chunk->failed = true;
+        return;
+    }
+
+    record = &records->data[records->count++];
+    record->type = (uint16_t)token->type;
+    record->raw = token->raw;
+    record->offset = from != NULL ? (uint32_t)(from - chunk->from) : UINT32_MAX;
+    record->length = from != NULL ? (uint32_t)(token->string.to - from) : 0;
+    record->line = (uint32_t)token->line;
+}
+
+static void sdlang_chunk_parse(struct sdlang_chunk_t* chunk)
+{
+    const char* eof = chunk->to == chunk->parallel->eof ? chunk->to : NULL;
+
+    sdlang_parser_begin(&chunk->parser, chunk);
+    sdlang_exec(&chunk->parser, chunk->from, chunk->to, eof);
+}
+
+static void sdlang_chunk_replay(struct sdlang_parser_t* parser,
+                                const struct sdlang_chunk_t* chunk, int base)
+{
+    for (size_t i = 0; i < chunk->records.count; ++i)
+    {
+        const struct sdlang_record_t* record = &chunk->records.data[i];
+        const char* from = record->offset != UINT32_MAX ? chunk->from + record->offset : NULL;
+
+        sdlang_push_token(parser, (enum sdlang_token_type_t)record->type,
+                          from, from != NULL ? from + record->length : NULL, (int)record->line + base,
+                          record->raw != 0);
+    }
+}
+
+static bool sdlang_top_level(const struct sdlang_parser_t* parser)
+{
+    /* between two statements of the top-level block, where a new parser can take over */
+    return parser->cs == sdlang_en_block && parser->top == 1 && parser->ts == 0;
+}
+
+static void* sdlang_parallel_worker(void* arg)
+{
+    struct sdlang_parallel_t* parallel = (struct sdlang_parallel_t*)arg;
+
+    pthread_mutex_lock(&parallel->mutex);
+
+    for (;;)
+    {
+        struct sdlang_chunk_t* chunk;
+
+        /* stays a few chunks ahead of the calling thread, which bounds the recorded tokens */
+        while (!parallel->stop && parallel->next < parallel->count && parallel->next >= parallel->limit)
+        {
+            pthread_cond_wait(&parallel->queued, &parallel->mutex);
+        }
+
+        if (parallel->stop || parallel->next == parallel->count)
+        {
+            break;
+        }
+
+        chunk = &parallel->chunks[parallel->next++];
+
+        if (parallel->num_spare > 0)
+        {
+            chunk->records = parallel->spare[--parallel->num_spare];
+        }
+
+        pthread_mutex_unlock(&parallel->mutex);
+
+        sdlang_chunk_parse(chunk);
+
+        pthread_mutex_lock(&parallel->mutex);
+        chunk->done = true;
+        pthread_cond_broadcast(&parallel->done);
+    }
+
+    pthread_mutex_unlock(&parallel->mutex);
+
+    return NULL;
+}
+
+static void sdlang_parallel_split(struct sdlang_parallel_t* parallel, size_t chunks)
+{
+    /* chunks of roughly equal size, with each cut found near its target */
+    const size_t size = (size_t)(parallel->eof - parallel->buffer);
+    const char* p = parallel->buffer;
+
+    parallel->count = 0;
+
+    while (p != parallel->eof)
+    {
+        struct sdlang_chunk_t* chunk = &parallel->chunks[parallel->count];
+        const char* target = parallel->buffer + size / chunks * (parallel->count + 1);
+
+        chunk->parallel = parallel;
+        chunk->from = p;
+        chunk->to = p = parallel->count + 1 < chunks
+            ? sdlang_find_split(target > p ? target : p, parallel->eof) : parallel->eof;
+        chunk->records = (struct sdlang_records_t) { 0 };
+        chunk->failed = chunk->direct = chunk->done = false;
+        chunk->base = 0;
+        sdlang_parser_init(&chunk->parser);
+        chunk->parser.emit_token = sdlang_chunk_emit;
+
+        ++parallel->count;
+    }
+}
+
+static bool sdlang_parallel_wait(struct sdlang_parallel_t* parallel, size_t i, bool* claimed)
+{
+    /*
+        waits for a chunk, and sets `claimed` if no worker started on it,
+        and the caller has to - returns false past the last chunk
+    */
+    pthread_mutex_lock(&parallel->mutex);
+
+    *claimed = i < parallel->count && parallel->next == i;
+
+    if (*claimed)
+    {
+        parallel->next = i + 1;
+    }
+
+    while (i < parallel->count && !*claimed && !parallel->chunks[i].done)
+    {
+        pthread_cond_wait(&parallel->done, &parallel->mutex);
+    }
+
+    pthread_mutex_unlock(&parallel->mutex);
+
+    return i < parallel->count;
+}
+
+static void sdlang_parallel_release(struct sdlang_parallel_t* parallel, size_t i, size_t limit)
+{
+    /* recycles the record buffer of a chunk, and lets the workers go on */
+    struct sdlang_chunk_t* chunk = &parallel->chunks[i];
+
+    pthread_mutex_lock(&parallel->mutex);
+
+    if (chunk->records.data != NULL && chunk->done)
+    {
+        chunk->records.count = 0;
+        parallel->spare[parallel->num_spare++] = chunk->records;
+        chunk->records = (struct sdlang_records_t) { 0 };
+    }
+
+    parallel->limit = limit;
+    pthread_cond_broadcast(&parallel->queued);
+    pthread_mutex_unlock(&parallel->mutex);
+}
+
+static void sdlang_parallel_free(struct sdlang_parallel_t* parallel, void* ptr)
+{
+    if (ptr != NULL)
+    {
+        (*parallel->allocator.alloc)(ptr, 0, parallel->allocator.user);
+    }
+}
+
+static int sdlang_parse_parallel(struct sdlang_parser_t* parser,
+                                 const char* buffer, size_t size, void* user)
+{
+    const size_t threads = (size_t)parser->threads;
+    const size_t chunks = size / SDLANG_PARSE_CHUNKSIZE;
+    const size_t ahead = 2 * threads;
+    struct sdlang_parallel_t parallel;
+    struct sdlang_parser_t* state = NULL;
+    pthread_t* workers;
+    size_t started = 0;
+    bool claimed;
+    int base = 0, err = SDLANG_PARSE_OK;
+
+    parallel.parser = parser;
+    parallel.allocator = parser->allocator.alloc != NULL
+        ? parser->allocator : (struct sdlang_allocator_t) { sdlang_default_alloc, NULL };
+    parallel.buffer = buffer;
+    parallel.eof = buffer + size;
+    parallel.next = parallel.num_spare = 0;
+    parallel.limit = ahead;
+    parallel.stop = false;
+
+    parallel.chunks = (struct sdlang_chunk_t*)(*parallel.allocator.alloc)(
+        NULL, chunks * sizeof(struct sdlang_chunk_t), parallel.allocator.user);
+    parallel.spare = (struct sdlang_records_t*)(*parallel.allocator.alloc)(
+        NULL, chunks * sizeof(struct sdlang_records_t), parallel.allocator.user);
+    workers = (pthread_t*)(*parallel.allocator.alloc)(
+        NULL, threads * sizeof(pthread_t), parallel.allocator.user);
+
+    if (parallel.chunks == NULL || parallel.spare == NULL || workers == NULL)
+    {
+        sdlang_parallel_free(&parallel, parallel.chunks);
+        sdlang_parallel_free(&parallel, parallel.spare);
+        sdlang_parallel_free(&parallel, workers);
+
+        return sdlang_parse_sequential(parser, buffer, size, user);
+    }
+
+    sdlang_parallel_split(&parallel, chunks);
+
+    pthread_mutex_init(&parallel.mutex, NULL);
+    pthread_cond_init(&parallel.queued, NULL);
+    pthread_cond_init(&parallel.done, NULL);
+
+    for (size_t i = 0; i < threads; ++i)
+    {
+        if (pthread_create(&workers[started], NULL, sdlang_parallel_worker, &parallel) == 0)
+        {
+            ++started;
+        }
+    }
+
+    sdlang_parser_begin(parser, user);
+
+    /* the calling thread only passes the tokens on, in order */
+    for (size_t i = 0; err == SDLANG_PARSE_OK && sdlang_parallel_wait(&parallel, i, &claimed); ++i)
+    {
+        struct sdlang_chunk_t* chunk = &parallel.chunks[i];
+
+        if (state == NULL || sdlang_top_level(state))
+        {
+            base += state != NULL ? state->curline - 1 : 0;
+
+            if (claimed || chunk->failed)
+            {
+                chunk->direct = true;
+                chunk->base = base;
+                sdlang_chunk_parse(chunk);
+            }
+            else
+            {
+                sdlang_chunk_replay(parser, chunk, base);
+            }
+
+            state = &chunk->parser;
+        }
+        else
+        {
+            /* the chunk starts within a statement, the current parser goes on */
+            struct sdlang_chunk_t* owner = (struct sdlang_chunk_t*)state->user;
+
+            owner->direct = true;
+            owner->base = base;
+            sdlang_exec(state, chunk->from, chunk->to, chunk->to == parallel.eof ? chunk->to : NULL);
+        }
+
+        err = sdlang_check_state(state);
+
+        sdlang_parallel_release(&parallel, i, i + 1 + ahead);
+    }
+
+    parser->curline = base + state->curline;
+    parser->stats.bytes_read = size;
+
+    pthread_mutex_lock(&parallel.mutex);
+    parallel.stop = true;
+    pthread_cond_broadcast(&parallel.queued);
+    pthread_mutex_unlock(&parallel.mutex);
+
+    for (size_t i = 0; i < started; ++i)
+    {
+        pthread_join(workers[i], NULL);
+    }
+
+    for (size_t i = 0; i < parallel.count; ++i)
+    {
+        sdlang_parallel_free(&parallel, parallel.chunks[i].records.data);
+    }
+
+    for (size_t i = 0; i < parallel.num_spare; ++i)
+    {
+        sdlang_parallel_free(&parallel, parallel.spare[i].data);
+    }
+
+    pthread_cond_destroy(&parallel.done);
+    pthread_cond_destroy(&parallel.queued);
+    pthread_mutex_destroy(&parallel.mutex);
+    sdlang_parallel_free(&parallel, workers);
+    sdlang_parallel_free(&parallel, parallel.spare);
+    sdlang_parallel_free(&parallel, parallel.chunks);
+
+    if (parser->batch != NULL)
+    {
+        sdlang_batch_flush(parser);
+    }
+
+    if (err != SDLANG_PARSE_OK)
+    {
+        (*parser->report_error)(err, parser->curline);
+    }
+
+    return err;
+}
+
+#endif
+
+/*
+    Parse jobs.
+
+    Each thread of the pool owns a range of jobs, and takes them from the
+    front. Once it runs dry, it steals the back half of the largest range
+    left, so threads only contend for a lock when one of them moves on to
+    another range.
+*/
+
+static void sdlang_job_run(const struct sdlang_parser_t* prototype, struct sdlang_job_t* job)
+{
+    struct sdlang_parser_t parser;
+
+    if (job->document != NULL)
+    {
+        const struct sdlang_allocator_t* allocator =
+            prototype->allocator.alloc != NULL ? &prototype->allocator : NULL;
+
+        job->result = job->path != NULL
+            ? sdlang_document_parse_file(job->document, job->path, allocator)
+            : sdlang_document_parse_buffer(job->document, job->buffer, job->size, allocator);
+
+        return;
+    }
+
+    sdlang_parser_init(&parser);
+    parser.emit_token = prototype->emit_token;
+    parser.emit_control = prototype->emit_control;
+    parser.report_error = prototype->report_error;
+    sdlang_parser_set_emit_functions(&parser, &prototype->functions);
+    parser.functions_v2 = prototype->functions_v2;
+    parser.allocator = prototype->allocator;
+
+    job->result = job->path != NULL
+        ? sdlang_parser_parse_file(&parser, job->path, job->user)
+        : sdlang_parser_parse_buffer(&parser, job->buffer, job->size, job->user);
+
+    sdlang_parser_release(&parser);
+}
+
+#ifdef SDLANG_HAVE_THREADS
+
+struct sdlang_pool_t;
+
+struct sdlang_range_t
+{
+    struct sdlang_pool_t* pool;
+    size_t begin, end;
+    pthread_mutex_t mutex;
+};
+
+struct sdlang_pool_t
+{
+    const struct sdlang_parser_t* prototype;
+    struct sdlang_job_t* jobs;
+    struct sdlang_range_t* ranges;
+    size_t count;
+};
+
+static bool sdlang_pool_take(struct sdlang_range_t* range, size_t* job)
+{
+    bool taken;
+
+    pthread_mutex_lock(&range->mutex);
+    taken = range->begin < range->end;
+
+    if (taken)
+    {
+        *job = range->begin++;
+    }
+
+    pthread_mutex_unlock(&range->mutex);
+
+    return taken;
+}
+
+static bool sdlang_pool_steal(struct sdlang_range_t* range)
+{
+    struct sdlang_pool_t* pool = range->pool;
+    struct sdlang_range_t* victim = NULL;
+    size_t left = 0, begin = 0, end = 0;
+
+    /* the victim can take jobs between the look and the steal, so the steal checks again */
+    for (size_t i = 0; i < pool->count; ++i)
+    {
+        struct sdlang_range_t* other = &pool->ranges[i];
+
+        pthread_mutex_lock(&other->mutex);
+
+        if (other != range && other->end - other->begin > left)
+        {
+            victim = other;
+            left = other->end - other->begin;
+        }
+
+        pthread_mutex_unlock(&other->mutex);
+    }
+
+    if (victim == NULL)
+    {
+        return false;
+    }
+
+    pthread_mutex_lock(&victim->mutex);
+
+    if (victim->begin < victim->end)
+    {
+        end = victim->end;
+        begin = victim->end -= (victim->end - victim->begin + 1) / 2;
+    }
+
+    pthread_mutex_unlock(&victim->mutex);
+
+    pthread_mutex_lock(&range->mutex);
+    range->begin = begin;
+    range->end = end;
+    pthread_mutex_unlock(&range->mutex);
+
+    /* an empty range means the race for the last job was lost, and the caller looks again */
+    return true;
+}
+
+static void* sdlang_pool_worker(void* arg)
+{
+    struct sdlang_range_t* range = (struct sdlang_range_t*)arg;
+    size_t job;
+
+    do
+    {
+        while (sdlang_pool_take(range, &job))
+        {
+            sdlang_job_run(range->pool->prototype, &range->pool->jobs[job]);
+        }
+    }
+    while (sdlang_pool_steal(range));
+
+    return NULL;
+}
+
+#endif
+
+int sdlang_parser_parse_jobs(const struct sdlang_parser_t* parser,
+    struct sdlang_job_t* jobs, size_t count)
+{
+    bool pooled = false;
+
+#ifdef SDLANG_HAVE_THREADS
+    const size_t threads = (size_t)parser->threads < count ? (size_t)parser->threads : count;
+
+    if (threads > 1)
+    {
+        const struct sdlang_allocator_t allocator = parser->allocator.alloc != NULL
+            ? parser->allocator : (struct sdlang_allocator_t) { sdlang_default_alloc, NULL };
+        struct sdlang_pool_t pool = { parser, jobs, NULL, threads };
+        pthread_t* workers;
+
+        pool.ranges = (struct sdlang_range_t*)(*allocator.alloc)(
+            NULL, threads * sizeof(struct sdlang_range_t), allocator.user);
+        workers = (pthread_t*)(*allocator.alloc)(NULL, threads * sizeof(pthread_t), allocator.user);
+
+        if (pool.ranges != NULL && workers != NULL)
+        {
+            size_t started = 0;
+
+            for (size_t i = 0; i < threads; ++i)
+            {
+                pool.ranges[i].pool = &pool;
+                pool.ranges[i].begin = count * i / threads;
+                pool.ranges[i].end = count * (i + 1) / threads;
+                pthread_mutex_init(&pool.ranges[i].mutex, NULL);
+            }
+
+            /*
+                the calling thread works on the first range, and steals
+                the ranges of threads which failed to start, if any
+            */
+            for (size_t i = 1; i < threads; ++i)
+            {
+                if (pthread_create(&workers[started], NULL, sdlang_pool_worker, &pool.ranges[i]) == 0)
+                {
+                    ++started;
+                }
+            }
+
+            sdlang_pool_worker(&pool.ranges[0]);
+
+            for (size_t i = 0; i < started; ++i)
+            {
+                pthread_join(workers[i], NULL);
+            }
+
+            for (size_t i = 0; i < threads; ++i)
+            {
+                pthread_mutex_destroy(&pool.ranges[i].mutex);
+            }
+
+            pooled = true;
+        }
+
+        if (pool.ranges != NULL)
+        {
+            (*allocator.alloc)(pool.ranges, 0, allocator.user);
+        }
+
+        if (workers != NULL)
+        {
+            (*allocator.alloc)(workers, 0, allocator.user);
+        }
+    }
+#endif
+
+    for (size_t i = 0; i < count && !pooled; ++i)
+    {
+        sdlang_job_run(parser, &jobs[i]);
+    }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (jobs[i].result != SDLANG_PARSE_OK)
+        {
+            return jobs[i].result;
+        }
+    }
+
+    return SDLANG_PARSE_OK;
+}
+
+/*
+    Document object model.
+
+    The builder appends nodes, values, attributes and strings to separate
+    vectors while tokens arrive. Values and attributes of a node are always
+    contiguous, because a node can't receive any more of them once another
+    node has been started. At the end, the vectors are moved into a single
+    arena, which is released with one call to the allocator.
+*/
+
+struct sdlang_vector_t
+{
+    char* data;
+    size_t size, capacity;
+};
+
+struct sdlang_builder_t
+{
+    struct sdlang_allocator_t allocator;
+    struct sdlang_vector_t nodes, values, attributes, strings;
+
+    /* node receiving values, or 0 */
+    uint32_t node;
+
+    /* pending attribute name */
+    bool attr;
+    uint32_t attr_name, attr_length;
+
+    /* open blocks, with the last child appended to each */
+    int depth;
+    struct
+    {
+        uint32_t parent, last;
+    } stack[SDLANG_PARSE_STACKSIZE + 1];
+
+    /* input stream, for sdlang_document_parse() */
+    size_t (*stream)(void* ptr, size_t size, void* user);
+    void* stream_user;
+
+    int error;
+};
+
+static void* sdlang_vector_push(struct sdlang_builder_t* builder,
+                                struct sdlang_vector_t* vector, size_t size)
+{
+    void* ptr;
+
+    if (vector->size + size > vector->capacity)
+    {
+        size_t capacity = vector->capacity > 0 ? vector->capacity : 4096;
+        char* data;
+
+        while (capacity < vector->size + size)
+        {
+            capacity *= 2;
+        }
+
+        /* all offsets and indices are 32 bit */
+        data = capacity <= UINT32_MAX
+            ? (*builder->allocator.alloc)(vector->data, capacity, builder->allocator.user)
+            : NULL;
+
+        if (data == NULL)
+        {
+            builder->error = SDLANG_PARSE_ERROR_BUFFER_TOO_SMALL;
+            return NULL;
+        }
+
+        vector->data = data;
+        vector->capacity = capacity;
+    }
+
+    ptr = vector->data + vector->size;
+    vector->size += size;
+
+    return ptr;
+}
+
+static bool sdlang_builder_string(struct sdlang_builder_t* builder,
+                                  const char* s, size_t len, uint32_t* offset)
+{
+    /* null-terminated copy in the string pool */
+    char* dst = sdlang_vector_push(builder, &builder->strings, len + 1);
+
+    if (dst == NULL)
+    {
+        return false;
+    }
+
+    SDLANG_MEMMOVE(dst, s, len);
+    dst[len] = '\0';
+    *offset = (uint32_t)(dst - builder->strings.data);
+
+    return true;
+}
+
+static void sdlang_builder_node(struct sdlang_builder_t* builder,
+                                const char* name, size_t len, int line)
+{
+    const uint32_t index = (uint32_t)(builder->nodes.size / sizeof(struct sdlang_node_t));
+    struct sdlang_node_t* nodes;
+    uint32_t offset;
+
+    if (!sdlang_builder_string(builder, name, len, &offset)
+        || sdlang_vector_push(builder, &builder->nodes, sizeof(struct sdlang_node_t)) == NULL)
+    {
+        return;
+    }
+
+    nodes = (struct sdlang_node_t*)builder->nodes.data;
+    nodes[index] = (struct sdlang_node_t) {
+        .name = offset,
+        .name_length = (uint32_t)len,
+        .parent = builder->stack[builder->depth].parent,
+        .line = (uint32_t)line
+    };
+
+    /* append to the parent's children */
+    nodes[nodes[index].parent].num_children += index != 0;
+
+    if (builder->stack[builder->depth].last != 0)
+    {
+        nodes[builder->stack[builder->depth].last].next_sibling = index;
+    }
+    else
+    {
+        nodes[nodes[index].parent].first_child = index;
+    }
+
+    builder->stack[builder->depth].last = index;
+    builder->node = index;
+}
+
+static struct sdlang_value_t* sdlang_builder_value(struct sdlang_builder_t* builder, int line)
+{
+    struct sdlang_node_t* node;
+    struct sdlang_value_t* value;
+
+    if (builder->node == 0)
+    {
+        /* anonymous node */
+        sdlang_builder_node(builder, "", 0, line);
+
+        if (builder->error != SDLANG_PARSE_OK)
+        {
+            return NULL;
+        }
+    }
+
+    node = (struct sdlang_node_t*)builder->nodes.data + builder->node;
+
+    if (builder->attr)
+    {
+        struct sdlang_attribute_t* attr =
+            sdlang_vector_push(builder, &builder->attributes, sizeof(struct sdlang_attribute_t));
+
+        if (attr == NULL)
+        {
+            return NULL;
+        }
+
+        if (node->num_attributes++ == 0)
+        {
+            node->attributes = (uint32_t)(attr - (struct sdlang_attribute_t*)builder->attributes.data);
+        }
+
+        attr->name = builder->attr_name;
+        attr->name_length = builder->attr_length;
+        builder->attr = false;
+        value = &attr->value;
+    }
+    else
+    {
+        value = sdlang_vector_push(builder, &builder->values, sizeof(struct sdlang_value_t));
+
+        if (value == NULL)
+        {
+            return NULL;
+        }
+
+        if (node->num_values++ == 0)
+        {
+            node->values = (uint32_t)(value - (struct sdlang_value_t*)builder->values.data);
+        }
+    }
+
+    value->length = 0;
+
+    return value;
+}
+
+static void sdlang_builder_data(struct sdlang_builder_t* builder,
+                                const struct sdlang_token_t* token)
+{
+    /* string and binary values, and 128 bit integers, go to the string pool */
+    const char *s = token->string.from, *e = token->string.to;
+    const int len = (int)(e - s);
+    struct sdlang_value_t* value;
+    char* dst;
+    uint32_t offset;
+    int n = 0;
+
+    switch (token->type)
+    {
+    case SDLANG_TOKEN_STRING:
+        if ((dst = sdlang_vector_push(builder, &builder->strings, (size_t)len + 1)) == NULL)
+        {
+            return;
+        }
+
+        n = token->raw ? (SDLANG_MEMMOVE(dst, s, len), len) : sdlang_decode_string(s, len, dst);
+        dst[n] = '\0';
+        break;
+
+    case SDLANG_TOKEN_BASE64:
+        if ((dst = sdlang_vector_push(builder, &builder->strings, (size_t)(len + 3) / 4 * 3)) == NULL)
+        {
+            return;
+        }
+
+        if ((n = sdlang_decode_base64(s, len, (unsigned char*)dst)) < 0)
+        {
+            builder->error = SDLANG_PARSE_ERROR_BASE64;
+            return;
+        }
+        break;
+
+    default:
+        {
+            /* 8 byte aligned {hi, lo} pair */
+            int64_t hi;
+            uint64_t lo;
+
+            builder->strings.size = (builder->strings.size + 7) & ~(size_t)7;
+
+            if ((dst = sdlang_vector_push(builder, &builder->strings, 16)) == NULL)
+            {
+                return;
+            }
+
+            sdlang_decode_i128(s, e, &hi, &lo);
+            SDLANG_MEMMOVE(dst, &hi, 8);
+            SDLANG_MEMMOVE(dst + 8, &lo, 8);
+            n = 16;
+        }
+        break;
+    }
+
+    /* give back what decoding didn't use */
+    offset = (uint32_t)(dst - builder->strings.data);
+    builder->strings.size = offset + n + (token->type == SDLANG_TOKEN_STRING);
+
+    if ((value = sdlang_builder_value(builder, token->line)) != NULL)
+    {
+        value->type = token->type == SDLANG_TOKEN_STRING ? SDLANG_VALUE_STRING
+            : token->type == SDLANG_TOKEN_BASE64 ? SDLANG_VALUE_BINARY : SDLANG_VALUE_I128;
+        value->length = (uint32_t)n;
+        value->data.offset = offset;
+    }
+}
+
+static void sdlang_builder_emit_token(struct sdlang_parser_t* parser,
+                                      const struct sdlang_token_t* token, void* user)
+{
+    struct sdlang_builder_t* builder = (struct sdlang_builder_t*)user;
+    const char *s = token->string.from, *e = token->string.to;
+    struct sdlang_value_t* value;
+
+    (void)parser;
+
+    if (builder->error != SDLANG_PARSE_OK)
+    {
+        return;
+    }
+
+    switch (token->type)
+    {
+    case SDLANG_TOKEN_NODE:
+        builder->attr = false;
+        sdlang_builder_node(builder, s, e - s, token->line);
+        return;
+
+    case SDLANG_TOKEN_NODE_END:
+        builder->node = 0;
+        builder->attr = false;
+        return;
+
+    case SDLANG_TOKEN_BLOCK:
+        if (builder->node == 0)
+        {
+            sdlang_builder_node(builder, "", 0, token->line);
+        }
+
+        builder->depth += 1;
+        builder->stack[builder->depth].parent = builder->node;
+        builder->stack[builder->depth].last = 0;
+        builder->node = 0;
+        builder->attr = false;
+        return;
+
+    case SDLANG_TOKEN_BLOCK_END:
+        builder->depth -= builder->depth > 0;
+        builder->node = 0;
+        builder->attr = false;
+        return;
+
+    case SDLANG_TOKEN_ATTRIBUTE:
+        builder->attr = sdlang_builder_string(builder, s, e - s, &builder->attr_name);
+        builder->attr_length = (uint32_t)(e - s);
+        return;
+
+    case SDLANG_TOKEN_STRING:
+    case SDLANG_TOKEN_BASE64:
+    case SDLANG_TOKEN_INT128:
+        sdlang_builder_data(builder, token);
+        return;
+
+    default:
+        break;
+    }
+
+    if ((value = sdlang_builder_value(builder, token->line)) == NULL)
+    {
+        return;
+    }
+
+    switch (token->type)
+    {
+    case SDLANG_TOKEN_INT32:
+        value->type = SDLANG_VALUE_I32;
+        value->data.i32 = sdlang_decode_i32(s, e);
+        break;
+
+    case SDLANG_TOKEN_INT64:
+        value->type = SDLANG_VALUE_I64;
+        value->data.i64 = sdlang_decode_i64(s, e - 1);
+        break;
+
+    case SDLANG_TOKEN_FLOAT32:
+        value->type = SDLANG_VALUE_F32;
+        value->data.f32 = sdlang_decode_f32(s, e - 1);
+        break;
+
+    case SDLANG_TOKEN_FLOAT64:
+        value->type = SDLANG_VALUE_F64;
+        value->data.f64 = sdlang_decode_f64(s, e);
+        break;
+
+    case SDLANG_TOKEN_UINT32:
+        value->type = SDLANG_VALUE_U32;
+        value->data.u32 = (uint32_t)sdlang_decode_hex(s, e);
+        break;
+
+    case SDLANG_TOKEN_UINT64:
+        value->type = SDLANG_VALUE_U64;
+        value->data.u64 = sdlang_decode_hex(s, e);
+        break;
+
+    case SDLANG_TOKEN_TRUE:
+    case SDLANG_TOKEN_FALSE:
+        value->type = SDLANG_VALUE_BOOL;
+        value->data.b = token->type == SDLANG_TOKEN_TRUE;
+        break;
+
+    default:
+        value->type = SDLANG_VALUE_NULL;
+        value->data.u64 = 0;
+        break;
+    }
+}
+
+static void sdlang_builder_release(struct sdlang_builder_t* builder)
+{
+    struct sdlang_vector_t* vectors[] = {
+        &builder->nodes, &builder->values, &builder->attributes, &builder->strings
+    };
+
+    for (size_t i = 0; i < sizeof(vectors) / sizeof(vectors[0]); ++i)
+    {
+        if (vectors[i]->data != NULL)
+        {
+            (*builder->allocator.alloc)(vectors[i]->data, 0, builder->allocator.user);
+        }
+    }
+}
+
+static void sdlang_document_begin(struct sdlang_document_t* doc, struct sdlang_builder_t* builder,
+                                  struct sdlang_parser_t* parser,
+                                  const struct sdlang_allocator_t* allocator)
+{
+    *doc = (struct sdlang_document_t) { 0 };
+    *builder = (struct sdlang_builder_t) { 0 };
+    builder->allocator = allocator != NULL
+        ? *allocator : (struct sdlang_allocator_t) { sdlang_default_alloc, NULL };
+
+    /* the root node, with an empty name at offset 0 */
+    sdlang_builder_node(builder, "", 0, 0);
+
+    sdlang_parser_init(parser);
+    sdlang_parser_set_emit_token(parser, sdlang_builder_emit_token);
+    sdlang_parser_set_report_error(parser, sdlang_user_report_error);
+    sdlang_parser_set_allocator(parser, &builder->allocator);
+}
+
+static int sdlang_document_end(struct sdlang_document_t* doc, struct sdlang_builder_t* builder,
+                               struct sdlang_parser_t* parser, int err)
+{
+    /* moves the vectors into a single arena */
+    const size_t nodes = (builder->nodes.size + 7) & ~(size_t)7;
+    const size_t values = (builder->values.size + 7) & ~(size_t)7;
+    const size_t attributes = (builder->attributes.size + 7) & ~(size_t)7;
+    char* arena = NULL;
+
+    sdlang_parser_release(parser);
+
+    if (err == SDLANG_PARSE_OK && builder->error != SDLANG_PARSE_OK)
+    {
+        err = builder->error;
+        (*sdlang_user_report_error)(err, parser->curline);
+    }
+
+    if (err == SDLANG_PARSE_OK)
+    {
+        arena = (*builder->allocator.alloc)(NULL, nodes + values + attributes + builder->strings.size,
+                                            builder->allocator.user);
+        err = arena != NULL ? SDLANG_PARSE_OK : SDLANG_PARSE_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    if (arena != NULL)
+    {
+        /* the root node and its name are always there */
+        SDLANG_MEMMOVE(arena, builder->nodes.data, builder->nodes.size);
+        SDLANG_MEMMOVE(arena + nodes + values + attributes, builder->strings.data, builder->strings.size);
+
+        if (builder->values.size > 0)
+        {
+            SDLANG_MEMMOVE(arena + nodes, builder->values.data, builder->values.size);
+        }
+
+        if (builder->attributes.size > 0)
+        {
+            SDLANG_MEMMOVE(arena + nodes + values, builder->attributes.data, builder->attributes.size);
+        }
+
+        doc->nodes = (const struct sdlang_node_t*)arena;
+        doc->values = (const struct sdlang_value_t*)(arena + nodes);
+        doc->attributes = (const struct sdlang_attribute_t*)(arena + nodes + values);
+        doc->strings = arena + nodes + values + attributes;
+        doc->num_nodes = (uint32_t)(builder->nodes.size / sizeof(struct sdlang_node_t));
+        doc->num_values = (uint32_t)(builder->values.size / sizeof(struct sdlang_value_t));
+        doc->num_attributes = (uint32_t)(builder->attributes.size / sizeof(struct sdlang_attribute_t));
+        doc->strings_size = (uint32_t)builder->strings.size;
+        doc->arena = arena;
+        doc->arena_size = nodes + values + attributes + builder->strings.size;
+        doc->allocator = builder->allocator;
+    }
+
+    sdlang_builder_release(builder);
+
+    return err;
+}
+
+static size_t sdlang_builder_stream(void* ptr, size_t size, void* user)
+{
+    struct sdlang_builder_t* builder = (struct sdlang_builder_t*)user;
+    return (*builder->stream)(ptr, size, builder->stream_user);
+}
+
+int sdlang_document_parse(struct sdlang_document_t* doc,
+    size_t (*stream)(void* ptr, size_t size, void* user), void* user,
+    const struct sdlang_allocator_t* allocator)
+{
+    struct sdlang_builder_t builder;
+    struct sdlang_parser_t parser;
+
+    sdlang_document_begin(doc, &builder, &parser, allocator);
+    builder.stream = stream;
+    builder.stream_user = user;
+
+    return sdlang_document_end(doc, &builder, &parser,
+        sdlang_parser_parse(&parser, sdlang_builder_stream, &builder));
+}
+
+int sdlang_document_parse_buffer(struct sdlang_document_t* doc,
+    const char* buffer, size_t size, const struct sdlang_allocator_t* allocator)
+{
+    struct sdlang_builder_t builder;
+    struct sdlang_parser_t parser;
+
+    sdlang_document_begin(doc, &builder, &parser, allocator);
+
+    return sdlang_document_end(doc, &builder, &parser,
+        sdlang_parser_parse_buffer(&parser, buffer, size, &builder));
+}
+
+int sdlang_document_parse_file(struct sdlang_document_t* doc,
+    const char* path, const struct sdlang_allocator_t* allocator)
+{
+    struct sdlang_builder_t builder;
+    struct sdlang_parser_t parser;
+
+    sdlang_document_begin(doc, &builder, &parser, allocator);
+
+    return sdlang_document_end(doc, &builder, &parser,
+        sdlang_parser_parse_file(&parser, path, &builder));
+}
+
+#ifdef SDLANG_HAVE_MMAP
+static void* sdlang_image_unmap(void* ptr, size_t size, void* user);
+#endif
+
+void sdlang_document_free(struct sdlang_document_t* doc)
+{
+#ifdef SDLANG_HAVE_MMAP
+    if (doc->arena != NULL && doc->allocator.alloc == sdlang_image_unmap)
+    {
+        munmap(doc->arena, doc->arena_size);
+    }
+    else
+#endif
+    if (doc->arena != NULL)
+    {
+        (*doc->allocator.alloc)(doc->arena, 0, doc->allocator.user);
+    }
+
+    *doc = (struct sdlang_document_t) { 0 };
+}
+
+const char* sdlang_document_name(const struct sdlang_document_t* doc, uint32_t node)
+{
+    return doc->strings + doc->nodes[node].name;
+}
+
+uint32_t sdlang_document_child(const struct sdlang_document_t* doc, uint32_t node, const char* name)
+{
+    uint32_t child = doc->nodes[node].first_child;
+
+    while (child != 0 && name != NULL && strcmp(doc->strings + doc->nodes[child].name, name) != 0)
+    {
+        child = doc->nodes[child].next_sibling;
+    }
+
+    return child;
+}
+
+uint32_t sdlang_document_next(const struct sdlang_document_t* doc, uint32_t node, const char* name)
+{
+    uint32_t next = doc->nodes[node].next_sibling;
+
+    while (next != 0 && name != NULL && strcmp(doc->strings + doc->nodes[next].name, name) != 0)
+    {
+        next = doc->nodes[next].next_sibling;
+    }
+
+    return next;
+}
+
+const struct sdlang_value_t* sdlang_document_value(const struct sdlang_document_t* doc,
+                                                   uint32_t node, uint32_t index)
+{
+    const struct sdlang_node_t* n = &doc->nodes[node];
+    return index < n->num_values ? &doc->values[n->values + index] : NULL;
+}
+
+const struct sdlang_value_t* sdlang_document_attribute(const struct sdlang_document_t* doc,
+                                                       uint32_t node, const char* name)
+{
+    const struct sdlang_node_t* n = &doc->nodes[node];
+
+    for (uint32_t i = 0; i < n->num_attributes; ++i)
+    {
+        const struct sdlang_attribute_t* attr = &doc->attributes[n->attributes + i];
+
+        if (strcmp(doc->strings + attr->name, name) == 0)
+        {
+            return &attr->value;
+        }
+    }
+
+    return NULL;
+}
+
+const void* sdlang_document_data(const struct sdlang_document_t* doc,
+                                 const struct sdlang_value_t* value)
+{
+    return doc->strings + value->data.offset;
+}
+
+/*
+    Binary images.
+
+    The header is followed by the arrays of the document, and its string
+    pool, at 8 byte aligned offsets which only depend on the counts in the
+    header. Padding is zeroed, so the checksum of an image only depends on
+    the document.
+*/
+
+#define SDLANG_IMAGE_MAGIC 0x424c4453u
+#define SDLANG_IMAGE_VERSION 1u
+#define SDLANG_IMAGE_BYTE_ORDER 0x01020304u
+
+struct sdlang_image_t
+{
+    uint32_t magic, version, byte_order, checksum;
+    uint32_t num_nodes, num_values, num_attributes, strings_size;
+    uint64_t size;
+};
+
+struct sdlang_image_layout_t
+{
+    uint64_t nodes, values, attributes, strings, size;
+};
+
+static struct sdlang_image_layout_t sdlang_image_layout(const struct sdlang_image_t* header)
+{
+    /* 64 bit, so that no header can overflow it */
+    struct sdlang_image_layout_t layout;
+
+    layout.nodes = (sizeof(struct sdlang_image_t) + 7) & ~(uint64_t)7;
+    layout.values = (layout.nodes + (uint64_t)header->num_nodes * sizeof(struct sdlang_node_t) + 7) & ~(uint64_t)7;
+    layout.attributes = layout.values + (uint64_t)header->num_values * sizeof(struct sdlang_value_t);
+    layout.strings = layout.attributes + (uint64_t)header->num_attributes * sizeof(struct sdlang_attribute_t);
+    layout.size = (layout.strings + header->strings_size + 7) & ~(uint64_t)7;
+
+    return layout;
+}
+
+static uint32_t sdlang_image_checksum(const char* image, size_t size)
+{
+    /* the header, without the checksum itself, and the rest */
+    struct sdlang_image_t header;
+
+    SDLANG_MEMMOVE(&header, image, sizeof(header));
+    header.checksum = 0;
+
+    return sdlang_hash((const char*)&header, sizeof(header))
+        ^ sdlang_hash(image + sizeof(header), size - sizeof(header));
+}
+
+struct sdlang_image_pool_t
+{
+    char* data;
+    uint32_t size;
+
+    /* interned names, as offsets + 1 */
+    uint32_t* slots;
+    uint32_t capacity;
+};
+
+static uint32_t sdlang_image_name(struct sdlang_image_pool_t* pool, const char* name, uint32_t len)
+{
+    uint32_t i, offset;
+
+    if (len == 0)
+    {
+        /* the root name */
+        return 0;
+    }
+
+    for (i = sdlang_hash(name, len) & (pool->capacity - 1); pool->slots[i] != 0; i = (i + 1) & (pool->capacity - 1))
+    {
+        offset = pool->slots[i] - 1;
+
+        if (memcmp(pool->data + offset, name, len) == 0 && pool->data[offset + len] == '\0')
+        {
+            return offset;
+        }
+    }
+
+    offset = pool->size;
+    SDLANG_MEMMOVE(pool->data + offset, name, len);
+    pool->size += len + 1;
+    pool->slots[i] = offset + 1;
+
+    return offset;
+}
+
+static void sdlang_image_value(struct sdlang_image_pool_t* pool, const struct sdlang_document_t* doc,
+                               struct sdlang_value_t* dst, const struct sdlang_value_t* value)
+{
+    /* copies only the active member of the union, so the rest stays zero */
+    uint32_t size;
+
+    dst->type = value->type;
+    dst->length = value->length;
+
+    switch (value->type)
+    {
+    case SDLANG_VALUE_BOOL:
+        dst->data.b = value->data.b;
+        return;
+
+    case SDLANG_VALUE_I32:
+    case SDLANG_VALUE_U32:
+    case SDLANG_VALUE_F32:
+        dst->data.u32 = value->data.u32;
+        return;
+
+    case SDLANG_VALUE_I64:
+    case SDLANG_VALUE_U64:
+    case SDLANG_VALUE_F64:
+        dst->data.u64 = value->data.u64;
+        return;
+
+    case SDLANG_VALUE_STRING:
+        size = value->length + 1;
+        break;
+
+    case SDLANG_VALUE_BINARY:
+        size = value->length;
+        break;
+
+    case SDLANG_VALUE_I128:
+        /* 8 byte aligned {hi, lo} pair */
+        pool->size = (pool->size + 7) & ~(uint32_t)7;
+        size = 16;
+        break;
+
+    default:
+        return;
+    }
+
+    SDLANG_MEMMOVE(pool->data + pool->size, doc->strings + value->data.offset, size);
+    dst->data.offset = pool->size;
+    pool->size += size;
+}
+
+int sdlang_document_compile(const struct sdlang_document_t* doc,
+    void** image, size_t* size, const struct sdlang_allocator_t* allocator)
+{
+    const struct sdlang_allocator_t alloc = allocator != NULL
+        ? *allocator : (struct sdlang_allocator_t) { sdlang_default_alloc, NULL };
+    const uint64_t bound = (uint64_t)doc->strings_size + 8 * ((uint64_t)doc->num_values + doc->num_attributes) + 8;
+    struct sdlang_image_t header = {
+        SDLANG_IMAGE_MAGIC, SDLANG_IMAGE_VERSION, SDLANG_IMAGE_BYTE_ORDER, 0,
+        doc->num_nodes, doc->num_values, doc->num_attributes, (uint32_t)bound, 0
+    };
+    struct sdlang_image_layout_t layout = sdlang_image_layout(&header);
+    struct sdlang_image_pool_t pool = { NULL, 1, NULL, 64 };
+    struct sdlang_node_t* nodes;
+    struct sdlang_value_t* values;
+    struct sdlang_attribute_t* attributes;
+    uint32_t *order = NULL, *index = NULL;
+    char* data = NULL;
+    uint32_t count = 1;
+
+    *image = NULL;
+    *size = 0;
+
+    while (pool.capacity < 2 * ((uint64_t)doc->num_nodes + doc->num_attributes))
+    {
+        pool.capacity *= 2;
+    }
+
+    if (bound <= UINT32_MAX && layout.size <= SIZE_MAX && doc->num_nodes > 0)
+    {
+        data = (*alloc.alloc)(NULL, (size_t)layout.size, alloc.user);
+        order = (*alloc.alloc)(NULL, 2 * sizeof(uint32_t) * doc->num_nodes, alloc.user);
+        pool.slots = (*alloc.alloc)(NULL, sizeof(uint32_t) * pool.capacity, alloc.user);
+    }
+
+    if (data == NULL || order == NULL || pool.slots == NULL)
+    {
+        if (data != NULL)
+        {
+            (*alloc.alloc)(data, 0, alloc.user);
+        }
+
+        if (order != NULL)
+        {
+            (*alloc.alloc)(order, 0, alloc.user);
+        }
+
+        if (pool.slots != NULL)
+        {
+            (*alloc.alloc)(pool.slots, 0, alloc.user);
+        }
+
+        (*sdlang_user_report_error)(SDLANG_PARSE_ERROR_BUFFER_TOO_SMALL, 0);
+        return SDLANG_PARSE_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    memset(data, 0, (size_t)layout.size);
+    memset(pool.slots, 0, sizeof(uint32_t) * pool.capacity);
+
+    nodes = (struct sdlang_node_t*)(data + layout.nodes);
+    values = (struct sdlang_value_t*)(data + layout.values);
+    attributes = (struct sdlang_attribute_t*)(data + layout.attributes);
+    pool.data = data + layout.strings;
+    index = order + doc->num_nodes;
+
+    /* breadth-first order, the new index of each node */
+    order[0] = index[0] = 0;
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        for (uint32_t child = doc->nodes[order[i]].first_child; child != 0 && count < doc->num_nodes;
+             child = doc->nodes[child].next_sibling)
+        {
+            index[child] = count;
+            order[count++] = child;
+        }
+    }
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const struct sdlang_node_t* node = &doc->nodes[order[i]];
+
+        nodes[i] = *node;
+        nodes[i].name = sdlang_image_name(&pool, doc->strings + node->name, node->name_length);
+        nodes[i].parent = index[node->parent];
+        nodes[i].first_child = node->first_child != 0 ? index[node->first_child] : 0;
+        nodes[i].next_sibling = node->next_sibling != 0 ? index[node->next_sibling] : 0;
+    }
+
+    for (uint32_t i = 0; i < doc->num_values; ++i)
+    {
+        sdlang_image_value(&pool, doc, &values[i], &doc->values[i]);
+    }
+
+    for (uint32_t i = 0; i < doc->num_attributes; ++i)
+    {
+        const struct sdlang_attribute_t* attr = &doc->attributes[i];
+
+        attributes[i].name = sdlang_image_name(&pool, doc->strings + attr->name, attr->name_length);
+        attributes[i].name_length = attr->name_length;
+        sdlang_image_value(&pool, doc, &attributes[i].value, &attr->value);
+    }
+
+    (*alloc.alloc)(pool.slots, 0, alloc.user);
+    (*alloc.alloc)(order, 0, alloc.user);
+
+    /* gives back what the string pool didn't use */
+    header.strings_size = pool.size;
+    layout = sdlang_image_layout(&header);
+    header.size = layout.size;
+    SDLANG_MEMMOVE(data, &header, sizeof(header));
+    header.checksum = sdlang_image_checksum(data, (size_t)layout.size);
+    SDLANG_MEMMOVE(data, &header, sizeof(header));
+
+    *image = (*alloc.alloc)(data, (size_t)layout.size, alloc.user);
+    *image = *image != NULL ? *image : data;
+    *size = (size_t)layout.size;
+
+    return SDLANG_PARSE_OK;
+}
+
+int sdlang_document_save(const struct sdlang_document_t* doc, const char* path)
+{
+    const struct sdlang_allocator_t allocator = { sdlang_default_alloc, NULL };
+    void* image;
+    size_t size;
+    FILE* file;
+    int err = sdlang_document_compile(doc, &image, &size, &allocator);
+
+    if (err != SDLANG_PARSE_OK)
+    {
+        return err;
+    }
+
+    file = fopen(path, "wb");
+    err = file != NULL && fwrite(image, 1, size, file) == size ? SDLANG_PARSE_OK : SDLANG_PARSE_ERROR_IO;
+
+    if (file != NULL && fclose(file) != 0)
+    {
+        err = SDLANG_PARSE_ERROR_IO;
+    }
+
+    (*allocator.alloc)(image, 0, allocator.user);
+
+    if (err != SDLANG_PARSE_OK)
+    {
+        (*sdlang_user_report_error)(err, 0);
+    }
+
+    return err;
+}
+
+static bool sdlang_image_string(const struct sdlang_document_t* doc, uint32_t offset, uint32_t length)
+{
+    /* null-terminated within the string pool */
+    return (uint64_t)offset + length < doc->strings_size && doc->strings[offset + length] == '\0';
+}
+
+static bool sdlang_image_check_value(const struct sdlang_document_t* doc, const struct sdlang_value_t* value)
+{
+    switch (value->type)
+    {
+    case SDLANG_VALUE_NULL:
+    case SDLANG_VALUE_BOOL:
+    case SDLANG_VALUE_I32:
+    case SDLANG_VALUE_I64:
+    case SDLANG_VALUE_U32:
+    case SDLANG_VALUE_U64:
+    case SDLANG_VALUE_F32:
+    case SDLANG_VALUE_F64:
+        return true;
+
+    case SDLANG_VALUE_STRING:
+        return sdlang_image_string(doc, value->data.offset, value->length);
+
+    case SDLANG_VALUE_BINARY:
+        return (uint64_t)value->data.offset + value->length <= doc->strings_size;
+
+    case SDLANG_VALUE_I128:
+        return value->data.offset % 8 == 0 && value->length == 16
+            && (uint64_t)value->data.offset + 16 <= doc->strings_size;
+
+    default:
+        return false;
+    }
+}
+
+static int sdlang_image_check(struct sdlang_document_t* doc, const char* image, size_t size)
+{
+    struct sdlang_image_t header;
+    struct sdlang_image_layout_t layout;
+
+    if (size < sizeof(header) || ((uintptr_t)image & 7) != 0)
+    {
+        return SDLANG_PARSE_ERROR_IMAGE;
+    }
+
+    SDLANG_MEMMOVE(&header, image, sizeof(header));
+    layout = sdlang_image_layout(&header);
+
+    if (header.magic != SDLANG_IMAGE_MAGIC || header.version != SDLANG_IMAGE_VERSION
+        || header.byte_order != SDLANG_IMAGE_BYTE_ORDER || header.size != size || layout.size != size
+        || header.num_nodes == 0 || header.strings_size == 0
+        || header.checksum != sdlang_image_checksum(image, size))
+    {
+        return SDLANG_PARSE_ERROR_IMAGE;
+    }
+
+    doc->nodes = (const struct sdlang_node_t*)(image + layout.nodes);
+    doc->values = (const struct sdlang_value_t*)(image + layout.values);
+    doc->attributes = (const struct sdlang_attribute_t*)(image + layout.attributes);
+    doc->strings = image + layout.strings;
+    doc->num_nodes = header.num_nodes;
+    doc->num_values = header.num_values;
+    doc->num_attributes = header.num_attributes;
+    doc->strings_size = header.strings_size;
+
+    /* links only point forward, so navigation can't loop */
+    for (uint32_t i = 0; i < doc->num_nodes; ++i)
+    {
+        const struct sdlang_node_t* node = &doc->nodes[i];
+
+        if (!sdlang_image_string(doc, node->name, node->name_length)
+            || (i > 0 ? node->parent >= i : node->parent != 0)
+            || (node->first_child != 0 && (node->first_child <= i || node->first_child >= doc->num_nodes))
+            || (node->next_sibling != 0 && (node->next_sibling <= i || node->next_sibling >= doc->num_nodes))
+            || (uint64_t)node->first_child + node->num_children > doc->num_nodes
+            || (uint64_t)node->values + node->num_values > doc->num_values
+            || (uint64_t)node->attributes + node->num_attributes > doc->num_attributes)
+        {
+            return SDLANG_PARSE_ERROR_IMAGE;
+        }
+    }
+
+    for (uint32_t i = 0; i < doc->num_values; ++i)
+    {
+        if (!sdlang_image_check_value(doc, &doc->values[i]))
+        {
+            return SDLANG_PARSE_ERROR_IMAGE;
+        }
+    }
+
+    for (uint32_t i = 0; i < doc->num_attributes; ++i)
+    {
+        const struct sdlang_attribute_t* attr = &doc->attributes[i];
+
+        if (!sdlang_image_string(doc, attr->name, attr->name_length) || !sdlang_image_check_value(doc, &attr->value))
+        {
+            return SDLANG_PARSE_ERROR_IMAGE;
+        }
+    }
+
+    return SDLANG_PARSE_OK;
+}
+
+int sdlang_document_load(struct sdlang_document_t* doc, const void* image, size_t size)
+{
+    const int err = sdlang_image_check(doc, (const char*)image, size);
+
+    if (err != SDLANG_PARSE_OK)
+    {
+        *doc = (struct sdlang_document_t) { 0 };
+        (*sdlang_user_report_error)(err, 0);
+    }
+
+    return err;
+}
+
+#ifdef SDLANG_HAVE_MMAP
+static void* sdlang_image_unmap(void* ptr, size_t size, void* user)
+{
+    /* only marks mapped images, which sdlang_document_free() unmaps */
+    (void)ptr;
+    (void)size;
+    (void)user;
+
+    return NULL;
+}
+#endif
+
+int sdlang_document_load_file(struct sdlang_document_t* doc, const char* path)
+{
+    struct sdlang_allocator_t allocator = { sdlang_default_alloc, NULL };
+    const int fd = sdlang_open_fd(path);
+    char* data = NULL;
+    size_t size = 0, capacity = 0;
+    int err = SDLANG_PARSE_OK;
+
+    *doc = (struct sdlang_document_t) { 0 };
+
+    if (fd < 0)
+    {
+        (*sdlang_user_report_error)(SDLANG_PARSE_ERROR_IO, 0);
+        return SDLANG_PARSE_ERROR_IO;
+    }
+
+#ifdef SDLANG_HAVE_MMAP
+    {
+        struct stat st;
+
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0)
+        {
+            void* map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+            if (map != MAP_FAILED)
+            {
+                data = map;
+                size = (size_t)st.st_size;
+                allocator.alloc = sdlang_image_unmap;
+            }
+        }
+    }
+#endif
+
+    /* pipes, or no mmap() support */
+    while (allocator.alloc == sdlang_default_alloc)
+    {
+        int n;
+
+        if (size == capacity)
+        {
+            char* grown = sdlang_default_alloc(data, capacity = capacity > 0 ? capacity * 2 : 4096, NULL);
+
+            if (grown == NULL)
+            {
+                err = SDLANG_PARSE_ERROR_BUFFER_TOO_SMALL;
+                break;
+            }
+
+            data = grown;
+        }
+
+        if ((n = (int)sdlang_read_fd(fd, data + size, capacity - size)) < 0 && errno == EINTR)
+        {
+            continue;
+        }
+
+        if (n <= 0)
+        {
+            err = n < 0 ? SDLANG_PARSE_ERROR_IO : SDLANG_PARSE_OK;
+            break;
+        }
+
+        size += (size_t)n;
+    }
+
+    sdlang_close_fd(fd);
+
+    if (err != SDLANG_PARSE_OK)
+    {
+        (*sdlang_user_report_error)(err, 0);
+    }
+    else if ((err = sdlang_document_load(doc, data, size)) == SDLANG_PARSE_OK)
+    {
+        doc->arena = data;
+        doc->arena_size = size;
+        doc->allocator = allocator;
+
+        return SDLANG_PARSE_OK;
+    }
+
+    doc->arena = data;
+    doc->arena_size = size;
+    doc->allocator = allocator;
+    sdlang_document_free(doc);
+
+    return err;
+}
+
+/*
+    Writer.
+
+    Items are formatted straight into the buffer, after making sure there's
+    room for the longest form they can take. Floats are written as the
+    shortest decimal which rounds back to the same bits, found with the
+    Schubfach algorithm (R. Giulietti, "The Schubfach way to render
+    doubles"): the bounds of the rounding interval are scaled by a power of
+    10 with round-to-odd multiplications, so that a single division by 10
+    tells whether a shorter decimal lies within.
+*/
+
+#if SDLANG_WRITE_BUFFERSIZE < 64
+# error "SDLANG_WRITE_BUFFERSIZE must hold the longest number"
+#endif
+
+/*
+    128 bit approximations g of 10^k, for k in [-292, 324], with
+    (g - 1) 2^r <= 10^k < g 2^r and the most significant bit set.
+*/
+
+#define SDLANG_POW10_MIN -292
+#define SDLANG_POW10_MAX 324
+
+static const uint64_t sdlang_pow10_128[] = {
+    0xff77b1fcbebcdc4full, 0x25e8e89c13bb0f7bull, 0x9faacf3df73609b1ull, 0x77b191618c54e9adull,
+    0xc795830d75038c1dull, 0xd59df5b9ef6a2418ull, 0xf97ae3d0d2446f25ull, 0x4b0573286b44ad1eull,
+    0x9becce62836ac577ull, 0x4ee367f9430aec33ull, 0xc2e801fb244576d5ull, 0x229c41f793cda740ull,
+    0xf3a20279ed56d48aull, 0x6b43527578c11110ull, 0x9845418c345644d6ull, 0x830a13896b78aaaaull,
+    0xbe5691ef416bd60cull, 0x23cc986bc656d554ull, 0xedec366b11c6cb8full, 0x2cbfbe86b7ec8aa9ull,
+    0x94b3a202eb1c3f39ull, 0x7bf7d71432f3d6aaull, 0xb9e08a83a5e34f07ull, 0xdaf5ccd93fb0cc54ull,
+    0xe858ad248f5c22c9ull, 0xd1b3400f8f9cff69ull, 0x91376c36d99995beull, 0x23100809b9c21fa2ull,
+    0xb58547448ffffb2dull, 0xabd40a0c2832a78bull, 0xe2e69915b3fff9f9ull, 0x16c90c8f323f516dull,
+    0x8dd01fad907ffc3bull, 0xae3da7d97f6792e4ull, 0xb1442798f49ffb4aull, 0x99cd11cfdf41779dull,
+    0xdd95317f31c7fa1dull, 0x40405643d711d584ull, 0x8a7d3eef7f1cfc52ull, 0x482835ea666b2573ull,
+    0xad1c8eab5ee43b66ull, 0xda3243650005eed0ull, 0xd863b256369d4a40ull, 0x90bed43e40076a83ull,
+    0x873e4f75e2224e68ull, 0x5a7744a6e804a292ull, 0xa90de3535aaae202ull, 0x711515d0a205cb37ull,
+    0xd3515c2831559a83ull, 0x0d5a5b44ca873e04ull, 0x8412d9991ed58091ull, 0xe858790afe9486c3ull,
+    0xa5178fff668ae0b6ull, 0x626e974dbe39a873ull, 0xce5d73ff402d98e3ull, 0xfb0a3d212dc81290ull,
+    0x80fa687f881c7f8eull, 0x7ce66634bc9d0b9aull, 0xa139029f6a239f72ull, 0x1c1fffc1ebc44e81ull,
+    0xc987434744ac874eull, 0xa327ffb266b56221ull, 0xfbe9141915d7a922ull, 0x4bf1ff9f0062baa9ull,
+    0x9d71ac8fada6c9b5ull, 0x6f773fc3603db4aaull, 0xc4ce17b399107c22ull, 0xcb550fb4384d21d4ull,
+    0xf6019da07f549b2bull, 0x7e2a53a146606a49ull, 0x99c102844f94e0fbull, 0x2eda7444cbfc426eull,
+    0xc0314325637a1939ull, 0xfa911155fefb5309ull, 0xf03d93eebc589f88ull, 0x793555ab7eba27cbull,
+    0x96267c7535b763b5ull, 0x4bc1558b2f3458dfull, 0xbbb01b9283253ca2ull, 0x9eb1aaedfb016f17ull,
+    0xea9c227723ee8bcbull, 0x465e15a979c1caddull, 0x92a1958a7675175full, 0x0bfacd89ec191ecaull,
+    0xb749faed14125d36ull, 0xcef980ec671f667cull, 0xe51c79a85916f484ull, 0x82b7e12780e7401bull,
+    0x8f31cc0937ae58d2ull, 0xd1b2ecb8b0908811ull, 0xb2fe3f0b8599ef07ull, 0x861fa7e6dcb4aa16ull,
+    0xdfbdcece67006ac9ull, 0x67a791e093e1d49bull, 0x8bd6a141006042bdull, 0xe0c8bb2c5c6d24e1ull,
+    0xaecc49914078536dull, 0x58fae9f773886e19ull, 0xda7f5bf590966848ull, 0xaf39a475506a899full,
+    0x888f99797a5e012dull, 0x6d8406c952429604ull, 0xaab37fd7d8f58178ull, 0xc8e5087ba6d33b84ull,
+    0xd5605fcdcf32e1d6ull, 0xfb1e4a9a90880a65ull, 0x855c3be0a17fcd26ull, 0x5cf2eea09a550680ull,
+    0xa6b34ad8c9dfc06full, 0xf42faa48c0ea481full, 0xd0601d8efc57b08bull, 0xf13b94daf124da27ull,
+    0x823c12795db6ce57ull, 0x76c53d08d6b70859ull, 0xa2cb1717b52481edull, 0x54768c4b0c64ca6full,
+    0xcb7ddcdda26da268ull, 0xa9942f5dcf7dfd0aull, 0xfe5d54150b090b02ull, 0xd3f93b35435d7c4dull,
+    0x9efa548d26e5a6e1ull, 0xc47bc5014a1a6db0ull, 0xc6b8e9b0709f109aull, 0x359ab6419ca1091cull,
+    0xf867241c8cc6d4c0ull, 0xc30163d203c94b63ull, 0x9b407691d7fc44f8ull, 0x79e0de63425dcf1eull,
+    0xc21094364dfb5636ull, 0x985915fc12f542e5ull, 0xf294b943e17a2bc4ull, 0x3e6f5b7b17b2939eull,
+    0x979cf3ca6cec5b5aull, 0xa705992ceecf9c43ull, 0xbd8430bd08277231ull, 0x50c6ff782a838354ull,
+    0xece53cec4a314ebdull, 0xa4f8bf5635246429ull, 0x940f4613ae5ed136ull, 0x871b7795e136be9aull,
+    0xb913179899f68584ull, 0x28e2557b59846e40ull, 0xe757dd7ec07426e5ull, 0x331aeada2fe589d0ull,
+    0x9096ea6f3848984full, 0x3ff0d2c85def7622ull, 0xb4bca50b065abe63ull, 0x0fed077a756b53aaull,
+    0xe1ebce4dc7f16dfbull, 0xd3e8495912c62895ull, 0x8d3360f09cf6e4bdull, 0x64712dd7abbbd95dull,
+    0xb080392cc4349decull, 0xbd8d794d96aacfb4ull, 0xdca04777f541c567ull, 0xecf0d7a0fc5583a1ull,
+    0x89e42caaf9491b60ull, 0xf41686c49db57245ull, 0xac5d37d5b79b6239ull, 0x311c2875c522ced6ull,
+    0xd77485cb25823ac7ull, 0x7d633293366b828cull, 0x86a8d39ef77164bcull, 0xae5dff9c02033198ull,
+    0xa8530886b54dbdebull, 0xd9f57f830283fdfdull, 0xd267caa862a12d66ull, 0xd072df63c324fd7cull,
+    0x8380dea93da4bc60ull, 0x4247cb9e59f71e6eull, 0xa46116538d0deb78ull, 0x52d9be85f074e609ull,
+    0xcd795be870516656ull, 0x67902e276c921f8cull, 0x806bd9714632dff6ull, 0x00ba1cd8a3db53b7ull,
+    0xa086cfcd97bf97f3ull, 0x80e8a40eccd228a5ull, 0xc8a883c0fdaf7df0ull, 0x6122cd128006b2ceull,
+    0xfad2a4b13d1b5d6cull, 0x796b805720085f82ull, 0x9cc3a6eec6311a63ull, 0xcbe3303674053bb1ull,
+    0xc3f490aa77bd60fcull, 0xbedbfc4411068a9dull, 0xf4f1b4d515acb93bull, 0xee92fb5515482d45ull,
+    0x991711052d8bf3c5ull, 0x751bdd152d4d1c4bull, 0xbf5cd54678eef0b6ull, 0xd262d45a78a0635eull,
+    0xef340a98172aace4ull, 0x86fb897116c87c35ull, 0x9580869f0e7aac0eull, 0xd45d35e6ae3d4da1ull,
+    0xbae0a846d2195712ull, 0x8974836059cca10aull, 0xe998d258869facd7ull, 0x2bd1a438703fc94cull,
+    0x91ff83775423cc06ull, 0x7b6306a34627ddd0ull, 0xb67f6455292cbf08ull, 0x1a3bc84c17b1d543ull,
+    0xe41f3d6a7377eecaull, 0x20caba5f1d9e4a94ull, 0x8e938662882af53eull, 0x547eb47b7282ee9dull,
+    0xb23867fb2a35b28dull, 0xe99e619a4f23aa44ull, 0xdec681f9f4c31f31ull, 0x6405fa00e2ec94d5ull,
+    0x8b3c113c38f9f37eull, 0xde83bc408dd3dd05ull, 0xae0b158b4738705eull, 0x9624ab50b148d446ull,
+    0xd98ddaee19068c76ull, 0x3badd624dd9b0958ull, 0x87f8a8d4cfa417c9ull, 0xe54ca5d70a80e5d7ull,
+    0xa9f6d30a038d1dbcull, 0x5e9fcf4ccd211f4dull, 0xd47487cc8470652bull, 0x7647c32000696720ull,
+    0x84c8d4dfd2c63f3bull, 0x29ecd9f40041e074ull, 0xa5fb0a17c777cf09ull, 0xf468107100525891ull,
+    0xcf79cc9db955c2ccull, 0x7182148d4066eeb5ull, 0x81ac1fe293d599bfull, 0xc6f14cd848405531ull,
+    0xa21727db38cb002full, 0xb8ada00e5a506a7dull, 0xca9cf1d206fdc03bull, 0xa6d90811f0e4851dull,
+    0xfd442e4688bd304aull, 0x908f4a166d1da664ull, 0x9e4a9cec15763e2eull, 0x9a598e4e043287ffull,
+    0xc5dd44271ad3cdbaull, 0x40eff1e1853f29feull, 0xf7549530e188c128ull, 0xd12bee59e68ef47dull,
+    0x9a94dd3e8cf578b9ull, 0x82bb74f8301958cfull, 0xc13a148e3032d6e7ull, 0xe36a52363c1faf02ull,
+    0xf18899b1bc3f8ca1ull, 0xdc44e6c3cb279ac2ull, 0x96f5600f15a7b7e5ull, 0x29ab103a5ef8c0baull,
+    0xbcb2b812db11a5deull, 0x7415d448f6b6f0e8ull, 0xebdf661791d60f56ull, 0x111b495b3464ad22ull,
+    0x936b9fcebb25c995ull, 0xcab10dd900beec35ull, 0xb84687c269ef3bfbull, 0x3d5d514f40eea743ull,
+    0xe65829b3046b0afaull, 0x0cb4a5a3112a5113ull, 0x8ff71a0fe2c2e6dcull, 0x47f0e785eaba72acull,
+    0xb3f4e093db73a093ull, 0x59ed216765690f57ull, 0xe0f218b8d25088b8ull, 0x306869c13ec3532dull,
+    0x8c974f7383725573ull, 0x1e414218c73a13fcull, 0xafbd2350644eeacfull, 0xe5d1929ef90898fbull,
+    0xdbac6c247d62a583ull, 0xdf45f746b74abf3aull, 0x894bc396ce5da772ull, 0x6b8bba8c328eb784ull,
+    0xab9eb47c81f5114full, 0x066ea92f3f326565ull, 0xd686619ba27255a2ull, 0xc80a537b0efefebeull,
+    0x8613fd0145877585ull, 0xbd06742ce95f5f37ull, 0xa798fc4196e952e7ull, 0x2c48113823b73705ull,
+    0xd17f3b51fca3a7a0ull, 0xf75a15862ca504c6ull, 0x82ef85133de648c4ull, 0x9a984d73dbe722fcull,
+    0xa3ab66580d5fdaf5ull, 0xc13e60d0d2e0ebbbull, 0xcc963fee10b7d1b3ull, 0x318df905079926a9ull,
+    0xffbbcfe994e5c61full, 0xfdf17746497f7053ull, 0x9fd561f1fd0f9bd3ull, 0xfeb6ea8bedefa634ull,
+    0xc7caba6e7c5382c8ull, 0xfe64a52ee96b8fc1ull, 0xf9bd690a1b68637bull, 0x3dfdce7aa3c673b1ull,
+    0x9c1661a651213e2dull, 0x06bea10ca65c084full, 0xc31bfa0fe5698db8ull, 0x486e494fcff30a63ull,
+    0xf3e2f893dec3f126ull, 0x5a89dba3c3efccfbull, 0x986ddb5c6b3a76b7ull, 0xf89629465a75e01dull,
+    0xbe89523386091465ull, 0xf6bbb397f1135824ull, 0xee2ba6c0678b597full, 0x746aa07ded582e2dull,
+    0x94db483840b717efull, 0xa8c2a44eb4571cddull, 0xba121a4650e4ddebull, 0x92f34d62616ce414ull,
+    0xe896a0d7e51e1566ull, 0x77b020baf9c81d18ull, 0x915e2486ef32cd60ull, 0x0ace1474dc1d122full,
+    0xb5b5ada8aaff80b8ull, 0x0d819992132456bbull, 0xe3231912d5bf60e6ull, 0x10e1fff697ed6c6aull,
+    0x8df5efabc5979c8full, 0xca8d3ffa1ef463c2ull, 0xb1736b96b6fd83b3ull, 0xbd308ff8a6b17cb3ull,
+    0xddd0467c64bce4a0ull, 0xac7cb3f6d05ddbdfull, 0x8aa22c0dbef60ee4ull, 0x6bcdf07a423aa96cull,
+    0xad4ab7112eb3929dull, 0x86c16c98d2c953c7ull, 0xd89d64d57a607744ull, 0xe871c7bf077ba8b8ull,
+    0x87625f056c7c4a8bull, 0x11471cd764ad4973ull, 0xa93af6c6c79b5d2dull, 0xd598e40d3dd89bd0ull,
+    0xd389b47879823479ull, 0x4aff1d108d4ec2c4ull, 0x843610cb4bf160cbull, 0xcedf722a585139bbull,
+    0xa54394fe1eedb8feull, 0xc2974eb4ee658829ull, 0xce947a3da6a9273eull, 0x733d226229feea33ull,
+    0x811ccc668829b887ull, 0x0806357d5a3f5260ull, 0xa163ff802a3426a8ull, 0xca07c2dcb0cf26f8ull,
+    0xc9bcff6034c13052ull, 0xfc89b393dd02f0b6ull, 0xfc2c3f3841f17c67ull, 0xbbac2078d443ace3ull,
+    0x9d9ba7832936edc0ull, 0xd54b944b84aa4c0eull, 0xc5029163f384a931ull, 0x0a9e795e65d4df12ull,
+    0xf64335bcf065d37dull, 0x4d4617b5ff4a16d6ull, 0x99ea0196163fa42eull, 0x504bced1bf8e4e46ull,
+    0xc06481fb9bcf8d39ull, 0xe45ec2862f71e1d7ull, 0xf07da27a82c37088ull, 0x5d767327bb4e5a4dull,
+    0x964e858c91ba2655ull, 0x3a6a07f8d510f870ull, 0xbbe226efb628afeaull, 0x890489f70a55368cull,
+    0xeadab0aba3b2dbe5ull, 0x2b45ac74ccea842full, 0x92c8ae6b464fc96full, 0x3b0b8bc90012929eull,
+    0xb77ada0617e3bbcbull, 0x09ce6ebb40173745ull, 0xe55990879ddcaabdull, 0xcc420a6a101d0516ull,
+    0x8f57fa54c2a9eab6ull, 0x9fa946824a12232eull, 0xb32df8e9f3546564ull, 0x47939822dc96abfaull,
+    0xdff9772470297ebdull, 0x59787e2b93bc56f8ull, 0x8bfbea76c619ef36ull, 0x57eb4edb3c55b65bull,
+    0xaefae51477a06b03ull, 0xede622920b6b23f2ull, 0xdab99e59958885c4ull, 0xe95fab368e45eceeull,
+    0x88b402f7fd75539bull, 0x11dbcb0218ebb415ull, 0xaae103b5fcd2a881ull, 0xd652bdc29f26a11aull,
+    0xd59944a37c0752a2ull, 0x4be76d3346f04960ull, 0x857fcae62d8493a5ull, 0x6f70a4400c562ddcull,
+    0xa6dfbd9fb8e5b88eull, 0xcb4ccd500f6bb953ull, 0xd097ad07a71f26b2ull, 0x7e2000a41346a7a8ull,
+    0x825ecc24c873782full, 0x8ed400668c0c28c9ull, 0xa2f67f2dfa90563bull, 0x728900802f0f32fbull,
+    0xcbb41ef979346bcaull, 0x4f2b40a03ad2ffbaull, 0xfea126b7d78186bcull, 0xe2f610c84987bfa9ull,
+    0x9f24b832e6b0f436ull, 0x0dd9ca7d2df4d7caull, 0xc6ede63fa05d3143ull, 0x91503d1c79720dbcull,
+    0xf8a95fcf88747d94ull, 0x75a44c6397ce912bull, 0x9b69dbe1b548ce7cull, 0xc986afbe3ee11abbull,
+    0xc24452da229b021bull, 0xfbe85badce996169ull, 0xf2d56790ab41c2a2ull, 0xfae27299423fb9c4ull,
+    0x97c560ba6b0919a5ull, 0xdccd879fc967d41bull, 0xbdb6b8e905cb600full, 0x5400e987bbc1c921ull,
+    0xed246723473e3813ull, 0x290123e9aab23b69ull, 0x9436c0760c86e30bull, 0xf9a0b6720aaf6522ull,
+    0xb94470938fa89bceull, 0xf808e40e8d5b3e6aull, 0xe7958cb87392c2c2ull, 0xb60b1d1230b20e05ull,
+    0x90bd77f3483bb9b9ull, 0xb1c6f22b5e6f48c3ull, 0xb4ecd5f01a4aa828ull, 0x1e38aeb6360b1af4ull,
+    0xe2280b6c20dd5232ull, 0x25c6da63c38de1b1ull, 0x8d590723948a535full, 0x579c487e5a38ad0full,
+    0xb0af48ec79ace837ull, 0x2d835a9df0c6d852ull, 0xdcdb1b2798182244ull, 0xf8e431456cf88e66ull,
+    0x8a08f0f8bf0f156bull, 0x1b8e9ecb641b5900ull, 0xac8b2d36eed2dac5ull, 0xe272467e3d222f40ull,
+    0xd7adf884aa879177ull, 0x5b0ed81dcc6abb10ull, 0x86ccbb52ea94baeaull, 0x98e947129fc2b4eaull,
+    0xa87fea27a539e9a5ull, 0x3f2398d747b36225ull, 0xd29fe4b18e88640eull, 0x8eec7f0d19a03aaeull,
+    0x83a3eeeef9153e89ull, 0x1953cf68300424adull, 0xa48ceaaab75a8e2bull, 0x5fa8c3423c052dd8ull,
+    0xcdb02555653131b6ull, 0x3792f412cb06794eull, 0x808e17555f3ebf11ull, 0xe2bbd88bbee40bd1ull,
+    0xa0b19d2ab70e6ed6ull, 0x5b6aceaeae9d0ec5ull, 0xc8de047564d20a8bull, 0xf245825a5a445276ull,
+    0xfb158592be068d2eull, 0xeed6e2f0f0d56713ull, 0x9ced737bb6c4183dull, 0x55464dd69685606cull,
+    0xc428d05aa4751e4cull, 0xaa97e14c3c26b887ull, 0xf53304714d9265dfull, 0xd53dd99f4b3066a9ull,
+    0x993fe2c6d07b7fabull, 0xe546a8038efe402aull, 0xbf8fdb78849a5f96ull, 0xde98520472bdd034ull,
+    0xef73d256a5c0f77cull, 0x963e66858f6d4441ull, 0x95a8637627989aadull, 0xdde7001379a44aa9ull,
+    0xbb127c53b17ec159ull, 0x5560c018580d5d53ull, 0xe9d71b689dde71afull, 0xaab8f01e6e10b4a7ull,
+    0x9226712162ab070dull, 0xcab3961304ca70e9ull, 0xb6b00d69bb55c8d1ull, 0x3d607b97c5fd0d23ull,
+    0xe45c10c42a2b3b05ull, 0x8cb89a7db77c506bull, 0x8eb98a7a9a5b04e3ull, 0x77f3608e92adb243ull,
+    0xb267ed1940f1c61cull, 0x55f038b237591ed4ull, 0xdf01e85f912e37a3ull, 0x6b6c46dec52f6689ull,
+    0x8b61313bbabce2c6ull, 0x2323ac4b3b3da016ull, 0xae397d8aa96c1b77ull, 0xabec975e0a0d081bull,
+    0xd9c7dced53c72255ull, 0x96e7bd358c904a22ull, 0x881cea14545c7575ull, 0x7e50d64177da2e55ull,
+    0xaa242499697392d2ull, 0xdde50bd1d5d0b9eaull, 0xd4ad2dbfc3d07787ull, 0x955e4ec64b44e865ull,
+    0x84ec3c97da624ab4ull, 0xbd5af13bef0b113full, 0xa6274bbdd0fadd61ull, 0xecb1ad8aeacdd58full,
+    0xcfb11ead453994baull, 0x67de18eda5814af3ull, 0x81ceb32c4b43fcf4ull, 0x80eacf948770ced8ull,
+    0xa2425ff75e14fc31ull, 0xa1258379a94d028eull, 0xcad2f7f5359a3b3eull, 0x096ee45813a04331ull,
+    0xfd87b5f28300ca0dull, 0x8bca9d6e188853fdull, 0x9e74d1b791e07e48ull, 0x775ea264cf55347eull,
+    0xc612062576589ddaull, 0x95364afe032a819eull, 0xf79687aed3eec551ull, 0x3a83ddbd83f52205ull,
+    0x9abe14cd44753b52ull, 0xc4926a9672793543ull, 0xc16d9a0095928a27ull, 0x75b7053c0f178294ull,
+    0xf1c90080baf72cb1ull, 0x5324c68b12dd6339ull, 0x971da05074da7beeull, 0xd3f6fc16ebca5e04ull,
+    0xbce5086492111aeaull, 0x88f4bb1ca6bcf585ull, 0xec1e4a7db69561a5ull, 0x2b31e9e3d06c32e6ull,
+    0x9392ee8e921d5d07ull, 0x3aff322e62439fd0ull, 0xb877aa3236a4b449ull, 0x09befeb9fad487c3ull,
+    0xe69594bec44de15bull, 0x4c2ebe687989a9b4ull, 0x901d7cf73ab0acd9ull, 0x0f9d37014bf60a11ull,
+    0xb424dc35095cd80full, 0x538484c19ef38c95ull, 0xe12e13424bb40e13ull, 0x2865a5f206b06fbaull,
+    0x8cbccc096f5088cbull, 0xf93f87b7442e45d4ull, 0xafebff0bcb24aafeull, 0xf78f69a51539d749ull,
+    0xdbe6fecebdedd5beull, 0xb573440e5a884d1cull, 0x89705f4136b4a597ull, 0x31680a88f8953031ull,
+    0xabcc77118461cefcull, 0xfdc20d2b36ba7c3eull, 0xd6bf94d5e57a42bcull, 0x3d32907604691b4dull,
+    0x8637bd05af6c69b5ull, 0xa63f9a49c2c1b110ull, 0xa7c5ac471b478423ull, 0x0fcf80dc33721d54ull,
+    0xd1b71758e219652bull, 0xd3c36113404ea4a9ull, 0x83126e978d4fdf3bull, 0x645a1cac083126eaull,
+    0xa3d70a3d70a3d70aull, 0x3d70a3d70a3d70a4ull, 0xccccccccccccccccull, 0xcccccccccccccccdull,
+    0x8000000000000000ull, 0x0000000000000001ull, 0xa000000000000000ull, 0x0000000000000001ull,
+    0xc800000000000000ull, 0x0000000000000001ull, 0xfa00000000000000ull, 0x0000000000000001ull,
+    0x9c40000000000000ull, 0x0000000000000001ull, 0xc350000000000000ull, 0x0000000000000001ull,
+    0xf424000000000000ull, 0x0000000000000001ull, 0x9896800000000000ull, 0x0000000000000001ull,
+    0xbebc200000000000ull, 0x0000000000000001ull, 0xee6b280000000000ull, 0x0000000000000001ull,
+    0x9502f90000000000ull, 0x0000000000000001ull, 0xba43b74000000000ull, 0x0000000000000001ull,
+    0xe8d4a51000000000ull, 0x0000000000000001ull, 0x9184e72a00000000ull, 0x0000000000000001ull,
+    0xb5e620f480000000ull, 0x0000000000000001ull, 0xe35fa931a0000000ull, 0x0000000000000001ull,
+    0x8e1bc9bf04000000ull, 0x0000000000000001ull, 0xb1a2bc2ec5000000ull, 0x0000000000000001ull,
+    0xde0b6b3a76400000ull, 0x0000000000000001ull, 0x8ac7230489e80000ull, 0x0000000000000001ull,
+    0xad78ebc5ac620000ull, 0x0000000000000001ull, 0xd8d726b7177a8000ull, 0x0000000000000001ull,
+    0x878678326eac9000ull, 0x0000000000000001ull, 0xa968163f0a57b400ull, 0x0000000000000001ull,
+    0xd3c21bcecceda100ull, 0x0000000000000001ull, 0x84595161401484a0ull, 0x0000000000000001ull,
+    0xa56fa5b99019a5c8ull, 0x0000000000000001ull, 0xcecb8f27f4200f3aull, 0x0000000000000001ull,
+    0x813f3978f8940984ull, 0x4000000000000001ull, 0xa18f07d736b90be5ull, 0x5000000000000001ull,
+    0xc9f2c9cd04674edeull, 0xa400000000000001ull, 0xfc6f7c4045812296ull, 0x4d00000000000001ull,
+    0x9dc5ada82b70b59dull, 0xf020000000000001ull, 0xc5371912364ce305ull, 0x6c28000000000001ull,
+    0xf684df56c3e01bc6ull, 0xc732000000000001ull, 0x9a130b963a6c115cull, 0x3c7f400000000001ull,
+    0xc097ce7bc90715b3ull, 0x4b9f100000000001ull, 0xf0bdc21abb48db20ull, 0x1e86d40000000001ull,
+    0x96769950b50d88f4ull, 0x1314448000000001ull, 0xbc143fa4e250eb31ull, 0x17d955a000000001ull,
+    0xeb194f8e1ae525fdull, 0x5dcfab0800000001ull, 0x92efd1b8d0cf37beull, 0x5aa1cae500000001ull,
+    0xb7abc627050305adull, 0xf14a3d9e40000001ull, 0xe596b7b0c643c719ull, 0x6d9ccd05d0000001ull,
+    0x8f7e32ce7bea5c6full, 0xe4820023a2000001ull, 0xb35dbf821ae4f38bull, 0xdda2802c8a800001ull,
+    0xe0352f62a19e306eull, 0xd50b2037ad200001ull, 0x8c213d9da502de45ull, 0x4526f422cc340001ull,
+    0xaf298d050e4395d6ull, 0x9670b12b7f410001ull, 0xdaf3f04651d47b4cull, 0x3c0cdd765f114001ull,
+    0x88d8762bf324cd0full, 0xa5880a69fb6ac801ull, 0xab0e93b6efee0053ull, 0x8eea0d047a457a01ull,
+    0xd5d238a4abe98068ull, 0x72a4904598d6d881ull, 0x85a36366eb71f041ull, 0x47a6da2b7f864751ull,
+    0xa70c3c40a64e6c51ull, 0x999090b65f67d925ull, 0xd0cf4b50cfe20765ull, 0xfff4b4e3f741cf6eull,
+    0x82818f1281ed449full, 0xbff8f10e7a8921a5ull, 0xa321f2d7226895c7ull, 0xaff72d52192b6a0eull,
+    0xcbea6f8ceb02bb39ull, 0x9bf4f8a69f764491ull, 0xfee50b7025c36a08ull, 0x02f236d04753d5b5ull,
+    0x9f4f2726179a2245ull, 0x01d762422c946591ull, 0xc722f0ef9d80aad6ull, 0x424d3ad2b7b97ef6ull,
+    0xf8ebad2b84e0d58bull, 0xd2e0898765a7deb3ull, 0x9b934c3b330c8577ull, 0x63cc55f49f88eb30ull,
+    0xc2781f49ffcfa6d5ull, 0x3cbf6b71c76b25fcull, 0xf316271c7fc3908aull, 0x8bef464e3945ef7bull,
+    0x97edd871cfda3a56ull, 0x97758bf0e3cbb5adull, 0xbde94e8e43d0c8ecull, 0x3d52eeed1cbea318ull,
+    0xed63a231d4c4fb27ull, 0x4ca7aaa863ee4bdeull, 0x945e455f24fb1cf8ull, 0x8fe8caa93e74ef6bull,
+    0xb975d6b6ee39e436ull, 0xb3e2fd538e122b45ull, 0xe7d34c64a9c85d44ull, 0x60dbbca87196b617ull,
+    0x90e40fbeea1d3a4aull, 0xbc8955e946fe31ceull, 0xb51d13aea4a488ddull, 0x6babab6398bdbe42ull,
+    0xe264589a4dcdab14ull, 0xc696963c7eed2dd2ull, 0x8d7eb76070a08aecull, 0xfc1e1de5cf543ca3ull,
+    0xb0de65388cc8ada8ull, 0x3b25a55f43294bccull, 0xdd15fe86affad912ull, 0x49ef0eb713f39ebfull,
+    0x8a2dbf142dfcc7abull, 0x6e3569326c784338ull, 0xacb92ed9397bf996ull, 0x49c2c37f07965405ull,
+    0xd7e77a8f87daf7fbull, 0xdc33745ec97be907ull, 0x86f0ac99b4e8dafdull, 0x69a028bb3ded71a4ull,
+    0xa8acd7c0222311bcull, 0xc40832ea0d68ce0dull, 0xd2d80db02aabd62bull, 0xf50a3fa490c30191ull,
+    0x83c7088e1aab65dbull, 0x792667c6da79e0fbull, 0xa4b8cab1a1563f52ull, 0x577001b891185939ull,
+    0xcde6fd5e09abcf26ull, 0xed4c0226b55e6f87ull, 0x80b05e5ac60b6178ull, 0x544f8158315b05b5ull,
+    0xa0dc75f1778e39d6ull, 0x696361ae3db1c722ull, 0xc913936dd571c84cull, 0x03bc3a19cd1e38eaull,
+    0xfb5878494ace3a5full, 0x04ab48a04065c724ull, 0x9d174b2dcec0e47bull, 0x62eb0d64283f9c77ull,
+    0xc45d1df942711d9aull, 0x3ba5d0bd324f8395ull, 0xf5746577930d6500ull, 0xca8f44ec7ee3647aull,
+    0x9968bf6abbe85f20ull, 0x7e998b13cf4e1eccull, 0xbfc2ef456ae276e8ull, 0x9e3fedd8c321a67full,
+    0xefb3ab16c59b14a2ull, 0xc5cfe94ef3ea101full, 0x95d04aee3b80ece5ull, 0xbba1f1d158724a13ull,
+    0xbb445da9ca61281full, 0x2a8a6e45ae8edc98ull, 0xea1575143cf97226ull, 0xf52d09d71a3293beull,
+    0x924d692ca61be758ull, 0x593c2626705f9c57ull, 0xb6e0c377cfa2e12eull, 0x6f8b2fb00c77836dull,
+    0xe498f455c38b997aull, 0x0b6dfb9c0f956448ull, 0x8edf98b59a373fecull, 0x4724bd4189bd5eadull,
+    0xb2977ee300c50fe7ull, 0x58edec91ec2cb658ull, 0xdf3d5e9bc0f653e1ull, 0x2f2967b66737e3eeull,
+    0x8b865b215899f46cull, 0xbd79e0d20082ee75ull, 0xae67f1e9aec07187ull, 0xecd8590680a3aa12ull,
+    0xda01ee641a708de9ull, 0xe80e6f4820cc9496ull, 0x884134fe908658b2ull, 0x3109058d147fdcdeull,
+    0xaa51823e34a7eedeull, 0xbd4b46f0599fd416ull, 0xd4e5e2cdc1d1ea96ull, 0x6c9e18ac7007c91bull,
+    0x850fadc09923329eull, 0x03e2cf6bc604ddb1ull, 0xa6539930bf6bff45ull, 0x84db8346b786151dull,
+    0xcfe87f7cef46ff16ull, 0xe612641865679a64ull, 0x81f14fae158c5f6eull, 0x4fcb7e8f3f60c07full,
+    0xa26da3999aef7749ull, 0xe3be5e330f38f09eull, 0xcb090c8001ab551cull, 0x5cadf5bfd3072cc6ull,
+    0xfdcb4fa002162a63ull, 0x73d9732fc7c8f7f7ull, 0x9e9f11c4014dda7eull, 0x2867e7fddcdd9afbull,
+    0xc646d63501a1511dull, 0xb281e1fd541501b9ull, 0xf7d88bc24209a565ull, 0x1f225a7ca91a4227ull,
+    0x9ae757596946075full, 0x3375788de9b06959ull, 0xc1a12d2fc3978937ull, 0x0052d6b1641c83afull,
+    0xf209787bb47d6b84ull, 0xc0678c5dbd23a49bull, 0x9745eb4d50ce6332ull, 0xf840b7ba963646e1ull,
+    0xbd176620a501fbffull, 0xb650e5a93bc3d899ull, 0xec5d3fa8ce427affull, 0xa3e51f138ab4cebfull,
+    0x93ba47c980e98cdfull, 0xc66f336c36b10138ull, 0xb8a8d9bbe123f017ull, 0xb80b0047445d4185ull,
+    0xe6d3102ad96cec1dull, 0xa60dc059157491e6ull, 0x9043ea1ac7e41392ull, 0x87c89837ad68db30ull,
+    0xb454e4a179dd1877ull, 0x29babe4598c311fcull, 0xe16a1dc9d8545e94ull, 0xf4296dd6fef3d67bull,
+    0x8ce2529e2734bb1dull, 0x1899e4a65f58660dull, 0xb01ae745b101e9e4ull, 0x5ec05dcff72e7f90ull,
+    0xdc21a1171d42645dull, 0x76707543f4fa1f74ull, 0x899504ae72497ebaull, 0x6a06494a791c53a9ull,
+    0xabfa45da0edbde69ull, 0x0487db9d17636893ull, 0xd6f8d7509292d603ull, 0x45a9d2845d3c42b7ull,
+    0x865b86925b9bc5c2ull, 0x0b8a2392ba45a9b3ull, 0xa7f26836f282b732ull, 0x8e6cac7768d7141full,
+    0xd1ef0244af2364ffull, 0x3207d795430cd927ull, 0x8335616aed761f1full, 0x7f44e6bd49e807b9ull,
+    0xa402b9c5a8d3a6e7ull, 0x5f16206c9c6209a7ull, 0xcd036837130890a1ull, 0x36dba887c37a8c10ull,
+    0x802221226be55a64ull, 0xc2494954da2c978aull, 0xa02aa96b06deb0fdull, 0xf2db9baa10b7bd6dull,
+    0xc83553c5c8965d3dull, 0x6f92829494e5acc8ull, 0xfa42a8b73abbf48cull, 0xcb772339ba1f17faull,
+    0x9c69a97284b578d7ull, 0xff2a760414536efcull, 0xc38413cf25e2d70dull, 0xfef5138519684abbull,
+    0xf46518c2ef5b8cd1ull, 0x7eb258665fc25d6aull, 0x98bf2f79d5993802ull, 0xef2f773ffbd97a62ull,
+    0xbeeefb584aff8603ull, 0xaafb550ffacfd8fbull, 0xeeaaba2e5dbf6784ull, 0x95ba2a53f983cf39ull,
+    0x952ab45cfa97a0b2ull, 0xdd945a747bf26184ull, 0xba756174393d88dfull, 0x94f971119aeef9e5ull,
+    0xe912b9d1478ceb17ull, 0x7a37cd5601aab85eull, 0x91abb422ccb812eeull, 0xac62e055c10ab33bull,
+    0xb616a12b7fe617aaull, 0x577b986b314d600aull, 0xe39c49765fdf9d94ull, 0xed5a7e85fda0b80cull,
+    0x8e41ade9fbebc27dull, 0x14588f13be847308ull, 0xb1d219647ae6b31cull, 0x596eb2d8ae258fc9ull,
+    0xde469fbd99a05fe3ull, 0x6fca5f8ed9aef3bcull, 0x8aec23d680043beeull, 0x25de7bb9480d5855ull,
+    0xada72ccc20054ae9ull, 0xaf561aa79a10ae6bull, 0xd910f7ff28069da4ull, 0x1b2ba1518094da05ull,
+    0x87aa9aff79042286ull, 0x90fb44d2f05d0843ull, 0xa99541bf57452b28ull, 0x353a1607ac744a54ull,
+    0xd3fa922f2d1675f2ull, 0x42889b8997915ce9ull, 0x847c9b5d7c2e09b7ull, 0x69956135febada12ull,
+    0xa59bc234db398c25ull, 0x43fab9837e699096ull, 0xcf02b2c21207ef2eull, 0x94f967e45e03f4bcull,
+    0x8161afb94b44f57dull, 0x1d1be0eebac278f6ull, 0xa1ba1ba79e1632dcull, 0x6462d92a69731733ull,
+    0xca28a291859bbf93ull, 0x7d7b8f7503cfdcffull, 0xfcb2cb35e702af78ull, 0x5cda735244c3d43full,
+    0x9defbf01b061adabull, 0x3a0888136afa64a8ull, 0xc56baec21c7a1916ull, 0x088aaa1845b8fdd1ull,
+    0xf6c69a72a3989f5bull, 0x8aad549e57273d46ull, 0x9a3c2087a63f6399ull, 0x36ac54e2f678864cull,
+    0xc0cb28a98fcf3c7full, 0x84576a1bb416a7deull, 0xf0fdf2d3f3c30b9full, 0x656d44a2a11c51d6ull,
+    0x969eb7c47859e743ull, 0x9f644ae5a4b1b326ull, 0xbc4665b596706114ull, 0x873d5d9f0dde1fefull,
+    0xeb57ff22fc0c7959ull, 0xa90cb506d155a7ebull, 0x9316ff75dd87cbd8ull, 0x09a7f12442d588f3ull,
+    0xb7dcbf5354e9beceull, 0x0c11ed6d538aeb30ull, 0xe5d3ef282a242e81ull, 0x8f1668c8a86da5fbull,
+    0x8fa475791a569d10ull, 0xf96e017d694487bdull, 0xb38d92d760ec4455ull, 0x37c981dcc395a9adull,
+    0xe070f78d3927556aull, 0x85bbe253f47b1418ull, 0x8c469ab843b89562ull, 0x93956d7478ccec8full,
+    0xaf58416654a6babbull, 0x387ac8d1970027b3ull, 0xdb2e51bfe9d0696aull, 0x06997b05fcc0319full,
+    0x88fcf317f22241e2ull, 0x441fece3bdf81f04ull, 0xab3c2fddeeaad25aull, 0xd527e81cad7626c4ull,
+    0xd60b3bd56a5586f1ull, 0x8a71e223d8d3b075ull, 0x85c7056562757456ull, 0xf6872d5667844e4aull,
+    0xa738c6bebb12d16cull, 0xb428f8ac016561dcull, 0xd106f86e69d785c7ull, 0xe13336d701beba53ull,
+    0x82a45b450226b39cull, 0xecc0024661173474ull, 0xa34d721642b06084ull, 0x27f002d7f95d0191ull,
+    0xcc20ce9bd35c78a5ull, 0x31ec038df7b441f5ull, 0xff290242c83396ceull, 0x7e67047175a15272ull,
+    0x9f79a169bd203e41ull, 0x0f0062c6e984d387ull, 0xc75809c42c684dd1ull, 0x52c07b78a3e60869ull,
+    0xf92e0c3537826145ull, 0xa7709a56ccdf8a83ull, 0x9bbcc7a142b17ccbull, 0x88a66076400bb692ull,
+    0xc2abf989935ddbfeull, 0x6acff893d00ea436ull, 0xf356f7ebf83552feull, 0x0583f6b8c4124d44ull,
+    0x98165af37b2153deull, 0xc3727a337a8b704bull, 0xbe1bf1b059e9a8d6ull, 0x744f18c0592e4c5dull,
+    0xeda2ee1c7064130cull, 0x1162def06f79df74ull, 0x9485d4d1c63e8be7ull, 0x8addcb5645ac2ba9ull,
+    0xb9a74a0637ce2ee1ull, 0x6d953e2bd7173693ull, 0xe8111c87c5c1ba99ull, 0xc8fa8db6ccdd0438ull,
+    0x910ab1d4db9914a0ull, 0x1d9c9892400a22a3ull, 0xb54d5e4a127f59c8ull, 0x2503beb6d00cab4cull,
+    0xe2a0b5dc971f303aull, 0x2e44ae64840fd61eull, 0x8da471a9de737e24ull, 0x5ceaecfed289e5d3ull,
+    0xb10d8e1456105dadull, 0x7425a83e872c5f48ull, 0xdd50f1996b947518ull, 0xd12f124e28f7771aull,
+    0x8a5296ffe33cc92full, 0x82bd6b70d99aaa70ull, 0xace73cbfdc0bfb7bull, 0x636cc64d1001550cull,
+    0xd8210befd30efa5aull, 0x3c47f7e05401aa4full, 0x8714a775e3e95c78ull, 0x65acfaec34810a72ull,
+    0xa8d9d1535ce3b396ull, 0x7f1839a741a14d0eull, 0xd31045a8341ca07cull, 0x1ede48111209a051ull,
+    0x83ea2b892091e44dull, 0x934aed0aab460433ull, 0xa4e4b66b68b65d60ull, 0xf81da84d56178540ull,
+    0xce1de40642e3f4b9ull, 0x36251260ab9d668full, 0x80d2ae83e9ce78f3ull, 0xc1d72b7c6b42601aull,
+    0xa1075a24e4421730ull, 0xb24cf65b8612f820ull, 0xc94930ae1d529cfcull, 0xdee033f26797b628ull,
+    0xfb9b7cd9a4a7443cull, 0x169840ef017da3b2ull, 0x9d412e0806e88aa5ull, 0x8e1f289560ee864full,
+    0xc491798a08a2ad4eull, 0xf1a6f2bab92a27e3ull, 0xf5b5d7ec8acb58a2ull, 0xae10af696774b1dcull,
+    0x9991a6f3d6bf1765ull, 0xacca6da1e0a8ef2aull, 0xbff610b0cc6edd3full, 0x17fd090a58d32af4ull,
+    0xeff394dcff8a948eull, 0xddfc4b4cef07f5b1ull, 0x95f83d0a1fb69cd9ull, 0x4abdaf101564f98full,
+    0xbb764c4ca7a4440full, 0x9d6d1ad41abe37f2ull, 0xea53df5fd18d5513ull, 0x84c86189216dc5eeull,
+    0x92746b9be2f8552cull, 0x32fd3cf5b4e49bb5ull, 0xb7118682dbb66a77ull, 0x3fbc8c33221dc2a2ull,
+    0xe4d5e82392a40515ull, 0x0fabaf3feaa5334bull, 0x8f05b1163ba6832dull, 0x29cb4d87f2a7400full,
+    0xb2c71d5bca9023f8ull, 0x743e20e9ef511013ull, 0xdf78e4b2bd342cf6ull, 0x914da9246b255417ull,
+    0x8bab8eefb6409c1aull, 0x1ad089b6c2f7548full, 0xae9672aba3d0c320ull, 0xa184ac2473b529b2ull,
+    0xda3c0f568cc4f3e8ull, 0xc9e5d72d90a2741full, 0x8865899617fb1871ull, 0x7e2fa67c7a658893ull,
+    0xaa7eebfb9df9de8dull, 0xddbb901b98feeab8ull, 0xd51ea6fa85785631ull, 0x552a74227f3ea566ull,
+    0x8533285c936b35deull, 0xd53a88958f872760ull, 0xa67ff273b8460356ull, 0x8a892abaf368f138ull,
+    0xd01fef10a657842cull, 0x2d2b7569b0432d86ull, 0x8213f56a67f6b29bull, 0x9c3b29620e29fc74ull,
+    0xa298f2c501f45f42ull, 0x8349f3ba91b47b90ull, 0xcb3f2f7642717713ull, 0x241c70a936219a74ull,
+    0xfe0efb53d30dd4d7ull, 0xed238cd383aa0111ull, 0x9ec95d1463e8a506ull, 0xf4363804324a40abull,
+    0xc67bb4597ce2ce48ull, 0xb143c6053edcd0d6ull, 0xf81aa16fdc1b81daull, 0xdd94b7868e94050bull,
+    0x9b10a4e5e9913128ull, 0xca7cf2b4191c8327ull, 0xc1d4ce1f63f57d72ull, 0xfd1c2f611f63a3f1ull,
+    0xf24a01a73cf2dccfull, 0xbc633b39673c8cedull, 0x976e41088617ca01ull, 0xd5be0503e085d814ull,
+    0xbd49d14aa79dbc82ull, 0x4b2d8644d8a74e19ull, 0xec9c459d51852ba2ull, 0xddf8e7d60ed1219full,
+    0x93e1ab8252f33b45ull, 0xcabb90e5c942b504ull, 0xb8da1662e7b00a17ull, 0x3d6a751f3b936244ull,
+    0xe7109bfba19c0c9dull, 0x0cc512670a783ad5ull, 0x906a617d450187e2ull, 0x27fb2b80668b24c6ull,
+    0xb484f9dc9641e9daull, 0xb1f9f660802dedf7ull, 0xe1a63853bbd26451ull, 0x5e7873f8a0396974ull,
+    0x8d07e33455637eb2ull, 0xdb0b487b6423e1e9ull, 0xb049dc016abc5e5full, 0x91ce1a9a3d2cda63ull,
+    0xdc5c5301c56b75f7ull, 0x7641a140cc7810fcull, 0x89b9b3e11b6329baull, 0xa9e904c87fcb0a9eull,
+    0xac2820d9623bf429ull, 0x546345fa9fbdcd45ull, 0xd732290fbacaf133ull, 0xa97c177947ad4096ull,
+    0x867f59a9d4bed6c0ull, 0x49ed8eabcccc485eull, 0xa81f301449ee8c70ull, 0x5c68f256bfff5a75ull,
+    0xd226fc195c6a2f8cull, 0x73832eec6fff3112ull, 0x83585d8fd9c25db7ull, 0xc831fd53c5ff7eacull,
+    0xa42e74f3d032f525ull, 0xba3e7ca8b77f5e56ull, 0xcd3a1230c43fb26full, 0x28ce1bd2e55f35ecull,
+    0x80444b5e7aa7cf85ull, 0x7980d163cf5b81b4ull, 0xa0555e361951c366ull, 0xd7e105bcc3326220ull,
+    0xc86ab5c39fa63440ull, 0x8dd9472bf3fefaa8ull, 0xfa856334878fc150ull, 0xb14f98f6f0feb952ull,
+    0x9c935e00d4b9d8d2ull, 0x6ed1bf9a569f33d4ull, 0xc3b8358109e84f07ull, 0x0a862f80ec4700c9ull,
+    0xf4a642e14c6262c8ull, 0xcd27bb612758c0fbull, 0x98e7e9cccfbd7dbdull, 0x8038d51cb897789dull,
+    0xbf21e44003acdd2cull, 0xe0470a63e6bd56c4ull, 0xeeea5d5004981478ull, 0x1858ccfce06cac75ull,
+    0x95527a5202df0ccbull, 0x0f37801e0c43ebc9ull, 0xbaa718e68396cffdull, 0xd30560258f54e6bbull,
+    0xe950df20247c83fdull, 0x47c6b82ef32a206aull, 0x91d28b7416cdd27eull, 0x4cdc331d57fa5442ull,
+    0xb6472e511c81471dull, 0xe0133fe4adf8e953ull, 0xe3d8f9e563a198e5ull, 0x58180fddd97723a7ull,
+    0x8e679c2f5e44ff8full, 0x570f09eaa7ea7649ull, 0xb201833b35d63f73ull, 0x2cd2cc6551e513dbull,
+    0xde81e40a034bcf4full, 0xf8077f7ea65e58d2ull, 0x8b112e86420f6191ull, 0xfb04afaf27faf783ull,
+    0xadd57a27d29339f6ull, 0x79c5db9af1f9b564ull, 0xd94ad8b1c7380874ull, 0x18375281ae7822bdull,
+    0x87cec76f1c830548ull, 0x8f2293910d0b15b6ull, 0xa9c2794ae3a3c69aull, 0xb2eb3875504ddb23ull,
+    0xd433179d9c8cb841ull, 0x5fa60692a46151ecull, 0x849feec281d7f328ull, 0xdbc7c41ba6bcd334ull,
+    0xa5c7ea73224deff3ull, 0x12b9b522906c0801ull, 0xcf39e50feae16befull, 0xd768226b34870a01ull,
+    0x81842f29f2cce375ull, 0xe6a1158300d46641ull, 0xa1e53af46f801c53ull, 0x60495ae3c1097fd1ull,
+    0xca5e89b18b602368ull, 0x385bb19cb14bdfc5ull, 0xfcf62c1dee382c42ull, 0x46729e03dd9ed7b6ull,
+    0x9e19db92b4e31ba9ull, 0x6c07a2c26a8346d2ull
+};
+
+static int sdlang_floor_log2_pow10(int e)
+{
+    /* 1741647 / 2^19 ~ log2(10) */
+    return (e * 1741647) >> 19;
+}
+
+static uint64_t sdlang_round_to_odd64(const uint64_t* g, uint64_t cp)
+{
+    /* g * cp / 2^128, with the lowest bit set if there's a remainder */
+    uint64_t x, y1;
+    const uint64_t y0 = sdlang_mul64(g[0], cp, &y1);
+    uint64_t sum;
+
+    sdlang_mul64(g[1], cp, &x);
+    sum = y0 + x;
+    y1 += sum < x;
+
+    return y1 | (sum > 1);
+}
+
+static uint32_t sdlang_round_to_odd32(uint64_t g, uint32_t cp)
+{
+    /* g * cp / 2^64, with the lowest bit set if there's a remainder */
+    const uint64_t lo = (uint64_t)(uint32_t)g * cp;
+    const uint64_t hi = (g >> 32) * cp + (lo >> 32);
+
+    return (uint32_t)(hi >> 32) | ((uint32_t)hi > 1);
+}
+
+static uint64_t sdlang_shortest_f64(uint64_t bits, int* exponent)
+{
+    /* the shortest w * 10^exponent which rounds to the finite, positive double `bits` */
+    const uint64_t fraction = bits & ((1ull << 52) - 1);
+    const int biased = (int)(bits >> 52) & 0x7ff;
+    const bool closer = fraction == 0 && biased > 1;
+    uint64_t c, cbl, cb, cbr, vbl, vb, vbr, lower, upper, s;
+    const uint64_t* g;
+    int q, k, h;
+    bool even, u_inside, w_inside;
+
+    if (biased != 0)
+    {
+        c = fraction | (1ull << 52);
+        q = biased - 1075;
+
+        if (q <= 0 && q > -53 && (c & ((1ull << -q) - 1)) == 0)
+        {
+            /* small integers */
+            *exponent = 0;
+            return c >> -q;
+        }
+    }
+    else
+    {
+        c = fraction;
+        q = -1074;
+    }
+
+    even = (c & 1) == 0;
+    cbl = 4 * c - 2 + closer;
+    cb = 4 * c;
+    cbr = 4 * c + 2;
+
+    /* floor(log10(2^q)), or of 3/4 2^q if the lower neighbour is closer */
+    k = (q * 1262611 - (closer ? 524031 : 0)) >> 22;
+    h = q + sdlang_floor_log2_pow10(-k) + 1;
+    g = &sdlang_pow10_128[2 * (-k - SDLANG_POW10_MIN)];
+
+    vbl = sdlang_round_to_odd64(g, cbl << h);
+    vb = sdlang_round_to_odd64(g, cb << h);
+    vbr = sdlang_round_to_odd64(g, cbr << h);
+    lower = vbl + !even;
+    upper = vbr - !even;
+    s = vb / 4;
+
+    if (s >= 10)
+    {
+        /* one digit less */
+        const uint64_t sp = s / 10;
+        const bool up_inside = lower <= 40 * sp;
+        const bool wp_inside = 40 * sp + 40 <= upper;
+
+        if (up_inside != wp_inside)
+        {
+            *exponent = k + 1;
+            return sp + wp_inside;
+        }
+    }
+
+    u_inside = lower <= 4 * s;
+    w_inside = 4 * s + 4 <= upper;
+    *exponent = k;
+
+    if (u_inside != w_inside)
+    {
+        return s + w_inside;
+    }
+
+    /* both or none inside, the closer one wins */
+    return s + (vb > 4 * s + 2 || (vb == 4 * s + 2 && (s & 1) != 0));
+}
+
+static uint32_t sdlang_shortest_f32(uint32_t bits, int* exponent)
+{
+    /* same as sdlang_shortest_f64(), with the upper half of the powers of 10 */
+    const uint32_t fraction = bits & ((1u << 23) - 1);
+    const int biased = (int)(bits >> 23) & 0xff;
+    const bool closer = fraction == 0 && biased > 1;
+    uint32_t c, cbl, cb, cbr, vbl, vb, vbr, lower, upper, s;
+    uint64_t g;
+    int q, k, h;
+    bool even, u_inside, w_inside;
+
+    if (biased != 0)
+    {
+        c = fraction | (1u << 23);
+        q = biased - 150;
+
+        if (q <= 0 && q > -24 && (c & ((1u << -q) - 1)) == 0)
+        {
+            *exponent = 0;
+            return c >> -q;
+        }
+    }
+    else
+    {
+        c = fraction;
+        q = -149;
+    }
+
+    even = (c & 1) == 0;
+    cbl = 4 * c - 2 + closer;
+    cb = 4 * c;
+    cbr = 4 * c + 2;
+
+    k = (q * 1262611 - (closer ? 524031 : 0)) >> 22;
+    h = q + sdlang_floor_log2_pow10(-k) + 1;
+
+    /* the upper 64 bits of g - 1, plus 1 */
+    g = sdlang_pow10_128[2 * (-k - SDLANG_POW10_MIN)];
+    g = g - (sdlang_pow10_128[2 * (-k - SDLANG_POW10_MIN) + 1] == 0) + 1;
+
+    vbl = sdlang_round_to_odd32(g, cbl << h);
+    vb = sdlang_round_to_odd32(g, cb << h);
+    vbr = sdlang_round_to_odd32(g, cbr << h);
+    lower = vbl + !even;
+    upper = vbr - !even;
+    s = vb / 4;
+
+    if (s >= 10)
+    {
+        const uint32_t sp = s / 10;
+        const bool up_inside = lower <= 40 * sp;
+        const bool wp_inside = 40 * sp + 40 <= upper;
+
+        if (up_inside != wp_inside)
+        {
+            *exponent = k + 1;
+            return sp + wp_inside;
+        }
+    }
+
+    u_inside = lower <= 4 * s;
+    w_inside = 4 * s + 4 <= upper;
+    *exponent = k;
+
+    if (u_inside != w_inside)
+    {
+        return s + w_inside;
+    }
+
+    return s + (vb > 4 * s + 2 || (vb == 4 * s + 2 && (s & 1) != 0));
+}
+
+static const char sdlang_digits2[] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+static int sdlang_count_digits(uint64_t v)
+{
+    int n = 1;
+
+    for (; v >= 10000; v /= 10000)
+    {
+        n += 4;
+    }
+
+    return n + (v >= 10) + (v >= 100) + (v >= 1000);
+}
+
+static char* sdlang_format_u64(char* d, uint64_t v, int n)
+{
+    /* writes the n digits of v, two at a time from the end */
+    char* p = d + n;
+
+    for (; v >= 100; v /= 100)
+    {
+        p -= 2;
+        SDLANG_MEMMOVE(p, &sdlang_digits2[2 * (v % 100)], 2);
+    }
+
+    if (v >= 10)
+    {
+        p -= 2;
+        SDLANG_MEMMOVE(p, &sdlang_digits2[2 * v], 2);
+    }
+    else
+    {
+        *--p = (char)('0' + v);
+    }
+
+    return d + n;
+}
+
+static char* sdlang_format_i64(char* d, int64_t v)
+{
+    const uint64_t u = v < 0 ? 0 - (uint64_t)v : (uint64_t)v;
+
+    if (v < 0)
+    {
+        *d++ = '-';
+    }
+
+    return sdlang_format_u64(d, u, sdlang_count_digits(u));
+}
+
+static char* sdlang_format_hex(char* d, uint64_t v, int min_digits)
+{
+    static const char hex[] = "0123456789abcdef";
+    int n = 1;
+
+    while (n < 16 && (v >> (4 * n)) != 0)
+    {
+        ++n;
+    }
+
+    n = n > min_digits ? n : min_digits;
+    *d++ = '0';
+    *d++ = 'x';
+
+    for (int i = n - 1; i >= 0; --i)
+    {
+        *d++ = hex[(v >> (4 * i)) & 15];
+    }
+
+    return d;
+}
+
+static char* sdlang_format_float(char* d, uint64_t w, int exponent)
+{
+    /*
+        w * 10^exponent as "123.45", "0.00012345" or "1.2345e-20", always
+        with a point or an exponent so that it reads back as a float.
+    */
+    int n, point;
+
+    while (w >= 10 && w % 10 == 0)
+    {
+        w /= 10;
+        ++exponent;
+    }
+
+    n = sdlang_count_digits(w);
+    point = n + exponent;
+
+    if (point > 0 && point <= 21)
+    {
+        if (exponent >= 0)
+        {
+            d = sdlang_format_u64(d, w, n);
+            memset(d, '0', (size_t)exponent);
+            d += exponent;
+            *d++ = '.';
+            *d++ = '0';
+        }
+        else
+        {
+            /* shifts the integer digits left to make room for the point */
+            sdlang_format_u64(d + 1, w, n);
+            SDLANG_MEMMOVE(d, d + 1, (size_t)point);
+            d[point] = '.';
+            d += n + 1;
+        }
+    }
+    else if (point <= 0 && point > -6)
+    {
+        *d++ = '0';
+        *d++ = '.';
+        memset(d, '0', (size_t)-point);
+        d = sdlang_format_u64(d - point, w, n);
+    }
+    else
+    {
+        sdlang_format_u64(d + 1, w, n);
+        d[0] = d[1];
+
+        if (n > 1)
+        {
+            d[1] = '.';
+            d += n + 1;
+        }
+        else
+        {
+            d += 1;
+        }
+
+        *d++ = 'e';
+        d = sdlang_format_i64(d, point - 1);
+    }
+
+    return d;
+}
+
+static bool sdlang_writer_flush(struct sdlang_writer_t* writer)
+{
+    if (writer->error == SDLANG_PARSE_OK && writer->used > 0
+        && (*writer->sink)(writer->buffer, writer->used, writer->user) != writer->used)
+    {
+        writer->error = SDLANG_PARSE_ERROR_IO;
+    }
+
+    writer->used = 0;
+
+    return writer->error == SDLANG_PARSE_OK;
+}
+
+static char* sdlang_writer_reserve(struct sdlang_writer_t* writer, size_t size)
+{
+    /* room for at least `size` bytes, or NULL once an error occurred */
+    if (writer->used + size > SDLANG_WRITE_BUFFERSIZE && !sdlang_writer_flush(writer))
+    {
+        return NULL;
+    }
+
+    return writer->error == SDLANG_PARSE_OK ? writer->buffer + writer->used : NULL;
+}
+
+static void sdlang_writer_commit(struct sdlang_writer_t* writer, const char* end)
+{
+    writer->used = (size_t)(end - writer->buffer);
+}
+
+static void sdlang_writer_raw(struct sdlang_writer_t* writer, const char* s, size_t len)
+{
+    /* in pieces, if it doesn't fit the buffer */
+    while (len > 0)
+    {
+        char* d = sdlang_writer_reserve(writer, 1);
+        size_t n = SDLANG_WRITE_BUFFERSIZE - writer->used;
+
+        if (d == NULL)
+        {
+            return;
+        }
+
+        n = n < len ? n : len;
+        SDLANG_MEMMOVE(d, s, n);
+        sdlang_writer_commit(writer, d + n);
+        s += n;
+        len -= n;
+    }
+}
+
+static void sdlang_writer_indent(struct sdlang_writer_t* writer)
+{
+    static const char spaces[] = "                                ";
+
+    for (int depth = writer->depth; depth > 0; depth -= 8)
+    {
+        sdlang_writer_raw(writer, spaces, depth < 8 ? 4 * (size_t)depth : 32);
+    }
+}
+
+static void sdlang_writer_end_line(struct sdlang_writer_t* writer)
+{
+    if (writer->line)
+    {
+        sdlang_writer_raw(writer, "\n", 1);
+        writer->line = false;
+    }
+}
+
+static char* sdlang_writer_value(struct sdlang_writer_t* writer, size_t size)
+{
+    /* separates a value from what's before, and reserves `size` bytes for it */
+    char* d;
+
+    if (!writer->line)
+    {
+        /* anonymous node */
+        sdlang_writer_indent(writer);
+        writer->line = true;
+    }
+
+    if ((d = sdlang_writer_reserve(writer, size + 1)) != NULL && writer->separate)
+    {
+        *d++ = ' ';
+    }
+
+    writer->separate = true;
+
+    return d;
+}
+
+static void sdlang_writer_fail(struct sdlang_writer_t* writer, int error)
+{
+    if (writer->error == SDLANG_PARSE_OK)
+    {
+        writer->error = error;
+    }
+}
+
+static bool sdlang_valid_name(const char* name, size_t len)
+{
+    /* an identifier, which isn't a keyword */
+    static const char* const keywords[] = { "true", "false", "on", "off", "null" };
+    size_t i = name[0] == '_';
+
+    if (i >= len || !((name[i] >= 'a' && name[i] <= 'z') || (name[i] >= 'A' && name[i] <= 'Z')))
+    {
+        return false;
+    }
+
+    for (++i; i < len; ++i)
+    {
+        const char ch = name[i];
+
+        if (!((ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || (ch >= '0' && ch <= '9')
+              || ch == '.' || ch == ':' || ch == '-' || ch == '_' || ch == '$'))
+        {
+            return false;
+        }
+    }
+
+    for (i = 0; i < sizeof(keywords) / sizeof(keywords[0]); ++i)
+    {
+        if (strlen(keywords[i]) == len && memcmp(keywords[i], name, len) == 0)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void sdlang_writer_init(struct sdlang_writer_t* writer,
+    size_t (*sink)(const void* ptr, size_t size, void* user), void* user)
+{
+    writer->sink = sink;
+    writer->user = user;
+    writer->depth = 0;
+    writer->line = writer->separate = false;
+    writer->error = SDLANG_PARSE_OK;
+    writer->used = 0;
+}
+
+int sdlang_writer_finish(struct sdlang_writer_t* writer)
+{
+    while (writer->depth > 0)
+    {
+        sdlang_writer_end_block(writer);
+    }
+
+    sdlang_writer_end_line(writer);
+    sdlang_writer_flush(writer);
+
+    return writer->error;
+}
+
+void sdlang_writer_node(struct sdlang_writer_t* writer, const char* name, size_t len)
+{
+    if (len > 0 && !sdlang_valid_name(name, len))
+    {
+        sdlang_writer_fail(writer, SDLANG_PARSE_ERROR_VALUE);
+        return;
+    }
+
+    sdlang_writer_end_line(writer);
+    sdlang_writer_indent(writer);
+    sdlang_writer_raw(writer, name, len);
+    writer->line = true;
+    writer->separate = len > 0;
+}
+
+void sdlang_writer_attribute(struct sdlang_writer_t* writer, const char* name, size_t len)
+{
+    char* d;
+
+    if (!sdlang_valid_name(name, len))
+    {
+        sdlang_writer_fail(writer, SDLANG_PARSE_ERROR_VALUE);
+        return;
+    }
+
+    if ((d = sdlang_writer_value(writer, 0)) != NULL)
+    {
+        sdlang_writer_commit(writer, d);
+        sdlang_writer_raw(writer, name, len);
+        sdlang_writer_raw(writer, "=", 1);
+    }
+
+    writer->separate = false;
+}
+
+void sdlang_writer_begin_block(struct sdlang_writer_t* writer)
+{
+    char* d = sdlang_writer_value(writer, 2);
+
+    if (d != NULL)
+    {
+        *d++ = '{';
+        *d++ = '\n';
+        sdlang_writer_commit(writer, d);
+    }
+
+    writer->line = false;
+    writer->depth += 1;
+}
+
+void sdlang_writer_end_block(struct sdlang_writer_t* writer)
+{
+    sdlang_writer_end_line(writer);
+
+    if (writer->depth > 0)
+    {
+        writer->depth -= 1;
+        sdlang_writer_indent(writer);
+        sdlang_writer_raw(writer, "}\n", 2);
+    }
+}
+
+void sdlang_writer_i32(struct sdlang_writer_t* writer, int32_t value)
+{
+    char* d = sdlang_writer_value(writer, 16);
+
+    if (d != NULL)
+    {
+        sdlang_writer_commit(writer, sdlang_format_i64(d, value));
+    }
+}
+
+void sdlang_writer_i64(struct sdlang_writer_t* writer, int64_t value)
+{
+    char* d = sdlang_writer_value(writer, 24);
+
+    if (d != NULL)
+    {
+        d = sdlang_format_i64(d, value);
+        *d++ = 'L';
+        sdlang_writer_commit(writer, d);
+    }
+}
+
+void sdlang_writer_i128(struct sdlang_writer_t* writer, int64_t hi, uint64_t lo)
+{
+    /* 32 bit limbs, divided by 10^9 until they're all zero */
+    uint32_t limbs[4];
+    char digits[48];
+    char* p = digits + sizeof(digits);
+    uint64_t h = (uint64_t)hi, l = lo;
+    const bool neg = hi < 0;
+    char* d = sdlang_writer_value(writer, 48);
+
+    if (d == NULL)
+    {
+        return;
+    }
+
+    if (neg)
+    {
+        l = ~l + 1;
+        h = ~h + (l == 0);
+    }
+
+    limbs[0] = (uint32_t)(h >> 32);
+    limbs[1] = (uint32_t)h;
+    limbs[2] = (uint32_t)(l >> 32);
+    limbs[3] = (uint32_t)l;
+
+    do
+    {
+        uint64_t rem = 0;
+
+        for (int i = 0; i < 4; ++i)
+        {
+            const uint64_t cur = (rem << 32) | limbs[i];
+            limbs[i] = (uint32_t)(cur / 1000000000u);
+            rem = cur % 1000000000u;
+        }
+
+        for (int i = 0; i < 9; ++i)
+        {
+            *--p = (char)('0' + rem % 10);
+            rem /= 10;
+        }
+    }
+    while ((limbs[0] | limbs[1] | limbs[2] | limbs[3]) != 0);
+
+    while (p + 1 < digits + sizeof(digits) && *p == '0')
+    {
+        ++p;
+    }
+
+    if (neg)
+    {
+        *d++ = '-';
+    }
+
+    SDLANG_MEMMOVE(d, p, (size_t)(digits + sizeof(digits) - p));
+    d += digits + sizeof(digits) - p;
+    *d++ = 'B';
+    *d++ = 'D';
+    sdlang_writer_commit(writer, d);
+}
+
+void sdlang_writer_u32(struct sdlang_writer_t* writer, uint32_t value)
+{
+    char* d = sdlang_writer_value(writer, 16);
+
+    if (d != NULL)
+    {
+        sdlang_writer_commit(writer, sdlang_format_hex(d, value, 1));
+    }
+}
+
+void sdlang_writer_u64(struct sdlang_writer_t* writer, uint64_t value)
+{
+    /* 9 digits at least, or it reads back as a 32 bit value */
+    char* d = sdlang_writer_value(writer, 24);
+
+    if (d != NULL)
+    {
+        sdlang_writer_commit(writer, sdlang_format_hex(d, value, 9));
+    }
+}
+
+void sdlang_writer_f32(struct sdlang_writer_t* writer, float value)
+{
+    union { float f; uint32_t u; } bits;
+    char* d;
+    int exponent;
+
+    bits.f = value;
+
+    if ((bits.u & 0x7f800000u) == 0x7f800000u)
+    {
+        sdlang_writer_fail(writer, SDLANG_PARSE_ERROR_VALUE);
+        return;
+    }
+
+    if ((d = sdlang_writer_value(writer, 40)) != NULL)
+    {
+        if (bits.u >> 31)
+        {
+            *d++ = '-';
+        }
+
+        if ((bits.u & 0x7fffffffu) == 0)
+        {
+            *d++ = '0';
+            *d++ = '.';
+            *d++ = '0';
+        }
+        else
+        {
+            const uint32_t w = sdlang_shortest_f32(bits.u & 0x7fffffffu, &exponent);
+            d = sdlang_format_float(d, w, exponent);
+        }
+
+        *d++ = 'f';
+        sdlang_writer_commit(writer, d);
+    }
+}
+
+void sdlang_writer_f64(struct sdlang_writer_t* writer, double value)
+{
+    union { double f; uint64_t u; } bits;
+    char* d;
+    int exponent;
+
+    bits.f = value;
+
+    if ((bits.u & 0x7ff0000000000000ull) == 0x7ff0000000000000ull)
+    {
+        sdlang_writer_fail(writer, SDLANG_PARSE_ERROR_VALUE);
+        return;
+    }
+
+    if ((d = sdlang_writer_value(writer, 40)) != NULL)
+    {
+        if (bits.u >> 63)
+        {
+            *d++ = '-';
+        }
+
+        if ((bits.u & 0x7fffffffffffffffull) == 0)
+        {
+            *d++ = '0';
+            *d++ = '.';
+            *d++ = '0';
+        }
+        else
+        {
+            const uint64_t w = sdlang_shortest_f64(bits.u & 0x7fffffffffffffffull, &exponent);
+            d = sdlang_format_float(d, w, exponent);
+        }
+
+        sdlang_writer_commit(writer, d);
+    }
+}
+
+void sdlang_writer_bool(struct sdlang_writer_t* writer, bool value)
+{
+    char* d = sdlang_writer_value(writer, 5);
+
+    if (d != NULL)
+    {
+        SDLANG_MEMMOVE(d, value ? "true" : "false", value ? 4 : 5);
+        sdlang_writer_commit(writer, d + (value ? 4 : 5));
+    }
+}
+
+void sdlang_writer_null(struct sdlang_writer_t* writer)
+{
+    char* d = sdlang_writer_value(writer, 4);
+
+    if (d != NULL)
+    {
+        SDLANG_MEMMOVE(d, "null", 4);
+        sdlang_writer_commit(writer, d + 4);
+    }
+}
+
+void sdlang_writer_string(struct sdlang_writer_t* writer, const char* value, size_t len)
+{
+    const char* e = value + len;
+    char* d = sdlang_writer_value(writer, 1);
+
+    if (d == NULL)
+    {
+        return;
+    }
+
+    *d++ = '"';
+    sdlang_writer_commit(writer, d);
+
+    while (value != e)
+    {
+        /* copies the run up to the next character to escape in one go */
+        const char* esc = sdlang_skip(value, e, '"', '\\', '\n', '\r', false);
+
+        sdlang_writer_raw(writer, value, (size_t)(esc - value));
+
+        if (esc == e || (d = sdlang_writer_reserve(writer, 2)) == NULL)
+        {
+            break;
+        }
+
+        *d++ = '\\';
+        *d++ = *esc == '\n' ? 'n' : *esc == '\r' ? 'r' : *esc;
+        sdlang_writer_commit(writer, d);
+        value = esc + 1;
+    }
+
+    sdlang_writer_raw(writer, "\"", 1);
+}
+
+void sdlang_writer_binary(struct sdlang_writer_t* writer, const void* value, size_t len)
+{
+    static const char base64[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    const unsigned char* s = (const unsigned char*)value;
+    char* d = sdlang_writer_value(writer, 1);
+
+    if (d == NULL)
+    {
+        return;
+    }
+
+    *d++ = '[';
+    sdlang_writer_commit(writer, d);
+
+    while (len > 0)
+    {
+        /* as many groups of 3 bytes as fit the buffer */
+        size_t groups = (SDLANG_WRITE_BUFFERSIZE - writer->used) / 4;
+        groups = groups < (len + 2) / 3 ? groups : (len + 2) / 3;
+
+        if ((d = sdlang_writer_reserve(writer, groups > 0 ? 4 * groups : 4)) == NULL)
+        {
+            return;
+        }
+
+        groups = groups > 0 ? groups : 1;
+
+        for (; groups > 0 && len >= 3; --groups, s += 3, len -= 3)
+        {
+            const uint32_t v = (uint32_t)s[0] << 16 | (uint32_t)s[1] << 8 | s[2];
+
+            *d++ = base64[v >> 18];
+            *d++ = base64[(v >> 12) & 63];
+            *d++ = base64[(v >> 6) & 63];
+            *d++ = base64[v & 63];
+        }
+
+        if (groups > 0 && len > 0)
+        {
+            /* padded tail */
+            const uint32_t v = (uint32_t)s[0] << 16 | (len > 1 ? (uint32_t)s[1] << 8 : 0);
+
+            *d++ = base64[v >> 18];
+            *d++ = base64[(v >> 12) & 63];
+            *d++ = len > 1 ? base64[(v >> 6) & 63] : '=';
+            *d++ = '=';
+            len = 0;
+        }
+
+        sdlang_writer_commit(writer, d);
+    }
+
+    sdlang_writer_raw(writer, "]", 1);
+}
+
+void sdlang_writer_token(struct sdlang_writer_t* writer, const struct sdlang_token_t* token)
+{
+    const char *s = token->string.from, *e = token->string.to;
+    char* d;
+
+    switch (token->type)
+    {
+    case SDLANG_TOKEN_NODE:
+        sdlang_writer_node(writer, s, (size_t)(e - s));
+        return;
+
+    case SDLANG_TOKEN_NODE_END:
+        sdlang_writer_end_line(writer);
+        return;
+
+    case SDLANG_TOKEN_BLOCK:
+        sdlang_writer_begin_block(writer);
+        return;
+
+    case SDLANG_TOKEN_BLOCK_END:
+        sdlang_writer_end_block(writer);
+        return;
+
+    case SDLANG_TOKEN_ATTRIBUTE:
+        sdlang_writer_attribute(writer, s, (size_t)(e - s));
+        return;
+
+    case SDLANG_TOKEN_STRING:
+    case SDLANG_TOKEN_BASE64:
+        /* with the original delimiters, escape sequences stay as they are */
+        s -= 1;
+        e += 1;
+        break;
+
+    default:
+        break;
+    }
+
+    if ((d = sdlang_writer_value(writer, 0)) != NULL)
+    {
+        sdlang_writer_commit(writer, d);
+        sdlang_writer_raw(writer, s, (size_t)(e - s));
+
+        if (token->type == SDLANG_TOKEN_INT128)
+        {
+            sdlang_writer_raw(writer, "BD", 2);
+        }
+    }
+}
+
+/*
+    Queries.
+
+    The query keeps, for each open block, the set of paths which match all
+    of its parents as a bit mask. A node name narrows the set of its block
+    down to the paths whose next step it matches, and splits them into the
+    paths which select its values or attributes, and the paths which go on
+    into its own block. A block with no paths going on is skipped.
+*/
+
+struct sdlang_query_state_t
+{
+    const struct sdlang_query_t* query;
+    void* user;
+
+    /* paths going on in each open block */
+    uint32_t active[SDLANG_PARSE_STACKSIZE + 1];
+    int depth;
+
+    /* the current node, if any, with the paths selecting its values and attributes, or going on */
+    bool node;
+    uint32_t values, attributes, children;
+
+    /* paths selecting the next value, after an attribute name */
+    bool attribute;
+    uint32_t selected;
+
+    /* input stream, for sdlang_query_parse() */
+    size_t (*stream)(void* ptr, size_t size, void* user);
+    void* stream_user;
+};
+
+static bool sdlang_query_step(struct sdlang_query_t* query, const char* name, size_t len,
+                              struct sdlang_query_step_t* step)
+{
+    /* copies the name of a step, which can be a wildcard */
+    if (len == 1 && *name == '*')
+    {
+        *step = (struct sdlang_query_step_t) { 0, 0 };
+        return true;
+    }
+
+    if (!sdlang_valid_name(name, len) || query->names_size + len > SDLANG_QUERY_NAMESIZE)
+    {
+        return false;
+    }
+
+    SDLANG_MEMMOVE(query->names + query->names_size, name, len);
+    *step = (struct sdlang_query_step_t) { (uint16_t)query->names_size, (uint16_t)len };
+    query->names_size += len;
+
+    return true;
+}
+
+static bool sdlang_query_equal(const struct sdlang_query_t* query,
+                               const struct sdlang_query_step_t* step, const char* name, size_t len)
+{
+    return step->length == len && memcmp(query->names + step->name, name, len) == 0;
+}
+
+void sdlang_query_init(struct sdlang_query_t* query,
+    void (*match)(int path, const struct sdlang_token_t* token, void* user))
+{
+    query->match = match;
+    query->num_paths = 0;
+    query->num_steps = 0;
+    query->names_size = 0;
+}
+
+int sdlang_query_add(struct sdlang_query_t* query, const char* path)
+{
+    const int num_steps = query->num_steps;
+    const size_t names_size = query->names_size;
+    const char* p = path;
+    struct sdlang_query_step_t attribute = { 0, 0 };
+
+    if (query->num_paths == SDLANG_QUERY_PATHS)
+    {
+        return -1;
+    }
+
+    for (;;)
+    {
+        const char* e = p + strcspn(p, "/@");
+
+        if (query->num_steps == SDLANG_QUERY_STEPS
+            || !sdlang_query_step(query, p, (size_t)(e - p), &query->steps[query->num_steps]))
+        {
+            break;
+        }
+
+        query->num_steps += 1;
+        p = e;
+
+        if (*p != '/')
+        {
+            /* an attribute name can't be a wildcard */
+            if (*p == '\0'
+                || (sdlang_query_step(query, p + 1, strlen(p + 1), &attribute) && attribute.length != 0))
+            {
+                query->paths[query->num_paths].first = (uint16_t)num_steps;
+                query->paths[query->num_paths].count = (uint16_t)(query->num_steps - num_steps);
+                query->paths[query->num_paths].attribute = attribute;
+
+                return query->num_paths++;
+            }
+
+            break;
+        }
+
+        ++p;
+    }
+
+    query->num_steps = num_steps;
+    query->names_size = names_size;
+
+    return -1;
+}
+
+static void sdlang_query_node(struct sdlang_query_state_t* state, const char* name, size_t len)
+{
+    const struct sdlang_query_t* query = state->query;
+    const int depth = state->depth;
+
+    state->node = true;
+    state->values = state->attributes = state->children = 0;
+
+    for (uint32_t active = state->active[depth]; active != 0; active &= active - 1)
+    {
+        const int i = sdlang_ctz32(active);
+        const struct sdlang_query_step_t* step = &query->steps[query->paths[i].first + depth];
+
+        if (step->length != 0 && !sdlang_query_equal(query, step, name, len))
+        {
+            continue;
+        }
+
+        if (depth + 1 < query->paths[i].count)
+        {
+            state->children |= 1u << i;
+        }
+        else if (query->paths[i].attribute.length != 0)
+        {
+            state->attributes |= 1u << i;
+        }
+        else
+        {
+            state->values |= 1u << i;
+        }
+    }
+}
+
+static void sdlang_query_emit_token(struct sdlang_parser_t* parser,
+                                    const struct sdlang_token_t* token, void* user)
+{
+    struct sdlang_query_state_t* state = (struct sdlang_query_state_t*)user;
+    const struct sdlang_query_t* query = state->query;
+    const char *s = token->string.from, *e = token->string.to;
+    uint32_t selected;
+
+    if (token->type != SDLANG_TOKEN_NODE && token->type != SDLANG_TOKEN_NODE_END
+        && token->type != SDLANG_TOKEN_BLOCK_END && !state->node)
+    {
+        /* values without a name */
+        sdlang_query_node(state, "", 0);
+    }
+
+    switch (token->type)
+    {
+    case SDLANG_TOKEN_NODE:
+        sdlang_query_node(state, s, (size_t)(e - s));
+        state->attribute = false;
+        break;
+
+    case SDLANG_TOKEN_NODE_END:
+        state->node = false;
+        state->attribute = false;
+        break;
+
+    case SDLANG_TOKEN_BLOCK:
+        if (state->children != 0 && state->depth < SDLANG_PARSE_STACKSIZE)
+        {
+            state->active[++state->depth] = state->children;
+        }
+        else
+        {
+            /* nothing to look for inside */
+            sdlang_begin_skip(parser);
+        }
+
+        state->node = false;
+        state->attribute = false;
+        break;
+
+    case SDLANG_TOKEN_BLOCK_END:
+        if (state->depth > 0)
+        {
+            --state->depth;
+        }
+
+        state->node = false;
+        state->attribute = false;
+        break;
+
+    case SDLANG_TOKEN_ATTRIBUTE:
+        state->attribute = true;
+        state->selected = 0;
+
+        for (uint32_t attributes = state->attributes; attributes != 0; attributes &= attributes - 1)
+        {
+            const int i = sdlang_ctz32(attributes);
+
+            if (sdlang_query_equal(query, &query->paths[i].attribute, s, (size_t)(e - s)))
+            {
+                state->selected |= 1u << i;
+            }
+        }
+        break;
+
+    default:
+        selected = state->attribute ? state->selected : state->values;
+        state->attribute = false;
+
+        for (; selected != 0; selected &= selected - 1)
+        {
+            (*query->match)(sdlang_ctz32(selected), token, state->user);
+        }
+        break;
+    }
+}
+
+static void sdlang_query_begin(struct sdlang_query_state_t* state, struct sdlang_parser_t* parser,
+                               const struct sdlang_query_t* query, void* user)
+{
+    const struct sdlang_allocator_t allocator = { sdlang_default_alloc, NULL };
+
+    state->query = query;
+    state->user = user;
+    state->active[0] = query->num_paths < 32 ? (1u << query->num_paths) - 1 : ~0u;
+    state->depth = 0;
+    state->node = state->attribute = false;
+    state->stream = NULL;
+
+    sdlang_parser_init(parser);
+    sdlang_parser_set_emit_token(parser, sdlang_query_emit_token);
+    sdlang_parser_set_report_error(parser, sdlang_user_report_error);
+    sdlang_parser_set_allocator(parser, &allocator);
+}
+
+static int sdlang_query_end(struct sdlang_parser_t* parser, int err)
+{
+    sdlang_parser_release(parser);
+    return err;
+}
+
+static size_t sdlang_query_stream(void* ptr, size_t size, void* user)
+{
+    struct sdlang_query_state_t* state = (struct sdlang_query_state_t*)user;
+    return (*state->stream)(ptr, size, state->stream_user);
+}
+
+int sdlang_query_parse(const struct sdlang_query_t* query,
+    size_t (*stream)(void* ptr, size_t size, void* user), void* user)
+{
+    struct sdlang_query_state_t state;
+    struct sdlang_parser_t parser;
+
+    sdlang_query_begin(&state, &parser, query, user);
+    state.stream = stream;
+    state.stream_user = user;
+
+    return sdlang_query_end(&parser, sdlang_parser_parse(&parser, sdlang_query_stream, &state));
+}
+
+int sdlang_query_parse_buffer(const struct sdlang_query_t* query,
+    const char* buffer, size_t size, void* user)
 {
-    if (emit_functions != NULL)
+    struct sdlang_query_state_t state;
+    struct sdlang_parser_t parser;
+
+    sdlang_query_begin(&state, &parser, query, user);
+
+    return sdlang_query_end(&parser, sdlang_parser_parse_buffer(&parser, buffer, size, &state));
+}
+
+int sdlang_query_parse_file(const struct sdlang_query_t* query, const char* path, void* user)
+{
+    struct sdlang_query_state_t state;
+    struct sdlang_parser_t parser;
+
+    sdlang_query_begin(&state, &parser, query, user);
+
+    return sdlang_query_end(&parser, sdlang_parser_parse_file(&parser, path, &state));
+}
+
+/*
+    Schemas.
+
+    A node key is found by its name and the key of the block it's in, so
+    each path is resolved one hash lookup per node, without comparing the
+    path as a whole. Values are converted in place of the callback which
+    would otherwise receive them, and blocks without keys are skipped like
+    queries skip them.
+*/
+
+#if (SDLANG_SCHEMA_KEYS & (SDLANG_SCHEMA_KEYS - 1)) != 0 || SDLANG_SCHEMA_KEYS > 0x8000
+# error "SDLANG_SCHEMA_KEYS must be a power of two, up to 32768"
+#endif
+
+#if SDLANG_SCHEMA_NAMESIZE > 0x10000
+# error "SDLANG_SCHEMA_NAMESIZE must be at most 65536"
+#endif
+
+struct sdlang_schema_state_t
+{
+    const struct sdlang_schema_t* schema;
+    char* target;
+    uint32_t counts[SDLANG_SCHEMA_KEYS / 2];
+    int err;
+
+    /* key + 1 of each open block, 0 for the top level */
+    uint32_t blocks[SDLANG_PARSE_STACKSIZE + 1];
+    int depth;
+
+    /* the current node and its key + 1, if any */
+    bool node;
+    uint32_t key;
+
+    /* key + 1 of the attribute selecting the next value, after an attribute name */
+    bool attribute;
+    uint32_t selected;
+
+    struct sdlang_parser_t* parser;
+
+    /* input stream, for sdlang_schema_parse() */
+    size_t (*stream)(void* ptr, size_t size, void* user);
+    void* stream_user;
+};
+
+static uint32_t sdlang_schema_slot(uint32_t parent, const char* name, size_t len, bool attribute)
+{
+    return (sdlang_hash(name, len) ^ (parent * 0x9e3779b1u) ^ (uint32_t)attribute) & (SDLANG_SCHEMA_KEYS - 1);
+}
+
+static uint32_t sdlang_schema_find(const struct sdlang_schema_t* schema, uint32_t parent,
+                                   const char* name, size_t len, bool attribute)
+{
+    /* returns the key + 1, or 0 if there's none */
+    for (uint32_t i = sdlang_schema_slot(parent, name, len, attribute); schema->keys[i].length != 0;
+         i = (i + 1) & (SDLANG_SCHEMA_KEYS - 1))
     {
-        emit_functions->node_name[0] = '\0';
-        emit_functions->attr_name[0] = '\0';
+        const struct sdlang_schema_key_t* key = &schema->keys[i];
+
+        if (key->parent == parent && key->length == len && key->attribute == attribute
+            && memcmp(schema->names + key->name, name, len) == 0)
+        {
+            return i + 1;
+        }
     }
 
-    sdlang_user_emit_functions = emit_functions;
+    return 0;
 }
 
-void sdlang_emit_token(const struct sdlang_token_t* token, void* user)
+static uint32_t sdlang_schema_insert(struct sdlang_schema_t* schema, uint32_t parent,
+                                     const char* name, size_t len, bool attribute)
 {
-    struct sdlang_functions_t* vtbl = sdlang_user_emit_functions;
+    /* finds or adds a key, and returns the key + 1, or 0 if the name is malformed or the schema full */
+    uint32_t i = sdlang_schema_find(schema, parent, name, len, attribute);
 
-    if (vtbl == NULL)
+    if (i != 0)
     {
-        return;
+        return i;
     }
 
-    const char* value = token->string.from;
-    const int len = (const int)(token->string.to - value);
+    if (!sdlang_valid_name(name, len) || schema->num_keys == SDLANG_SCHEMA_KEYS / 2
+        || schema->names_size + len > SDLANG_SCHEMA_NAMESIZE)
+    {
+        return 0;
+    }
 
-#define size_minus_one(dst) \
-    ((int)sizeof(vtbl->dst) - 1)
+    for (i = sdlang_schema_slot(parent, name, len, attribute); schema->keys[i].length != 0;
+         i = (i + 1) & (SDLANG_SCHEMA_KEYS - 1))
+    {
+    }
 
-#define safe_copy_value(dst) \
-    strncpy(vtbl->dst, value, len < size_minus_one(dst) ? len : size_minus_one(dst)); \
-    vtbl->dst[len < size_minus_one(dst) ? len : size_minus_one(dst)] = '\0'
+    SDLANG_MEMMOVE(schema->names + schema->names_size, name, len);
+    schema->keys[i] = (struct sdlang_schema_key_t) {
+        .parent = (uint16_t)parent,
+        .name = (uint16_t)schema->names_size,
+        .length = (uint16_t)len,
+        .attribute = attribute
+    };
+    schema->names_size += len;
+    schema->num_keys += 1;
 
-#define safe_call(fn, params) \
-    if (vtbl->fn != NULL) vtbl->fn params
+    if (parent != 0)
+    {
+        schema->keys[parent - 1].children |= !attribute;
+    }
 
-#define safe_emit_value(fn, ...) \
-    if (vtbl->value_##fn != NULL) vtbl->value_##fn(vtbl->node_name, vtbl->attr_name, __VA_ARGS__); \
-    vtbl->attr_name[0] = '\0';
+    return i + 1;
+}
 
-    switch (token->type)
+int sdlang_schema_init(struct sdlang_schema_t* schema,
+                       const struct sdlang_field_t* fields, uint32_t num_fields)
+{
+    memset(schema->keys, 0, sizeof(schema->keys));
+    schema->num_keys = 0;
+    schema->num_fields = 0;
+    schema->names_size = 0;
+
+    if (num_fields > SDLANG_SCHEMA_KEYS / 2)
     {
-    case SDLANG_TOKEN_NODE:
-        {
-            safe_copy_value(node_name);
-        }
-        break;
+        return SDLANG_PARSE_ERROR;
+    }
 
-    case SDLANG_TOKEN_NODE_END:
-        {
-            vtbl->node_name[0] = '\0';
-        }
-        break;
+    for (uint32_t f = 0; f < num_fields; ++f)
+    {
+        const char* p = fields[f].path;
+        uint32_t key = 0;
 
-    case SDLANG_TOKEN_BLOCK:
+        for (;;)
         {
-            safe_call(block_begin, (vtbl->node_name, user));
-        }
-        break;
+            const char* e = p + strcspn(p, "/@");
 
-    case SDLANG_TOKEN_BLOCK_END:
-        {
-            safe_call(block_end, (user));
-        }
-        break;
+            if ((key = sdlang_schema_insert(schema, key, p, (size_t)(e - p), false)) == 0)
+            {
+                return SDLANG_PARSE_ERROR;
+            }
 
-    case SDLANG_TOKEN_ATTRIBUTE:
-        {
-            /* store attribute name */
-            safe_copy_value(attr_name);
+            p = e;
+
+            if (*p == '@')
+            {
+                key = sdlang_schema_insert(schema, key, p + 1, strlen(p + 1), true);
+                break;
+            }
+
+            if (*p++ == '\0')
+            {
+                break;
+            }
         }
-        break;
 
-    case SDLANG_TOKEN_INT32:
+        if (key == 0 || schema->keys[key - 1].field != 0 || fields[f].count == 0
+            || (unsigned)fields[f].type > SDLANG_FIELD_STRING)
         {
-            const long l = strtol(value, NULL, 10);
-            safe_emit_value(i32, l, user);
+            return SDLANG_PARSE_ERROR;
         }
-        break;
 
-    case SDLANG_TOKEN_INT64:
+        schema->keys[key - 1].field = (uint16_t)(f + 1);
+        schema->keys[key - 1].type = (uint8_t)fields[f].type;
+        schema->keys[key - 1].count = fields[f].count;
+        schema->keys[key - 1].offset = fields[f].offset;
+        schema->num_fields += 1;
+    }
+
+    return SDLANG_PARSE_OK;
+}
+
+static bool sdlang_schema_string(struct sdlang_schema_state_t* state, char* dst, uint32_t size,
+                                 const struct sdlang_token_t* token)
+{
+    /* backquoted strings are taken literally */
+    const char *s = token->string.from, *e = token->string.to;
+    const char* esc = token->raw ? e : sdlang_skip(s, e, '\\', '\\', '\\', '\\', false);
+    char* text;
+    int len;
+
+    if (esc == e)
+    {
+        if ((size_t)(e - s) >= size)
         {
-            const long long ll = strtoll(value, NULL, 10);
-            safe_emit_value(i64, ll, user);
+            return false;
         }
-        break;
 
-    case SDLANG_TOKEN_INT128:
-        {
-            int64_t hi = 0;
-            uint64_t lo = 0;
+        SDLANG_MEMMOVE(dst, s, e - s);
+        dst[e - s] = '\0';
+        return true;
+    }
 
-            const char *s = value, *e = &value[len];
-            int64_t sign = 1;
+    /* escapes only shorten the text, which may then fit */
+    if ((size_t)(e - s) < size)
+    {
+        text = dst;
+    }
+    else if ((text = (char*)sdlang_parser_scratch(state->parser, (size_t)(e - s))) == NULL)
+    {
+        return false;
+    }
 
-            if (*s == '-')
-            {
-                sign = -sign;
-                ++s;
-            }
+    SDLANG_MEMMOVE(text, s, esc - s);
+    len = (int)(esc - s) + sdlang_decode_string(esc, (int)(e - esc), text + (esc - s));
 
-            while (s != e)
-            {
-                const uint64_t digit = *s - '0';
+    if ((uint32_t)len >= size)
+    {
+        return false;
+    }
 
-                if (lo * 10 + digit < lo)
-                {
-                    hi = (hi << 4) | (lo >> 48);
-                    lo >>= 4;
-                }
+    if (text != dst)
+    {
+        SDLANG_MEMMOVE(dst, text, len);
+    }
 
-                lo = lo * 10 + digit;
+    dst[len] = '\0';
+    return true;
+}
 
-                ++s;
-            }
+static bool sdlang_schema_store(struct sdlang_schema_state_t* state, const struct sdlang_schema_key_t* key,
+                                const struct sdlang_token_t* token)
+{
+    const enum sdlang_token_type_t type = token->type;
+    const char *s = token->string.from, *e = token->string.to;
+    uint32_t* count = &state->counts[key->field - 1];
+    char* dst = state->target + key->offset;
+    int64_t i = 0;
 
-            hi = sign * hi;
+    if (type == SDLANG_TOKEN_NULL)
+    {
+        return true;
+    }
 
-            safe_emit_value(i128, hi, lo, user);
-        }
-        break;
+    if (*count == key->count && key->type != SDLANG_FIELD_STRING)
+    {
+        return false;
+    }
 
-    case SDLANG_TOKEN_FLOAT32:
+    if (type == SDLANG_TOKEN_INT32 || type == SDLANG_TOKEN_INT64)
+    {
+        i = type == SDLANG_TOKEN_INT32 ? sdlang_decode_i32(s, e) : sdlang_decode_i64(s, e - 1);
+    }
+
+    switch ((enum sdlang_field_type_t)key->type)
+    {
+    case SDLANG_FIELD_I32:
+        if (type != SDLANG_TOKEN_INT32)
         {
-            const float f = strtof(value, NULL);
-            safe_emit_value(f32, f, user);
+            return false;
         }
+
+        ((int32_t*)dst)[*count] = (int32_t)i;
         break;
 
-    case SDLANG_TOKEN_FLOAT64:
+    case SDLANG_FIELD_I64:
+        if (type != SDLANG_TOKEN_INT32 && type != SDLANG_TOKEN_INT64)
         {
-            const double d = strtod(value, NULL);
-            safe_emit_value(f64, d, user);
+            return false;
         }
+
+        ((int64_t*)dst)[*count] = i;
         break;
 
-    case SDLANG_TOKEN_STRING:
+    case SDLANG_FIELD_U32:
+        if (type == SDLANG_TOKEN_UINT32)
         {
-            safe_emit_value(string, value, len, user);
+            i = (int64_t)sdlang_decode_hex(s, e);
         }
-        break;
-
-    case SDLANG_TOKEN_BASE64:
+        else if (type != SDLANG_TOKEN_INT32 || i < 0)
         {
-            safe_emit_value(base64, value, len, user);
+            return false;
         }
+
+        ((uint32_t*)dst)[*count] = (uint32_t)i;
         break;
 
-    case SDLANG_TOKEN_UINT32:
+    case SDLANG_FIELD_U64:
+        if (type == SDLANG_TOKEN_UINT32 || type == SDLANG_TOKEN_UINT64)
         {
-            const unsigned long ul = strtoul(value, NULL, 16);
-            safe_emit_value(u32, ul, user);
+            ((uint64_t*)dst)[*count] = sdlang_decode_hex(s, e);
         }
-        break;
-
-    case SDLANG_TOKEN_UINT64:
+        else if ((type == SDLANG_TOKEN_INT32 || type == SDLANG_TOKEN_INT64) && i >= 0)
         {
-            const unsigned long long ull = strtoull(value, NULL, 16);
-            safe_emit_value(u64, ull, user);
+            ((uint64_t*)dst)[*count] = (uint64_t)i;
+        }
+        else
+        {
+            return false;
         }
         break;
 
-    case SDLANG_TOKEN_TRUE:
+    case SDLANG_FIELD_F32:
+        if (type == SDLANG_TOKEN_FLOAT32 || type == SDLANG_TOKEN_FLOAT64)
         {
-            safe_emit_value(bool, true, user);
+            /* strip 'f' suffix */
+            ((float*)dst)[*count] = sdlang_decode_f32(s, e - (type == SDLANG_TOKEN_FLOAT32));
+        }
+        else if (type == SDLANG_TOKEN_INT32 || type == SDLANG_TOKEN_INT64)
+        {
+            ((float*)dst)[*count] = (float)i;
+        }
+        else
+        {
+            return false;
         }
         break;
 
-    case SDLANG_TOKEN_FALSE:
+    case SDLANG_FIELD_F64:
+        if (type == SDLANG_TOKEN_FLOAT32)
         {
-            safe_emit_value(bool, false, user);
+            ((double*)dst)[*count] = sdlang_decode_f32(s, e - 1);
+        }
+        else if (type == SDLANG_TOKEN_FLOAT64)
+        {
+            ((double*)dst)[*count] = sdlang_decode_f64(s, e);
+        }
+        else if (type == SDLANG_TOKEN_INT32 || type == SDLANG_TOKEN_INT64)
+        {
+            ((double*)dst)[*count] = (double)i;
+        }
+        else
+        {
+            return false;
         }
         break;
 
-    case SDLANG_TOKEN_NULL:
+    case SDLANG_FIELD_BOOL:
+        if (type != SDLANG_TOKEN_TRUE && type != SDLANG_TOKEN_FALSE)
         {
-            safe_emit_value(null, user);
+            return false;
         }
+
+        ((bool*)dst)[*count] = type == SDLANG_TOKEN_TRUE;
         break;
 
-    default:
+    case SDLANG_FIELD_STRING:
+        /* a single string, `count` is the size of the array */
+        if (type != SDLANG_TOKEN_STRING || *count != 0 || !sdlang_schema_string(state, dst, key->count, token))
+        {
+            return false;
+        }
         break;
     }
-}
-
-static void (*sdlang_user_emit_token)(const struct sdlang_token_t*, void*) = sdlang_emit_token;
 
-void sdlang_set_emit_token(void (*emit_token)(const struct sdlang_token_t* token, void* user))
-{
-    sdlang_user_emit_token = emit_token != NULL ? emit_token : sdlang_emit_token;
+    *count += 1;
+    return true;
 }
 
-static void emit(enum sdlang_token_type_t type, const char* ts,
-                 const char* te, int line, void* user)
+static void sdlang_schema_emit_token(struct sdlang_parser_t* parser,
+                                     const struct sdlang_token_t* token, void* user)
 {
-    switch (type)
+    struct sdlang_schema_state_t* state = (struct sdlang_schema_state_t*)user;
+    const struct sdlang_schema_t* schema = state->schema;
+    const char *s = token->string.from, *e = token->string.to;
+    uint32_t selected;
+
+    switch (token->type)
     {
-    case SDLANG_TOKEN_ATTRIBUTE:
-        /* strip trailing '=' */
-        --te;
+    case SDLANG_TOKEN_NODE:
+        state->node = true;
+        state->key = sdlang_schema_find(schema, state->blocks[state->depth], s, (size_t)(e - s), false);
+        state->attribute = false;
         break;
 
-    case SDLANG_TOKEN_INT32:
-    case SDLANG_TOKEN_INT64:
-    case SDLANG_TOKEN_FLOAT32:
-    case SDLANG_TOKEN_FLOAT64:
-        /* strip leading '+' */
-        if (*ts == '+')
+    case SDLANG_TOKEN_NODE_END:
+        state->node = false;
+        state->attribute = false;
+        break;
+
+    case SDLANG_TOKEN_BLOCK:
+        if (state->node && state->key != 0 && schema->keys[state->key - 1].children
+            && state->depth < SDLANG_PARSE_STACKSIZE)
         {
-            ++ts;
+            state->blocks[++state->depth] = state->key;
+        }
+        else
+        {
+            /* nothing to bind inside */
+            sdlang_begin_skip(parser);
         }
+
+        state->node = false;
+        state->attribute = false;
         break;
 
-    case SDLANG_TOKEN_INT128:
-        /* strip leading '+' and suffix */
-        if (*ts == '+')
+    case SDLANG_TOKEN_BLOCK_END:
+        if (state->depth > 0)
         {
-            ++ts;
+            --state->depth;
         }
-        te -= 2;
+
+        state->node = false;
+        state->attribute = false;
         break;
 
-    case SDLANG_TOKEN_STRING:
-    case SDLANG_TOKEN_BASE64:
-        /* strip delimiters */
-        ++ts;
-        --te;
+    case SDLANG_TOKEN_ATTRIBUTE:
+        if (!state->node)
+        {
+            /* attributes without a name */
+            state->node = true;
+            state->key = 0;
+        }
+
+        state->attribute = true;
+        state->selected = state->key != 0
+            ? sdlang_schema_find(schema, state->key, s, (size_t)(e - s), true) : 0;
         break;
 
     default:
+        if (!state->node)
+        {
+            /* values without a name */
+            state->node = true;
+            state->key = 0;
+        }
+
+        selected = state->attribute ? state->selected : state->key;
+        state->attribute = false;
+
+        if (selected != 0 && schema->keys[selected - 1].field != 0
+            && !sdlang_schema_store(state, &schema->keys[selected - 1], token))
+        {
+            state->err = SDLANG_PARSE_ERROR_VALUE;
+            (*parser->report_error)(SDLANG_PARSE_ERROR_VALUE, token->line);
+        }
         break;
     }
+}
 
-    const struct sdlang_token_t token = {
-        .type = type,
-        .string = {
-            .from = ts,
-            .to = te
-        },
-        .line = line
-    };
+static void sdlang_schema_begin(struct sdlang_schema_state_t* state, struct sdlang_parser_t* parser,
+                                const struct sdlang_schema_t* schema, void* target)
+{
+    const struct sdlang_allocator_t allocator = { sdlang_default_alloc, NULL };
+
+    state->schema = schema;
+    state->target = (char*)target;
+    memset(state->counts, 0, sizeof(state->counts));
+    state->err = SDLANG_PARSE_OK;
+    state->blocks[0] = 0;
+    state->depth = 0;
+    state->node = state->attribute = false;
+    state->parser = parser;
+    state->stream = NULL;
 
-    (*sdlang_user_emit_token)(&token, user);
+    sdlang_parser_init(parser);
+    sdlang_parser_set_emit_token(parser, sdlang_schema_emit_token);
+    sdlang_parser_set_report_error(parser, sdlang_user_report_error);
+    sdlang_parser_set_allocator(parser, &allocator);
 }
 
-static void sdlang_report_error(enum sdlang_error_t error, int line)
+static int sdlang_schema_end(struct sdlang_schema_state_t* state, struct sdlang_parser_t* parser,
+                             uint32_t* counts, int err)
 {
-    (void)error;
-    (void)line;
+    if (counts != NULL)
+    {
+        SDLANG_MEMMOVE(counts, state->counts, state->schema->num_fields * sizeof(uint32_t));
+    }
+
+    sdlang_parser_release(parser);
+    return err != SDLANG_PARSE_OK ? err : state->err;
 }
 
-static void (*sdlang_user_report_error)(enum sdlang_error_t error, int line) = sdlang_report_error;
+static size_t sdlang_schema_stream(void* ptr, size_t size, void* user)
+{
+    struct sdlang_schema_state_t* state = (struct sdlang_schema_state_t*)user;
+    return (*state->stream)(ptr, size, state->stream_user);
+}
 
-void sdlang_set_report_error(void (*report_error)(enum sdlang_error_t error, int line))
+int sdlang_schema_parse(const struct sdlang_schema_t* schema, void* target, uint32_t* counts,
+    size_t (*stream)(void* ptr, size_t size, void* user), void* user)
 {
-    sdlang_user_report_error = report_error != NULL ? report_error : sdlang_report_error;
+    struct sdlang_schema_state_t state;
+    struct sdlang_parser_t parser;
+
+    sdlang_schema_begin(&state, &parser, schema, target);
+    state.stream = stream;
+    state.stream_user = user;
+
+    return sdlang_schema_end(&state, &parser, counts,
+                             sdlang_parser_parse(&parser, sdlang_schema_stream, &state));
 }
 
-static void check_stack_size(char** p, char* pe, int top, int line)
+int sdlang_schema_parse_buffer(const struct sdlang_schema_t* schema, void* target, uint32_t* counts,
+    const char* buffer, size_t size)
 {
-    if (top == SDLANG_PARSE_STACKSIZE - 1)
-    {
-        /*
-            trick the FSM into completing the current iteration,
-            then the main loop checks for the stack pointer
-        */
-        *p = pe - 1;
-    }
+    struct sdlang_schema_state_t state;
+    struct sdlang_parser_t parser;
+
+    sdlang_schema_begin(&state, &parser, schema, target);
+
+    return sdlang_schema_end(&state, &parser, counts,
+                             sdlang_parser_parse_buffer(&parser, buffer, size, &state));
 }
 
-#include "sdlang.inl"
+int sdlang_schema_parse_file(const struct sdlang_schema_t* schema, void* target, uint32_t* counts,
+    const char* path)
+{
+    struct sdlang_schema_state_t state;
+    struct sdlang_parser_t parser;
+
+    sdlang_schema_begin(&state, &parser, schema, target);
+
+    return sdlang_schema_end(&state, &parser, counts,
+                             sdlang_parser_parse_file(&parser, path, &state));
+}
@@ -7,15 +7,57 @@
 # define SDLANG_PARSE_BUFFERSIZE 1024
 #endif
 
+#ifndef SDLANG_PARSE_BINARYSIZE
+# define SDLANG_PARSE_BINARYSIZE (SDLANG_PARSE_BUFFERSIZE / 4 * 3)
+#endif
+
 #ifndef SDLANG_PARSE_STACKSIZE
 # define SDLANG_PARSE_STACKSIZE 32
 #endif
 
+#ifndef SDLANG_PARSE_CHUNKSIZE
+# define SDLANG_PARSE_CHUNKSIZE (1 << 20)
+#endif
+
+#ifndef SDLANG_WRITE_BUFFERSIZE
+# define SDLANG_WRITE_BUFFERSIZE (1 << 16)
+#endif
+
+#ifndef SDLANG_QUERY_STEPS
+# define SDLANG_QUERY_STEPS 64
+#endif
+
+#ifndef SDLANG_QUERY_NAMESIZE
+# define SDLANG_QUERY_NAMESIZE 1024
+#endif
+
+#ifndef SDLANG_QUERY_PATHS
+# define SDLANG_QUERY_PATHS 32
+#endif
+
+/* the paths which are still open are tracked in uint32_t masks */
+#if SDLANG_QUERY_PATHS > 32
+# error "SDLANG_QUERY_PATHS must be at most 32"
+#endif
+
+#ifndef SDLANG_SCHEMA_KEYS
+# define SDLANG_SCHEMA_KEYS 512
+#endif
+
+#ifndef SDLANG_SCHEMA_NAMESIZE
+# define SDLANG_SCHEMA_NAMESIZE 4096
+#endif
+
 #ifndef SDLANG_MEMMOVE
 # include <string.h>
 # define SDLANG_MEMMOVE(d, s, n) memmove(d, s, n)
 #endif
 
+#if defined(__SIZEOF_INT128__) && !defined(SDLANG_NO_INT128)
+# define SDLANG_HAVE_INT128
+__extension__ typedef __int128 sdlang_int128_t;
+#endif
+
 #define SDLANG_NODE_MAXNAMELEN 48
 #define SDLANG_ATTR_MAXNAMELEN 48
 
@@ -55,13 +97,43 @@ enum sdlang_token_type_t
 
 /*#
     ### sdlang_error_t
+
+    `SDLANG_PARSE_STOPPED` isn't an error, but the status of a parse which
+    was stopped by the user, see `sdlang_control_t`. It's returned like the
+    error codes, and isn't reported.
 #*/
 enum sdlang_error_t
 {
     SDLANG_PARSE_OK = 0,
     SDLANG_PARSE_ERROR,
     SDLANG_PARSE_ERROR_STACK_OVERFLOW,
-    SDLANG_PARSE_ERROR_BUFFER_TOO_SMALL
+    SDLANG_PARSE_ERROR_BUFFER_TOO_SMALL,
+    SDLANG_PARSE_ERROR_IO,
+    SDLANG_PARSE_ERROR_BASE64,
+    SDLANG_PARSE_ERROR_IMAGE,
+    SDLANG_PARSE_ERROR_VALUE,
+    SDLANG_PARSE_STOPPED
+};
+
+/*#
+    ### sdlang_control_t
+
+    Returned by a control function, see `sdlang_set_emit_control()`.
+
+    - `SDLANG_CONTINUE` passes the token on, and goes on parsing.
+    - `SDLANG_SKIP` for a `SDLANG_TOKEN_BLOCK` token jumps to the matching
+      `}`, without tokenizing the block. Neither the block token, nor any
+      token up to and including the closing brace are passed on. Same as
+      `SDLANG_CONTINUE` for any other token.
+    - `SDLANG_STOP` drops the token, and stops parsing as soon as the
+      scanner gets back to its main loop. No more tokens are passed on, and
+      the parse function returns `SDLANG_PARSE_STOPPED`.
+#*/
+enum sdlang_control_t
+{
+    SDLANG_CONTINUE = 0,
+    SDLANG_SKIP,
+    SDLANG_STOP
 };
 
 /*#
@@ -93,6 +165,12 @@ struct sdlang_token_t
     } string;
 
     int line;
+
+    /* set for strings delimited by backquotes, which are taken literally */
+    bool raw;
+
+    /* symbol id of node and attribute names, see sdlang_symbols_t */
+    uint32_t symbol;
 };
 
 /*#
@@ -110,6 +188,34 @@ struct sdlang_token_t
     If a function pointer is set to `NULL`, any corresponding callback will be
     discarded.
 
+    Numeric values are converted without respect to the current locale.
+    Integers which are out of range for their type are clamped.
+
+    `value_i128` receives 128 bit integers as two's complement, split into
+    the signed upper and the unsigned lower 64 bits. If the compiler supports
+    `__int128`, `SDLANG_HAVE_INT128` is defined, and `value_i128_native` can
+    be used to receive the value in a native type.
+
+    `value_binary` receives the decoded bytes of base64 values. Payloads which
+    don't decode are reported as `SDLANG_PARSE_ERROR_BASE64`, and skipped.
+    Payloads which decode to more than `SDLANG_PARSE_BINARYSIZE` bytes need a
+    parser context with an allocator, or are reported as
+    `SDLANG_PARSE_ERROR_BUFFER_TOO_SMALL`. Parsing continues in both cases.
+    If `value_binary` is set, it is called instead of `value_base64`.
+
+    `value_text` receives string values with escape sequences and line
+    continuations resolved, see `sdlang_decode_string()`. Strings without
+    any backslash, and strings delimited by backquotes, are passed without
+    being copied. Escaped strings longer than `SDLANG_PARSE_BUFFERSIZE`
+    need a parser context with an allocator, or are reported as
+    `SDLANG_PARSE_ERROR_BUFFER_TOO_SMALL`.
+    If `value_text` is set, it is called instead of `value_string`.
+
+    `node_symbol` and `attr_symbol` hold the ids of the current node and
+    attribute name if the parser context has a symbol table, or 0, see
+    `sdlang_symbols_t`. Callbacks read them from the table passed to
+    `sdlang_set_emit_functions()`, or from `functions` of a parser context.
+
     !!! WARNING
         `node_name` and `attr_name` are used internally as a temporary storage
         for node and attribute names. Consider their content read-only during,
@@ -134,6 +240,484 @@ struct sdlang_functions_t
     /* local node/attribute name buffers */
     char node_name[SDLANG_NODE_MAXNAMELEN];
     char attr_name[SDLANG_ATTR_MAXNAMELEN];
+
+    /* appended, so that the members above keep their offsets */
+    void (*value_binary)(const char* node, const char* attr, const unsigned char* ptr, int len, void* user);
+    void (*value_text)(const char* node, const char* attr, const char* ptr, int len, void* user);
+
+    /* interned node/attribute names, used instead of the buffers if set */
+    const char* node;
+    const char* attr;
+
+    /* symbol ids of the current node/attribute name, read-only */
+    uint32_t node_symbol;
+    uint32_t attr_symbol;
+
+    /* last, so that it doesn't move any other member */
+#ifdef SDLANG_HAVE_INT128
+    void (*value_i128_native)(const char* node, const char* attr, sdlang_int128_t value, void* user);
+#endif
+};
+
+/*#
+    ### sdlang_functions_v2_t
+
+    User function table, version 2.
+
+    Same as `sdlang_functions_t`, but node and attribute names are passed as
+    `sdlang_name_t` views of `len` characters, which are neither copied nor
+    truncated, and not null-terminated. Values without an attribute get an
+    empty `attr`. `symbol` is the id of the name if the parser context has a
+    symbol table, in which case `ptr` points to the interned name, see
+    `sdlang_symbols_t`.
+
+    Names point into the input, and stay valid until the node ends - for a
+    node name, or until the value is passed - for an attribute name. When
+    parsing from a stream, the parser keeps both in its buffer across
+    refills, moving them to the front together with any unfinished token
+    instead of copying them on each token. Without an allocator, the names
+    and the token must fit into `SDLANG_PARSE_BUFFERSIZE` together.
+#*/
+struct sdlang_name_t
+{
+    const char* ptr;
+    uint32_t len;
+    uint32_t symbol;
+};
+
+struct sdlang_functions_v2_t
+{
+    void (*block_begin)(struct sdlang_name_t node, void* user);
+    void (*block_end)(void* user);
+    void (*value_i32)(struct sdlang_name_t node, struct sdlang_name_t attr, int32_t value, void* user);
+    void (*value_i64)(struct sdlang_name_t node, struct sdlang_name_t attr, int64_t value, void* user);
+    void (*value_i128)(struct sdlang_name_t node, struct sdlang_name_t attr, int64_t hi, uint64_t lo, void* user);
+    void (*value_f32)(struct sdlang_name_t node, struct sdlang_name_t attr, float value, void* user);
+    void (*value_f64)(struct sdlang_name_t node, struct sdlang_name_t attr, double value, void* user);
+    void (*value_string)(struct sdlang_name_t node, struct sdlang_name_t attr, const char* ptr, int len, void* user);
+    void (*value_text)(struct sdlang_name_t node, struct sdlang_name_t attr, const char* ptr, int len, void* user);
+    void (*value_base64)(struct sdlang_name_t node, struct sdlang_name_t attr, const char* ptr, int len, void* user);
+    void (*value_binary)(struct sdlang_name_t node, struct sdlang_name_t attr, const unsigned char* ptr, int len, void* user);
+    void (*value_u32)(struct sdlang_name_t node, struct sdlang_name_t attr, uint32_t value, void* user);
+    void (*value_u64)(struct sdlang_name_t node, struct sdlang_name_t attr, uint64_t value, void* user);
+    void (*value_bool)(struct sdlang_name_t node, struct sdlang_name_t attr, bool value, void* user);
+    void (*value_null)(struct sdlang_name_t node, struct sdlang_name_t attr, void* user);
+#ifdef SDLANG_HAVE_INT128
+    void (*value_i128_native)(struct sdlang_name_t node, struct sdlang_name_t attr, sdlang_int128_t value, void* user);
+#endif
+};
+
+/*#
+    ### sdlang_allocator_t
+
+    Memory allocator used by a parser context.
+
+    `alloc` follows the semantics of `realloc()`: it's called with `ptr` set
+    to `NULL` to allocate, with an existing block to resize, and with a
+    `size` of zero to free the block at `ptr`.
+
+    ~~~ C
+    void* alloc(void* ptr, size_t size, void* user)
+    {
+        if (size == 0)
+        {
+            free(ptr);
+            return NULL;
+        }
+
+        return realloc(ptr, size);
+    }
+    ~~~
+#*/
+struct sdlang_allocator_t
+{
+    void* (*alloc)(void* ptr, size_t size, void* user);
+    void* user;
+};
+
+/*#
+    ### sdlang_symbols_t
+
+    Symbol table, which maps node and attribute names to dense ids.
+
+    Once a parser context is given a symbol table, each node and attribute
+    name is looked up, and added if it's new. The id is passed in the
+    `symbol` field of `sdlang_token_t`. Function table callbacks receive the
+    interned, untruncated name instead of a copy, and its id in the
+    `node_symbol` and `attr_symbol` members of the table. Ids start at 1,
+    in the order names are added, so names registered with
+    `sdlang_symbols_intern()` before parsing get known ids.
+
+    ~~~ C
+    enum { NAME = 1, PORT };
+
+    sdlang_symbols_init(&symbols, NULL);
+    sdlang_symbols_intern(&symbols, "name", 4);
+    sdlang_symbols_intern(&symbols, "port", 4);
+    sdlang_parser_set_symbols(&parser, &symbols);
+    ~~~
+
+    A table may be shared by several parser contexts, but not used from
+    more than one thread at a time. Names stay valid, and keep their ids,
+    until the table is released. If memory runs out, names get id 0 and
+    are copied as usual.
+#*/
+struct sdlang_symbols_t
+{
+    struct sdlang_allocator_t allocator;
+
+    /* open addressing table of ids */
+    uint32_t* slots;
+    uint32_t capacity, count;
+
+    /* names by id, entry 0 is unused */
+    struct
+    {
+        const char* name;
+        uint32_t length, hash;
+    }* entries;
+
+    /* name pool */
+    char* chunk;
+    size_t chunk_used, chunk_size;
+};
+
+/*#
+    ### sdlang_batch_t
+
+    Token batch, filled by a parser context instead of calling the token
+    callback for each token.
+
+    The caller provides four arrays of `capacity` entries. The parser
+    stores the type, string offset, string length and line of each token
+    at index `count`, and calls `flush` when the batch is full, and at the
+    end of each input chunk, after which `count` starts over. Token strings
+    start at `base + offsets[i]`, and are only valid during `flush`. Tokens
+    without a string have a length of 0. If `raw` points to a fifth array,
+    it gets the `raw` flag of each token, see `sdlang_token_t`.
+
+    ~~~ C
+    void flush(const struct sdlang_batch_t* batch, void* user)
+    {
+        for (uint32_t i = 0; i < batch->count; ++i)
+        {
+            if (batch->types[i] == SDLANG_TOKEN_NODE)
+            {
+                ...
+            }
+        }
+    }
+    ~~~
+#*/
+struct sdlang_batch_t
+{
+    uint8_t* types;
+    uint32_t* offsets;
+    uint32_t* lengths;
+    uint32_t* lines;
+    uint32_t capacity;
+
+    void (*flush)(const struct sdlang_batch_t* batch, void* user);
+
+    /* set by the parser */
+    uint32_t count;
+    const char* base;
+
+    /* optional */
+    uint8_t* raw;
+};
+
+/*#
+    ### sdlang_stats_t
+
+    Input buffer statistics of a parser context, reset with each parse.
+
+    `bytes_read` counts the bytes passed to the FSM, `bytes_copied` counts
+    the bytes moved or copied to the parse buffer to keep unfinished tokens
+    contiguous.
+#*/
+struct sdlang_stats_t
+{
+    size_t bytes_read;
+    size_t bytes_copied;
+};
+
+/*#
+    ### sdlang_parser_t
+
+    Parser context.
+
+    A parser owns its callbacks, a copy of the user function table, the input
+    buffer and the state of the FSM. It doesn't share any data with other
+    parser instances, so each thread can run its own parser without locking.
+
+    The structure is allocated by the caller, and must be initialized with
+    `sdlang_parser_init()`. It must not be copied once initialized. Consider
+    all fields private, with the exception of `stats` which may be read -
+    use the `sdlang_parser_*` functions to configure it.
+#*/
+struct sdlang_parser_t
+{
+    /* user callbacks */
+    void (*emit_token)(struct sdlang_parser_t* parser, const struct sdlang_token_t* token, void* user);
+    enum sdlang_control_t (*emit_control)(struct sdlang_parser_t* parser, const struct sdlang_token_t* token, void* user);
+    void (*report_error)(enum sdlang_error_t error, int line);
+    struct sdlang_functions_t functions;
+    struct sdlang_functions_v2_t functions_v2;
+    void* user;
+
+    /* current names for the version 2 function table */
+    struct sdlang_name_t node, attr;
+
+    /* FSM state */
+    int cs, act, top, curline;
+    int stack[SDLANG_PARSE_STACKSIZE];
+    const char *ts, *te;
+
+    /* block jumped over without tokenizing, see sdlang_query_t */
+    struct
+    {
+        int depth, state;
+        char last;
+    } skip;
+
+    /* set by SDLANG_STOP, see sdlang_control_t */
+    bool stopped;
+
+    /* input buffer */
+    char buffer[SDLANG_PARSE_BUFFERSIZE];
+    char* buf;
+    size_t capacity, have;
+    int error;
+
+    /* decoded string and binary values */
+    void* scratch;
+    size_t scratch_capacity;
+
+    struct sdlang_allocator_t allocator;
+    struct sdlang_symbols_t* symbols;
+    struct sdlang_batch_t* batch;
+    struct sdlang_stats_t stats;
+    int threads;
+};
+
+/*#
+    ### sdlang_document_t
+
+    Document object model, built in a single pass by `sdlang_document_parse()`.
+
+    Nodes, values and attributes are stored in flat arrays, and linked by
+    32 bit indices instead of pointers. Node 0 is the root, which holds the
+    top-level nodes as children - as no other node can link to it, 0 also
+    marks the end of a child or sibling list. The values and attributes of a
+    node are contiguous ranges in their arrays.
+
+    Names, string and binary values and 128 bit integers are kept in the
+    string pool, addressed by byte offsets. Names and string values are
+    null-terminated, escape sequences in strings are resolved. 128 bit
+    integers are stored as a signed upper and an unsigned lower 64 bit half.
+
+    Values which don't follow a node name, as in `"text" 1 2`, are attached
+    to an anonymous node with an empty name.
+
+    All data lives in a single allocation, released by `sdlang_document_free()`.
+    A document can also be compiled to a binary image, and loaded from one
+    without parsing, see `sdlang_document_compile()`.
+#*/
+enum sdlang_value_type_t
+{
+    SDLANG_VALUE_NULL,
+    SDLANG_VALUE_BOOL,
+    SDLANG_VALUE_I32,
+    SDLANG_VALUE_I64,
+    SDLANG_VALUE_I128,
+    SDLANG_VALUE_U32,
+    SDLANG_VALUE_U64,
+    SDLANG_VALUE_F32,
+    SDLANG_VALUE_F64,
+    SDLANG_VALUE_STRING,
+    SDLANG_VALUE_BINARY
+};
+
+struct sdlang_value_t
+{
+    /* enum sdlang_value_type_t */
+    uint32_t type;
+
+    /* byte length of string pool data */
+    uint32_t length;
+
+    union
+    {
+        bool b;
+        int32_t i32;
+        int64_t i64;
+        uint32_t u32;
+        uint64_t u64;
+        float f32;
+        double f64;
+
+        /* string pool offset of strings, binaries and 128 bit integers */
+        uint32_t offset;
+    } data;
+};
+
+struct sdlang_node_t
+{
+    uint32_t name, name_length;
+    uint32_t parent, first_child, next_sibling, num_children;
+    uint32_t values, num_values;
+    uint32_t attributes, num_attributes;
+    uint32_t line;
+};
+
+struct sdlang_attribute_t
+{
+    uint32_t name, name_length;
+    struct sdlang_value_t value;
+};
+
+struct sdlang_document_t
+{
+    const struct sdlang_node_t* nodes;
+    const struct sdlang_value_t* values;
+    const struct sdlang_attribute_t* attributes;
+    const char* strings;
+    uint32_t num_nodes, num_values, num_attributes, strings_size;
+
+    void* arena;
+    size_t arena_size;
+    struct sdlang_allocator_t allocator;
+};
+
+struct sdlang_job_t
+{
+    /* input, a file, or a buffer if path is NULL */
+    const char* path;
+    const char* buffer;
+    size_t size;
+
+    /* forwarded to callbacks */
+    void* user;
+
+    /* if not NULL, the input is parsed into this document instead */
+    struct sdlang_document_t* document;
+
+    /* enum sdlang_error_t */
+    int result;
+};
+
+/*#
+    ### sdlang_writer_t
+
+    Buffered SDLang output, see `sdlang_writer_init()`.
+#*/
+struct sdlang_writer_t
+{
+    size_t (*sink)(const void* ptr, size_t size, void* user);
+    void* user;
+
+    /* open blocks, and the state of the current line */
+    int depth;
+    bool line, separate;
+    int error;
+
+    char buffer[SDLANG_WRITE_BUFFERSIZE];
+    size_t used;
+};
+
+/*#
+    ### sdlang_query_t
+
+    Path queries, see `sdlang_query_add()`. Names are copied into `names`,
+    so the query doesn't refer to the path strings it was built from.
+#*/
+struct sdlang_query_step_t
+{
+    /* offset and length in `names`, or a length of 0 for `*` */
+    uint16_t name, length;
+};
+
+struct sdlang_query_t
+{
+    void (*match)(int path, const struct sdlang_token_t* token, void* user);
+
+    /* the steps of each path, and the attribute it selects, if any */
+    struct
+    {
+        uint16_t first, count;
+        struct sdlang_query_step_t attribute;
+    } paths[SDLANG_QUERY_PATHS];
+    int num_paths;
+
+    struct sdlang_query_step_t steps[SDLANG_QUERY_STEPS];
+    int num_steps;
+
+    char names[SDLANG_QUERY_NAMESIZE];
+    size_t names_size;
+};
+
+/*#
+    ### sdlang_field_t
+
+    Binds the values selected by `path` to `count` elements of `type` at
+    `offset` in a target struct, see `sdlang_schema_init()`. Strings are
+    bound to a `char` array of `count` bytes, which holds a single string.
+#*/
+enum sdlang_field_type_t
+{
+    SDLANG_FIELD_I32,
+    SDLANG_FIELD_I64,
+    SDLANG_FIELD_U32,
+    SDLANG_FIELD_U64,
+    SDLANG_FIELD_F32,
+    SDLANG_FIELD_F64,
+    SDLANG_FIELD_BOOL,
+    SDLANG_FIELD_STRING
+};
+
+struct sdlang_field_t
+{
+    const char* path;
+    enum sdlang_field_type_t type;
+    size_t offset;
+    uint32_t count;
+};
+
+/*#
+    ### sdlang_schema_t
+
+    Compiled field table, see `sdlang_schema_init()`. Each node of a path,
+    and each attribute, is a key in a hash table with linear probing, which
+    is looked up by its name and the key of its parent node. Names are
+    copied into `names`, so the schema doesn't refer to the field table it
+    was built from.
+#*/
+struct sdlang_schema_key_t
+{
+    /* parent key + 1, 0 at the top level */
+    uint16_t parent;
+
+    /* offset and length in `names`, or a length of 0 for an empty slot */
+    uint16_t name, length;
+
+    /* field index + 1, or 0 if the key only leads to other keys */
+    uint16_t field;
+    bool attribute, children;
+
+    /* copied from the field */
+    uint8_t type;
+    uint32_t count;
+    size_t offset;
+};
+
+struct sdlang_schema_t
+{
+    struct sdlang_schema_key_t keys[SDLANG_SCHEMA_KEYS];
+    uint32_t num_keys, num_fields;
+
+    char names[SDLANG_SCHEMA_NAMESIZE];
+    size_t names_size;
 };
 
 /*#
@@ -209,6 +793,52 @@ extern void sdlang_set_emit_token(void (*emit_token)(const struct sdlang_token_t
 #*/
 extern void sdlang_set_emit_functions(struct sdlang_functions_t* emit_functions);
 
+/*#
+    ### sdlang_set_emit_control
+
+    ~~~ C
+    void sdlang_set_emit_control(enum sdlang_control_t (*emit_control)(const struct sdlang_token_t* token, void* user));
+    ~~~
+
+    Sets a control function, which sees each token before the token
+    function does, and decides how the parser goes on, see
+    `sdlang_control_t`. Pass NULL to remove it.
+
+    The token function and the function table don't change, so a control
+    function can be put in front of any of them. A lookup which only needs
+    a few values near the top of a large file can stop as soon as it has
+    them, and skip the blocks it isn't interested in on the way:
+
+    ~~~ C
+    enum sdlang_control_t find_version(const struct sdlang_token_t* token, void* user)
+    {
+        struct lookup_t* lookup = (struct lookup_t*)user;
+
+        switch (token->type)
+        {
+        case SDLANG_TOKEN_NODE:
+            lookup->in_version = token->string.to - token->string.from == 7
+                && memcmp(token->string.from, "version", 7) == 0;
+            return SDLANG_CONTINUE;
+        case SDLANG_TOKEN_BLOCK:
+            return SDLANG_SKIP;
+        case SDLANG_TOKEN_INT32:
+            if (lookup->in_version)
+            {
+                lookup->version = sdlang_token_i32(token);
+                return SDLANG_STOP;
+            }
+            return SDLANG_CONTINUE;
+        default:
+            return SDLANG_CONTINUE;
+        }
+    }
+    ~~~
+
+    Parsers with a control function don't split their input across threads.
+#*/
+extern void sdlang_set_emit_control(enum sdlang_control_t (*emit_control)(const struct sdlang_token_t* token, void* user));
+
 /*#
     ### sdlang_set_report_error
 
@@ -251,6 +881,775 @@ extern void sdlang_set_report_error(void (*report_error)(enum sdlang_error_t err
 #*/
 extern int sdlang_parse(size_t (*stream)(void* ptr, size_t size, void* user), void* user);
 
+/*#
+    ### sdlang_parse_buffer
+
+    ~~~ C
+    int sdlang_parse_buffer(const char* buffer, size_t size, void* user);
+    ~~~
+
+    Parses a SDLang document from a caller-owned memory range.
+
+    The whole range is scanned in one pass, without copying it into the
+    internal parse buffer. In consequence, `SDLANG_PARSE_BUFFERSIZE` doesn't
+    limit the size of literals or string values.
+
+    Token `string` pointers address the memory at `buffer` directly, and stay
+    valid for as long as the caller keeps this memory alive.
+
+    Returns 0 on success, or a positive number which can be mapped to
+    `sdlang_error_t`.
+#*/
+extern int sdlang_parse_buffer(const char* buffer, size_t size, void* user);
+
+/*#
+    ### sdlang_parse_fd
+
+    ~~~ C
+    int sdlang_parse_fd(int fd, void* user);
+    ~~~
+
+    Parses a SDLang document from an open file descriptor.
+
+    Regular files are memory-mapped, with sequential access hints, and then
+    parsed in place like `sdlang_parse_buffer()`. Other descriptors, like
+    pipes or sockets, or platforms without `mmap()` fall back to buffered
+    reads through the internal parse buffer. Reads interrupted by a signal
+    are retried, other read errors stop the parser and are reported as
+    `SDLANG_PARSE_ERROR_IO`.
+
+    The descriptor isn't closed by this function.
+#*/
+extern int sdlang_parse_fd(int fd, void* user);
+
+/*#
+    ### sdlang_parse_file
+
+    ~~~ C
+    int sdlang_parse_file(const char* path, void* user);
+    ~~~
+
+    Opens the file at `path` and parses it with `sdlang_parse_fd()`.
+
+    Returns `SDLANG_PARSE_ERROR_IO` if the file can't be opened.
+#*/
+extern int sdlang_parse_file(const char* path, void* user);
+
+/*#
+    ### sdlang_parser_init
+
+    ~~~ C
+    void sdlang_parser_init(struct sdlang_parser_t* parser);
+    ~~~
+
+    Initializes a parser context. The token function is set to
+    `sdlang_parser_emit_token()`, the function table is empty, and errors are
+    not reported.
+#*/
+extern void sdlang_parser_init(struct sdlang_parser_t* parser);
+
+/*#
+    ### sdlang_parser_emit_token
+
+    ~~~ C
+    void sdlang_parser_emit_token(struct sdlang_parser_t* parser,
+                                  const struct sdlang_token_t* token, void* user);
+    ~~~
+
+    Same as `sdlang_emit_token()`, but translates the token to calls into the
+    function table owned by `parser`.
+#*/
+extern void sdlang_parser_emit_token(struct sdlang_parser_t* parser,
+                                     const struct sdlang_token_t* token, void* user);
+
+/*#
+    ### sdlang_parser_set_emit_token
+
+    ~~~ C
+    void sdlang_parser_set_emit_token(struct sdlang_parser_t* parser,
+        void (*emit_token)(struct sdlang_parser_t* parser,
+                           const struct sdlang_token_t* token, void* user));
+    ~~~
+
+    Same as `sdlang_set_emit_token()`, for a parser context. Pass NULL to set
+    the default function, `sdlang_parser_emit_token()`.
+#*/
+extern void sdlang_parser_set_emit_token(struct sdlang_parser_t* parser,
+    void (*emit_token)(struct sdlang_parser_t* parser,
+                       const struct sdlang_token_t* token, void* user));
+
+/*#
+    ### sdlang_parser_set_emit_control
+
+    ~~~ C
+    void sdlang_parser_set_emit_control(struct sdlang_parser_t* parser,
+        enum sdlang_control_t (*emit_control)(struct sdlang_parser_t* parser,
+                                              const struct sdlang_token_t* token, void* user));
+    ~~~
+
+    Same as `sdlang_set_emit_control()`, for a parser context. The control
+    function isn't called in batch mode, see `sdlang_batch_t`.
+#*/
+extern void sdlang_parser_set_emit_control(struct sdlang_parser_t* parser,
+    enum sdlang_control_t (*emit_control)(struct sdlang_parser_t* parser,
+                                          const struct sdlang_token_t* token, void* user));
+
+/*#
+    ### sdlang_parser_set_emit_functions
+
+    ~~~ C
+    void sdlang_parser_set_emit_functions(struct sdlang_parser_t* parser,
+                                          const struct sdlang_functions_t* emit_functions);
+    ~~~
+
+    Same as `sdlang_set_emit_functions()`, for a parser context. The function
+    table is copied into the parser, so one table can be used to initialize
+    any number of parsers.
+#*/
+extern void sdlang_parser_set_emit_functions(struct sdlang_parser_t* parser,
+                                             const struct sdlang_functions_t* emit_functions);
+
+/*#
+    ### sdlang_parser_set_emit_functions_v2
+
+    ~~~ C
+    void sdlang_parser_set_emit_functions_v2(struct sdlang_parser_t* parser,
+                                             const struct sdlang_functions_v2_t* emit_functions);
+    ~~~
+
+    Copies a version 2 user function table to a parser context, and sets
+    the parser's token callback to dispatch to it. Pass NULL to switch back
+    to the default token callback.
+#*/
+extern void sdlang_parser_set_emit_functions_v2(struct sdlang_parser_t* parser,
+                                                const struct sdlang_functions_v2_t* emit_functions);
+
+/*#
+    ### sdlang_parser_set_report_error
+
+    ~~~ C
+    void sdlang_parser_set_report_error(struct sdlang_parser_t* parser,
+        void (*report_error)(enum sdlang_error_t error, int line));
+    ~~~
+
+    Same as `sdlang_set_report_error()`, for a parser context.
+#*/
+extern void sdlang_parser_set_report_error(struct sdlang_parser_t* parser,
+    void (*report_error)(enum sdlang_error_t error, int line));
+
+/*#
+    ### sdlang_parser_set_allocator
+
+    ~~~ C
+    void sdlang_parser_set_allocator(struct sdlang_parser_t* parser,
+                                     const struct sdlang_allocator_t* allocator);
+    void sdlang_parser_release(struct sdlang_parser_t* parser);
+    ~~~
+
+    Sets the memory allocator of a parser context. Pass NULL to remove it.
+
+    By default, a parser only uses its internal buffer of
+    `SDLANG_PARSE_BUFFERSIZE` bytes, and stops with
+    `SDLANG_PARSE_ERROR_BUFFER_TOO_SMALL` if a token doesn't fit. With an
+    allocator, the buffer doubles in size instead, for as long as a token
+    is unfinished. Tokens which fit are never moved to a new buffer.
+
+    The grown buffer is kept for subsequent parses, until it's returned to
+    the allocator with `sdlang_parser_release()`.
+#*/
+extern void sdlang_parser_set_allocator(struct sdlang_parser_t* parser,
+                                        const struct sdlang_allocator_t* allocator);
+extern void sdlang_parser_release(struct sdlang_parser_t* parser);
+
+/*#
+    ### sdlang_parser_set_batch
+
+    ~~~ C
+    void sdlang_parser_set_batch(struct sdlang_parser_t* parser, struct sdlang_batch_t* batch);
+    ~~~
+
+    Sets the token batch of a parser context. While a batch is set, tokens
+    are stored in the batch, and neither the token callback nor the
+    function tables are called. Pass NULL to remove it.
+#*/
+extern void sdlang_parser_set_batch(struct sdlang_parser_t* parser, struct sdlang_batch_t* batch);
+
+/*#
+    ### sdlang_parser_set_threads
+
+    ~~~ C
+    void sdlang_parser_set_threads(struct sdlang_parser_t* parser, int threads);
+    ~~~
+
+    Sets the number of threads used by `sdlang_parser_parse_buffer()`, and
+    by `sdlang_parser_parse_fd()` and `sdlang_parser_parse_file()` on
+    memory-mapped files. Pass 0 to use one thread per online CPU. The
+    default is 1, which parses on the calling thread.
+
+    Inputs of at least two `SDLANG_PARSE_CHUNKSIZE` blocks are split into
+    chunks of about equal size. Each chunk ends at the first line break
+    after its share of the input which is followed by a name in the first
+    column, as top-level statements usually are, so the input isn't
+    scanned before it's parsed. Worker threads run the state machine on the
+    chunks, and record their tokens. The calling thread delivers the tokens in document order, with correct
+    line numbers, to the token callback, function tables or batch of the
+    parser - so callbacks are never called concurrently, and see the same
+    sequence as with a single thread. If a chunk turns out not to start at
+    the top level, the calling thread continues to parse it sequentially.
+
+    Recorded tokens use memory from the allocator of the parser, or from
+    `realloc()` if none is set - a custom allocator has to be thread-safe
+    when more than one thread is used. Threads need POSIX threads, on other
+    platforms or with `SDLANG_NO_THREADS` defined the setting is ignored.
+#*/
+extern void sdlang_parser_set_threads(struct sdlang_parser_t* parser, int threads);
+
+/*#
+    ### sdlang_parser_set_symbols
+
+    ~~~ C
+    void sdlang_parser_set_symbols(struct sdlang_parser_t* parser, struct sdlang_symbols_t* symbols);
+    ~~~
+
+    Sets the symbol table of a parser context. Pass NULL to remove it.
+#*/
+extern void sdlang_parser_set_symbols(struct sdlang_parser_t* parser, struct sdlang_symbols_t* symbols);
+
+/*#
+    ### sdlang_parser_parse
+
+    ~~~ C
+    int sdlang_parser_parse(struct sdlang_parser_t* parser,
+        size_t (*stream)(void* ptr, size_t size, void* user), void* user);
+    int sdlang_parser_parse_buffer(struct sdlang_parser_t* parser,
+        const char* buffer, size_t size, void* user);
+    int sdlang_parser_parse_fd(struct sdlang_parser_t* parser, int fd, void* user);
+    int sdlang_parser_parse_file(struct sdlang_parser_t* parser, const char* path, void* user);
+    ~~~
+
+    Same as `sdlang_parse()`, `sdlang_parse_buffer()`, `sdlang_parse_fd()` and
+    `sdlang_parse_file()`, using the callbacks and state of a parser context.
+
+    The global functions are thin wrappers around these, with a temporary
+    parser context set up to use the global callbacks.
+#*/
+extern int sdlang_parser_parse(struct sdlang_parser_t* parser,
+    size_t (*stream)(void* ptr, size_t size, void* user), void* user);
+extern int sdlang_parser_parse_buffer(struct sdlang_parser_t* parser,
+    const char* buffer, size_t size, void* user);
+extern int sdlang_parser_parse_fd(struct sdlang_parser_t* parser, int fd, void* user);
+extern int sdlang_parser_parse_file(struct sdlang_parser_t* parser, const char* path, void* user);
+
+/*#
+    ### sdlang_parser_parse_jobs
+
+    ~~~ C
+    int sdlang_parser_parse_jobs(const struct sdlang_parser_t* parser,
+        struct sdlang_job_t* jobs, size_t count);
+    ~~~
+
+    Parses many independent files or buffers at once, e.g. per-entity
+    configuration files at startup.
+
+    Each job gets a parser context of its own, with the callbacks, function
+    tables and allocator of `parser`, and passes its `user` pointer to the
+    callbacks, so they can tell the inputs apart. Jobs with a `document` are
+    parsed into that document instead, see `sdlang_document_parse()`, which
+    is then owned by the caller. The result of each job is stored in its
+    `result` field.
+
+    Jobs run on a pool of `sdlang_parser_set_threads()` threads, including
+    the calling thread. Each thread starts with an equal range of jobs, and
+    steals half of the remaining range of another thread once its own is
+    done, so a few large files don't hold up the rest. Callbacks are called
+    concurrently from different threads then, but never for the same job,
+    and the allocator has to be thread-safe. The symbol table and batch of
+    `parser` aren't used.
+
+    Returns 0 if all jobs succeeded, or the result of the first job which
+    failed.
+#*/
+extern int sdlang_parser_parse_jobs(const struct sdlang_parser_t* parser,
+    struct sdlang_job_t* jobs, size_t count);
+
+/*#
+    ### sdlang_parser_feed
+
+    ~~~ C
+    void sdlang_parser_begin(struct sdlang_parser_t* parser, void* user);
+    int sdlang_parser_feed(struct sdlang_parser_t* parser, const char* data, size_t size);
+    int sdlang_parser_finish(struct sdlang_parser_t* parser);
+    ~~~
+
+    Push-style parsing, for input which arrives in pieces, e.g. from a
+    non-blocking socket.
+
+    `sdlang_parser_begin()` resets the parser and sets the `user` context
+    forwarded to callbacks. Each call to `sdlang_parser_feed()` then scans the
+    bytes passed, and emits all tokens which can be completed. The FSM state
+    is kept in the parser between calls. `sdlang_parser_finish()` marks the
+    end of input, and emits the last pending token.
+
+    Data is scanned in place. Only a token which is split across two calls
+    to `sdlang_parser_feed()` is copied to the parser buffer, which limits
+    the size of such tokens to `SDLANG_PARSE_BUFFERSIZE`, unless an allocator
+    is set. Its rest is copied in steps which double in size, starting at
+    16 bytes, so that at most twice the rest plus 16 bytes are copied before
+    the data is scanned in place again.
+
+    Returns 0 on success, or a positive number which can be mapped to
+    `sdlang_error_t`. Once an error occured, all further calls return the
+    same error until the parser is reset.
+#*/
+extern void sdlang_parser_begin(struct sdlang_parser_t* parser, void* user);
+extern int sdlang_parser_feed(struct sdlang_parser_t* parser, const char* data, size_t size);
+extern int sdlang_parser_finish(struct sdlang_parser_t* parser);
+
+/*#
+    ### sdlang_decode_base64
+
+    ~~~ C
+    int sdlang_decode_base64(const char* src, int len, unsigned char* dst);
+    ~~~
+
+    Decodes `len` characters of base64 text at `src` to `dst`, which must
+    have room for at least `(len + 3) / 4 * 3` bytes. Padding is optional.
+
+    Returns the number of bytes written, or -1 if the text contains invalid
+    characters or misplaced padding.
+#*/
+extern int sdlang_decode_base64(const char* src, int len, unsigned char* dst);
+
+/*#
+    ### sdlang_decode_string
+
+    ~~~ C
+    int sdlang_decode_string(const char* src, int len, char* dst);
+    ~~~
+
+    Resolves escape sequences in `len` characters of string text at `src`,
+    and writes the result to `dst`, which must have room for `len` bytes.
+
+    `\n`, `\r` and `\t` are translated to their control characters. A
+    backslash at the end of a line continues the string on the next line,
+    skipping the line break and any leading blanks. Any other character
+    following a backslash is copied as is.
+
+    Returns the number of bytes written.
+#*/
+extern int sdlang_decode_string(const char* src, int len, char* dst);
+
+/*#
+    ### sdlang_token_i32
+
+    ~~~ C
+    int32_t sdlang_token_i32(const struct sdlang_token_t* token);
+    int64_t sdlang_token_i64(const struct sdlang_token_t* token);
+    void sdlang_token_i128(const struct sdlang_token_t* token, int64_t* hi, uint64_t* lo);
+    uint64_t sdlang_token_u64(const struct sdlang_token_t* token);
+    float sdlang_token_f32(const struct sdlang_token_t* token);
+    double sdlang_token_f64(const struct sdlang_token_t* token);
+    ~~~
+
+    Converts the string of a `SDLANG_TOKEN_INT32`, `SDLANG_TOKEN_INT64`,
+    `SDLANG_TOKEN_INT128`, `SDLANG_TOKEN_UINT32`/`SDLANG_TOKEN_UINT64`,
+    `SDLANG_TOKEN_FLOAT32` or `SDLANG_TOKEN_FLOAT64` token, exactly like the
+    function table does, for consumers of the token callback or batches.
+    `sdlang_token_f32()` also takes a `SDLANG_TOKEN_FLOAT64` token, which it
+    rounds to `float` directly rather than through `double`, so that `f32`
+    fields filled by loaders from `tools/schemac.c` get the same bits as
+    `SDLANG_FIELD_F32` fields of `sdlang_schema_parse()`. The function table
+    still passes `SDLANG_TOKEN_FLOAT64` tokens to `value_f64` only.
+#*/
+extern int32_t sdlang_token_i32(const struct sdlang_token_t* token);
+extern int64_t sdlang_token_i64(const struct sdlang_token_t* token);
+extern void sdlang_token_i128(const struct sdlang_token_t* token, int64_t* hi, uint64_t* lo);
+extern uint64_t sdlang_token_u64(const struct sdlang_token_t* token);
+extern float sdlang_token_f32(const struct sdlang_token_t* token);
+extern double sdlang_token_f64(const struct sdlang_token_t* token);
+
+/*#
+    ### sdlang_symbols_init
+
+    ~~~ C
+    void sdlang_symbols_init(struct sdlang_symbols_t* symbols, const struct sdlang_allocator_t* allocator);
+    void sdlang_symbols_release(struct sdlang_symbols_t* symbols);
+    uint32_t sdlang_symbols_intern(struct sdlang_symbols_t* symbols, const char* name, size_t len);
+    const char* sdlang_symbols_name(const struct sdlang_symbols_t* symbols, uint32_t id);
+    ~~~
+
+    `sdlang_symbols_init()` sets up an empty symbol table, which allocates
+    with `allocator`, or with `realloc()` and `free()` if it is `NULL`.
+    `sdlang_symbols_release()` frees all memory of the table, and empties it.
+
+    `sdlang_symbols_intern()` returns the id of the `len` characters at
+    `name`, and adds them if they aren't in the table yet. Returns 0 if
+    memory runs out.
+
+    `sdlang_symbols_name()` returns the null-terminated name of an id, or
+    `NULL` for an unknown id.
+#*/
+extern void sdlang_symbols_init(struct sdlang_symbols_t* symbols, const struct sdlang_allocator_t* allocator);
+extern void sdlang_symbols_release(struct sdlang_symbols_t* symbols);
+extern uint32_t sdlang_symbols_intern(struct sdlang_symbols_t* symbols, const char* name, size_t len);
+extern const char* sdlang_symbols_name(const struct sdlang_symbols_t* symbols, uint32_t id);
+
+/*#
+    ### sdlang_document_parse
+
+    ~~~ C
+    int sdlang_document_parse(struct sdlang_document_t* doc,
+        size_t (*stream)(void* ptr, size_t size, void* user), void* user,
+        const struct sdlang_allocator_t* allocator);
+    int sdlang_document_parse_buffer(struct sdlang_document_t* doc,
+        const char* buffer, size_t size, const struct sdlang_allocator_t* allocator);
+    int sdlang_document_parse_file(struct sdlang_document_t* doc,
+        const char* path, const struct sdlang_allocator_t* allocator);
+    void sdlang_document_free(struct sdlang_document_t* doc);
+    ~~~
+
+    Parses the input into `doc`. The document, and the parse buffer while
+    parsing, are allocated with `allocator`, or with `realloc()` and `free()`
+    if it is `NULL`. Errors are reported to the global error callback.
+
+    Returns 0 on success, or a positive number which can be mapped to
+    `sdlang_error_t`. Running out of memory is reported as
+    `SDLANG_PARSE_ERROR_BUFFER_TOO_SMALL`. On error, `doc` is left empty.
+
+    `sdlang_document_free()` releases all memory of a document.
+#*/
+extern int sdlang_document_parse(struct sdlang_document_t* doc,
+    size_t (*stream)(void* ptr, size_t size, void* user), void* user,
+    const struct sdlang_allocator_t* allocator);
+extern int sdlang_document_parse_buffer(struct sdlang_document_t* doc,
+    const char* buffer, size_t size, const struct sdlang_allocator_t* allocator);
+extern int sdlang_document_parse_file(struct sdlang_document_t* doc,
+    const char* path, const struct sdlang_allocator_t* allocator);
+extern void sdlang_document_free(struct sdlang_document_t* doc);
+
+/*#
+    ### sdlang_document_compile
+
+    ~~~ C
+    int sdlang_document_compile(const struct sdlang_document_t* doc,
+        void** image, size_t* size, const struct sdlang_allocator_t* allocator);
+    int sdlang_document_save(const struct sdlang_document_t* doc, const char* path);
+    int sdlang_document_load(struct sdlang_document_t* doc, const void* image, size_t size);
+    int sdlang_document_load_file(struct sdlang_document_t* doc, const char* path);
+    ~~~
+
+    Converts a document to a binary image, and back, so that configuration
+    which rarely changes doesn't have to be parsed at every start.
+
+    An image is a versioned header followed by the node, value and attribute
+    arrays, and the string pool of the document, each 8 byte aligned. As all
+    links are indices and offsets, it doesn't depend on where it's loaded.
+    Numbers are stored decoded, strings and binaries decoded, and equal
+    names are stored once. Nodes are stored in breadth-first order, so the
+    children of a node are contiguous, and its `n`-th child is
+    `first_child + n`. Images are only valid on machines of the same byte
+    order.
+
+    `sdlang_document_compile()` allocates the image with `allocator`, or with
+    `realloc()` if it is `NULL`, and `sdlang_document_save()` writes it to a
+    file.
+
+    `sdlang_document_load()` checks the header, a checksum of the whole image,
+    and all indices and offsets, then points `doc` into `image`, which must be
+    8 byte aligned and outlive the document. `sdlang_document_load_file()`
+    memory-maps the file where `mmap()` is available, and reads it into memory
+    otherwise - `sdlang_document_free()` releases it.
+
+    Returns 0 on success, or a positive number which can be mapped to
+    `sdlang_error_t`. Invalid or corrupt images are reported as
+    `SDLANG_PARSE_ERROR_IMAGE` to the global error callback.
+#*/
+extern int sdlang_document_compile(const struct sdlang_document_t* doc,
+    void** image, size_t* size, const struct sdlang_allocator_t* allocator);
+extern int sdlang_document_save(const struct sdlang_document_t* doc, const char* path);
+extern int sdlang_document_load(struct sdlang_document_t* doc, const void* image, size_t size);
+extern int sdlang_document_load_file(struct sdlang_document_t* doc, const char* path);
+
+/*#
+    ### sdlang_document_child
+
+    ~~~ C
+    const char* sdlang_document_name(const struct sdlang_document_t* doc, uint32_t node);
+    uint32_t sdlang_document_child(const struct sdlang_document_t* doc, uint32_t node, const char* name);
+    uint32_t sdlang_document_next(const struct sdlang_document_t* doc, uint32_t node, const char* name);
+    const struct sdlang_value_t* sdlang_document_value(const struct sdlang_document_t* doc,
+                                                       uint32_t node, uint32_t index);
+    const struct sdlang_value_t* sdlang_document_attribute(const struct sdlang_document_t* doc,
+                                                           uint32_t node, const char* name);
+    const void* sdlang_document_data(const struct sdlang_document_t* doc,
+                                     const struct sdlang_value_t* value);
+    ~~~
+
+    Document navigation.
+
+    `sdlang_document_child()` returns the first child of `node` called
+    `name`, and `sdlang_document_next()` the next sibling called `name`, or 0
+    if there is none. Pass `NULL` as `name` to match any node.
+
+    ~~~ C
+    for (uint32_t n = sdlang_document_child(&doc, 0, "file"); n != 0;
+         n = sdlang_document_next(&doc, n, "file"))
+    {
+        const struct sdlang_value_t* v = sdlang_document_value(&doc, n, 0);
+        ...
+    }
+    ~~~
+
+    `sdlang_document_value()` returns the value at `index`, and
+    `sdlang_document_attribute()` the value of the attribute `name` of a
+    node, or `NULL` if there is none. `sdlang_document_data()` returns the
+    string pool data of string, binary and 128 bit integer values.
+#*/
+extern const char* sdlang_document_name(const struct sdlang_document_t* doc, uint32_t node);
+extern uint32_t sdlang_document_child(const struct sdlang_document_t* doc, uint32_t node, const char* name);
+extern uint32_t sdlang_document_next(const struct sdlang_document_t* doc, uint32_t node, const char* name);
+extern const struct sdlang_value_t* sdlang_document_value(const struct sdlang_document_t* doc,
+                                                          uint32_t node, uint32_t index);
+extern const struct sdlang_value_t* sdlang_document_attribute(const struct sdlang_document_t* doc,
+                                                              uint32_t node, const char* name);
+extern const void* sdlang_document_data(const struct sdlang_document_t* doc,
+                                        const struct sdlang_value_t* value);
+
+/*#
+    ### sdlang_writer_init
+
+    ~~~ C
+    void sdlang_writer_init(struct sdlang_writer_t* writer,
+        size_t (*sink)(const void* ptr, size_t size, void* user), void* user);
+    int sdlang_writer_finish(struct sdlang_writer_t* writer);
+    ~~~
+
+    Initializes a writer, which formats SDLang text into its buffer of
+    `SDLANG_WRITE_BUFFERSIZE` bytes, and passes it to `sink` whenever it's
+    full. The sink writes `size` bytes at `ptr`, and returns the number of
+    bytes effectively written, e.g. by calling `fwrite()`.
+
+    `sdlang_writer_finish()` ends the last line, closes open blocks and
+    flushes the buffer.
+
+    Returns 0 on success, or a positive number which can be mapped to
+    `sdlang_error_t`: `SDLANG_PARSE_ERROR_IO` if the sink came up short, or
+    `SDLANG_PARSE_ERROR_VALUE` if a name or value can't be written as
+    SDLang. After an error, nothing more is written.
+#*/
+extern void sdlang_writer_init(struct sdlang_writer_t* writer,
+    size_t (*sink)(const void* ptr, size_t size, void* user), void* user);
+extern int sdlang_writer_finish(struct sdlang_writer_t* writer);
+
+/*#
+    ### sdlang_writer_node
+
+    ~~~ C
+    void sdlang_writer_node(struct sdlang_writer_t* writer, const char* name, size_t len);
+    void sdlang_writer_attribute(struct sdlang_writer_t* writer, const char* name, size_t len);
+    void sdlang_writer_begin_block(struct sdlang_writer_t* writer);
+    void sdlang_writer_end_block(struct sdlang_writer_t* writer);
+    ~~~
+
+    Document structure. `sdlang_writer_node()` starts a node on a new line,
+    an empty name starts an anonymous node. `sdlang_writer_attribute()`
+    writes `name=`, followed by the next value. Blocks open `{` at the end
+    of the current line, and close `}` on a line of their own. Lines are
+    indented by 4 spaces per open block.
+#*/
+extern void sdlang_writer_node(struct sdlang_writer_t* writer, const char* name, size_t len);
+extern void sdlang_writer_attribute(struct sdlang_writer_t* writer, const char* name, size_t len);
+extern void sdlang_writer_begin_block(struct sdlang_writer_t* writer);
+extern void sdlang_writer_end_block(struct sdlang_writer_t* writer);
+
+/*#
+    ### sdlang_writer_i32
+
+    ~~~ C
+    void sdlang_writer_i32(struct sdlang_writer_t* writer, int32_t value);
+    void sdlang_writer_i64(struct sdlang_writer_t* writer, int64_t value);
+    void sdlang_writer_i128(struct sdlang_writer_t* writer, int64_t hi, uint64_t lo);
+    void sdlang_writer_u32(struct sdlang_writer_t* writer, uint32_t value);
+    void sdlang_writer_u64(struct sdlang_writer_t* writer, uint64_t value);
+    void sdlang_writer_f32(struct sdlang_writer_t* writer, float value);
+    void sdlang_writer_f64(struct sdlang_writer_t* writer, double value);
+    void sdlang_writer_bool(struct sdlang_writer_t* writer, bool value);
+    void sdlang_writer_null(struct sdlang_writer_t* writer);
+    void sdlang_writer_string(struct sdlang_writer_t* writer, const char* value, size_t len);
+    void sdlang_writer_binary(struct sdlang_writer_t* writer, const void* value, size_t len);
+    void sdlang_writer_token(struct sdlang_writer_t* writer, const struct sdlang_token_t* token);
+    ~~~
+
+    Writes a value, in the form which reads back as the matching token
+    type: `L` and `BD` suffixes for 64 and 128 bit integers, hexadecimal for
+    unsigned integers (with at least 9 digits for 64 bit ones), and an `f`
+    suffix for 32 bit floats.
+
+    Floats are written as the shortest decimal which reads back to the
+    same value, using the Schubfach algorithm, e.g. `0.1` or `1e-7`.
+    Infinities and NaNs can't be written. Strings are double-quoted, with
+    `"`, `\`, line feeds and carriage returns escaped. Binary data is
+    encoded as base64 in brackets.
+
+    `sdlang_writer_token()` writes a token as read by the parser, so a
+    token callback can copy a document.
+#*/
+extern void sdlang_writer_i32(struct sdlang_writer_t* writer, int32_t value);
+extern void sdlang_writer_i64(struct sdlang_writer_t* writer, int64_t value);
+extern void sdlang_writer_i128(struct sdlang_writer_t* writer, int64_t hi, uint64_t lo);
+extern void sdlang_writer_u32(struct sdlang_writer_t* writer, uint32_t value);
+extern void sdlang_writer_u64(struct sdlang_writer_t* writer, uint64_t value);
+extern void sdlang_writer_f32(struct sdlang_writer_t* writer, float value);
+extern void sdlang_writer_f64(struct sdlang_writer_t* writer, double value);
+extern void sdlang_writer_bool(struct sdlang_writer_t* writer, bool value);
+extern void sdlang_writer_null(struct sdlang_writer_t* writer);
+extern void sdlang_writer_string(struct sdlang_writer_t* writer, const char* value, size_t len);
+extern void sdlang_writer_binary(struct sdlang_writer_t* writer, const void* value, size_t len);
+extern void sdlang_writer_token(struct sdlang_writer_t* writer, const struct sdlang_token_t* token);
+
+/*#
+    ### sdlang_query_init
+
+    ~~~ C
+    void sdlang_query_init(struct sdlang_query_t* query,
+        void (*match)(int path, const struct sdlang_token_t* token, void* user));
+    int sdlang_query_add(struct sdlang_query_t* query, const char* path);
+    ~~~
+
+    Initializes an empty query, and adds paths to it. Returns the index of
+    the path, which is passed to `match` along with each value it selects,
+    or -1 if the path is malformed or the query is full - a query holds up
+    to `SDLANG_QUERY_PATHS` paths, which can't be more than 32, with
+    `SDLANG_QUERY_STEPS` steps and `SDLANG_QUERY_NAMESIZE` bytes of names
+    altogether.
+
+    A path is a list of node names separated by `/`, starting at the top
+    level. It selects the values of the last node, or with a trailing
+    `@name`, the value of that attribute. A step written as `*` matches any
+    node, e.g. `*` followed by `/listen` selects the `listen` nodes in all
+    top-level blocks.
+
+    ~~~ C
+    sdlang_query_add(&query, "renderer:options");     // values of top-level renderer:options nodes
+    sdlang_query_add(&query, "server/listen");        // listen nodes in server blocks
+    sdlang_query_add(&query, "server/listen@port");   // their port attributes
+    ~~~
+
+    Values without a node name, as in `"text" 1 2`, belong to an anonymous
+    node, which only `*` matches.
+#*/
+extern void sdlang_query_init(struct sdlang_query_t* query,
+    void (*match)(int path, const struct sdlang_token_t* token, void* user));
+extern int sdlang_query_add(struct sdlang_query_t* query, const char* path);
+
+/*#
+    ### sdlang_query_parse
+
+    ~~~ C
+    int sdlang_query_parse(const struct sdlang_query_t* query,
+        size_t (*stream)(void* ptr, size_t size, void* user), void* user);
+    int sdlang_query_parse_buffer(const struct sdlang_query_t* query,
+        const char* buffer, size_t size, void* user);
+    int sdlang_query_parse_file(const struct sdlang_query_t* query, const char* path, void* user);
+    ~~~
+
+    Runs a query while parsing, and passes the value tokens selected by
+    its paths to `match`, in document order. Tokens are passed as read, so
+    values are only converted if the callback does so, e.g. with
+    `sdlang_token_i32()`. Token strings are only valid during the call.
+
+    Blocks which none of the paths can look into are fast-forwarded to
+    their closing brace without tokenizing them, so syntax errors inside
+    them aren't reported.
+
+    Returns 0 on success, or a positive number which can be mapped to
+    `sdlang_error_t`. Errors are reported to the global error callback.
+#*/
+extern int sdlang_query_parse(const struct sdlang_query_t* query,
+    size_t (*stream)(void* ptr, size_t size, void* user), void* user);
+extern int sdlang_query_parse_buffer(const struct sdlang_query_t* query,
+    const char* buffer, size_t size, void* user);
+extern int sdlang_query_parse_file(const struct sdlang_query_t* query, const char* path, void* user);
+
+/*#
+    ### sdlang_schema_init
+
+    ~~~ C
+    int sdlang_schema_init(struct sdlang_schema_t* schema,
+                           const struct sdlang_field_t* fields, uint32_t num_fields);
+    ~~~
+
+    Compiles a field table, which binds paths to members of a struct. Paths
+    are written like query paths, see `sdlang_query_add()`, without
+    wildcards.
+
+    ~~~ C
+    struct window_t
+    {
+        char title[64];
+        int32_t size[2];
+        bool fullscreen;
+        float gamma;
+    };
+
+    static const struct sdlang_field_t window_fields[] = {
+        { "window@title", SDLANG_FIELD_STRING, offsetof(struct window_t, title), 64 },
+        { "window/size", SDLANG_FIELD_I32, offsetof(struct window_t, size), 2 },
+        { "window/fullscreen", SDLANG_FIELD_BOOL, offsetof(struct window_t, fullscreen), 1 },
+        { "window/gamma", SDLANG_FIELD_F32, offsetof(struct window_t, gamma), 1 }
+    };
+    ~~~
+
+    Returns `SDLANG_PARSE_OK`, or `SDLANG_PARSE_ERROR` if a path is
+    malformed or bound twice, or the schema is full - a schema holds up to
+    half of `SDLANG_SCHEMA_KEYS` nodes and attributes, with
+    `SDLANG_SCHEMA_NAMESIZE` bytes of names altogether.
+#*/
+extern int sdlang_schema_init(struct sdlang_schema_t* schema,
+                              const struct sdlang_field_t* fields, uint32_t num_fields);
+
+/*#
+    ### sdlang_schema_parse
+
+    ~~~ C
+    int sdlang_schema_parse(const struct sdlang_schema_t* schema, void* target, uint32_t* counts,
+        size_t (*stream)(void* ptr, size_t size, void* user), void* user);
+    int sdlang_schema_parse_buffer(const struct sdlang_schema_t* schema, void* target, uint32_t* counts,
+        const char* buffer, size_t size);
+    int sdlang_schema_parse_file(const struct sdlang_schema_t* schema, void* target, uint32_t* counts,
+        const char* path);
+    ~~~
+
+    Parses a document, and converts the values selected by the fields of a
+    schema straight into `target`, without calling back. Values fill the
+    elements of their field in document order, across all nodes which the
+    path selects, so `size 1920 1080` and two `size` nodes with one value
+    each both fill `int32_t size[2]`. Members without values aren't
+    written, and `null` values are dropped. If `counts` isn't NULL, it
+    receives the number of values stored for each field.
+
+    Values are checked against the type of their field. Integers can be
+    bound to integer fields at least as wide and to float fields, and if
+    they aren't negative, to unsigned fields. Hexadecimal integers can be
+    bound to unsigned fields at least as wide, and floats to float fields
+    of either size. Values of any other type, values beyond
+    the `count` of their field, and strings which don't fit into theirs are
+    reported as `SDLANG_PARSE_ERROR_VALUE`, and dropped.
+
+    Blocks which no path looks into are fast-forwarded to their closing
+    brace, like queries do.
+
+    Returns 0 on success, `SDLANG_PARSE_ERROR_VALUE` if any value was
+    dropped, or another positive number which can be mapped to
+    `sdlang_error_t`. Errors are reported to the global error callback.
+#*/
+extern int sdlang_schema_parse(const struct sdlang_schema_t* schema, void* target, uint32_t* counts,
+    size_t (*stream)(void* ptr, size_t size, void* user), void* user);
+extern int sdlang_schema_parse_buffer(const struct sdlang_schema_t* schema, void* target, uint32_t* counts,
+    const char* buffer, size_t size);
+extern int sdlang_schema_parse_file(const struct sdlang_schema_t* schema, void* target, uint32_t* counts,
+    const char* path);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,409 @@
+#pragma once
+
+#include "sdlang.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/*#
+    ## C++ front end
+
+    ### sdlang::parse
+
+    ~~~ C++
+    template<class Handler> int sdlang::parse(Handler& handler, const char* data, size_t size);
+    template<class Handler> int sdlang::parse(Handler& handler, std::FILE* file);
+    template<class Handler> int sdlang::parse_file(Handler& handler, const char* path);
+    ~~~
+
+    Parses a buffer, a stream or a file, and passes the tokens to the
+    methods of `handler`, which are resolved at compile time. All methods
+    are optional - tokens without a method are dropped, and their values
+    aren't even converted.
+
+    ~~~ C++
+    struct Handler
+    {
+        void on_node(std::string_view name);
+        void on_node_end();
+        void on_block_begin();
+        void on_block_end();
+        void on_attribute(std::string_view name);
+        void on_i32(int32_t value);
+        void on_i64(int64_t value);
+        void on_i128(int64_t hi, uint64_t lo);
+        void on_u32(uint32_t value);
+        void on_u64(uint64_t value);
+        void on_f32(float value);
+        void on_f64(double value);
+        void on_bool(bool value);
+        void on_null();
+        void on_string(std::string_view raw);
+        void on_text(std::string_view text);
+        void on_base64(std::string_view raw);
+        void on_binary(const unsigned char* ptr, size_t len);
+        void on_error(sdlang_error_t error, int line);
+    };
+    ~~~
+
+    Values are converted like the C function table does, `on_text` and
+    `on_binary` receive decoded strings and base64 payloads, and are called
+    instead of `on_string` and `on_base64` if a handler has both. String
+    views are only valid during the call.
+
+    The parser runs the C state machine in batch mode, see
+    `sdlang_batch_t`, so there's a single indirect call per batch, and the
+    handler methods can be inlined into the dispatch loop. Parse buffers
+    grow with `realloc()` as needed.
+
+    Returns 0 on success, or a positive number which can be mapped to
+    `sdlang_error_t`. Errors are passed to `on_error` if the handler has it,
+    or reported to the global error callback otherwise.
+
+    Requires C++17.
+#*/
+
+namespace sdlang
+{
+
+namespace detail
+{
+
+#define SDLANG_HPP_DETECT(name, args)                                                     \
+    template<class H, class = void> struct has_##name : std::false_type {};               \
+    template<class H>                                                                     \
+    struct has_##name<H, std::void_t<decltype(std::declval<H&>().name args)>>             \
+        : std::true_type {};
+
+SDLANG_HPP_DETECT(on_node, (std::string_view()))
+SDLANG_HPP_DETECT(on_node_end, ())
+SDLANG_HPP_DETECT(on_block_begin, ())
+SDLANG_HPP_DETECT(on_block_end, ())
+SDLANG_HPP_DETECT(on_attribute, (std::string_view()))
+SDLANG_HPP_DETECT(on_i32, (int32_t()))
+SDLANG_HPP_DETECT(on_i64, (int64_t()))
+SDLANG_HPP_DETECT(on_i128, (int64_t(), uint64_t()))
+SDLANG_HPP_DETECT(on_u32, (uint32_t()))
+SDLANG_HPP_DETECT(on_u64, (uint64_t()))
+SDLANG_HPP_DETECT(on_f32, (float()))
+SDLANG_HPP_DETECT(on_f64, (double()))
+SDLANG_HPP_DETECT(on_bool, (bool()))
+SDLANG_HPP_DETECT(on_null, ())
+SDLANG_HPP_DETECT(on_string, (std::string_view()))
+SDLANG_HPP_DETECT(on_text, (std::string_view()))
+SDLANG_HPP_DETECT(on_base64, (std::string_view()))
+SDLANG_HPP_DETECT(on_binary, (static_cast<const unsigned char*>(nullptr), size_t()))
+SDLANG_HPP_DETECT(on_error, (sdlang_error_t(), int()))
+
+#undef SDLANG_HPP_DETECT
+
+inline void* alloc(void* ptr, size_t size, void*)
+{
+    if (size == 0)
+    {
+        std::free(ptr);
+        return nullptr;
+    }
+
+    return std::realloc(ptr, size);
+}
+
+inline void ignore_error(sdlang_error_t, int)
+{
+}
+
+template<class Handler>
+class session
+{
+public:
+    static constexpr uint32_t capacity = 256;
+
+    explicit session(Handler& handler)
+        : handler_(handler)
+    {
+        const sdlang_allocator_t allocator = { alloc, nullptr };
+
+        sdlang_parser_init(&parser_);
+        sdlang_parser_set_allocator(&parser_, &allocator);
+
+        if constexpr (has_on_error<Handler>::value)
+        {
+            sdlang_parser_set_report_error(&parser_, ignore_error);
+        }
+
+        batch_ = sdlang_batch_t { types_, offsets_, lengths_, lines_, capacity, &session::flush, 0, nullptr, raw_ };
+        sdlang_parser_set_batch(&parser_, &batch_);
+    }
+
+    ~session()
+    {
+        sdlang_parser_release(&parser_);
+    }
+
+    session(const session&) = delete;
+    session& operator=(const session&) = delete;
+
+    int parse(const char* data, size_t size)
+    {
+        return finish(sdlang_parser_parse_buffer(&parser_, data, size, this));
+    }
+
+    int parse(std::FILE* file)
+    {
+        file_ = file;
+        return finish(sdlang_parser_parse(&parser_, &session::read, this));
+    }
+
+    int parse_file(const char* path)
+    {
+        return finish(sdlang_parser_parse_file(&parser_, path, this));
+    }
+
+private:
+    static size_t read(void* ptr, size_t size, void* user)
+    {
+        return std::fread(ptr, 1, size, static_cast<session*>(user)->file_);
+    }
+
+    static void flush(const sdlang_batch_t* batch, void* user)
+    {
+        static_cast<session*>(user)->dispatch(*batch);
+    }
+
+    int finish(int err)
+    {
+        if constexpr (has_on_error<Handler>::value)
+        {
+            if (err != SDLANG_PARSE_OK)
+            {
+                handler_.on_error(static_cast<sdlang_error_t>(err), parser_.curline);
+            }
+        }
+
+        return err;
+    }
+
+    void dispatch(const sdlang_batch_t& batch)
+    {
+        for (uint32_t i = 0; i < batch.count; ++i)
+        {
+            const char* from = batch.base + batch.offsets[i];
+            const sdlang_token_t token = {
+                static_cast<sdlang_token_type_t>(batch.types[i]),
+                { from, from + batch.lengths[i] },
+                static_cast<int>(batch.lines[i]),
+                batch.raw[i] != 0,
+                0
+            };
+            const std::string_view string(from, batch.lengths[i]);
+
+            switch (token.type)
+            {
+            case SDLANG_TOKEN_NODE:
+                if constexpr (has_on_node<Handler>::value)
+                {
+                    handler_.on_node(string);
+                }
+                break;
+
+            case SDLANG_TOKEN_NODE_END:
+                if constexpr (has_on_node_end<Handler>::value)
+                {
+                    handler_.on_node_end();
+                }
+                break;
+
+            case SDLANG_TOKEN_BLOCK:
+                if constexpr (has_on_block_begin<Handler>::value)
+                {
+                    handler_.on_block_begin();
+                }
+                break;
+
+            case SDLANG_TOKEN_BLOCK_END:
+                if constexpr (has_on_block_end<Handler>::value)
+                {
+                    handler_.on_block_end();
+                }
+                break;
+
+            case SDLANG_TOKEN_ATTRIBUTE:
+                if constexpr (has_on_attribute<Handler>::value)
+                {
+                    handler_.on_attribute(string);
+                }
+                break;
+
+            case SDLANG_TOKEN_INT32:
+                if constexpr (has_on_i32<Handler>::value)
+                {
+                    handler_.on_i32(sdlang_token_i32(&token));
+                }
+                break;
+
+            case SDLANG_TOKEN_INT64:
+                if constexpr (has_on_i64<Handler>::value)
+                {
+                    handler_.on_i64(sdlang_token_i64(&token));
+                }
+                break;
+
+            case SDLANG_TOKEN_INT128:
+                if constexpr (has_on_i128<Handler>::value)
+                {
+                    int64_t hi;
+                    uint64_t lo;
+
+                    sdlang_token_i128(&token, &hi, &lo);
+                    handler_.on_i128(hi, lo);
+                }
+                break;
+
+            case SDLANG_TOKEN_FLOAT32:
+                if constexpr (has_on_f32<Handler>::value)
+                {
+                    handler_.on_f32(sdlang_token_f32(&token));
+                }
+                break;
+
+            case SDLANG_TOKEN_FLOAT64:
+                if constexpr (has_on_f64<Handler>::value)
+                {
+                    handler_.on_f64(sdlang_token_f64(&token));
+                }
+                break;
+
+            case SDLANG_TOKEN_STRING:
+                if constexpr (has_on_text<Handler>::value)
+                {
+                    text(string, token.raw);
+                }
+                else if constexpr (has_on_string<Handler>::value)
+                {
+                    handler_.on_string(string);
+                }
+                break;
+
+            case SDLANG_TOKEN_BASE64:
+                if constexpr (has_on_binary<Handler>::value)
+                {
+                    binary(string, token.line);
+                }
+                else if constexpr (has_on_base64<Handler>::value)
+                {
+                    handler_.on_base64(string);
+                }
+                break;
+
+            case SDLANG_TOKEN_UINT32:
+                if constexpr (has_on_u32<Handler>::value)
+                {
+                    handler_.on_u32(static_cast<uint32_t>(sdlang_token_u64(&token)));
+                }
+                break;
+
+            case SDLANG_TOKEN_UINT64:
+                if constexpr (has_on_u64<Handler>::value)
+                {
+                    handler_.on_u64(sdlang_token_u64(&token));
+                }
+                break;
+
+            case SDLANG_TOKEN_TRUE:
+            case SDLANG_TOKEN_FALSE:
+                if constexpr (has_on_bool<Handler>::value)
+                {
+                    handler_.on_bool(token.type == SDLANG_TOKEN_TRUE);
+                }
+                break;
+
+            case SDLANG_TOKEN_NULL:
+                if constexpr (has_on_null<Handler>::value)
+                {
+                    handler_.on_null();
+                }
+                break;
+
+            default:
+                break;
+            }
+        }
+    }
+
+    void text(std::string_view string, bool raw)
+    {
+        /* backquoted strings are taken literally, like in the C function table */
+        if (raw || string.find('\\') == std::string_view::npos)
+        {
+            handler_.on_text(string);
+            return;
+        }
+
+        text_.resize(string.size());
+        const int len = sdlang_decode_string(string.data(), static_cast<int>(string.size()), text_.data());
+        handler_.on_text(std::string_view(text_.data(), static_cast<size_t>(len)));
+    }
+
+    void binary(std::string_view string, int line)
+    {
+        binary_.resize((string.size() + 3) / 4 * 3);
+        const int len = sdlang_decode_base64(string.data(), static_cast<int>(string.size()), binary_.data());
+
+        if (len >= 0)
+        {
+            handler_.on_binary(binary_.data(), static_cast<size_t>(len));
+        }
+        else if constexpr (has_on_error<Handler>::value)
+        {
+            handler_.on_error(SDLANG_PARSE_ERROR_BASE64, line);
+        }
+        else
+        {
+            (*parser_.report_error)(SDLANG_PARSE_ERROR_BASE64, line);
+        }
+    }
+
+    Handler& handler_;
+    sdlang_parser_t parser_;
+    sdlang_batch_t batch_;
+    std::FILE* file_ = nullptr;
+
+    uint8_t types_[capacity];
+    uint32_t offsets_[capacity];
+    uint32_t lengths_[capacity];
+    uint32_t lines_[capacity];
+    uint8_t raw_[capacity];
+
+    std::vector<char> text_;
+    std::vector<unsigned char> binary_;
+};
+
+} // namespace detail
+
+template<class Handler>
+int parse(Handler& handler, const char* data, size_t size)
+{
+    detail::session<Handler> session(handler);
+    return session.parse(data, size);
+}
+
+template<class Handler>
+int parse(Handler& handler, std::FILE* file)
+{
+    detail::session<Handler> session(handler);
+    return session.parse(file);
+}
+
+template<class Handler>
+int parse_file(Handler& handler, const char* path)
+{
+    detail::session<Handler> session(handler);
+    return session.parse_file(path);
+}
+
+} // namespace sdlang
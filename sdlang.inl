@@ -6,7 +6,7 @@
  ******************************************************************************/
 
 
-/* #line 130 "sdlang.rl" */
+/* #line 145 "sdlang.rl" */
 
 
 
@@ -19,18 +19,15 @@ static const int sdlang_en_block = 24;
 static const int sdlang_en_main = 22;
 
 
-/* #line 133 "sdlang.rl" */
+/* #line 148 "sdlang.rl" */
 
-int sdlang_parse(size_t (*stream)(void* ptr, size_t size, void* user), void* user)
+static void sdlang_init(struct sdlang_parser_t* parser)
 {
-    char buf[SDLANG_PARSE_BUFFERSIZE];
-    int cs, act, have = 0, curline = 1;
-    int stack[SDLANG_PARSE_STACKSIZE], top = 0;
-    char *ts, *te = 0;
-    int done = 0, err = SDLANG_PARSE_OK;
+    int cs, act, top;
+    const char *ts, *te;
 
     
-/* #line 34 "sdlang.inl" */
+/* #line 31 "sdlang.inl" */
 	{
 	cs = sdlang_start;
 	top = 0;
@@ -39,30 +36,37 @@ int sdlang_parse(size_t (*stream)(void* ptr, size_t size, void* user), void* use
 	act = 0;
 	}
 
-/* #line 143 "sdlang.rl" */
-
-    while (!done)
-    {
-        char *p = buf + have, *pe, *eof = 0;
-        int len, space = SDLANG_PARSE_BUFFERSIZE - have;
+/* #line 155 "sdlang.rl" */
 
-        if (space == 0)
-        {
-            err = SDLANG_PARSE_ERROR_BUFFER_TOO_SMALL;
-            break;
-        }
+    parser->cs = cs;
+    parser->act = act;
+    parser->top = top;
+    parser->curline = 1;
+    parser->ts = ts;
+    parser->te = te;
+}
 
-        len = (int)stream(p, space, user);
-        pe = p + len;
+static void sdlang_exec(struct sdlang_parser_t* parser, const char* p,
+                        const char* pe, const char* eof)
+{
+    int cs = parser->cs, act = parser->act, top = parser->top;
+    int curline = parser->curline;
+    int* stack = parser->stack;
+    const char *ts = parser->ts, *te = parser->te;
 
-        if (len < space)
-        {
-            eof = pe;
-            done = 1;
-        }
+    if (parser->skip.depth != 0)
+    {
+        /* a skipped block goes on from the previous buffer */
+        p = sdlang_skip_block(parser, p, pe, &curline);
+    }
+    else if (cs == sdlang_en_c_comment)
+    {
+        /* so does a comment */
+        p = sdlang_skip_comment_body(p, pe, &curline);
+    }
 
-        
-/* #line 66 "sdlang.inl" */
+    
+/* #line 70 "sdlang.inl" */
 	{
 	if ( p == pe )
 		goto _test_eof;
@@ -137,8 +141,8 @@ _again:
 _resume:
 	switch ( cs )
 	{
-tr33:
-/* #line 127 "sdlang.rl" */
+tr36:
+/* #line 142 "sdlang.rl" */
 	{te = p+1;{p--; {
         check_stack_size(&p, pe, top, curline);
     {stack[top++] = 22;goto st24;}}}}
@@ -151,8 +155,8 @@ st22:
 case 22:
 /* #line 1 "NONE" */
 	{ts = p;}
-/* #line 155 "sdlang.inl" */
-	goto tr33;
+/* #line 159 "sdlang.inl" */
+	goto tr36;
 tr1:
 /* #line 16 "sdlang.rl" */
 	{curline += 1;}
@@ -163,7 +167,7 @@ st1:
 	if ( ++p == pe )
 		goto _test_eof1;
 case 1:
-/* #line 167 "sdlang.inl" */
+/* #line 171 "sdlang.inl" */
 	switch( (*p) ) {
 		case 10: goto tr1;
 		case 42: goto st2;
@@ -180,14 +184,14 @@ case 2:
 	}
 	goto st1;
 tr3:
-/* #line 46 "sdlang.rl" */
+/* #line 52 "sdlang.rl" */
 	{{goto st24;}}
 	goto st23;
 st23:
 	if ( ++p == pe )
 		goto _test_eof23;
 case 23:
-/* #line 191 "sdlang.inl" */
+/* #line 195 "sdlang.inl" */
 	goto st0;
 st0:
 cs = 0;
@@ -195,121 +199,130 @@ cs = 0;
 tr4:
 /* #line 16 "sdlang.rl" */
 	{curline += 1;}
-/* #line 119 "sdlang.rl" */
-	{te = p+1;{emit(SDLANG_TOKEN_NODE_END, NULL, NULL, curline, user);}}
+/* #line 134 "sdlang.rl" */
+	{te = p+1;{emit(parser, SDLANG_TOKEN_NODE_END, NULL, NULL, curline);}}
 	goto st24;
 tr8:
-/* #line 81 "sdlang.rl" */
-	{te = p+1;{emit(SDLANG_TOKEN_STRING, ts, te, curline, user);}}
+/* #line 87 "sdlang.rl" */
+	{te = p+1;{emit(parser, SDLANG_TOKEN_STRING, ts, te, curline);}}
 	goto st24;
-tr11:
+tr12:
 /* #line 16 "sdlang.rl" */
 	{curline += 1;}
-/* #line 115 "sdlang.rl" */
-	{te = p+1;{emit(SDLANG_TOKEN_NODE_END, NULL, NULL, curline, user);}}
+/* #line 127 "sdlang.rl" */
+	{te = p+1;{emit(parser, SDLANG_TOKEN_NODE_END, NULL, NULL, curline);}}
 	goto st24;
-tr19:
+tr21:
 /* #line 1 "NONE" */
 	{	switch( act ) {
 	case 5:
-	{{p = ((te))-1;}emit(SDLANG_TOKEN_FLOAT64, ts, te, curline, user);}
+	{{p = ((te))-1;}emit(parser, SDLANG_TOKEN_FLOAT64, ts, te, curline);}
 	break;
 	case 8:
-	{{p = ((te))-1;}emit(SDLANG_TOKEN_INT32, ts, te, curline, user);}
+	{{p = ((te))-1;}emit(parser, SDLANG_TOKEN_INT32, ts, te, curline);}
 	break;
 	case 11:
-	{{p = ((te))-1;}emit(SDLANG_TOKEN_TRUE, ts, te, curline, user);}
+	{{p = ((te))-1;}emit(parser, SDLANG_TOKEN_TRUE, ts, te, curline);}
 	break;
 	case 12:
-	{{p = ((te))-1;}emit(SDLANG_TOKEN_FALSE, ts, te, curline, user);}
+	{{p = ((te))-1;}emit(parser, SDLANG_TOKEN_FALSE, ts, te, curline);}
 	break;
 	case 13:
-	{{p = ((te))-1;}emit(SDLANG_TOKEN_NULL, ts, te, curline, user);}
+	{{p = ((te))-1;}emit(parser, SDLANG_TOKEN_NULL, ts, te, curline);}
 	break;
 	}
 	}
 	goto st24;
-tr22:
-/* #line 88 "sdlang.rl" */
-	{{p = ((te))-1;}{emit(SDLANG_TOKEN_INT32, ts, te, curline, user);}}
-	goto st24;
-tr25:
-/* #line 87 "sdlang.rl" */
-	{te = p+1;{emit(SDLANG_TOKEN_INT128, ts, te, curline, user);}}
+tr24:
+/* #line 94 "sdlang.rl" */
+	{{p = ((te))-1;}{emit(parser, SDLANG_TOKEN_INT32, ts, te, curline);}}
 	goto st24;
-tr26:
-/* #line 116 "sdlang.rl" */
-	{te = p+1;{{goto st1;}}}
+tr27:
+/* #line 93 "sdlang.rl" */
+	{te = p+1;{emit(parser, SDLANG_TOKEN_INT128, ts, te, curline);}}
 	goto st24;
 tr29:
-/* #line 98 "sdlang.rl" */
-	{te = p+1;{emit(SDLANG_TOKEN_BASE64, ts, te, curline, user);}}
+/* #line 128 "sdlang.rl" */
+	{te = p+1;{
+            {p = ((sdlang_skip_comment_body(p + 1, pe, &curline)))-1;}
+            {goto st1;}
+        }}
+	goto st24;
+tr32:
+/* #line 104 "sdlang.rl" */
+	{te = p+1;{emit(parser, SDLANG_TOKEN_BASE64, ts, te, curline);}}
 	goto st24;
-tr30:
+tr33:
 /* #line 16 "sdlang.rl" */
 	{curline += 1;}
-/* #line 118 "sdlang.rl" */
+/* #line 133 "sdlang.rl" */
 	{te = p+1;}
 	goto st24;
-tr34:
-/* #line 121 "sdlang.rl" */
-	{te = p+1;}
+tr37:
+/* #line 136 "sdlang.rl" */
+	{te = p+1;{{p = ((sdlang_skip_blank(p + 1, pe)))-1;}}}
 	goto st24;
-tr40:
-/* #line 103 "sdlang.rl" */
-	{te = p+1;{emit(SDLANG_TOKEN_NODE_END, ts, te, curline, user);}}
+tr43:
+/* #line 109 "sdlang.rl" */
+	{te = p+1;{emit(parser, SDLANG_TOKEN_NODE_END, ts, te, curline);}}
 	goto st24;
-tr47:
-/* #line 105 "sdlang.rl" */
+tr50:
+/* #line 111 "sdlang.rl" */
 	{te = p+1;{
-            emit(SDLANG_TOKEN_BLOCK, ts, te, curline, user);
+            emit(parser, SDLANG_TOKEN_BLOCK, ts, te, curline);
+
+            if (parser->skip.depth == 0)
             {
+                {
         check_stack_size(&p, pe, top, curline);
     {stack[top++] = 24;goto st24;}}
+            }
+
+            {p = ((sdlang_skip_block(parser, p + 1, pe, &curline)))-1;}
         }}
 	goto st24;
-tr48:
-/* #line 110 "sdlang.rl" */
+tr51:
+/* #line 122 "sdlang.rl" */
 	{te = p+1;{
-            emit(SDLANG_TOKEN_BLOCK_END, ts, te, curline, user);
+            emit(parser, SDLANG_TOKEN_BLOCK_END, ts, te, curline);
             {cs = stack[--top];goto _again;}
         }}
 	goto st24;
-tr49:
-/* #line 84 "sdlang.rl" */
-	{te = p;p--;{emit(SDLANG_TOKEN_FLOAT64, ts, te, curline, user);}}
+tr52:
+/* #line 90 "sdlang.rl" */
+	{te = p;p--;{emit(parser, SDLANG_TOKEN_FLOAT64, ts, te, curline);}}
 	goto st24;
-tr50:
-/* #line 83 "sdlang.rl" */
-	{te = p+1;{emit(SDLANG_TOKEN_FLOAT32, ts, te, curline, user);}}
+tr53:
+/* #line 89 "sdlang.rl" */
+	{te = p+1;{emit(parser, SDLANG_TOKEN_FLOAT32, ts, te, curline);}}
 	goto st24;
-tr51:
-/* #line 88 "sdlang.rl" */
-	{te = p;p--;{emit(SDLANG_TOKEN_INT32, ts, te, curline, user);}}
+tr54:
+/* #line 94 "sdlang.rl" */
+	{te = p;p--;{emit(parser, SDLANG_TOKEN_INT32, ts, te, curline);}}
 	goto st24;
-tr53:
-/* #line 86 "sdlang.rl" */
-	{te = p+1;{emit(SDLANG_TOKEN_INT64, ts, te, curline, user);}}
+tr56:
+/* #line 92 "sdlang.rl" */
+	{te = p+1;{emit(parser, SDLANG_TOKEN_INT64, ts, te, curline);}}
 	goto st24;
-tr55:
-/* #line 91 "sdlang.rl" */
-	{te = p;p--;{emit(SDLANG_TOKEN_UINT32, ts, te, curline, user);}}
+tr58:
+/* #line 97 "sdlang.rl" */
+	{te = p;p--;{emit(parser, SDLANG_TOKEN_UINT32, ts, te, curline);}}
 	goto st24;
-tr64:
-/* #line 90 "sdlang.rl" */
-	{te = p;p--;{emit(SDLANG_TOKEN_UINT64, ts, te, curline, user);}}
+tr67:
+/* #line 96 "sdlang.rl" */
+	{te = p;p--;{emit(parser, SDLANG_TOKEN_UINT64, ts, te, curline);}}
 	goto st24;
-tr71:
-/* #line 90 "sdlang.rl" */
-	{te = p+1;{emit(SDLANG_TOKEN_UINT64, ts, te, curline, user);}}
+tr74:
+/* #line 96 "sdlang.rl" */
+	{te = p+1;{emit(parser, SDLANG_TOKEN_UINT64, ts, te, curline);}}
 	goto st24;
-tr72:
-/* #line 79 "sdlang.rl" */
-	{te = p;p--;{emit(SDLANG_TOKEN_NODE, ts, te, curline, user);}}
+tr75:
+/* #line 85 "sdlang.rl" */
+	{te = p;p--;{emit(parser, SDLANG_TOKEN_NODE, ts, te, curline);}}
 	goto st24;
-tr73:
-/* #line 77 "sdlang.rl" */
-	{te = p+1;{emit(SDLANG_TOKEN_ATTRIBUTE, ts, te, curline, user);}}
+tr76:
+/* #line 83 "sdlang.rl" */
+	{te = p+1;{emit(parser, SDLANG_TOKEN_ATTRIBUTE, ts, te, curline);}}
 	goto st24;
 st24:
 /* #line 1 "NONE" */
@@ -319,12 +332,12 @@ st24:
 case 24:
 /* #line 1 "NONE" */
 	{ts = p;}
-/* #line 323 "sdlang.inl" */
+/* #line 336 "sdlang.inl" */
 	switch( (*p) ) {
-		case 9: goto tr34;
+		case 9: goto tr37;
 		case 10: goto tr4;
 		case 13: goto st3;
-		case 32: goto tr34;
+		case 32: goto tr37;
 		case 34: goto st4;
 		case 35: goto st6;
 		case 39: goto st7;
@@ -332,8 +345,8 @@ case 24:
 		case 45: goto st15;
 		case 46: goto st10;
 		case 47: goto st16;
-		case 48: goto tr39;
-		case 59: goto tr40;
+		case 48: goto tr42;
+		case 59: goto tr43;
 		case 91: goto st18;
 		case 92: goto st19;
 		case 95: goto st21;
@@ -342,12 +355,12 @@ case 24:
 		case 110: goto st51;
 		case 111: goto st54;
 		case 116: goto st56;
-		case 123: goto tr47;
-		case 125: goto tr48;
+		case 123: goto tr50;
+		case 125: goto tr51;
 	}
 	if ( (*p) < 65 ) {
 		if ( 49 <= (*p) && (*p) <= 57 )
-			goto tr17;
+			goto tr19;
 	} else if ( (*p) > 90 ) {
 		if ( 97 <= (*p) && (*p) <= 122 )
 			goto st45;
@@ -365,17 +378,21 @@ tr7:
 /* #line 16 "sdlang.rl" */
 	{curline += 1;}
 	goto st4;
+tr6:
+/* #line 22 "sdlang.rl" */
+	{{p = ((sdlang_skip_dquote(p + 1, pe)))-1;}}
+	goto st4;
 st4:
 	if ( ++p == pe )
 		goto _test_eof4;
 case 4:
-/* #line 373 "sdlang.inl" */
+/* #line 390 "sdlang.inl" */
 	switch( (*p) ) {
 		case 10: goto tr7;
 		case 34: goto tr8;
 		case 92: goto st5;
 	}
-	goto st4;
+	goto tr6;
 st5:
 	if ( ++p == pe )
 		goto _test_eof5;
@@ -383,35 +400,44 @@ case 5:
 	if ( (*p) == 10 )
 		goto tr7;
 	goto st4;
+tr11:
+/* #line 24 "sdlang.rl" */
+	{{p = ((sdlang_skip_line(p + 1, pe)))-1;}}
+	goto st6;
 st6:
 	if ( ++p == pe )
 		goto _test_eof6;
 case 6:
+/* #line 412 "sdlang.inl" */
 	if ( (*p) == 10 )
-		goto tr11;
-	goto st6;
-tr13:
+		goto tr12;
+	goto tr11;
+tr14:
 /* #line 16 "sdlang.rl" */
 	{curline += 1;}
 	goto st7;
+tr13:
+/* #line 23 "sdlang.rl" */
+	{{p = ((sdlang_skip_squote(p + 1, pe)))-1;}}
+	goto st7;
 st7:
 	if ( ++p == pe )
 		goto _test_eof7;
 case 7:
-/* #line 402 "sdlang.inl" */
+/* #line 428 "sdlang.inl" */
 	switch( (*p) ) {
-		case 10: goto tr13;
+		case 10: goto tr14;
 		case 39: goto tr8;
 		case 92: goto st8;
 		case 96: goto tr8;
 	}
-	goto st7;
+	goto tr13;
 st8:
 	if ( ++p == pe )
 		goto _test_eof8;
 case 8:
 	if ( (*p) == 10 )
-		goto tr13;
+		goto tr14;
 	goto st7;
 st9:
 	if ( ++p == pe )
@@ -419,38 +445,38 @@ st9:
 case 9:
 	switch( (*p) ) {
 		case 46: goto st10;
-		case 48: goto tr16;
+		case 48: goto tr18;
 	}
 	if ( 49 <= (*p) && (*p) <= 57 )
-		goto tr17;
+		goto tr19;
 	goto st0;
 st10:
 	if ( ++p == pe )
 		goto _test_eof10;
 case 10:
 	if ( 48 <= (*p) && (*p) <= 57 )
-		goto tr18;
+		goto tr20;
 	goto st0;
-tr18:
+tr20:
 /* #line 1 "NONE" */
 	{te = p+1;}
-/* #line 84 "sdlang.rl" */
+/* #line 90 "sdlang.rl" */
 	{act = 5;}
 	goto st25;
 st25:
 	if ( ++p == pe )
 		goto _test_eof25;
 case 25:
-/* #line 445 "sdlang.inl" */
+/* #line 471 "sdlang.inl" */
 	switch( (*p) ) {
 		case 69: goto st11;
-		case 70: goto tr50;
+		case 70: goto tr53;
 		case 101: goto st11;
-		case 102: goto tr50;
+		case 102: goto tr53;
 	}
 	if ( 48 <= (*p) && (*p) <= 57 )
-		goto tr18;
-	goto tr49;
+		goto tr20;
+	goto tr52;
 st11:
 	if ( ++p == pe )
 		goto _test_eof11;
@@ -461,92 +487,92 @@ case 11:
 	}
 	if ( 48 <= (*p) && (*p) <= 57 )
 		goto st26;
-	goto tr19;
+	goto tr21;
 st12:
 	if ( ++p == pe )
 		goto _test_eof12;
 case 12:
 	if ( 48 <= (*p) && (*p) <= 57 )
 		goto st26;
-	goto tr19;
+	goto tr21;
 st26:
 	if ( ++p == pe )
 		goto _test_eof26;
 case 26:
 	switch( (*p) ) {
-		case 70: goto tr50;
-		case 102: goto tr50;
+		case 70: goto tr53;
+		case 102: goto tr53;
 	}
 	if ( 48 <= (*p) && (*p) <= 57 )
 		goto st26;
-	goto tr49;
-tr16:
+	goto tr52;
+tr18:
 /* #line 1 "NONE" */
 	{te = p+1;}
-/* #line 88 "sdlang.rl" */
+/* #line 94 "sdlang.rl" */
 	{act = 8;}
 	goto st27;
 st27:
 	if ( ++p == pe )
 		goto _test_eof27;
 case 27:
-/* #line 494 "sdlang.inl" */
+/* #line 520 "sdlang.inl" */
 	switch( (*p) ) {
-		case 46: goto tr18;
+		case 46: goto tr20;
 		case 66: goto st14;
 		case 69: goto st11;
-		case 76: goto tr53;
+		case 76: goto tr56;
 		case 98: goto st14;
 		case 101: goto st11;
-		case 108: goto tr53;
+		case 108: goto tr56;
 	}
 	if ( 48 <= (*p) && (*p) <= 57 )
 		goto st13;
-	goto tr51;
+	goto tr54;
 st13:
 	if ( ++p == pe )
 		goto _test_eof13;
 case 13:
 	switch( (*p) ) {
-		case 46: goto tr18;
+		case 46: goto tr20;
 		case 69: goto st11;
 		case 101: goto st11;
 	}
 	if ( 48 <= (*p) && (*p) <= 57 )
 		goto st13;
-	goto tr22;
+	goto tr24;
 st14:
 	if ( ++p == pe )
 		goto _test_eof14;
 case 14:
 	switch( (*p) ) {
-		case 68: goto tr25;
-		case 100: goto tr25;
+		case 68: goto tr27;
+		case 100: goto tr27;
 	}
-	goto tr22;
-tr17:
+	goto tr24;
+tr19:
 /* #line 1 "NONE" */
 	{te = p+1;}
-/* #line 88 "sdlang.rl" */
+/* #line 94 "sdlang.rl" */
 	{act = 8;}
 	goto st28;
 st28:
 	if ( ++p == pe )
 		goto _test_eof28;
 case 28:
-/* #line 538 "sdlang.inl" */
+/* #line 564 "sdlang.inl" */
 	switch( (*p) ) {
-		case 46: goto tr18;
+		case 46: goto tr20;
 		case 66: goto st14;
 		case 69: goto st11;
-		case 76: goto tr53;
+		case 76: goto tr56;
 		case 98: goto st14;
 		case 101: goto st11;
-		case 108: goto tr53;
+		case 108: goto tr56;
 	}
 	if ( 48 <= (*p) && (*p) <= 57 )
-		goto tr17;
-	goto tr51;
+		goto tr19;
+	goto tr54;
 st15:
 	if ( ++p == pe )
 		goto _test_eof15;
@@ -554,45 +580,45 @@ case 15:
 	switch( (*p) ) {
 		case 45: goto st6;
 		case 46: goto st10;
-		case 48: goto tr16;
+		case 48: goto tr18;
 	}
 	if ( 49 <= (*p) && (*p) <= 57 )
-		goto tr17;
+		goto tr19;
 	goto st0;
 st16:
 	if ( ++p == pe )
 		goto _test_eof16;
 case 16:
 	switch( (*p) ) {
-		case 42: goto tr26;
+		case 42: goto tr29;
 		case 47: goto st6;
 	}
 	goto st0;
-tr39:
+tr42:
 /* #line 1 "NONE" */
 	{te = p+1;}
-/* #line 88 "sdlang.rl" */
+/* #line 94 "sdlang.rl" */
 	{act = 8;}
 	goto st29;
 st29:
 	if ( ++p == pe )
 		goto _test_eof29;
 case 29:
-/* #line 582 "sdlang.inl" */
+/* #line 608 "sdlang.inl" */
 	switch( (*p) ) {
-		case 46: goto tr18;
+		case 46: goto tr20;
 		case 66: goto st14;
 		case 69: goto st11;
-		case 76: goto tr53;
+		case 76: goto tr56;
 		case 88: goto st17;
 		case 98: goto st14;
 		case 101: goto st11;
-		case 108: goto tr53;
+		case 108: goto tr56;
 		case 120: goto st17;
 	}
 	if ( 48 <= (*p) && (*p) <= 57 )
 		goto st13;
-	goto tr51;
+	goto tr54;
 st17:
 	if ( ++p == pe )
 		goto _test_eof17;
@@ -605,7 +631,7 @@ case 17:
 			goto st30;
 	} else
 		goto st30;
-	goto tr22;
+	goto tr24;
 st30:
 	if ( ++p == pe )
 		goto _test_eof30;
@@ -618,7 +644,7 @@ case 30:
 			goto st31;
 	} else
 		goto st31;
-	goto tr55;
+	goto tr58;
 st31:
 	if ( ++p == pe )
 		goto _test_eof31;
@@ -631,7 +657,7 @@ case 31:
 			goto st32;
 	} else
 		goto st32;
-	goto tr55;
+	goto tr58;
 st32:
 	if ( ++p == pe )
 		goto _test_eof32;
@@ -644,7 +670,7 @@ case 32:
 			goto st33;
 	} else
 		goto st33;
-	goto tr55;
+	goto tr58;
 st33:
 	if ( ++p == pe )
 		goto _test_eof33;
@@ -657,7 +683,7 @@ case 33:
 			goto st34;
 	} else
 		goto st34;
-	goto tr55;
+	goto tr58;
 st34:
 	if ( ++p == pe )
 		goto _test_eof34;
@@ -670,7 +696,7 @@ case 34:
 			goto st35;
 	} else
 		goto st35;
-	goto tr55;
+	goto tr58;
 st35:
 	if ( ++p == pe )
 		goto _test_eof35;
@@ -683,7 +709,7 @@ case 35:
 			goto st36;
 	} else
 		goto st36;
-	goto tr55;
+	goto tr58;
 st36:
 	if ( ++p == pe )
 		goto _test_eof36;
@@ -696,7 +722,7 @@ case 36:
 			goto st37;
 	} else
 		goto st37;
-	goto tr55;
+	goto tr58;
 st37:
 	if ( ++p == pe )
 		goto _test_eof37;
@@ -709,7 +735,7 @@ case 37:
 			goto st38;
 	} else
 		goto st38;
-	goto tr55;
+	goto tr58;
 st38:
 	if ( ++p == pe )
 		goto _test_eof38;
@@ -722,7 +748,7 @@ case 38:
 			goto st39;
 	} else
 		goto st39;
-	goto tr64;
+	goto tr67;
 st39:
 	if ( ++p == pe )
 		goto _test_eof39;
@@ -735,7 +761,7 @@ case 39:
 			goto st40;
 	} else
 		goto st40;
-	goto tr64;
+	goto tr67;
 st40:
 	if ( ++p == pe )
 		goto _test_eof40;
@@ -748,7 +774,7 @@ case 40:
 			goto st41;
 	} else
 		goto st41;
-	goto tr64;
+	goto tr67;
 st41:
 	if ( ++p == pe )
 		goto _test_eof41;
@@ -761,7 +787,7 @@ case 41:
 			goto st42;
 	} else
 		goto st42;
-	goto tr64;
+	goto tr67;
 st42:
 	if ( ++p == pe )
 		goto _test_eof42;
@@ -774,7 +800,7 @@ case 42:
 			goto st43;
 	} else
 		goto st43;
-	goto tr64;
+	goto tr67;
 st43:
 	if ( ++p == pe )
 		goto _test_eof43;
@@ -787,27 +813,27 @@ case 43:
 			goto st44;
 	} else
 		goto st44;
-	goto tr64;
+	goto tr67;
 st44:
 	if ( ++p == pe )
 		goto _test_eof44;
 case 44:
 	if ( (*p) < 65 ) {
 		if ( 48 <= (*p) && (*p) <= 57 )
-			goto tr71;
+			goto tr74;
 	} else if ( (*p) > 70 ) {
 		if ( 97 <= (*p) && (*p) <= 102 )
-			goto tr71;
+			goto tr74;
 	} else
-		goto tr71;
-	goto tr64;
+		goto tr74;
+	goto tr67;
 st45:
 	if ( ++p == pe )
 		goto _test_eof45;
 case 45:
 	switch( (*p) ) {
 		case 36: goto st45;
-		case 61: goto tr73;
+		case 61: goto tr76;
 		case 95: goto st45;
 	}
 	if ( (*p) < 48 ) {
@@ -821,7 +847,7 @@ case 45:
 			goto st45;
 	} else
 		goto st45;
-	goto tr72;
+	goto tr75;
 st18:
 	if ( ++p == pe )
 		goto _test_eof18;
@@ -829,7 +855,7 @@ case 18:
 	switch( (*p) ) {
 		case 43: goto st18;
 		case 61: goto st18;
-		case 93: goto tr29;
+		case 93: goto tr32;
 	}
 	if ( (*p) < 65 ) {
 		if ( 47 <= (*p) && (*p) <= 57 )
@@ -845,7 +871,7 @@ st19:
 		goto _test_eof19;
 case 19:
 	switch( (*p) ) {
-		case 10: goto tr30;
+		case 10: goto tr33;
 		case 13: goto st20;
 	}
 	goto st0;
@@ -854,7 +880,7 @@ st20:
 		goto _test_eof20;
 case 20:
 	if ( (*p) == 10 )
-		goto tr30;
+		goto tr33;
 	goto st0;
 st21:
 	if ( ++p == pe )
@@ -872,7 +898,7 @@ st46:
 case 46:
 	switch( (*p) ) {
 		case 36: goto st45;
-		case 61: goto tr73;
+		case 61: goto tr76;
 		case 95: goto st45;
 		case 97: goto st47;
 	}
@@ -887,14 +913,14 @@ case 46:
 			goto st45;
 	} else
 		goto st45;
-	goto tr72;
+	goto tr75;
 st47:
 	if ( ++p == pe )
 		goto _test_eof47;
 case 47:
 	switch( (*p) ) {
 		case 36: goto st45;
-		case 61: goto tr73;
+		case 61: goto tr76;
 		case 95: goto st45;
 		case 108: goto st48;
 	}
@@ -909,14 +935,14 @@ case 47:
 			goto st45;
 	} else
 		goto st45;
-	goto tr72;
+	goto tr75;
 st48:
 	if ( ++p == pe )
 		goto _test_eof48;
 case 48:
 	switch( (*p) ) {
 		case 36: goto st45;
-		case 61: goto tr73;
+		case 61: goto tr76;
 		case 95: goto st45;
 		case 115: goto st49;
 	}
@@ -931,16 +957,16 @@ case 48:
 			goto st45;
 	} else
 		goto st45;
-	goto tr72;
+	goto tr75;
 st49:
 	if ( ++p == pe )
 		goto _test_eof49;
 case 49:
 	switch( (*p) ) {
 		case 36: goto st45;
-		case 61: goto tr73;
+		case 61: goto tr76;
 		case 95: goto st45;
-		case 101: goto tr77;
+		case 101: goto tr80;
 	}
 	if ( (*p) < 48 ) {
 		if ( 45 <= (*p) && (*p) <= 46 )
@@ -953,30 +979,30 @@ case 49:
 			goto st45;
 	} else
 		goto st45;
-	goto tr72;
-tr77:
+	goto tr75;
+tr80:
 /* #line 1 "NONE" */
 	{te = p+1;}
-/* #line 94 "sdlang.rl" */
+/* #line 100 "sdlang.rl" */
 	{act = 12;}
 	goto st50;
-tr80:
+tr83:
 /* #line 1 "NONE" */
 	{te = p+1;}
-/* #line 96 "sdlang.rl" */
+/* #line 102 "sdlang.rl" */
 	{act = 13;}
 	goto st50;
-tr82:
+tr85:
 /* #line 1 "NONE" */
 	{te = p+1;}
-/* #line 93 "sdlang.rl" */
+/* #line 99 "sdlang.rl" */
 	{act = 11;}
 	goto st50;
 st50:
 	if ( ++p == pe )
 		goto _test_eof50;
 case 50:
-/* #line 980 "sdlang.inl" */
+/* #line 1006 "sdlang.inl" */
 	switch( (*p) ) {
 		case 36: goto st45;
 		case 95: goto st45;
@@ -992,14 +1018,14 @@ case 50:
 			goto st45;
 	} else
 		goto st45;
-	goto tr19;
+	goto tr21;
 st51:
 	if ( ++p == pe )
 		goto _test_eof51;
 case 51:
 	switch( (*p) ) {
 		case 36: goto st45;
-		case 61: goto tr73;
+		case 61: goto tr76;
 		case 95: goto st45;
 		case 117: goto st52;
 	}
@@ -1014,14 +1040,14 @@ case 51:
 			goto st45;
 	} else
 		goto st45;
-	goto tr72;
+	goto tr75;
 st52:
 	if ( ++p == pe )
 		goto _test_eof52;
 case 52:
 	switch( (*p) ) {
 		case 36: goto st45;
-		case 61: goto tr73;
+		case 61: goto tr76;
 		case 95: goto st45;
 		case 108: goto st53;
 	}
@@ -1036,16 +1062,16 @@ case 52:
 			goto st45;
 	} else
 		goto st45;
-	goto tr72;
+	goto tr75;
 st53:
 	if ( ++p == pe )
 		goto _test_eof53;
 case 53:
 	switch( (*p) ) {
 		case 36: goto st45;
-		case 61: goto tr73;
+		case 61: goto tr76;
 		case 95: goto st45;
-		case 108: goto tr80;
+		case 108: goto tr83;
 	}
 	if ( (*p) < 48 ) {
 		if ( 45 <= (*p) && (*p) <= 46 )
@@ -1058,17 +1084,17 @@ case 53:
 			goto st45;
 	} else
 		goto st45;
-	goto tr72;
+	goto tr75;
 st54:
 	if ( ++p == pe )
 		goto _test_eof54;
 case 54:
 	switch( (*p) ) {
 		case 36: goto st45;
-		case 61: goto tr73;
+		case 61: goto tr76;
 		case 95: goto st45;
 		case 102: goto st55;
-		case 110: goto tr82;
+		case 110: goto tr85;
 	}
 	if ( (*p) < 48 ) {
 		if ( 45 <= (*p) && (*p) <= 46 )
@@ -1081,16 +1107,16 @@ case 54:
 			goto st45;
 	} else
 		goto st45;
-	goto tr72;
+	goto tr75;
 st55:
 	if ( ++p == pe )
 		goto _test_eof55;
 case 55:
 	switch( (*p) ) {
 		case 36: goto st45;
-		case 61: goto tr73;
+		case 61: goto tr76;
 		case 95: goto st45;
-		case 102: goto tr77;
+		case 102: goto tr80;
 	}
 	if ( (*p) < 48 ) {
 		if ( 45 <= (*p) && (*p) <= 46 )
@@ -1103,14 +1129,14 @@ case 55:
 			goto st45;
 	} else
 		goto st45;
-	goto tr72;
+	goto tr75;
 st56:
 	if ( ++p == pe )
 		goto _test_eof56;
 case 56:
 	switch( (*p) ) {
 		case 36: goto st45;
-		case 61: goto tr73;
+		case 61: goto tr76;
 		case 95: goto st45;
 		case 114: goto st57;
 	}
@@ -1125,14 +1151,14 @@ case 56:
 			goto st45;
 	} else
 		goto st45;
-	goto tr72;
+	goto tr75;
 st57:
 	if ( ++p == pe )
 		goto _test_eof57;
 case 57:
 	switch( (*p) ) {
 		case 36: goto st45;
-		case 61: goto tr73;
+		case 61: goto tr76;
 		case 95: goto st45;
 		case 117: goto st58;
 	}
@@ -1147,16 +1173,16 @@ case 57:
 			goto st45;
 	} else
 		goto st45;
-	goto tr72;
+	goto tr75;
 st58:
 	if ( ++p == pe )
 		goto _test_eof58;
 case 58:
 	switch( (*p) ) {
 		case 36: goto st45;
-		case 61: goto tr73;
+		case 61: goto tr76;
 		case 95: goto st45;
-		case 101: goto tr82;
+		case 101: goto tr85;
 	}
 	if ( (*p) < 48 ) {
 		if ( 45 <= (*p) && (*p) <= 46 )
@@ -1169,7 +1195,7 @@ case 58:
 			goto st45;
 	} else
 		goto st45;
-	goto tr72;
+	goto tr75;
 	}
 	_test_eof22: cs = 22; goto _test_eof; 
 	_test_eof1: cs = 1; goto _test_eof; 
@@ -1234,82 +1260,507 @@ case 58:
 	if ( p == eof )
 	{
 	switch ( cs ) {
-	case 25: goto tr49;
-	case 11: goto tr19;
-	case 12: goto tr19;
-	case 26: goto tr49;
-	case 27: goto tr51;
-	case 13: goto tr22;
-	case 14: goto tr22;
-	case 28: goto tr51;
-	case 29: goto tr51;
-	case 17: goto tr22;
-	case 30: goto tr55;
-	case 31: goto tr55;
-	case 32: goto tr55;
-	case 33: goto tr55;
-	case 34: goto tr55;
-	case 35: goto tr55;
-	case 36: goto tr55;
-	case 37: goto tr55;
-	case 38: goto tr64;
-	case 39: goto tr64;
-	case 40: goto tr64;
-	case 41: goto tr64;
-	case 42: goto tr64;
-	case 43: goto tr64;
-	case 44: goto tr64;
-	case 45: goto tr72;
-	case 46: goto tr72;
-	case 47: goto tr72;
-	case 48: goto tr72;
-	case 49: goto tr72;
-	case 50: goto tr19;
-	case 51: goto tr72;
-	case 52: goto tr72;
-	case 53: goto tr72;
-	case 54: goto tr72;
-	case 55: goto tr72;
-	case 56: goto tr72;
-	case 57: goto tr72;
-	case 58: goto tr72;
+	case 25: goto tr52;
+	case 11: goto tr21;
+	case 12: goto tr21;
+	case 26: goto tr52;
+	case 27: goto tr54;
+	case 13: goto tr24;
+	case 14: goto tr24;
+	case 28: goto tr54;
+	case 29: goto tr54;
+	case 17: goto tr24;
+	case 30: goto tr58;
+	case 31: goto tr58;
+	case 32: goto tr58;
+	case 33: goto tr58;
+	case 34: goto tr58;
+	case 35: goto tr58;
+	case 36: goto tr58;
+	case 37: goto tr58;
+	case 38: goto tr67;
+	case 39: goto tr67;
+	case 40: goto tr67;
+	case 41: goto tr67;
+	case 42: goto tr67;
+	case 43: goto tr67;
+	case 44: goto tr67;
+	case 45: goto tr75;
+	case 46: goto tr75;
+	case 47: goto tr75;
+	case 48: goto tr75;
+	case 49: goto tr75;
+	case 50: goto tr21;
+	case 51: goto tr75;
+	case 52: goto tr75;
+	case 53: goto tr75;
+	case 54: goto tr75;
+	case 55: goto tr75;
+	case 56: goto tr75;
+	case 57: goto tr75;
+	case 58: goto tr75;
 	}
 	}
 
 	_out: {}
 	}
 
-/* #line 165 "sdlang.rl" */
+/* #line 184 "sdlang.rl" */
+
+    if (parser->batch != NULL)
+    {
+        /* token strings don't survive the next refill */
+        sdlang_batch_flush(parser);
+    }
+
+    parser->cs = cs;
+    parser->act = act;
+    parser->top = top;
+    parser->curline = curline;
+    parser->ts = ts;
+    parser->te = te;
+}
+
+static int sdlang_check_state(const struct sdlang_parser_t* parser)
+{
+    if (parser->stopped)
+    {
+        return SDLANG_PARSE_STOPPED;
+    }
 
-        if (cs == sdlang_error)
+    if (parser->cs == sdlang_error)
+    {
+        return SDLANG_PARSE_ERROR;
+    }
+
+    if (parser->top == SDLANG_PARSE_STACKSIZE)
+    {
+        return SDLANG_PARSE_ERROR_STACK_OVERFLOW;
+    }
+
+    return SDLANG_PARSE_OK;
+}
+
+void sdlang_parser_begin(struct sdlang_parser_t* parser, void* user)
+{
+    parser->user = user;
+    parser->have = 0;
+    parser->error = SDLANG_PARSE_OK;
+    parser->node = parser->attr = (struct sdlang_name_t) { "", 0, 0 };
+    parser->stats.bytes_read = 0;
+    parser->stats.bytes_copied = 0;
+    parser->skip.depth = 0;
+    parser->stopped = false;
+    sdlang_init(parser);
+}
+
+static bool sdlang_pinned(const struct sdlang_name_t* name)
+{
+    /* a name in the input, as opposed to an interned name */
+    return name->len > 0 && name->symbol == 0;
+}
+
+static size_t sdlang_pinned_end(const struct sdlang_parser_t* parser, const char* buf, const char* pe)
+{
+    /* end offset of the last name kept in the buffer, if any */
+    const struct sdlang_name_t* names[] = { &parser->attr, &parser->node };
+
+    for (int i = 0; i < 2; ++i)
+    {
+        if (sdlang_pinned(names[i]) && names[i]->ptr >= buf && names[i]->ptr < pe)
         {
-            err = SDLANG_PARSE_ERROR;
-            break;
+            return (size_t)(names[i]->ptr + names[i]->len - buf);
         }
+    }
+
+    return 0;
+}
 
-        if (top == SDLANG_PARSE_STACKSIZE)
+static char* sdlang_keep_names(struct sdlang_parser_t* parser, char* dst)
+{
+    /*
+        moves the names which the function table still refers to to `dst`,
+        keeping their order - they can't overlap with anything after them
+    */
+    struct sdlang_name_t* names[] = { &parser->node, &parser->attr };
+
+    for (int i = 0; i < 2; ++i)
+    {
+        if (sdlang_pinned(names[i]))
         {
-            err = SDLANG_PARSE_ERROR_STACK_OVERFLOW;
-            break;
+            if (names[i]->ptr != dst)
+            {
+                SDLANG_MEMMOVE(dst, names[i]->ptr, names[i]->len);
+                names[i]->ptr = dst;
+                parser->stats.bytes_copied += names[i]->len;
+            }
+
+            dst += names[i]->len;
         }
+    }
+
+    return dst;
+}
+
+static int sdlang_grow_buffer(struct sdlang_parser_t* parser, size_t size, size_t keep)
+{
+    /*
+        reallocates the parse buffer to hold at least `size` bytes, keeping
+        the first `keep` bytes - which are the unfinished token and the
+        pinned names, if any
+    */
+    const bool token = parser->ts >= parser->buf && parser->ts < parser->buf + keep;
+    const size_t ts = token ? (size_t)(parser->ts - parser->buf) : 0;
+    const size_t te = token ? (size_t)(parser->te - parser->buf) : 0;
+    struct sdlang_name_t* names[] = { &parser->node, &parser->attr };
+    size_t offsets[2] = { 0 };
+    bool moved[2] = { false };
+    size_t capacity = parser->capacity;
+    char* buf;
+
+    if (parser->allocator.alloc == NULL)
+    {
+        return SDLANG_PARSE_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    while (capacity < size)
+    {
+        capacity *= 2;
+    }
 
-        if (ts == 0)
+    for (int i = 0; i < 2; ++i)
+    {
+        if (sdlang_pinned(names[i]) && names[i]->ptr >= parser->buf && names[i]->ptr < parser->buf + keep)
         {
-            have = 0;
+            offsets[i] = (size_t)(names[i]->ptr - parser->buf);
+            moved[i] = true;
         }
-        else
+    }
+
+    if (parser->buf == parser->buffer)
+    {
+        buf = (*parser->allocator.alloc)(NULL, capacity, parser->allocator.user);
+
+        if (buf != NULL)
         {
-            have = (int)(pe - ts);
-            SDLANG_MEMMOVE(buf, ts, have);
-            te = buf + (te - ts);
-            ts = buf;
+            SDLANG_MEMMOVE(buf, parser->buffer, keep);
         }
     }
+    else
+    {
+        buf = (*parser->allocator.alloc)(parser->buf, capacity, parser->allocator.user);
+    }
 
-    if (err != SDLANG_PARSE_OK)
+    if (buf == NULL)
     {
-        (*sdlang_user_report_error)(err, curline);
+        return SDLANG_PARSE_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    if (token)
+    {
+        parser->ts = buf + ts;
+        parser->te = buf + te;
+    }
+
+    for (int i = 0; i < 2; ++i)
+    {
+        if (moved[i])
+        {
+            names[i]->ptr = buf + offsets[i];
+        }
+    }
+
+    parser->buf = buf;
+    parser->capacity = capacity;
+    parser->stats.bytes_copied += keep;
+
+    return SDLANG_PARSE_OK;
+}
+
+static void sdlang_keep_buffer(struct sdlang_parser_t* parser, const char* pe)
+{
+    /*
+        an unfinished token stays where it is as long as there's enough
+        space left to read into, and is moved to the front of the buffer
+        only if the remaining space runs low - together with the names
+        pinned for the function table, which precede it
+    */
+    char* buf = parser->buf;
+
+    if (parser->ts == 0)
+    {
+        parser->have = sdlang_pinned_end(parser, buf, pe);
+
+        if (parser->have > 0 && parser->capacity - parser->have < parser->capacity / 2)
+        {
+            parser->have = sdlang_keep_names(parser, buf) - buf;
+        }
+
+        return;
+    }
+
+    parser->have = pe - buf;
+
+    if (parser->capacity - parser->have < parser->capacity / 2)
+    {
+        const size_t len = pe - parser->ts;
+        char* dst = sdlang_keep_names(parser, buf);
+
+        if (parser->ts > dst)
+        {
+            SDLANG_MEMMOVE(dst, parser->ts, len);
+            parser->te = dst + (parser->te - parser->ts);
+            parser->ts = dst;
+            parser->stats.bytes_copied += len;
+        }
+
+        parser->have = (size_t)(parser->ts - buf) + len;
+    }
+}
+
+static int sdlang_parse_stream(struct sdlang_parser_t* parser,
+                               size_t (*stream)(void* ptr, size_t size, void* user),
+                               void* stream_user, void* user)
+{
+    int done = 0, err = SDLANG_PARSE_OK;
+
+    sdlang_parser_begin(parser, user);
+
+    while (!done)
+    {
+        char *p, *pe, *eof = 0;
+        size_t len, space = parser->capacity - parser->have;
+
+        if (space == 0)
+        {
+            /* a single token fills the whole buffer */
+            err = sdlang_grow_buffer(parser, parser->capacity + 1, parser->have);
+
+            if (err != SDLANG_PARSE_OK)
+            {
+                break;
+            }
+
+            space = parser->capacity - parser->have;
+        }
+
+        p = parser->buf + parser->have;
+        len = stream(p, space, stream_user);
+        pe = p + len;
+        parser->stats.bytes_read += len;
+
+        if (len < space)
+        {
+            eof = pe;
+            done = 1;
+        }
+
+        sdlang_exec(parser, p, pe, eof);
+
+        if ((err = sdlang_check_state(parser)) != SDLANG_PARSE_OK)
+        {
+            break;
+        }
+
+        sdlang_keep_buffer(parser, pe);
+    }
+
+    if (err != SDLANG_PARSE_OK && err != SDLANG_PARSE_STOPPED)
+    {
+        (*parser->report_error)(err, parser->curline);
+    }
+
+    return err;
+}
+
+int sdlang_parser_parse(struct sdlang_parser_t* parser,
+    size_t (*stream)(void* ptr, size_t size, void* user), void* user)
+{
+    return sdlang_parse_stream(parser, stream, user, user);
+}
+
+static int sdlang_parse_sequential(struct sdlang_parser_t* parser,
+                                   const char* buffer, size_t size, void* user)
+{
+    int err;
+
+    sdlang_parser_begin(parser, user);
+    sdlang_exec(parser, buffer, buffer + size, buffer + size);
+    parser->stats.bytes_read = size;
+
+    if ((err = sdlang_check_state(parser)) != SDLANG_PARSE_OK && err != SDLANG_PARSE_STOPPED)
+    {
+        (*parser->report_error)(err, parser->curline);
+    }
+
+    return err;
+}
+
+int sdlang_parser_parse_buffer(struct sdlang_parser_t* parser,
+    const char* buffer, size_t size, void* user)
+{
+#ifdef SDLANG_HAVE_THREADS
+    /* skipping and stopping act on the scanner of this parser */
+    if (parser->threads > 1 && parser->emit_control == NULL
+        && size >= 2 * (size_t)SDLANG_PARSE_CHUNKSIZE)
+    {
+        return sdlang_parse_parallel(parser, buffer, size, user);
+    }
+#endif
+
+    return sdlang_parse_sequential(parser, buffer, size, user);
+}
+
+static int sdlang_feed_error(struct sdlang_parser_t* parser, int err)
+{
+    parser->error = err;
+
+    if (err != SDLANG_PARSE_STOPPED)
+    {
+        (*parser->report_error)(err, parser->curline);
     }
 
     return err;
 }
+
+static int sdlang_keep_token(struct sdlang_parser_t* parser, const char* pe)
+{
+    /*
+        copies an unfinished token, and the names pinned for the function
+        table, from the caller's memory - names already in the buffer are
+        moved to the front
+    */
+    const size_t len = parser->ts != 0 ? (size_t)(pe - parser->ts) : 0;
+    const size_t have = len + (sdlang_pinned(&parser->node) ? parser->node.len : 0)
+                            + (sdlang_pinned(&parser->attr) ? parser->attr.len : 0);
+    char* dst;
+    int err;
+
+    if (have > parser->capacity
+        && (err = sdlang_grow_buffer(parser, have,
+                sdlang_pinned_end(parser, parser->buf, parser->buf + parser->capacity))) != SDLANG_PARSE_OK)
+    {
+        return err;
+    }
+
+    dst = sdlang_keep_names(parser, parser->buf);
+
+    if (parser->ts != 0)
+    {
+        SDLANG_MEMMOVE(dst, parser->ts, len);
+        parser->te = dst + (parser->te - parser->ts);
+        parser->ts = dst;
+        parser->stats.bytes_copied += len;
+    }
+
+    parser->have = have;
+
+    return SDLANG_PARSE_OK;
+}
+
+int sdlang_parser_feed(struct sdlang_parser_t* parser, const char* data, size_t size)
+{
+    size_t step = 16;
+    int err;
+
+    if (parser->error != SDLANG_PARSE_OK)
+    {
+        return parser->error;
+    }
+
+    /*
+        a token split across calls is completed in the parser buffer, by
+        copying steps which double in size until it ends - the remaining
+        bytes, and a token which started in the last step, are scanned in
+        place
+    */
+    while (parser->ts != 0 && size > 0)
+    {
+        char *p, *pe;
+        size_t len, space = parser->capacity - parser->have;
+
+        if (space == 0)
+        {
+            err = sdlang_grow_buffer(parser, parser->capacity + 1, parser->have);
+
+            if (err != SDLANG_PARSE_OK)
+            {
+                return sdlang_feed_error(parser, err);
+            }
+
+            space = parser->capacity - parser->have;
+        }
+
+        len = size < space ? size : space;
+        len = len < step ? len : step;
+        p = parser->buf + parser->have;
+        pe = p + len;
+        SDLANG_MEMMOVE(p, data, len);
+        data += len;
+        size -= len;
+        step *= 2;
+        parser->stats.bytes_read += len;
+        parser->stats.bytes_copied += len;
+
+        sdlang_exec(parser, p, pe, 0);
+
+        if ((err = sdlang_check_state(parser)) != SDLANG_PARSE_OK)
+        {
+            return sdlang_feed_error(parser, err);
+        }
+
+        if (size > 0 && (parser->ts == 0 || parser->ts >= p))
+        {
+            const char *ts = parser->ts, *te = parser->te;
+
+            parser->ts = 0;
+            sdlang_keep_buffer(parser, pe);
+
+            if (ts != 0)
+            {
+                parser->ts = data - (pe - ts);
+                parser->te = parser->ts + (te - ts);
+            }
+
+            break;
+        }
+
+        sdlang_keep_buffer(parser, pe);
+    }
+
+    if (size > 0)
+    {
+        sdlang_exec(parser, data, data + size, 0);
+        parser->stats.bytes_read += size;
+
+        if ((err = sdlang_check_state(parser)) != SDLANG_PARSE_OK
+            || ((parser->ts != 0 || sdlang_pinned(&parser->node) || sdlang_pinned(&parser->attr))
+                && (err = sdlang_keep_token(parser, data + size)) != SDLANG_PARSE_OK))
+        {
+            return sdlang_feed_error(parser, err);
+        }
+    }
+
+    return SDLANG_PARSE_OK;
+}
+
+int sdlang_parser_finish(struct sdlang_parser_t* parser)
+{
+    const char* pe = parser->buf + parser->have;
+    int err;
+
+    if (parser->error != SDLANG_PARSE_OK)
+    {
+        return parser->error;
+    }
+
+    sdlang_exec(parser, pe, pe, pe);
+    parser->have = 0;
+
+    if ((err = sdlang_check_state(parser)) != SDLANG_PARSE_OK)
+    {
+        return sdlang_feed_error(parser, err);
+    }
+
+    return SDLANG_PARSE_OK;
+}
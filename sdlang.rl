@@ -17,13 +17,19 @@
     newline_wrap = '\\' newline;
     any_count_line = any | newline;
 
+    # fast-skip over runs of characters which don't change the state
+
+    action skip_dquote {fexec sdlang_skip_dquote(p + 1, pe);}
+    action skip_squote {fexec sdlang_skip_squote(p + 1, pe);}
+    action skip_line {fexec sdlang_skip_line(p + 1, pe);}
+
     # quoted strings
     #   + optionally use ' to delimit single-quoted strings
 
-    single_quote_char = [^'`\\] | newline | ( '\\' . any_count_line );
+    single_quote_char = ([^'`\\\n] @skip_squote) | newline | ( '\\' . any_count_line );
     single_quote_string = ['`]{1} . single_quote_char* . ['`]{1};
 
-    double_quote_char = [^"\\] | newline | ( '\\' any_count_line );
+    double_quote_char = ([^"\\\n] @skip_dquote) | newline | ( '\\' any_count_line );
     double_quote_string = '"' . double_quote_char* . '"';
 
     any_string = single_quote_string | double_quote_string;
@@ -42,7 +48,7 @@
 
     # comments
 
-    one_line_comment = ('//' | '--' | '#') [^\n]* newline;
+    one_line_comment = ('//' | '--' | '#') ([^\n] @skip_line)* newline;
     c_comment := any_count_line* :>> '*/' @{fgoto block;};
 
     # numeric values
@@ -74,51 +80,60 @@
 
     block := |*
 
-        attribute {emit(SDLANG_TOKEN_ATTRIBUTE, ts, te, curline, user);};
+        attribute {emit(parser, SDLANG_TOKEN_ATTRIBUTE, ts, te, curline);};
 
-        literal {emit(SDLANG_TOKEN_NODE, ts, te, curline, user);};
+        literal {emit(parser, SDLANG_TOKEN_NODE, ts, te, curline);};
 
-        any_string {emit(SDLANG_TOKEN_STRING, ts, te, curline, user);};
+        any_string {emit(parser, SDLANG_TOKEN_STRING, ts, te, curline);};
 
-        float32 {emit(SDLANG_TOKEN_FLOAT32, ts, te, curline, user);};
-        float64 {emit(SDLANG_TOKEN_FLOAT64, ts, te, curline, user);};
+        float32 {emit(parser, SDLANG_TOKEN_FLOAT32, ts, te, curline);};
+        float64 {emit(parser, SDLANG_TOKEN_FLOAT64, ts, te, curline);};
 
-        int64 {emit(SDLANG_TOKEN_INT64, ts, te, curline, user);};
-        int128 {emit(SDLANG_TOKEN_INT128, ts, te, curline, user);};
-        int32 {emit(SDLANG_TOKEN_INT32, ts, te, curline, user);};
+        int64 {emit(parser, SDLANG_TOKEN_INT64, ts, te, curline);};
+        int128 {emit(parser, SDLANG_TOKEN_INT128, ts, te, curline);};
+        int32 {emit(parser, SDLANG_TOKEN_INT32, ts, te, curline);};
 
-        hex64 {emit(SDLANG_TOKEN_UINT64, ts, te, curline, user);};
-        hex32 {emit(SDLANG_TOKEN_UINT32, ts, te, curline, user);};
+        hex64 {emit(parser, SDLANG_TOKEN_UINT64, ts, te, curline);};
+        hex32 {emit(parser, SDLANG_TOKEN_UINT32, ts, te, curline);};
 
-        kw_true {emit(SDLANG_TOKEN_TRUE, ts, te, curline, user);};
-        kw_false {emit(SDLANG_TOKEN_FALSE, ts, te, curline, user);};
+        kw_true {emit(parser, SDLANG_TOKEN_TRUE, ts, te, curline);};
+        kw_false {emit(parser, SDLANG_TOKEN_FALSE, ts, te, curline);};
 
-        kw_null {emit(SDLANG_TOKEN_NULL, ts, te, curline, user);};
+        kw_null {emit(parser, SDLANG_TOKEN_NULL, ts, te, curline);};
 
-        base64_string {emit(SDLANG_TOKEN_BASE64, ts, te, curline, user);};
+        base64_string {emit(parser, SDLANG_TOKEN_BASE64, ts, te, curline);};
 # data/time formats
 # skip empty lines
 # lazy token_end
 
-        ';' {emit(SDLANG_TOKEN_NODE_END, ts, te, curline, user);};
+        ';' {emit(parser, SDLANG_TOKEN_NODE_END, ts, te, curline);};
 
         '{' {
-            emit(SDLANG_TOKEN_BLOCK, ts, te, curline, user);
-            fcall block;
+            emit(parser, SDLANG_TOKEN_BLOCK, ts, te, curline);
+
+            if (parser->skip.depth == 0)
+            {
+                fcall block;
+            }
+
+            fexec sdlang_skip_block(parser, p + 1, pe, &curline);
         };
 
         '}' {
-            emit(SDLANG_TOKEN_BLOCK_END, ts, te, curline, user);
+            emit(parser, SDLANG_TOKEN_BLOCK_END, ts, te, curline);
             fret;
         };
 
-        one_line_comment {emit(SDLANG_TOKEN_NODE_END, NULL, NULL, curline, user);};
-        '/*' {fgoto c_comment;};
+        one_line_comment {emit(parser, SDLANG_TOKEN_NODE_END, NULL, NULL, curline);};
+        '/*' {
+            fexec sdlang_skip_comment_body(p + 1, pe, &curline);
+            fgoto c_comment;
+        };
 
         newline_wrap; # wrapping lines do not end node
-        newline {emit(SDLANG_TOKEN_NODE_END, NULL, NULL, curline, user);};
+        newline {emit(parser, SDLANG_TOKEN_NODE_END, NULL, NULL, curline);};
 
-        [ \t];
+        [ \t] {fexec sdlang_skip_blank(p + 1, pe);};
 
     *|;
 
@@ -131,29 +146,283 @@
 
 %% write data nofinal;
 
-int sdlang_parse(size_t (*stream)(void* ptr, size_t size, void* user), void* user)
+static void sdlang_init(struct sdlang_parser_t* parser)
 {
-    char buf[SDLANG_PARSE_BUFFERSIZE];
-    int cs, act, have = 0, curline = 1;
-    int stack[SDLANG_PARSE_STACKSIZE], top = 0;
-    char *ts, *te = 0;
-    int done = 0, err = SDLANG_PARSE_OK;
+    int cs, act, top;
+    const char *ts, *te;
 
     %% write init;
 
+    parser->cs = cs;
+    parser->act = act;
+    parser->top = top;
+    parser->curline = 1;
+    parser->ts = ts;
+    parser->te = te;
+}
+
+static void sdlang_exec(struct sdlang_parser_t* parser, const char* p,
+                        const char* pe, const char* eof)
+{
+    int cs = parser->cs, act = parser->act, top = parser->top;
+    int curline = parser->curline;
+    int* stack = parser->stack;
+    const char *ts = parser->ts, *te = parser->te;
+
+    if (parser->skip.depth != 0)
+    {
+        /* a skipped block goes on from the previous buffer */
+        p = sdlang_skip_block(parser, p, pe, &curline);
+    }
+    else if (cs == sdlang_en_c_comment)
+    {
+        /* so does a comment */
+        p = sdlang_skip_comment_body(p, pe, &curline);
+    }
+
+    %% write exec;
+
+    if (parser->batch != NULL)
+    {
+        /* token strings don't survive the next refill */
+        sdlang_batch_flush(parser);
+    }
+
+    parser->cs = cs;
+    parser->act = act;
+    parser->top = top;
+    parser->curline = curline;
+    parser->ts = ts;
+    parser->te = te;
+}
+
+static int sdlang_check_state(const struct sdlang_parser_t* parser)
+{
+    if (parser->stopped)
+    {
+        return SDLANG_PARSE_STOPPED;
+    }
+
+    if (parser->cs == sdlang_error)
+    {
+        return SDLANG_PARSE_ERROR;
+    }
+
+    if (parser->top == SDLANG_PARSE_STACKSIZE)
+    {
+        return SDLANG_PARSE_ERROR_STACK_OVERFLOW;
+    }
+
+    return SDLANG_PARSE_OK;
+}
+
+void sdlang_parser_begin(struct sdlang_parser_t* parser, void* user)
+{
+    parser->user = user;
+    parser->have = 0;
+    parser->error = SDLANG_PARSE_OK;
+    parser->node = parser->attr = (struct sdlang_name_t) { "", 0, 0 };
+    parser->stats.bytes_read = 0;
+    parser->stats.bytes_copied = 0;
+    parser->skip.depth = 0;
+    parser->stopped = false;
+    sdlang_init(parser);
+}
+
+static bool sdlang_pinned(const struct sdlang_name_t* name)
+{
+    /* a name in the input, as opposed to an interned name */
+    return name->len > 0 && name->symbol == 0;
+}
+
+static size_t sdlang_pinned_end(const struct sdlang_parser_t* parser, const char* buf, const char* pe)
+{
+    /* end offset of the last name kept in the buffer, if any */
+    const struct sdlang_name_t* names[] = { &parser->attr, &parser->node };
+
+    for (int i = 0; i < 2; ++i)
+    {
+        if (sdlang_pinned(names[i]) && names[i]->ptr >= buf && names[i]->ptr < pe)
+        {
+            return (size_t)(names[i]->ptr + names[i]->len - buf);
+        }
+    }
+
+    return 0;
+}
+
+static char* sdlang_keep_names(struct sdlang_parser_t* parser, char* dst)
+{
+    /*
+        moves the names which the function table still refers to to `dst`,
+        keeping their order - they can't overlap with anything after them
+    */
+    struct sdlang_name_t* names[] = { &parser->node, &parser->attr };
+
+    for (int i = 0; i < 2; ++i)
+    {
+        if (sdlang_pinned(names[i]))
+        {
+            if (names[i]->ptr != dst)
+            {
+                SDLANG_MEMMOVE(dst, names[i]->ptr, names[i]->len);
+                names[i]->ptr = dst;
+                parser->stats.bytes_copied += names[i]->len;
+            }
+
+            dst += names[i]->len;
+        }
+    }
+
+    return dst;
+}
+
+static int sdlang_grow_buffer(struct sdlang_parser_t* parser, size_t size, size_t keep)
+{
+    /*
+        reallocates the parse buffer to hold at least `size` bytes, keeping
+        the first `keep` bytes - which are the unfinished token and the
+        pinned names, if any
+    */
+    const bool token = parser->ts >= parser->buf && parser->ts < parser->buf + keep;
+    const size_t ts = token ? (size_t)(parser->ts - parser->buf) : 0;
+    const size_t te = token ? (size_t)(parser->te - parser->buf) : 0;
+    struct sdlang_name_t* names[] = { &parser->node, &parser->attr };
+    size_t offsets[2] = { 0 };
+    bool moved[2] = { false };
+    size_t capacity = parser->capacity;
+    char* buf;
+
+    if (parser->allocator.alloc == NULL)
+    {
+        return SDLANG_PARSE_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    while (capacity < size)
+    {
+        capacity *= 2;
+    }
+
+    for (int i = 0; i < 2; ++i)
+    {
+        if (sdlang_pinned(names[i]) && names[i]->ptr >= parser->buf && names[i]->ptr < parser->buf + keep)
+        {
+            offsets[i] = (size_t)(names[i]->ptr - parser->buf);
+            moved[i] = true;
+        }
+    }
+
+    if (parser->buf == parser->buffer)
+    {
+        buf = (*parser->allocator.alloc)(NULL, capacity, parser->allocator.user);
+
+        if (buf != NULL)
+        {
+            SDLANG_MEMMOVE(buf, parser->buffer, keep);
+        }
+    }
+    else
+    {
+        buf = (*parser->allocator.alloc)(parser->buf, capacity, parser->allocator.user);
+    }
+
+    if (buf == NULL)
+    {
+        return SDLANG_PARSE_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    if (token)
+    {
+        parser->ts = buf + ts;
+        parser->te = buf + te;
+    }
+
+    for (int i = 0; i < 2; ++i)
+    {
+        if (moved[i])
+        {
+            names[i]->ptr = buf + offsets[i];
+        }
+    }
+
+    parser->buf = buf;
+    parser->capacity = capacity;
+    parser->stats.bytes_copied += keep;
+
+    return SDLANG_PARSE_OK;
+}
+
+static void sdlang_keep_buffer(struct sdlang_parser_t* parser, const char* pe)
+{
+    /*
+        an unfinished token stays where it is as long as there's enough
+        space left to read into, and is moved to the front of the buffer
+        only if the remaining space runs low - together with the names
+        pinned for the function table, which precede it
+    */
+    char* buf = parser->buf;
+
+    if (parser->ts == 0)
+    {
+        parser->have = sdlang_pinned_end(parser, buf, pe);
+
+        if (parser->have > 0 && parser->capacity - parser->have < parser->capacity / 2)
+        {
+            parser->have = sdlang_keep_names(parser, buf) - buf;
+        }
+
+        return;
+    }
+
+    parser->have = pe - buf;
+
+    if (parser->capacity - parser->have < parser->capacity / 2)
+    {
+        const size_t len = pe - parser->ts;
+        char* dst = sdlang_keep_names(parser, buf);
+
+        if (parser->ts > dst)
+        {
+            SDLANG_MEMMOVE(dst, parser->ts, len);
+            parser->te = dst + (parser->te - parser->ts);
+            parser->ts = dst;
+            parser->stats.bytes_copied += len;
+        }
+
+        parser->have = (size_t)(parser->ts - buf) + len;
+    }
+}
+
+static int sdlang_parse_stream(struct sdlang_parser_t* parser,
+                               size_t (*stream)(void* ptr, size_t size, void* user),
+                               void* stream_user, void* user)
+{
+    int done = 0, err = SDLANG_PARSE_OK;
+
+    sdlang_parser_begin(parser, user);
+
     while (!done)
     {
-        char *p = buf + have, *pe, *eof = 0;
-        int len, space = SDLANG_PARSE_BUFFERSIZE - have;
+        char *p, *pe, *eof = 0;
+        size_t len, space = parser->capacity - parser->have;
 
         if (space == 0)
         {
-            err = SDLANG_PARSE_ERROR_BUFFER_TOO_SMALL;
-            break;
+            /* a single token fills the whole buffer */
+            err = sdlang_grow_buffer(parser, parser->capacity + 1, parser->have);
+
+            if (err != SDLANG_PARSE_OK)
+            {
+                break;
+            }
+
+            space = parser->capacity - parser->have;
         }
 
-        len = (int)stream(p, space, user);
+        p = parser->buf + parser->have;
+        len = stream(p, space, stream_user);
         pe = p + len;
+        parser->stats.bytes_read += len;
 
         if (len < space)
         {
@@ -161,37 +430,212 @@ int sdlang_parse(size_t (*stream)(void* ptr, size_t size, void* user), void* use
             done = 1;
         }
 
-        %% write exec;
+        sdlang_exec(parser, p, pe, eof);
 
-        if (cs == sdlang_error)
+        if ((err = sdlang_check_state(parser)) != SDLANG_PARSE_OK)
         {
-            err = SDLANG_PARSE_ERROR;
             break;
         }
 
-        if (top == SDLANG_PARSE_STACKSIZE)
+        sdlang_keep_buffer(parser, pe);
+    }
+
+    if (err != SDLANG_PARSE_OK && err != SDLANG_PARSE_STOPPED)
+    {
+        (*parser->report_error)(err, parser->curline);
+    }
+
+    return err;
+}
+
+int sdlang_parser_parse(struct sdlang_parser_t* parser,
+    size_t (*stream)(void* ptr, size_t size, void* user), void* user)
+{
+    return sdlang_parse_stream(parser, stream, user, user);
+}
+
+static int sdlang_parse_sequential(struct sdlang_parser_t* parser,
+                                   const char* buffer, size_t size, void* user)
+{
+    int err;
+
+    sdlang_parser_begin(parser, user);
+    sdlang_exec(parser, buffer, buffer + size, buffer + size);
+    parser->stats.bytes_read = size;
+
+    if ((err = sdlang_check_state(parser)) != SDLANG_PARSE_OK && err != SDLANG_PARSE_STOPPED)
+    {
+        (*parser->report_error)(err, parser->curline);
+    }
+
+    return err;
+}
+
+int sdlang_parser_parse_buffer(struct sdlang_parser_t* parser,
+    const char* buffer, size_t size, void* user)
+{
+#ifdef SDLANG_HAVE_THREADS
+    /* skipping and stopping act on the scanner of this parser */
+    if (parser->threads > 1 && parser->emit_control == NULL
+        && size >= 2 * (size_t)SDLANG_PARSE_CHUNKSIZE)
+    {
+        return sdlang_parse_parallel(parser, buffer, size, user);
+    }
+#endif
+
+    return sdlang_parse_sequential(parser, buffer, size, user);
+}
+
+static int sdlang_feed_error(struct sdlang_parser_t* parser, int err)
+{
+    parser->error = err;
+
+    if (err != SDLANG_PARSE_STOPPED)
+    {
+        (*parser->report_error)(err, parser->curline);
+    }
+
+    return err;
+}
+
+static int sdlang_keep_token(struct sdlang_parser_t* parser, const char* pe)
+{
+    /*
+        copies an unfinished token, and the names pinned for the function
+        table, from the caller's memory - names already in the buffer are
+        moved to the front
+    */
+    const size_t len = parser->ts != 0 ? (size_t)(pe - parser->ts) : 0;
+    const size_t have = len + (sdlang_pinned(&parser->node) ? parser->node.len : 0)
+                            + (sdlang_pinned(&parser->attr) ? parser->attr.len : 0);
+    char* dst;
+    int err;
+
+    if (have > parser->capacity
+        && (err = sdlang_grow_buffer(parser, have,
+                sdlang_pinned_end(parser, parser->buf, parser->buf + parser->capacity))) != SDLANG_PARSE_OK)
+    {
+        return err;
+    }
+
+    dst = sdlang_keep_names(parser, parser->buf);
+
+    if (parser->ts != 0)
+    {
+        SDLANG_MEMMOVE(dst, parser->ts, len);
+        parser->te = dst + (parser->te - parser->ts);
+        parser->ts = dst;
+        parser->stats.bytes_copied += len;
+    }
+
+    parser->have = have;
+
+    return SDLANG_PARSE_OK;
+}
+
+int sdlang_parser_feed(struct sdlang_parser_t* parser, const char* data, size_t size)
+{
+    size_t step = 16;
+    int err;
+
+    if (parser->error != SDLANG_PARSE_OK)
+    {
+        return parser->error;
+    }
+
+    /*
+        a token split across calls is completed in the parser buffer, by
+        copying steps which double in size until it ends - the remaining
+        bytes, and a token which started in the last step, are scanned in
+        place
+    */
+    while (parser->ts != 0 && size > 0)
+    {
+        char *p, *pe;
+        size_t len, space = parser->capacity - parser->have;
+
+        if (space == 0)
         {
-            err = SDLANG_PARSE_ERROR_STACK_OVERFLOW;
-            break;
+            err = sdlang_grow_buffer(parser, parser->capacity + 1, parser->have);
+
+            if (err != SDLANG_PARSE_OK)
+            {
+                return sdlang_feed_error(parser, err);
+            }
+
+            space = parser->capacity - parser->have;
         }
 
-        if (ts == 0)
+        len = size < space ? size : space;
+        len = len < step ? len : step;
+        p = parser->buf + parser->have;
+        pe = p + len;
+        SDLANG_MEMMOVE(p, data, len);
+        data += len;
+        size -= len;
+        step *= 2;
+        parser->stats.bytes_read += len;
+        parser->stats.bytes_copied += len;
+
+        sdlang_exec(parser, p, pe, 0);
+
+        if ((err = sdlang_check_state(parser)) != SDLANG_PARSE_OK)
+        {
+            return sdlang_feed_error(parser, err);
+        }
+
+        if (size > 0 && (parser->ts == 0 || parser->ts >= p))
         {
-            have = 0;
+            const char *ts = parser->ts, *te = parser->te;
+
+            parser->ts = 0;
+            sdlang_keep_buffer(parser, pe);
+
+            if (ts != 0)
+            {
+                parser->ts = data - (pe - ts);
+                parser->te = parser->ts + (te - ts);
+            }
+
+            break;
         }
-        else
+
+        sdlang_keep_buffer(parser, pe);
+    }
+
+    if (size > 0)
+    {
+        sdlang_exec(parser, data, data + size, 0);
+        parser->stats.bytes_read += size;
+
+        if ((err = sdlang_check_state(parser)) != SDLANG_PARSE_OK
+            || ((parser->ts != 0 || sdlang_pinned(&parser->node) || sdlang_pinned(&parser->attr))
+                && (err = sdlang_keep_token(parser, data + size)) != SDLANG_PARSE_OK))
         {
-            have = (int)(pe - ts);
-            SDLANG_MEMMOVE(buf, ts, have);
-            te = buf + (te - ts);
-            ts = buf;
+            return sdlang_feed_error(parser, err);
         }
     }
 
-    if (err != SDLANG_PARSE_OK)
+    return SDLANG_PARSE_OK;
+}
+
+int sdlang_parser_finish(struct sdlang_parser_t* parser)
+{
+    const char* pe = parser->buf + parser->have;
+    int err;
+
+    if (parser->error != SDLANG_PARSE_OK)
+    {
+        return parser->error;
+    }
+
+    sdlang_exec(parser, pe, pe, pe);
+    parser->have = 0;
+
+    if ((err = sdlang_check_state(parser)) != SDLANG_PARSE_OK)
     {
-        (*sdlang_user_report_error)(err, curline);
+        return sdlang_feed_error(parser, err);
     }
 
-    return err;
+    return SDLANG_PARSE_OK;
 }
@@ -0,0 +1,951 @@
+#include "sdlang.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+    Generates a loader for a schema written in SDL, which fills a struct
+    like sdlang_schema_parse() does, but matches names with code instead of
+    looking them up in a hash table.
+
+    schemac schema.sdl prefix
+
+    writes prefix.h and prefix.c. A schema names the loader, and binds
+    each path to a member of the struct:
+
+        schema "window"
+
+        field "window@title" "string" 64
+        field "window/size" "i32" 2
+        field "window/fullscreen" "bool"
+        field "window/gamma" "f32" member="gamma"
+
+    The type is one of i32, i64, u32, u64, f32, f64, bool or string. The
+    count is the number of elements of an array, or the size of a string,
+    and defaults to 1. The member is named after the last node or attribute
+    of the path, unless given.
+
+    For each block, the names of its nodes are matched by length, then by
+    the first character which tells them apart, and at last compared with a
+    memcmp() of constant length, so a name is recognized in a few branches.
+    Nodes which no path looks into, and their blocks, are skipped by the
+    generic parser.
+*/
+
+#define MAX_FIELDS (SDLANG_SCHEMA_KEYS / 2)
+#define MAX_NAME SDLANG_NODE_MAXNAMELEN
+
+struct field_t
+{
+    char path[4 * MAX_NAME];
+    char member[MAX_NAME];
+    enum sdlang_field_type_t type;
+    uint32_t count;
+
+    /* the node whose values or attribute the field takes */
+    uint32_t key;
+    char attribute[MAX_NAME];
+};
+
+struct key_t
+{
+    /* key of the block the node is in, 0 for the top level */
+    uint32_t parent;
+    char name[MAX_NAME];
+
+    /* field + 1 of the values of the node, if any */
+    uint32_t field;
+    bool children;
+};
+
+/* a name to match, and the number returned for it */
+struct match_t
+{
+    const char* name;
+    size_t len;
+    uint32_t result;
+};
+
+static const struct
+{
+    const char* name;
+    const char* c_type;
+} types[] = {
+    { "i32", "int32_t" },
+    { "i64", "int64_t" },
+    { "u32", "uint32_t" },
+    { "u64", "uint64_t" },
+    { "f32", "float" },
+    { "f64", "double" },
+    { "bool", "bool" },
+    { "string", "char" }
+};
+
+#define NUM_TYPES (sizeof(types) / sizeof(types[0]))
+
+/* store function of each type, with the conversions of sdlang_schema_parse() */
+static const char* const stores[NUM_TYPES] = {
+    "    if (*count == size || token->type != SDLANG_TOKEN_INT32)\n"
+    "    {\n"
+    "        return false;\n"
+    "    }\n"
+    "\n"
+    "    dst[(*count)++] = sdlang_token_i32(token);\n"
+    "    return true;\n",
+
+    "    if (*count == size || (token->type != SDLANG_TOKEN_INT32 && token->type != SDLANG_TOKEN_INT64))\n"
+    "    {\n"
+    "        return false;\n"
+    "    }\n"
+    "\n"
+    "    dst[(*count)++] = token->type == SDLANG_TOKEN_INT32 ? sdlang_token_i32(token) : sdlang_token_i64(token);\n"
+    "    return true;\n",
+
+    "    int32_t i;\n"
+    "\n"
+    "    if (*count == size)\n"
+    "    {\n"
+    "        return false;\n"
+    "    }\n"
+    "\n"
+    "    if (token->type == SDLANG_TOKEN_UINT32)\n"
+    "    {\n"
+    "        dst[(*count)++] = (uint32_t)sdlang_token_u64(token);\n"
+    "        return true;\n"
+    "    }\n"
+    "\n"
+    "    if (token->type != SDLANG_TOKEN_INT32 || (i = sdlang_token_i32(token)) < 0)\n"
+    "    {\n"
+    "        return false;\n"
+    "    }\n"
+    "\n"
+    "    dst[(*count)++] = (uint32_t)i;\n"
+    "    return true;\n",
+
+    "    int64_t i;\n"
+    "\n"
+    "    if (*count == size)\n"
+    "    {\n"
+    "        return false;\n"
+    "    }\n"
+    "\n"
+    "    if (token->type == SDLANG_TOKEN_UINT32 || token->type == SDLANG_TOKEN_UINT64)\n"
+    "    {\n"
+    "        dst[(*count)++] = sdlang_token_u64(token);\n"
+    "        return true;\n"
+    "    }\n"
+    "\n"
+    "    if (token->type == SDLANG_TOKEN_INT32)\n"
+    "    {\n"
+    "        i = sdlang_token_i32(token);\n"
+    "    }\n"
+    "    else if (token->type == SDLANG_TOKEN_INT64)\n"
+    "    {\n"
+    "        i = sdlang_token_i64(token);\n"
+    "    }\n"
+    "    else\n"
+    "    {\n"
+    "        return false;\n"
+    "    }\n"
+    "\n"
+    "    if (i < 0)\n"
+    "    {\n"
+    "        return false;\n"
+    "    }\n"
+    "\n"
+    "    dst[(*count)++] = (uint64_t)i;\n"
+    "    return true;\n",
+
+    "    if (*count == size)\n"
+    "    {\n"
+    "        return false;\n"
+    "    }\n"
+    "\n"
+    "    switch (token->type)\n"
+    "    {\n"
+    "    case SDLANG_TOKEN_FLOAT32:\n"
+    "    case SDLANG_TOKEN_FLOAT64:\n"
+    "        dst[(*count)++] = sdlang_token_f32(token);\n"
+    "        return true;\n"
+    "    case SDLANG_TOKEN_INT32:\n"
+    "        dst[(*count)++] = (float)sdlang_token_i32(token);\n"
+    "        return true;\n"
+    "    case SDLANG_TOKEN_INT64:\n"
+    "        dst[(*count)++] = (float)sdlang_token_i64(token);\n"
+    "        return true;\n"
+    "    default:\n"
+    "        return false;\n"
+    "    }\n",
+
+    "    if (*count == size)\n"
+    "    {\n"
+    "        return false;\n"
+    "    }\n"
+    "\n"
+    "    switch (token->type)\n"
+    "    {\n"
+    "    case SDLANG_TOKEN_FLOAT32:\n"
+    "        dst[(*count)++] = sdlang_token_f32(token);\n"
+    "        return true;\n"
+    "    case SDLANG_TOKEN_FLOAT64:\n"
+    "        dst[(*count)++] = sdlang_token_f64(token);\n"
+    "        return true;\n"
+    "    case SDLANG_TOKEN_INT32:\n"
+    "        dst[(*count)++] = (double)sdlang_token_i32(token);\n"
+    "        return true;\n"
+    "    case SDLANG_TOKEN_INT64:\n"
+    "        dst[(*count)++] = (double)sdlang_token_i64(token);\n"
+    "        return true;\n"
+    "    default:\n"
+    "        return false;\n"
+    "    }\n",
+
+    "    if (*count == size || (token->type != SDLANG_TOKEN_TRUE && token->type != SDLANG_TOKEN_FALSE))\n"
+    "    {\n"
+    "        return false;\n"
+    "    }\n"
+    "\n"
+    "    dst[(*count)++] = token->type == SDLANG_TOKEN_TRUE;\n"
+    "    return true;\n",
+
+    "    /* a single string, `size` is the size of the array; backquoted strings are taken literally */\n"
+    "    const char *s = token->string.from, *e = token->string.to;\n"
+    "    const size_t len = (size_t)(e - s);\n"
+    "    char* text;\n"
+    "    int n;\n"
+    "\n"
+    "    if (*count != 0 || token->type != SDLANG_TOKEN_STRING)\n"
+    "    {\n"
+    "        return false;\n"
+    "    }\n"
+    "\n"
+    "    if (token->raw || memchr(s, '\\\\', len) == NULL)\n"
+    "    {\n"
+    "        if (len >= size)\n"
+    "        {\n"
+    "            return false;\n"
+    "        }\n"
+    "\n"
+    "        memcpy(dst, s, len);\n"
+    "        dst[len] = '\\0';\n"
+    "        *count = 1;\n"
+    "        return true;\n"
+    "    }\n"
+    "\n"
+    "    /* escapes only shorten the text, which may then fit */\n"
+    "    if ((text = len < size ? dst : (char*)malloc(len)) == NULL)\n"
+    "    {\n"
+    "        return false;\n"
+    "    }\n"
+    "\n"
+    "    n = sdlang_decode_string(s, (int)len, text);\n"
+    "\n"
+    "    if (text != dst)\n"
+    "    {\n"
+    "        if ((size_t)n < size)\n"
+    "        {\n"
+    "            memcpy(dst, text, (size_t)n);\n"
+    "        }\n"
+    "\n"
+    "        free(text);\n"
+    "    }\n"
+    "\n"
+    "    if ((size_t)n >= size)\n"
+    "    {\n"
+    "        return false;\n"
+    "    }\n"
+    "\n"
+    "    dst[n] = '\\0';\n"
+    "    *count = 1;\n"
+    "    return true;\n"
+};
+
+static struct field_t fields[MAX_FIELDS];
+static uint32_t num_fields;
+
+/* key 0 is the top level */
+static struct key_t keys[MAX_FIELDS + 1];
+static uint32_t num_keys;
+
+static struct match_t matches[MAX_FIELDS];
+
+static bool copy_name(char* dst, const char* src, size_t len)
+{
+    if (len == 0 || len >= MAX_NAME)
+    {
+        return false;
+    }
+
+    memcpy(dst, src, len);
+    dst[len] = '\0';
+    return true;
+}
+
+static uint32_t add_key(uint32_t parent, const char* name, size_t len)
+{
+    uint32_t key;
+
+    for (key = 1; key <= num_keys; key++)
+    {
+        if (keys[key].parent == parent && strlen(keys[key].name) == len && memcmp(keys[key].name, name, len) == 0)
+        {
+            return key;
+        }
+    }
+
+    if (!copy_name(keys[num_keys + 1].name, name, len))
+    {
+        return 0;
+    }
+
+    key = ++num_keys;
+    keys[key].parent = parent;
+    keys[parent].children = true;
+
+    return key;
+}
+
+static bool add_fields(void)
+{
+    /* splits paths into keys, which sdlang_schema_init() has checked */
+    for (uint32_t f = 0; f < num_fields; f++)
+    {
+        struct field_t* field = &fields[f];
+        const char* p = field->path;
+        const char* last = p;
+        uint32_t key = 0;
+
+        for (;;)
+        {
+            const char* e = p + strcspn(p, "/@");
+
+            if ((key = add_key(key, p, (size_t)(e - p))) == 0)
+            {
+                fprintf(stderr, "%s: names are limited to %d characters\n", field->path, MAX_NAME - 1);
+                return false;
+            }
+
+            last = p;
+            p = e;
+
+            if (*p == '@')
+            {
+                last = p + 1;
+
+                if (!copy_name(field->attribute, last, strlen(last)))
+                {
+                    fprintf(stderr, "%s: names are limited to %d characters\n", field->path, MAX_NAME - 1);
+                    return false;
+                }
+                break;
+            }
+
+            if (*p++ == '\0')
+            {
+                keys[key].field = f + 1;
+                break;
+            }
+        }
+
+        field->key = key;
+
+        if (field->member[0] == '\0')
+        {
+            /* named after the last node or attribute, as a C identifier */
+            for (size_t i = 0; last[i] != '\0' && last[i] != '/' && last[i] != '@'; i++)
+            {
+                field->member[i] = strchr(".:-$", last[i]) != NULL ? '_' : last[i];
+            }
+        }
+
+        for (uint32_t i = 0; i < f; i++)
+        {
+            if (strcmp(fields[i].member, field->member) == 0)
+            {
+                fprintf(stderr, "member %s is bound twice\n", field->member);
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+static bool valid_identifier(const char* name)
+{
+    if (!((name[0] >= 'a' && name[0] <= 'z') || (name[0] >= 'A' && name[0] <= 'Z') || name[0] == '_'))
+    {
+        return false;
+    }
+
+    return strspn(name, "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_") == strlen(name);
+}
+
+static bool string_value(const struct sdlang_document_t* doc, const struct sdlang_value_t* value,
+                         char* dst, size_t size)
+{
+    if (value == NULL || value->type != SDLANG_VALUE_STRING || value->length >= size)
+    {
+        return false;
+    }
+
+    memcpy(dst, sdlang_document_data(doc, value), value->length);
+    dst[value->length] = '\0';
+    return true;
+}
+
+static bool read_schema(const char* path, char* name, size_t size)
+{
+    struct sdlang_document_t doc;
+    struct sdlang_field_t table[MAX_FIELDS];
+    struct sdlang_schema_t* schema;
+    char type[16];
+    bool ok = true;
+
+    if (sdlang_document_parse_file(&doc, path, NULL) != SDLANG_PARSE_OK)
+    {
+        fprintf(stderr, "failed to parse %s\n", path);
+        return false;
+    }
+
+    uint32_t node = sdlang_document_child(&doc, 0, "schema");
+
+    if (node == 0 || !string_value(&doc, sdlang_document_value(&doc, node, 0), name, size) || !valid_identifier(name))
+    {
+        fprintf(stderr, "%s: expected schema \"name\"\n", path);
+        sdlang_document_free(&doc);
+        return false;
+    }
+
+    for (node = sdlang_document_child(&doc, 0, "field"); node != 0 && ok; node = sdlang_document_next(&doc, node, "field"))
+    {
+        struct field_t* field = &fields[num_fields];
+        const struct sdlang_value_t* count = sdlang_document_value(&doc, node, 2);
+        const struct sdlang_value_t* member = sdlang_document_attribute(&doc, node, "member");
+        const int line = (int)doc.nodes[node].line;
+        size_t t;
+
+        if (num_fields == MAX_FIELDS)
+        {
+            fprintf(stderr, "%s:%d: too many fields\n", path, line);
+            ok = false;
+            break;
+        }
+
+        if (!string_value(&doc, sdlang_document_value(&doc, node, 0), field->path, sizeof(field->path))
+            || !string_value(&doc, sdlang_document_value(&doc, node, 1), type, sizeof(type)))
+        {
+            fprintf(stderr, "%s:%d: expected field \"path\" \"type\" [count]\n", path, line);
+            ok = false;
+            break;
+        }
+
+        for (t = 0; t < NUM_TYPES && strcmp(types[t].name, type) != 0; t++)
+        {
+        }
+
+        if (t == NUM_TYPES)
+        {
+            fprintf(stderr, "%s:%d: unknown type %s\n", path, line, type);
+            ok = false;
+            break;
+        }
+
+        field->type = (enum sdlang_field_type_t)t;
+        field->count = 1;
+
+        if (count != NULL)
+        {
+            if (count->type != SDLANG_VALUE_I32 || count->data.i32 < 1)
+            {
+                fprintf(stderr, "%s:%d: count must be a positive integer\n", path, line);
+                ok = false;
+                break;
+            }
+
+            field->count = (uint32_t)count->data.i32;
+        }
+
+        if (member != NULL && (!string_value(&doc, member, field->member, sizeof(field->member))
+                               || !valid_identifier(field->member)))
+        {
+            fprintf(stderr, "%s:%d: member must be a C identifier\n", path, line);
+            ok = false;
+            break;
+        }
+
+        table[num_fields] = (struct sdlang_field_t) { field->path, field->type, 0, field->count };
+        num_fields++;
+    }
+
+    sdlang_document_free(&doc);
+
+    if (!ok)
+    {
+        return false;
+    }
+
+    /* the same checks as a schema built at runtime */
+    if ((schema = malloc(sizeof(struct sdlang_schema_t))) == NULL)
+    {
+        fprintf(stderr, "out of memory\n");
+        return false;
+    }
+
+    if (num_fields == 0 || sdlang_schema_init(schema, table, num_fields) != SDLANG_PARSE_OK)
+    {
+        fprintf(stderr, "%s: a path is malformed or bound twice\n", path);
+        ok = false;
+    }
+
+    free(schema);
+    return ok && add_fields();
+}
+
+static void print_upper(FILE* out, const char* s)
+{
+    for (; *s != '\0'; s++)
+    {
+        fputc(*s >= 'a' && *s <= 'z' ? *s - 'a' + 'A' : *s, out);
+    }
+}
+
+static int compare_matches(const void* a, const void* b)
+{
+    const struct match_t* x = (const struct match_t*)a;
+    const struct match_t* y = (const struct match_t*)b;
+
+    if (x->len != y->len)
+    {
+        return x->len < y->len ? -1 : 1;
+    }
+
+    return strcmp(x->name, y->name);
+}
+
+static void write_group(FILE* out, const struct match_t* group, uint32_t n, int indent)
+{
+    /* names of the same length, sorted */
+    if (n == 1)
+    {
+        fprintf(out, "%*sreturn memcmp(s, \"%s\", %zu) == 0 ? %u : 0;\n",
+                indent, "", group->name, group->len, group->result);
+        return;
+    }
+
+    size_t at = 0;
+
+    while (group[0].name[at] == group[n - 1].name[at])
+    {
+        at++;
+    }
+
+    fprintf(out, "%*sswitch (s[%zu])\n%*s{\n", indent, "", at, indent, "");
+
+    for (uint32_t i = 0, j; i < n; i = j)
+    {
+        for (j = i + 1; j < n && group[j].name[at] == group[i].name[at]; j++)
+        {
+        }
+
+        fprintf(out, "%*scase '%c':\n", indent, "", group[i].name[at]);
+        write_group(out, group + i, j - i, indent + 4);
+    }
+
+    fprintf(out, "%*s}\n%*sbreak;\n", indent, "", indent, "");
+}
+
+static void write_matches(FILE* out, struct match_t* list, uint32_t n, int indent)
+{
+    qsort(list, n, sizeof(struct match_t), compare_matches);
+    fprintf(out, "%*sswitch (len)\n%*s{\n", indent, "", indent, "");
+
+    for (uint32_t i = 0, j; i < n; i = j)
+    {
+        for (j = i + 1; j < n && list[j].len == list[i].len; j++)
+        {
+        }
+
+        fprintf(out, "%*scase %zu:\n", indent, "", list[i].len);
+        write_group(out, list + i, j - i, indent + 4);
+    }
+
+    fprintf(out, "%*s}\n%*sbreak;\n", indent, "", indent, "");
+}
+
+static void write_header(FILE* out, const char* name, const char* schema_path)
+{
+    fprintf(out, "/* generated by schemac from %s, don't edit */\n\n#pragma once\n\n#include \"sdlang.h\"\n\n", schema_path);
+    fprintf(out, "#ifdef __cplusplus\nextern \"C\" {\n#endif\n\n");
+    fprintf(out, "struct %s_t\n{\n", name);
+
+    for (uint32_t f = 0; f < num_fields; f++)
+    {
+        if (fields[f].count == 1 && fields[f].type != SDLANG_FIELD_STRING)
+        {
+            fprintf(out, "    %s %s;\n", types[fields[f].type].c_type, fields[f].member);
+        }
+        else
+        {
+            fprintf(out, "    %s %s[%u];\n", types[fields[f].type].c_type, fields[f].member, fields[f].count);
+        }
+    }
+
+    fprintf(out, "};\n\n/* indices of `counts` */\nenum %s_field_t\n{\n", name);
+
+    for (uint32_t f = 0; f < num_fields; f++)
+    {
+        fprintf(out, "    ");
+        print_upper(out, name);
+        fputc('_', out);
+        print_upper(out, fields[f].member);
+        fprintf(out, ",\n");
+    }
+
+    fprintf(out, "    ");
+    print_upper(out, name);
+    fprintf(out, "_NUM_FIELDS\n};\n\n");
+
+    fprintf(out,
+            "extern int %s_parse(struct sdlang_parser_t* parser, struct %s_t* target, uint32_t* counts,\n"
+            "    size_t (*stream)(void* ptr, size_t size, void* user), void* user);\n"
+            "extern int %s_parse_buffer(struct sdlang_parser_t* parser, struct %s_t* target, uint32_t* counts,\n"
+            "    const char* buffer, size_t size);\n"
+            "extern int %s_parse_file(struct sdlang_parser_t* parser, struct %s_t* target, uint32_t* counts,\n"
+            "    const char* path);\n\n",
+            name, name, name, name, name, name);
+    fprintf(out, "#ifdef __cplusplus\n}\n#endif\n");
+}
+
+static void write_source(FILE* out, const char* name, const char* header, const char* schema_path)
+{
+    bool used[NUM_TYPES] = { false };
+    uint32_t n;
+
+    fprintf(out, "/* generated by schemac from %s, don't edit */\n\n#include \"%s\"\n\n", schema_path, header);
+    fprintf(out, "#include <stdlib.h>\n#include <string.h>\n\n");
+
+    fprintf(out,
+            "struct %s_state_t\n{\n"
+            "    struct %s_t* target;\n"
+            "    uint32_t counts[%u];\n"
+            "    int err;\n\n"
+            "    /* key of each open block, 0 for the top level */\n"
+            "    uint32_t blocks[SDLANG_PARSE_STACKSIZE + 1];\n"
+            "    int depth;\n\n"
+            "    /* the current node and its key, and the field + 1 selected by an attribute name */\n"
+            "    bool node, attribute;\n"
+            "    uint32_t key, selected;\n\n"
+            "    size_t (*stream)(void* ptr, size_t size, void* user);\n"
+            "    void* stream_user;\n"
+            "};\n\n",
+            name, name, num_fields);
+
+    /* keys */
+    fprintf(out, "/* field + 1 of the values of each node key */\nstatic const uint32_t %s_values[%u] = {", name, num_keys + 1);
+
+    for (uint32_t key = 0; key <= num_keys; key++)
+    {
+        fprintf(out, "%s%u", key == 0 ? " " : ", ", keys[key].field);
+    }
+
+    fprintf(out, " };\n\n/* whether a path looks into the block of each node key */\nstatic const bool %s_children[%u] = {", name, num_keys + 1);
+
+    for (uint32_t key = 0; key <= num_keys; key++)
+    {
+        /* unknown nodes have key 0, the top level isn't a block */
+        fprintf(out, "%s%s", key == 0 ? " " : ", ", key != 0 && keys[key].children ? "true" : "false");
+    }
+
+    fprintf(out, " };\n\n");
+
+    /* node names */
+    fprintf(out,
+            "static uint32_t %s_node(uint32_t block, const char* s, size_t len)\n{\n"
+            "    /* returns the key of a node in the block of key `block`, or 0 */\n"
+            "    switch (block)\n    {\n",
+            name);
+
+    for (uint32_t block = 0; block <= num_keys; block++)
+    {
+        n = 0;
+
+        for (uint32_t key = 1; key <= num_keys; key++)
+        {
+            if (keys[key].parent == block)
+            {
+                matches[n++] = (struct match_t) { keys[key].name, strlen(keys[key].name), key };
+            }
+        }
+
+        if (n != 0)
+        {
+            fprintf(out, "    case %u:\n", block);
+            write_matches(out, matches, n, 8);
+        }
+    }
+
+    fprintf(out, "    }\n\n    return 0;\n}\n\n");
+
+    /* attribute names */
+    fprintf(out,
+            "static uint32_t %s_attribute(uint32_t key, const char* s, size_t len)\n{\n"
+            "    /* returns the field + 1 of an attribute of a node of key `key`, or 0 */\n",
+            name);
+
+    n = 0;
+
+    for (uint32_t f = 0; f < num_fields; f++)
+    {
+        n += fields[f].attribute[0] != '\0';
+    }
+
+    if (n == 0)
+    {
+        fprintf(out, "    (void)key;\n    (void)s;\n    (void)len;\n\n");
+    }
+    else
+    {
+        fprintf(out, "    switch (key)\n    {\n");
+
+        for (uint32_t key = 1; key <= num_keys; key++)
+        {
+            n = 0;
+
+            for (uint32_t f = 0; f < num_fields; f++)
+            {
+                if (fields[f].key == key && fields[f].attribute[0] != '\0')
+                {
+                    matches[n++] = (struct match_t) { fields[f].attribute, strlen(fields[f].attribute), f + 1 };
+                }
+            }
+
+            if (n != 0)
+            {
+                fprintf(out, "    case %u:\n", key);
+                write_matches(out, matches, n, 8);
+            }
+        }
+
+        fprintf(out, "    }\n\n");
+    }
+
+    fprintf(out, "    return 0;\n}\n\n");
+
+    /* conversions */
+    for (uint32_t f = 0; f < num_fields; f++)
+    {
+        used[fields[f].type] = true;
+    }
+
+    for (size_t t = 0; t < NUM_TYPES; t++)
+    {
+        if (used[t])
+        {
+            fprintf(out,
+                    "static bool %s_store_%s(const struct sdlang_token_t* token, %s* dst, uint32_t size, uint32_t* count)\n{\n%s}\n\n",
+                    name, types[t].name, types[t].c_type, stores[t]);
+        }
+    }
+
+    fprintf(out,
+            "static bool %s_store(struct %s_state_t* state, uint32_t field, const struct sdlang_token_t* token)\n{\n"
+            "    struct %s_t* target = state->target;\n"
+            "    uint32_t* count = &state->counts[field];\n\n"
+            "    switch (field)\n    {\n",
+            name, name, name);
+
+    for (uint32_t f = 0; f < num_fields; f++)
+    {
+        const bool array = fields[f].count != 1 || fields[f].type == SDLANG_FIELD_STRING;
+
+        fprintf(out, "    case %u:\n        return %s_store_%s(token, %starget->%s, %u, count);\n",
+                f, name, types[fields[f].type].name, array ? "" : "&", fields[f].member, fields[f].count);
+    }
+
+    fprintf(out, "    default:\n        return false;\n    }\n}\n\n");
+
+    /* control function */
+    fprintf(out,
+            "static enum sdlang_control_t %s_control(struct sdlang_parser_t* parser, const struct sdlang_token_t* token,\n"
+            "    void* user)\n"
+            "{\n"
+            "    struct %s_state_t* state = (struct %s_state_t*)user;\n"
+            "    const char *s = token->string.from, *e = token->string.to;\n"
+            "    uint32_t field;\n\n"
+            "    switch (token->type)\n"
+            "    {\n"
+            "    case SDLANG_TOKEN_NODE:\n"
+            "        state->node = true;\n"
+            "        state->key = %s_node(state->blocks[state->depth], s, (size_t)(e - s));\n"
+            "        state->attribute = false;\n"
+            "        break;\n\n"
+            "    case SDLANG_TOKEN_NODE_END:\n"
+            "        state->node = false;\n"
+            "        state->attribute = false;\n"
+            "        break;\n\n"
+            "    case SDLANG_TOKEN_BLOCK:\n"
+            "        if (!state->node || !%s_children[state->key] || state->depth == SDLANG_PARSE_STACKSIZE)\n"
+            "        {\n"
+            "            /* nothing to bind inside */\n"
+            "            state->node = false;\n"
+            "            state->attribute = false;\n"
+            "            return SDLANG_SKIP;\n"
+            "        }\n\n"
+            "        state->blocks[++state->depth] = state->key;\n"
+            "        state->node = false;\n"
+            "        state->attribute = false;\n"
+            "        break;\n\n"
+            "    case SDLANG_TOKEN_BLOCK_END:\n"
+            "        if (state->depth > 0)\n"
+            "        {\n"
+            "            --state->depth;\n"
+            "        }\n\n"
+            "        state->node = false;\n"
+            "        state->attribute = false;\n"
+            "        break;\n\n"
+            "    case SDLANG_TOKEN_ATTRIBUTE:\n"
+            "        if (!state->node)\n"
+            "        {\n"
+            "            /* attributes without a name */\n"
+            "            state->node = true;\n"
+            "            state->key = 0;\n"
+            "        }\n\n"
+            "        state->attribute = true;\n"
+            "        state->selected = state->key != 0 ? %s_attribute(state->key, s, (size_t)(e - s)) : 0;\n"
+            "        break;\n\n"
+            "    default:\n"
+            "        if (!state->node)\n"
+            "        {\n"
+            "            /* values without a name */\n"
+            "            state->node = true;\n"
+            "            state->key = 0;\n"
+            "        }\n\n"
+            "        field = state->attribute ? state->selected : %s_values[state->key];\n"
+            "        state->attribute = false;\n\n"
+            "        if (field != 0 && token->type != SDLANG_TOKEN_NULL && !%s_store(state, field - 1, token))\n"
+            "        {\n"
+            "            state->err = SDLANG_PARSE_ERROR_VALUE;\n"
+            "            (*parser->report_error)(SDLANG_PARSE_ERROR_VALUE, token->line);\n"
+            "        }\n"
+            "        break;\n"
+            "    }\n\n"
+            "    return SDLANG_CONTINUE;\n"
+            "}\n\n",
+            name, name, name, name, name, name, name, name);
+
+    /* parse functions */
+    fprintf(out,
+            "static void %s_emit_token(struct sdlang_parser_t* parser, const struct sdlang_token_t* token, void* user)\n"
+            "{\n"
+            "    /* everything is done by the control function */\n"
+            "    (void)parser;\n"
+            "    (void)token;\n"
+            "    (void)user;\n"
+            "}\n\n"
+            "static void %s_begin(struct %s_state_t* state, struct sdlang_parser_t* parser, struct %s_t* target)\n"
+            "{\n"
+            "    state->target = target;\n"
+            "    memset(state->counts, 0, sizeof(state->counts));\n"
+            "    state->err = SDLANG_PARSE_OK;\n"
+            "    state->blocks[0] = 0;\n"
+            "    state->depth = 0;\n"
+            "    state->node = state->attribute = false;\n"
+            "    state->stream = NULL;\n\n"
+            "    sdlang_parser_set_emit_token(parser, %s_emit_token);\n"
+            "    sdlang_parser_set_emit_control(parser, %s_control);\n"
+            "}\n\n"
+            "static int %s_end(struct %s_state_t* state, uint32_t* counts, int err)\n"
+            "{\n"
+            "    if (counts != NULL)\n"
+            "    {\n"
+            "        memcpy(counts, state->counts, sizeof(state->counts));\n"
+            "    }\n\n"
+            "    return err != SDLANG_PARSE_OK ? err : state->err;\n"
+            "}\n\n"
+            "static size_t %s_stream(void* ptr, size_t size, void* user)\n"
+            "{\n"
+            "    struct %s_state_t* state = (struct %s_state_t*)user;\n"
+            "    return (*state->stream)(ptr, size, state->stream_user);\n"
+            "}\n\n",
+            name, name, name, name, name, name, name, name, name, name, name);
+
+    fprintf(out,
+            "int %s_parse(struct sdlang_parser_t* parser, struct %s_t* target, uint32_t* counts,\n"
+            "    size_t (*stream)(void* ptr, size_t size, void* user), void* user)\n"
+            "{\n"
+            "    struct %s_state_t state;\n\n"
+            "    %s_begin(&state, parser, target);\n"
+            "    state.stream = stream;\n"
+            "    state.stream_user = user;\n\n"
+            "    return %s_end(&state, counts, sdlang_parser_parse(parser, %s_stream, &state));\n"
+            "}\n\n"
+            "int %s_parse_buffer(struct sdlang_parser_t* parser, struct %s_t* target, uint32_t* counts,\n"
+            "    const char* buffer, size_t size)\n"
+            "{\n"
+            "    struct %s_state_t state;\n\n"
+            "    %s_begin(&state, parser, target);\n\n"
+            "    return %s_end(&state, counts, sdlang_parser_parse_buffer(parser, buffer, size, &state));\n"
+            "}\n\n"
+            "int %s_parse_file(struct sdlang_parser_t* parser, struct %s_t* target, uint32_t* counts,\n"
+            "    const char* path)\n"
+            "{\n"
+            "    struct %s_state_t state;\n\n"
+            "    %s_begin(&state, parser, target);\n\n"
+            "    return %s_end(&state, counts, sdlang_parser_parse_file(parser, path, &state));\n"
+            "}\n",
+            name, name, name, name, name, name,
+            name, name, name, name, name,
+            name, name, name, name, name);
+}
+
+int main(int argc, char* argv[])
+{
+    char name[MAX_NAME], path[1024];
+    FILE* out;
+
+    if (argc != 3)
+    {
+        fprintf(stderr, "usage: %s schema.sdl prefix\n", argv[0]);
+        return 1;
+    }
+
+    if (!read_schema(argv[1], name, sizeof(name)))
+    {
+        return 1;
+    }
+
+    /* the header is included by the name it has next to the source */
+    const char* base = argv[2];
+
+    for (const char* p = argv[2]; *p != '\0'; p++)
+    {
+        base = *p == '/' || *p == '\\' ? p + 1 : base;
+    }
+
+    snprintf(path, sizeof(path), "%s.h", argv[2]);
+
+    if ((out = fopen(path, "w")) == NULL)
+    {
+        fprintf(stderr, "failed to open %s\n", path);
+        return 1;
+    }
+
+    write_header(out, name, argv[1]);
+    fclose(out);
+
+    snprintf(path, sizeof(path), "%s.c", argv[2]);
+
+    if ((out = fopen(path, "w")) == NULL)
+    {
+        fprintf(stderr, "failed to open %s\n", path);
+        return 1;
+    }
+
+    snprintf(path, sizeof(path), "%s.h", base);
+    write_source(out, name, path, argv[1]);
+    fclose(out);
+
+    return 0;
+}